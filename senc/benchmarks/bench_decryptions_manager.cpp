@@ -0,0 +1,75 @@
+/*********************************************************************
+ * \file   bench_decryptions_manager.cpp
+ * \brief  Benchmarks of DecryptionsManager class.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "benchmarks.hpp"
+#include "bench_utils.hpp"
+
+#include "../server/managers/DecryptionsManager.hpp"
+#include <string>
+#include <vector>
+
+using senc::server::managers::DecryptionsManager;
+using senc::member_count_t;
+using senc::OperationID;
+
+namespace senc::bench
+{
+	// participants each operation requires before moving to collecting
+	constexpr member_count_t PARTICIPANTS_PER_OP = 200;
+
+	// operations each thread drives to collecting
+	constexpr std::size_t OPS_PER_THREAD = 200;
+
+	/**
+	 * @brief Creates operations waiting for `PARTICIPANTS_PER_OP` participants.
+	 * @param manager Decryptions manager to create operations in.
+	 * @param count Amount of operations to create.
+	 * @return IDs of created operations.
+	 */
+	static std::vector<OperationID> make_operations(DecryptionsManager& manager, std::size_t count)
+	{
+		std::vector<OperationID> res;
+		res.reserve(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			res.push_back(manager.new_operation());
+			manager.prepare_operation(
+				res.back(), "requester", UserSetID::generate(), Ciphertext{},
+				0, PARTICIPANTS_PER_OP
+			);
+		}
+		return res;
+	}
+
+	void bench_decryptions_manager()
+	{
+		print_group("DecryptionsManager::register_participant");
+
+		std::vector<std::string> usernames;
+		for (member_count_t i = 0; i < PARTICIPANTS_PER_OP; ++i)
+			usernames.push_back("user" + std::to_string(i));
+
+		for (std::size_t threadCount : { 1, 2, 4, 8 })
+		{
+			// each thread registers participants of its own operations
+			DecryptionsManager manager;
+			auto opids = make_operations(manager, threadCount * OPS_PER_THREAD);
+			const auto elapsed = measure_threads(threadCount, [&](std::size_t t)
+			{
+				for (std::size_t i = t * OPS_PER_THREAD; i < (t + 1) * OPS_PER_THREAD; ++i)
+					for (const auto& username : usernames)
+						do_not_optimize(manager.register_participant(opids[i], username, false));
+			});
+			print_result(
+				"distinct ops, threads=" + std::to_string(threadCount),
+				threadCount * OPS_PER_THREAD * PARTICIPANTS_PER_OP,
+				elapsed
+			);
+		}
+	}
+}
@@ -0,0 +1,148 @@
+/*********************************************************************
+ * \file   bench_ec_group.cpp
+ * \brief  Benchmarks of ECGroup and P256Group classes and schemas using them.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "benchmarks.hpp"
+#include "bench_utils.hpp"
+
+#include "../utils/enc/HybridElGamal2L.hpp"
+#include "../utils/enc/ECHKDF2L.hpp"
+#include "../utils/enc/AES1L.hpp"
+#include "../utils/P256Group.hpp"
+#include "../utils/ECGroup.hpp"
+#include "../utils/Random.hpp"
+#include <string>
+#include <vector>
+#include <span>
+
+using senc::utils::enc::HybridElGamal2L;
+using senc::utils::enc::ECHKDF2L;
+using senc::utils::enc::AES1L;
+using senc::utils::P256Group;
+using senc::utils::ECGroup;
+using senc::utils::BigInt;
+using senc::utils::Buffer;
+using senc::utils::Random;
+
+namespace senc::bench
+{
+	// exponentiations per benchmark
+	constexpr std::size_t POW_ITERATIONS = 2000;
+
+	// multi-exponentiations per benchmark
+	constexpr std::size_t MULTI_POW_ITERATIONS = 50;
+
+	// batch encryptions per benchmark, and plaintexts per batch
+	constexpr std::size_t ENCRYPT_BATCH_ITERATIONS = 10;
+	constexpr std::size_t ENCRYPT_BATCH_SIZE = 256;
+
+	/**
+	 * @brief Samples exponents below group order.
+	 * @param count Amount of exponents to sample.
+	 * @return Sampled exponents.
+	 */
+	static std::vector<BigInt> sample_exponents(std::size_t count)
+	{
+		std::vector<BigInt> res;
+		res.reserve(count);
+		for (std::size_t i = 0; i < count; ++i)
+			res.push_back(Random<BigInt>::sample_below(ECGroup::order()));
+		return res;
+	}
+
+	/**
+	 * @brief Benchmarks group operations and schema using a given group type.
+	 * @tparam G Group type (`ECGroup` or `P256Group`).
+	 * @param name Name of group type.
+	 * @param exps Exponents to use.
+	 */
+	template <typename G>
+	static void bench_group(const std::string& name, const std::vector<BigInt>& exps)
+	{
+		print_group(name + " exponentiation");
+
+		// warm up fixed-base table, so that its one-time build is not measured
+		do_not_optimize(G::generator_pow(exps.front()));
+
+		// g^2 is not the base point, so it takes the generic path (same cost as un-tabled g^x)
+		const G base = G::generator() * G::generator();
+		std::size_t i = 0;
+		print_result("pow (generic)", exps.size(), measure(exps.size(), [&]()
+		{
+			do_not_optimize(base.pow(exps[i++]));
+		}));
+
+		i = 0;
+		print_result("generator_pow (fixed-base table)", exps.size(), measure(exps.size(), [&]()
+		{
+			do_not_optimize(G::generator_pow(exps[i++]));
+		}));
+
+		G acc = base;
+		print_result("operator*=", exps.size(), measure(exps.size(), [&]()
+		{
+			acc *= base;
+		}));
+		print_result("encode", exps.size(), measure(exps.size(), [&]()
+		{
+			do_not_optimize(acc.encode());
+		}));
+
+		for (std::size_t count : { 4, 64 })
+		{
+			std::vector<G> bases;
+			for (std::size_t j = 0; j < count; ++j)
+				bases.push_back(G::sample());
+			const std::span<const BigInt> baseExps(exps.data(), count);
+			const std::string suffix = " (" + std::to_string(count) + " bases)";
+
+			print_result("separate pows" + suffix, MULTI_POW_ITERATIONS, measure(MULTI_POW_ITERATIONS, [&]()
+			{
+				G res = G::identity();
+				for (std::size_t j = 0; j < count; ++j)
+					res *= bases[j].pow(baseExps[j]);
+				do_not_optimize(res);
+			}));
+			print_result("multi_pow" + suffix, MULTI_POW_ITERATIONS, measure(MULTI_POW_ITERATIONS, [&]()
+			{
+				do_not_optimize(senc::utils::multi_pow<G, BigInt>(bases, baseExps));
+			}));
+		}
+
+		print_group("HybridElGamal2L<" + name + ">");
+
+		HybridElGamal2L<G, AES1L, ECHKDF2L> schema;
+		print_result("keygen", exps.size(), measure(exps.size(), [&]()
+		{
+			do_not_optimize(schema.keygen());
+		}));
+
+		// encrypt does two generator exponentiations and two generic ones (with public keys)
+		const auto [pubKey1, privKey1] = schema.keygen();
+		const auto [pubKey2, privKey2] = schema.keygen();
+		const Buffer plaintext(32, 0xAB);
+		print_result("encrypt (32 bytes)", exps.size(), measure(exps.size(), [&]()
+		{
+			do_not_optimize(schema.encrypt(plaintext, pubKey1, pubKey2));
+		}));
+
+		// encrypt_batch exponentiates public keys with precomputed tables (built by first batch, then cached)
+		const std::vector<Buffer> plaintexts(ENCRYPT_BATCH_SIZE, plaintext);
+		print_result("encrypt_batch (" + std::to_string(ENCRYPT_BATCH_SIZE) + " x 32 bytes)",
+			ENCRYPT_BATCH_ITERATIONS * ENCRYPT_BATCH_SIZE, measure(ENCRYPT_BATCH_ITERATIONS, [&]()
+			{
+				do_not_optimize(schema.encrypt_batch(plaintexts, pubKey1, pubKey2));
+			}));
+	}
+
+	void bench_ec_group()
+	{
+		const auto exps = sample_exponents(POW_ITERATIONS);
+		bench_group<ECGroup>("ECGroup", exps);
+		bench_group<P256Group>("P256Group", exps);
+	}
+}
@@ -0,0 +1,44 @@
+/*********************************************************************
+ * \file   bench_main.cpp
+ * \brief  Entry point of benchmarks executable.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "benchmarks.hpp"
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using senc::bench::bench_decryptions_manager;
+using senc::bench::bench_ec_group;
+using senc::bench::bench_mod_int;
+using senc::bench::bench_sqlite_indexes;
+
+// benchmark groups by name
+const std::vector<std::pair<std::string, std::function<void()>>> GROUPS{
+	{ "decryptions_manager", bench_decryptions_manager },
+	{ "ec_group", bench_ec_group },
+	{ "mod_int", bench_mod_int },
+	{ "sqlite_indexes", bench_sqlite_indexes },
+};
+
+int main(int argc, char** argv)
+{
+	// optional argument: substring of names of groups to run (all if omitted)
+	if (argc > 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " [filter]" << std::endl;
+		return 1;
+	}
+	const std::string filter = (2 == argc) ? argv[1] : "";
+
+	for (const auto& [name, func] : GROUPS)
+		if (name.find(filter) != std::string::npos)
+			func();
+
+	return 0;
+}
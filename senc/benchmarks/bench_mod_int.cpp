@@ -0,0 +1,114 @@
+/*********************************************************************
+ * \file   bench_mod_int.cpp
+ * \brief  Benchmarks of ModInt and MontModInt classes, as used for Shamir scalars.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "benchmarks.hpp"
+#include "bench_utils.hpp"
+
+#include "../common/aliases.hpp"
+#include "../common/sizes.hpp"
+#include "../utils/MontModInt.hpp"
+#include "../utils/ModInt.hpp"
+#include <string>
+#include <vector>
+
+using senc::utils::MontModInt;
+using senc::utils::ModInt;
+
+namespace senc::bench
+{
+	// arithmetic operations per benchmark
+	constexpr std::size_t ARITH_ITERATIONS = 20000;
+
+	// inversions (and exponentiations) per benchmark
+	constexpr std::size_t INVERSE_ITERATIONS = 500;
+
+	// Lagrange coefficients sets computed per benchmark
+	constexpr std::size_t LAGRANGE_ITERATIONS = 5;
+
+	/**
+	 * @brief Benchmarks arithmetic of a modular integer type (same workloads as ModInt tests).
+	 * @tparam M Modular integer type (`ModInt` or `MontModInt`).
+	 * @param name Name of modular integer type.
+	 * @param values Plain values to use (at least `ARITH_ITERATIONS`).
+	 */
+	template <typename M>
+	static void bench_mod_int_type(const std::string& name, const std::vector<typename M::Int>& values)
+	{
+		print_group(name);
+
+		std::vector<M> elems;
+		elems.reserve(values.size());
+		print_result("construct", values.size(), measure(values.size(), [&]()
+		{
+			elems.emplace_back(values[elems.size()]);
+		}));
+
+		M acc = elems.front();
+		std::size_t i = 0;
+		print_result("operator+=", ARITH_ITERATIONS, measure(ARITH_ITERATIONS, [&]()
+		{
+			acc += elems[i++];
+		}));
+		i = 0;
+		print_result("operator*=", ARITH_ITERATIONS, measure(ARITH_ITERATIONS, [&]()
+		{
+			acc *= elems[i++];
+		}));
+		i = 0;
+		print_result("operator/", INVERSE_ITERATIONS, measure(INVERSE_ITERATIONS, [&]()
+		{
+			do_not_optimize(elems[i] / elems[i + 1]);
+			++i;
+		}));
+		i = 0;
+		print_result("pow", INVERSE_ITERATIONS, measure(INVERSE_ITERATIONS, [&]()
+		{
+			do_not_optimize(elems[i].pow(values[i + 1]));
+			++i;
+		}));
+
+		// Horner evaluation of a polynomial of maximal userset degree (as in making shards)
+		const std::size_t degree = MAX_MEMBERS;
+		i = 0;
+		print_result("poly eval (degree " + std::to_string(degree) + ")", INVERSE_ITERATIONS,
+			measure(INVERSE_ITERATIONS, [&]()
+			{
+				M res = elems[0];
+				for (std::size_t j = 1; j <= degree; ++j)
+					res = res * elems[i] + elems[j];
+				do_not_optimize(res);
+				++i;
+			}));
+		do_not_optimize(acc);
+	}
+
+	void bench_mod_int()
+	{
+		using Traits = typename PrivKeyShardValue::Traits;
+		std::vector<utils::BigInt> values;
+		values.reserve(ARITH_ITERATIONS);
+		for (std::size_t i = 0; i < ARITH_ITERATIONS; ++i)
+			values.push_back(PrivKeyShardValue::sample());
+
+		bench_mod_int_type<ModInt<Traits>>("ModInt (group order)", values);
+		bench_mod_int_type<MontModInt<Traits>>("MontModInt (group order)", values);
+
+		print_group("Lagrange coefficients (group order)");
+		for (std::size_t count : { std::size_t(16), MAX_MEMBERS })
+		{
+			std::vector<PrivKeyShardID> ids;
+			for (std::size_t id = 1; id <= count; ++id)
+				ids.emplace_back(static_cast<long>(id));
+			print_result("lagrange_coeffs (" + std::to_string(count) + " shards)", LAGRANGE_ITERATIONS,
+				measure(LAGRANGE_ITERATIONS, [&]()
+				{
+					do_not_optimize(Shamir::lagrange_coeffs(ids));
+				}));
+		}
+	}
+}
@@ -0,0 +1,175 @@
+/*********************************************************************
+ * \file   bench_sqlite_indexes.cpp
+ * \brief  Benchmarks of sqlite schema indexes, on the server storage schema.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "benchmarks.hpp"
+#include "bench_utils.hpp"
+
+#include "../utils/sqlite/Database.hpp"
+#include "../utils/bytes.hpp"
+#include <string>
+#include <vector>
+
+namespace sql = senc::utils::sqlite;
+
+namespace senc::bench
+{
+	// registered users
+	constexpr std::size_t USERS = 100000;
+
+	// members of each userset (usersets are created until reaching `MEMBERSHIPS`)
+	constexpr std::size_t MEMBERS_PER_USERSET = 10;
+
+	// total memberships
+	constexpr std::size_t MEMBERSHIPS = 1000000;
+
+	// lookups of each kind per benchmark
+	constexpr std::size_t LOOKUP_ITERATIONS = 200;
+
+	// same tables as `SqliteServerStorage`, with given indexes
+	template <sql::schemas::SomeIndex... Indexes>
+	using MembersDB = sql::schemas::DB<
+		sql::schemas::Table<"Users",
+			sql::schemas::PrimaryKey<"username", sql::Text>,
+			sql::schemas::Col       <"pwd_salt", sql::Blob>,
+			sql::schemas::Col       <"pwd_hash", sql::Blob>
+		>,
+		sql::schemas::Table<"UserSets",
+			sql::schemas::PrimaryKey<"id"                   , sql::Blob>,
+			sql::schemas::Col       <"owners_threshold"     , sql::Int >,
+			sql::schemas::Col       <"reg_members_threshold", sql::Int >
+		>,
+		sql::schemas::Table<"Members",
+			sql::schemas::ForeignKey<"username"  , sql::Text, "Users"         >,
+			sql::schemas::ForeignKey<"userset_id", sql::Blob, "UserSets", "id">,
+			sql::schemas::Col       <"shard_id"  , sql::Blob                  >,
+			sql::schemas::Col       <"is_owner"  , sql::Int                   >
+		>,
+		Indexes...
+	>;
+
+	/**
+	 * @brief Gets name of a benchmark user.
+	 */
+	static std::string username(std::size_t user)
+	{
+		return "user" + std::to_string(user);
+	}
+
+	/**
+	 * @brief Gets (fixed size) ID of a benchmark userset, or shard ID of a member.
+	 */
+	static utils::Buffer id_bytes(std::size_t id)
+	{
+		utils::Buffer res(16, 0);
+		for (std::size_t i = 0; i < sizeof(id); ++i)
+			res[i] = static_cast<utils::byte>(id >> (8 * i));
+		return res;
+	}
+
+	/**
+	 * @brief Gets user of a member of a benchmark userset (members of a userset are distinct).
+	 */
+	static std::size_t member_user(std::size_t userset, std::size_t member)
+	{
+		return (userset + member * 10007) % USERS;
+	}
+
+	/**
+	 * @brief Benchmarks filling a database of given schema, then storage lookups on it.
+	 * @tparam Schema Database schema (a `MembersDB`).
+	 * @param title Title of benchmark group.
+	 */
+	template <sql::schemas::SomeDB Schema>
+	static void bench_members_db(const std::string& title)
+	{
+		print_group(title);
+		sql::Database<Schema> db(":memory:");
+		const utils::Buffer pwd(32, 0xAB);
+
+		std::size_t i = 0;
+		print_result("insert user", USERS, measure(USERS, [&]()
+		{
+			db.template insert<"Users">(sql::Text(username(i++)), sql::BlobView(pwd), sql::BlobView(pwd));
+		}));
+
+		const std::size_t usersets = MEMBERSHIPS / MEMBERS_PER_USERSET;
+		for (std::size_t s = 0; s < usersets; ++s)
+			db.template insert<"UserSets">(sql::Blob(id_bytes(s)), sql::Int(1), sql::Int(1));
+
+		i = 0;
+		print_result("insert membership", MEMBERSHIPS, measure(MEMBERSHIPS, [&]()
+		{
+			const std::size_t s = i / MEMBERS_PER_USERSET, m = i % MEMBERS_PER_USERSET;
+			db.template insert<"Members">(
+				sql::Text(username(member_user(s, m))),
+				sql::Blob(id_bytes(s)),
+				sql::Blob(id_bytes(m + 1)),
+				sql::Int(0 == m)
+			);
+			++i;
+		}));
+
+		// lookups are spread across usersets (and users); `rows` counts matched rows of all lookups
+		const auto userset_of = [usersets](std::size_t j) { return (j * 7919) % usersets; };
+		std::size_t rows = 0;
+
+		i = 0;
+		print_result("get_usersets", LOOKUP_ITERATIONS, measure(LOOKUP_ITERATIONS, [&]()
+		{
+			const std::string user = username(member_user(userset_of(i++), 0));
+			db.template select<"Members", sql::SelectArg<"userset_id">>()
+				.template where<"username">(sql::TextView(user))
+				.where("is_owner != 0")
+				>> [&rows](sql::BlobView) { ++rows; };
+		}));
+
+		i = 0;
+		print_result("user_owns_userset", LOOKUP_ITERATIONS, measure(LOOKUP_ITERATIONS, [&]()
+		{
+			const std::size_t s = userset_of(i++);
+			const std::string user = username(member_user(s, 0));
+			const utils::Buffer setID = id_bytes(s);
+			db.template select<"Members", sql::SelectArg<"username">>()
+				.template where<"username">(sql::TextView(user))
+				.template where<"userset_id">(sql::BlobView(setID))
+				.where("is_owner != 0")
+				>> [&rows](sql::TextView) { ++rows; };
+		}));
+
+		i = 0;
+		print_result("get_userset_info (members)", LOOKUP_ITERATIONS, measure(LOOKUP_ITERATIONS, [&]()
+		{
+			const utils::Buffer setID = id_bytes(userset_of(i++));
+			db.template select<"Members", sql::SelectArg<"username">, sql::SelectArg<"is_owner">>()
+				.template where<"userset_id">(sql::BlobView(setID))
+				>> [&rows](sql::TextView, sql::IntView) { ++rows; };
+		}));
+
+		i = 0;
+		print_result("shard_id_exists", LOOKUP_ITERATIONS, measure(LOOKUP_ITERATIONS, [&]()
+		{
+			const utils::Buffer setID = id_bytes(userset_of(i));
+			const utils::Buffer shardID = id_bytes(i % (MEMBERS_PER_USERSET * 2) + 1); // half exist
+			++i;
+			db.template select<"Members", sql::SelectArg<"username">>()
+				.template where<"shard_id">(sql::BlobView(shardID))
+				.template where<"userset_id">(sql::BlobView(setID))
+				>> [&rows](sql::TextView) { ++rows; };
+		}));
+		do_not_optimize(rows);
+	}
+
+	void bench_sqlite_indexes()
+	{
+		bench_members_db<MembersDB<>>("sqlite storage schema (no indexes)");
+		bench_members_db<MembersDB<
+			sql::schemas::Index      <"Members", "username"  , "userset_id">,
+			sql::schemas::UniqueIndex<"Members", "userset_id", "shard_id"  >
+		>>("sqlite storage schema (Members indexes)");
+	}
+}
@@ -0,0 +1,78 @@
+/*********************************************************************
+ * \file   bench_utils.cpp
+ * \brief  Implementation of utilities for benchmarks.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "bench_utils.hpp"
+
+#include <condition_variable>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <mutex>
+
+namespace senc::bench
+{
+	const volatile void* sink = nullptr;
+
+	void print_group(const std::string& title)
+	{
+		std::cout << std::endl << "===== " << title << " =====" << std::endl;
+		std::cout << std::left << std::setw(48) << "benchmark"
+			<< std::right << std::setw(12) << "ops"
+			<< std::setw(14) << "ns/op"
+			<< std::setw(14) << "ops/s" << std::endl;
+	}
+
+	void print_result(const std::string& name, std::size_t ops, Clock::duration elapsed)
+	{
+		const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+		const double nsPerOp = ops ? (ns / ops) : 0.0;
+		const double opsPerSec = (ns > 0) ? (ops * 1e9 / ns) : 0.0;
+		std::cout << std::left << std::setw(48) << name
+			<< std::right << std::setw(12) << ops
+			<< std::setw(14) << std::fixed << std::setprecision(1) << nsPerOp
+			<< std::setw(14) << std::fixed << std::setprecision(0) << opsPerSec << std::endl;
+	}
+
+	Clock::duration measure(std::size_t iterations, const std::function<void()>& func)
+	{
+		const auto start = Clock::now();
+		for (std::size_t i = 0; i < iterations; ++i)
+			func();
+		return Clock::now() - start;
+	}
+
+	Clock::duration measure_threads(std::size_t threadCount, const std::function<void(std::size_t)>& func)
+	{
+		std::mutex mtx;
+		std::condition_variable cv;
+		bool go = false;
+
+		std::vector<std::jthread> threads;
+		threads.reserve(threadCount);
+		for (std::size_t i = 0; i < threadCount; ++i)
+			threads.emplace_back([&, i]()
+			{
+				{
+					std::unique_lock<std::mutex> lock(mtx);
+					cv.wait(lock, [&go]() { return go; });
+				}
+				func(i);
+			});
+
+		// release all threads at once
+		const auto start = Clock::now();
+		{
+			const std::lock_guard<std::mutex> lock(mtx);
+			go = true;
+		}
+		cv.notify_all();
+		threads.clear(); // joins
+		return Clock::now() - start;
+	}
+}
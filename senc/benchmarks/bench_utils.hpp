@@ -0,0 +1,61 @@
+/*********************************************************************
+ * \file   bench_utils.hpp
+ * \brief  Header of utilities for benchmarks.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <chrono>
+#include <string>
+
+namespace senc::bench
+{
+	using Clock = std::chrono::steady_clock;
+
+	// written by `do_not_optimize`, so that computed values are considered used
+	extern const volatile void* sink;
+
+	/**
+	 * @brief Prints a header line for a benchmark group.
+	 * @param title Title of benchmark group.
+	 */
+	void print_group(const std::string& title);
+
+	/**
+	 * @brief Prints result of a single benchmark.
+	 * @param name Name of benchmark (including parameters).
+	 * @param ops Amount of operations performed.
+	 * @param elapsed Total time it took to perform `ops` operations.
+	 */
+	void print_result(const std::string& name, std::size_t ops, Clock::duration elapsed);
+
+	/**
+	 * @brief Measures time it takes to run a function a given amount of times.
+	 * @param iterations Amount of times to run `func`.
+	 * @param func Function to run.
+	 * @return Total elapsed time.
+	 */
+	Clock::duration measure(std::size_t iterations, const std::function<void()>& func);
+
+	/**
+	 * @brief Measures time it takes for a set of threads to run a function concurrently.
+	 * @param threadCount Amount of threads to run.
+	 * @param func Function to run on each thread (given thread index).
+	 * @return Time from release of all threads until last thread finished.
+	 */
+	Clock::duration measure_threads(std::size_t threadCount, const std::function<void(std::size_t)>& func);
+
+	/**
+	 * @brief Prevents compiler from optimizing away a computed value.
+	 * @param value Computed value.
+	 */
+	template <typename T>
+	inline void do_not_optimize(const T& value)
+	{
+		sink = &value;
+	}
+}
@@ -0,0 +1,32 @@
+/*********************************************************************
+ * \file   benchmarks.hpp
+ * \brief  Declares all benchmark groups.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+namespace senc::bench
+{
+	/**
+	 * @brief Benchmarks concurrent access to `DecryptionsManager`.
+	 */
+	void bench_decryptions_manager();
+
+	/**
+	 * @brief Benchmarks `ECGroup` and `P256Group` operations, and key generation and encryption using them.
+	 */
+	void bench_ec_group();
+
+	/**
+	 * @brief Benchmarks `ModInt` and `MontModInt` arithmetic under group order, and Lagrange coefficients.
+	 */
+	void bench_mod_int();
+
+	/**
+	 * @brief Benchmarks server storage lookups on a populated sqlite database, with and without indexes.
+	 */
+	void bench_sqlite_indexes();
+}
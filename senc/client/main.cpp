@@ -536,6 +536,14 @@ namespace senc::client
 				print_finished_data(i, data);
 		}
 
+		if (!resp.expired_operations.empty())
+		{
+			hadUpdates = true;
+			cout << "IDs of decryption operations that expired before finishing:" << endl;
+			for (const auto& [i, opid] : resp.expired_operations | utils::views::enumerate)
+				cout << (i + 1) << ".\t" << opid << endl;
+		}
+
 		if (!hadUpdates)
 			cout << "No updates to show." << endl;
 		cout << endl;
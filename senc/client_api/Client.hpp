@@ -74,11 +74,20 @@ namespace senc::clientapi
 
 		Ciphertext encrypt(const UserSetID& usersetID, const utils::Buffer& msg) override;
 
+		std::vector<Ciphertext> encrypt_batch(const UserSetID& usersetID,
+											  std::span<const utils::Buffer> msgs) override;
+
 		OperationID decrypt(const UserSetID& usersetID, const Ciphertext& ciphertext) override;
 
 		void force_update() override;
 
 	private:
+		// maximum time server may hold an update request until updates arrive (long-poll)
+		static constexpr std::chrono::milliseconds UPDATE_MAX_WAIT{ 1000 };
+
+		// delay between update cycles (short, since server already holds update requests)
+		static constexpr std::chrono::milliseconds UPDATE_CYCLE_DELAY{ 50 };
+
 		IP _serverIP;
 		utils::Port _serverPort;
 		std::function<void(const OperationID&, const utils::Buffer&)> _decryptFinishedCallback;
@@ -190,6 +199,12 @@ namespace senc::clientapi
 		 */
 		void handle_finished_decryption(pkt::UpdateResponse::FinishedDecryptionsRecord&& data);
 
+		/**
+		 * @brief Handles "expired operation" update.
+		 * @param opid Operation ID.
+		 */
+		void handle_expired_operation(const OperationID& opid);
+
 		/**
 		 * @brief Attemps to participate in decryption operation.
 		 * @param opid Operation ID (moved).
@@ -159,6 +159,19 @@ namespace senc::clientapi
 		); 
 	}
 
+	template <utils::IPType IP>
+	inline std::vector<Ciphertext> Client<IP>::encrypt_batch(const UserSetID& usersetID,
+															 std::span<const utils::Buffer> msgs)
+	{
+		const storage::ProfileRecord record = find_profile_record_by_userset_id(usersetID);
+
+		return _schema.encrypt_batch(
+			msgs,
+			record.reg_layer_pub_key(),
+			record.owner_layer_pub_key()
+		);
+	}
+
 	template <utils::IPType IP>
 	inline OperationID Client<IP>::decrypt(const UserSetID& usersetID, const Ciphertext& ciphertext)
 	{
@@ -197,7 +210,7 @@ namespace senc::clientapi
 		this->_packetHandler.emplace(QueuedPacketHandler::client(
 			_sock,
 			[this](PacketHandler& packetHandler) { return this->update_callback(packetHandler); },
-			std::chrono::milliseconds(2000), // two seconds between update cycles
+			UPDATE_CYCLE_DELAY,
 			_packetHandlerFactory
 		));
 	}
@@ -222,7 +235,10 @@ namespace senc::clientapi
 	{
 		try
 		{
-			pkt::UpdateResponse resp = Self::post_on<pkt::UpdateResponse>(packetHandler, pkt::UpdateRequest{});
+			pkt::UpdateResponse resp = Self::post_on<pkt::UpdateResponse>(
+				packetHandler,
+				pkt::UpdateRequest{ static_cast<update_wait_t>(UPDATE_MAX_WAIT.count()) }
+			);
 			for (auto& record : resp.added_as_reg_member)
 				this->handle_added_as_reg_member(std::move(record));
 			for (auto& record : resp.added_as_owner)
@@ -233,6 +249,8 @@ namespace senc::clientapi
 				this->handle_to_decrypt(std::move(record));
 			for (auto& record : resp.finished_decryptions)
 				this->handle_finished_decryption(std::move(record));
+			for (const auto& opid : resp.expired_operations)
+				this->handle_expired_operation(opid);
 		}
 		catch (const ClientException&)
 		{
@@ -371,6 +389,13 @@ namespace senc::clientapi
 		_decryptFinishedCallback(data.op_id, decrypted);
 	}
 
+	template <utils::IPType IP>
+	inline void Client<IP>::handle_expired_operation(const OperationID& opid)
+	{
+		// operation will never finish, drop its pending decryption
+		_pendingDecryptions.erase(opid);
+	}
+
 	template <utils::IPType IP>
 	inline void Client<IP>::request_participance(OperationID&& opid)
 	{
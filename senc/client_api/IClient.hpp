@@ -11,6 +11,8 @@
 #include "../common/aliases.hpp"
 #include "../utils/ranges.hpp"
 #include <functional>
+#include <vector>
+#include <span>
 
 namespace senc::clientapi
 {
@@ -90,6 +92,17 @@ namespace senc::clientapi
 		 */
 		virtual Ciphertext encrypt(const UserSetID& usersetID, const utils::Buffer& msg) = 0;
 
+		/**
+		 * @brief Encrypts multiple messages under a userset.
+		 * @note Requires user to be logged in.
+		 * @note Considerably faster than encrypting each message separately (see `Schema::encrypt_batch`).
+		 * @param usersetID ID of userset to encrypt under.
+		 * @param msgs Messages to encrypt.
+		 * @return Encrypted messages (matching `msgs` by index).
+		 */
+		virtual std::vector<Ciphertext> encrypt_batch(const UserSetID& usersetID,
+													  std::span<const utils::Buffer> msgs) = 0;
+
 		/**
 		 * @brief Queues a message decryption under a userset.
 		 * @note Requires user to be logged in.
@@ -13,6 +13,7 @@
 #include "../utils/bytes.hpp"
 #include "Client.hpp"
 #include "Value.hpp"
+#include <algorithm>
 
 namespace api = senc::clientapi;
 namespace utils = senc::utils;
@@ -78,8 +79,8 @@ uintptr_t SENC_NewCiphertext(const uint8_t* c1Bytes, uint64_t c1Len,
 			auto& [c1, c2, c3] = res;
 			auto& [c3a, c3b] = c3;
 
-			c1 = utils::ECGroup::decode({ c1Bytes, c1Len });
-			c2 = utils::ECGroup::decode({ c2Bytes, c2Len });
+			c1 = senc::EncGroup::decode({ c1Bytes, c1Len });
+			c2 = senc::EncGroup::decode({ c2Bytes, c2Len });
 			c3a.Assign(c3aBytes, c3aLen);
 			c3b.assign(c3bBytes, c3bBytes + c3bLen);
 
@@ -367,6 +368,36 @@ uintptr_t SENC_Encrypt(uintptr_t hClient, const char* usersetID,
 	})->as_nint();
 }
 
+uintptr_t SENC_EncryptBatch(uintptr_t hClient, const char* usersetID, uint64_t msgsCount,
+							const uint8_t** msgs, const uint64_t* msgLens, uintptr_t* hCiphertexts) noexcept
+{
+	auto& client = *(api::Value<std::unique_ptr<api::IClient>>::from_nint(hClient)->get());
+	return api::Error::ret_null_or_err([&client, usersetID, msgsCount, msgs, msgLens, hCiphertexts]()
+	{
+		std::vector<utils::Buffer> plaintexts;
+		plaintexts.reserve(msgsCount);
+		for (uint64_t i = 0; i < msgsCount; ++i)
+			plaintexts.emplace_back(msgs[i], msgs[i] + msgLens[i]);
+
+		auto ciphertexts = client.encrypt_batch(usersetID, plaintexts);
+
+		// allocate all handles before publishing any, so that output is untouched on failure
+		std::vector<uintptr_t> handles;
+		handles.reserve(msgsCount);
+		for (uint64_t i = 0; i < msgsCount; ++i)
+		{
+			handles.push_back(api::Value<senc::Ciphertext>::new_instance(std::move(ciphertexts[i]))->as_nint());
+			if (SENC_HasError(handles.back()))
+			{
+				for (const uintptr_t handle : handles)
+					SENC_FreeHandle(handle);
+				throw std::bad_alloc(); // moving a ciphertext into a handle only fails on allocation
+			}
+		}
+		std::copy(handles.begin(), handles.end(), hCiphertexts);
+	})->as_nint();
+}
+
 uintptr_t SENC_Decrypt(uintptr_t hClient, const char* usersetID, uintptr_t hCiphertext) noexcept
 {
 	auto& client = *(api::Value<std::unique_ptr<api::IClient>>::from_nint(hClient)->get());
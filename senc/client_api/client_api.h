@@ -335,6 +335,27 @@ SENC_CLIENT_API_PUBLIC uintptr_t SENC_Encrypt(uintptr_t hClient,
 											  const uint8_t* msg,
 											  uint64_t msgLen) SENC_NOTHROW;
 
+/**
+ * @brief Encrypts multiple messages under a userset.
+ * @note Requires user to be logged in.
+ * @note Considerably faster than calling `SENC_Encrypt` for each message.
+ * @param hClient Client handle.
+ * @param usersetID ID of userset to encrypt under.
+ * @param msgsCount Amount of messages to encrypt.
+ * @param msgs Messages to encrypt.
+ * @param msgLens Lengths of messages to encrypt (matching `msgs` by index).
+ * @param hCiphertexts Output array (of `msgsCount` elements) to store ciphertext handles of encrypted
+ *					   messages into (untouched if failed). Each handle is to be deallocated by caller.
+ * @return Null on success, error if failed.
+ * @note Calling this function on a non-client handle is undefined behaviour.
+ */
+SENC_CLIENT_API_PUBLIC uintptr_t SENC_EncryptBatch(uintptr_t hClient,
+												   const char* usersetID,
+												   uint64_t msgsCount,
+												   const uint8_t** msgs,
+												   const uint64_t* msgLens,
+												   uintptr_t* hCiphertexts) SENC_NOTHROW;
+
 /**
  * @brief Queues a message decryption under a userset.
  * @note Requires user to be logged in.
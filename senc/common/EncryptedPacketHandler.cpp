@@ -13,6 +13,27 @@
 namespace senc
 {
 	EncryptedPacketHandler::Self EncryptedPacketHandler::server(utils::Socket& sock)
+	{
+		return server_handshake(sock, nullptr);
+	}
+
+	EncryptedPacketHandler::Self EncryptedPacketHandler::server(utils::Socket& sock, EphemeralKeyPool& keyPool)
+	{
+		return server_handshake(sock, &keyPool);
+	}
+
+	EncryptedPacketHandler::Self EncryptedPacketHandler::client(utils::Socket& sock)
+	{
+		return client_handshake(sock, nullptr);
+	}
+
+	EncryptedPacketHandler::Self EncryptedPacketHandler::client(utils::Socket& sock, EphemeralKeyPool& keyPool)
+	{
+		return client_handshake(sock, &keyPool);
+	}
+
+	EncryptedPacketHandler::Self EncryptedPacketHandler::server_handshake(utils::Socket& sock,
+																		  EphemeralKeyPool* keyPool)
 	{
 		Self res(sock);
 
@@ -31,9 +52,9 @@ namespace senc
 			Group gx{};
 			SockUtils::recv_ecgroup_elem(res._sock, gx);
 
-			// sample y and send gy for key exchange
-			const utils::BigInt y = sample_pow();
-			const Group gy = Group::generator().pow(y);
+			// take y (precomputed along with gy, if pooled) and send gy for key exchange
+			EphemeralKeyGen gen;
+			const auto [y, gy] = keyPool ? keyPool->take(gen) : gen.keygen();
 			SockUtils::send_ecgroup_elem(res._sock, gy);
 
 			// compute g^xy and dereive key
@@ -48,7 +69,8 @@ namespace senc
 		return res;
 	}
 
-	EncryptedPacketHandler::Self EncryptedPacketHandler::client(utils::Socket& sock)
+	EncryptedPacketHandler::Self EncryptedPacketHandler::client_handshake(utils::Socket& sock,
+																		  EphemeralKeyPool* keyPool)
 	{
 		Self res(sock);
 
@@ -62,9 +84,9 @@ namespace senc
 
 		try
 		{
-			// sample x and send g^x for key exchange
-			const utils::BigInt x = sample_pow();
-			const Group gx = Group::generator().pow(x);
+			// take x (precomputed along with g^x, if pooled) and send g^x for key exchange
+			EphemeralKeyGen gen;
+			const auto [x, gx] = keyPool ? keyPool->take(gen) : gen.keygen();
 			SockUtils::send_ecgroup_elem(res._sock, gx);
 
 			// receive gy for key exchange
@@ -403,12 +425,21 @@ namespace senc
 
 	void EncryptedPacketHandler::send_request_data(const pkt::UpdateRequest& packet)
 	{
-		(void)packet;
+		utils::Buffer data{};
+
+		utils::write_bytes(data, packet.max_wait_ms);
+
+		send_encrypted_data(data);
 	}
 
 	void EncryptedPacketHandler::recv_request_data(pkt::UpdateRequest& out)
 	{
-		(void)out;
+		utils::Buffer data{};
+		recv_encrypted_data(data);
+		const auto end = data.cend();
+		auto it = data.cbegin();
+
+		it = utils::read_bytes(out.max_wait_ms, it, end);
 	}
 
 	void EncryptedPacketHandler::send_response_data(const pkt::UpdateResponse& packet)
@@ -421,6 +452,7 @@ namespace senc
 		utils::write_bytes(data, static_cast<lookup_count_t>(packet.on_lookup.size()));
 		utils::write_bytes(data, static_cast<pending_count_t>(packet.to_decrypt.size()));
 		utils::write_bytes(data, static_cast<res_count_t>(packet.finished_decryptions.size()));
+		utils::write_bytes(data, static_cast<res_count_t>(packet.expired_operations.size()));
 
 		// write added_as_owner records
 		for (const auto& record : packet.added_as_owner)
@@ -442,6 +474,10 @@ namespace senc
 		for (const auto& record : packet.finished_decryptions)
 			write_update_record(data, record);
 
+		// send expired_operations records
+		for (const auto& record : packet.expired_operations)
+			utils::write_bytes(data, record);
+
 		send_encrypted_data(data);
 	}
 
@@ -469,6 +505,9 @@ namespace senc
 		res_count_t finishedDecryptionsCount{};
 		it = utils::read_bytes(finishedDecryptionsCount, it, end);
 
+		res_count_t expiredOperationsCount{};
+		it = utils::read_bytes(expiredOperationsCount, it, end);
+
 		// end read vector lengths
 
 		// read added_as_owner records
@@ -495,6 +534,11 @@ namespace senc
 		out.finished_decryptions.resize(finishedDecryptionsCount);
 		for (auto& record : out.finished_decryptions)
 			it = read_update_record(record, it, end);
+
+		// read expired_operations records
+		out.expired_operations.resize(expiredOperationsCount);
+		for (auto& record : out.expired_operations)
+			it = utils::read_bytes(record, it, end);
 	}
 
 	void EncryptedPacketHandler::send_request_data(const pkt::DecryptParticipateRequest& packet)
@@ -638,8 +682,9 @@ namespace senc
 			write_big_int(out, std::nullopt);
 			return;
 		}
-		write_big_int(out, elem.x());
-		write_big_int(out, elem.y());
+		const auto [x, y] = elem.xy();
+		write_big_int(out, x);
+		write_big_int(out, y);
 	}
 
 	utils::Buffer::const_iterator EncryptedPacketHandler::read_ecgroup_elem(utils::ECGroup& out,
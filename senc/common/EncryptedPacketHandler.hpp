@@ -10,6 +10,7 @@
 
 #include "KeyedPacketHandlerSyncData.hpp"
 #include "ConnEstablishException.hpp"
+#include "EphemeralKeyPool.hpp"
 #include "../utils/enc/ECHKDF1L.hpp"
 #include "../utils/enc/AES1L.hpp"
 #include "../utils/Random.hpp"
@@ -33,16 +34,34 @@ namespace senc
 		 * @brief Gets handler instance for server side.
 		 * @param sock Socket to send and receive packets through.
 		 * @throw ConnEstablishException If failed to establish connection.
+		 * @note Computes ephemeral key on calling thread.
 		 */
 		static Self server(utils::Socket& sock);
 
+		/**
+		 * @brief Gets handler instance for server side.
+		 * @param sock Socket to send and receive packets through.
+		 * @param keyPool Pool to take ephemeral key from.
+		 * @throw ConnEstablishException If failed to establish connection.
+		 */
+		static Self server(utils::Socket& sock, EphemeralKeyPool& keyPool);
+
 		/**
 		 * @brief Gets handler instance for client side.
 		 * @param sock Socket to send and receive packets through.
 		 * @throw ConnEstablishException If failed to establish connection.
+		 * @note Computes ephemeral key on calling thread.
 		 */
 		static Self client(utils::Socket& sock);
 
+		/**
+		 * @brief Gets handler instance for client side.
+		 * @param sock Socket to send and receive packets through.
+		 * @param keyPool Pool to take ephemeral key from.
+		 * @throw ConnEstablishException If failed to establish connection.
+		 */
+		static Self client(utils::Socket& sock, EphemeralKeyPool& keyPool);
+
 		const IPacketHandlerSyncData& get_sync_data() const override;
 
 		void send_response_data(const pkt::ErrorResponse& packet) override;
@@ -116,14 +135,6 @@ namespace senc
 		Schema _schema;
 		KDF _kdf;
 
-		static utils::BigInt sample_pow()
-		{
-			static thread_local utils::Distribution<utils::BigInt> powDist(
-				utils::Random<utils::BigInt>::get_dist_below(Group::order())
-			);
-			return powDist();
-		}
-
 		/**
 		 * @typedef encdata_size_t
 		 * @brief Primitive used for size of encrypted packet data.
@@ -135,6 +146,22 @@ namespace senc
 		 */
 		static constexpr std::size_t MAX_ENCDATA_SIZE = std::numeric_limits<encdata_size_t>::max();
 
+		/**
+		 * @brief Establishes connection on server side.
+		 * @param sock Socket to send and receive packets through.
+		 * @param keyPool Pool to take ephemeral key from (`nullptr` to compute it on calling thread).
+		 * @throw ConnEstablishException If failed to establish connection.
+		 */
+		static Self server_handshake(utils::Socket& sock, EphemeralKeyPool* keyPool);
+
+		/**
+		 * @brief Establishes connection on client side.
+		 * @param sock Socket to send and receive packets through.
+		 * @param keyPool Pool to take ephemeral key from (`nullptr` to compute it on calling thread).
+		 * @throw ConnEstablishException If failed to establish connection.
+		 */
+		static Self client_handshake(utils::Socket& sock, EphemeralKeyPool* keyPool);
+
 		void send_encrypted_data(const utils::Buffer& data);
 		
 		void recv_encrypted_data(utils::Buffer& out);
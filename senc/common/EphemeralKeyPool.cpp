@@ -0,0 +1,24 @@
+/*********************************************************************
+ * \file   EphemeralKeyPool.cpp
+ * \brief  Implementation of `EphemeralKeyGen` class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "EphemeralKeyPool.hpp"
+
+#include "../utils/Random.hpp"
+
+namespace senc
+{
+	EphemeralKeyGen::KeyPair EphemeralKeyGen::keygen() const
+	{
+		static thread_local utils::Distribution<utils::BigInt> powDist(
+			utils::Random<utils::BigInt>::get_dist_below(Group::order())
+		);
+		utils::BigInt y = powDist();
+		Group gy = Group::generator_pow(y);
+		return KeyPair{ std::move(y), std::move(gy) };
+	}
+}
@@ -0,0 +1,47 @@
+/*********************************************************************
+ * \file   EphemeralKeyPool.hpp
+ * \brief  Header of `EphemeralKeyGen` class and `EphemeralKeyPool` alias.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include "../utils/enc/KeyPool.hpp"
+#include "../utils/ECGroup.hpp"
+
+namespace senc
+{
+	/**
+	 * @class senc::EphemeralKeyGen
+	 * @brief Generator of ephemeral key exchange pairs `(y, g^y)` (stateless, so thread-safe).
+	 */
+	class EphemeralKeyGen
+	{
+	public:
+		using Group = utils::ECGroup;
+
+		/**
+		 * @struct senc::EphemeralKeyGen::KeyPair
+		 * @brief Ephemeral key exchange pair.
+		 */
+		struct KeyPair
+		{
+			utils::BigInt priv; // y
+			Group pub;			// g^y
+		};
+
+		/**
+		 * @brief Computes a fresh key pair.
+		 */
+		KeyPair keygen() const;
+	};
+
+	/**
+	 * @typedef senc::EphemeralKeyPool
+	 * @brief Pool of ready ephemeral key exchange pairs.
+	 * @note Lets handshakes skip the fixed-base exponentiation, leaving a single variable-base one.
+	 */
+	using EphemeralKeyPool = utils::enc::KeyPool<EphemeralKeyGen>;
+}
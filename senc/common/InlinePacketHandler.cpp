@@ -251,12 +251,12 @@ namespace senc
 
 	void InlinePacketHandler::send_request_data(const pkt::UpdateRequest& packet)
 	{
-		(void)packet;
+		_sock.send_connected_value(packet.max_wait_ms);
 	}
 
 	void InlinePacketHandler::recv_request_data(pkt::UpdateRequest& out)
 	{
-		(void)out;
+		_sock.recv_connected_value(out.max_wait_ms);
 	}
 
 	void InlinePacketHandler::send_response_data(const pkt::UpdateResponse& packet)
@@ -267,6 +267,7 @@ namespace senc
 		_sock.send_connected_value(static_cast<lookup_count_t>(packet.on_lookup.size()));
 		_sock.send_connected_value(static_cast<pending_count_t>(packet.to_decrypt.size()));
 		_sock.send_connected_value(static_cast<res_count_t>(packet.finished_decryptions.size()));
+		_sock.send_connected_value(static_cast<res_count_t>(packet.expired_operations.size()));
 
 		// send added_as_owner records
 		for (const auto& record : packet.added_as_owner)
@@ -287,6 +288,10 @@ namespace senc
 		// send finished_decryptions records
 		for (const auto& record : packet.finished_decryptions)
 			send_update_record(record);
+
+		// send expired_operations records
+		for (const auto& record : packet.expired_operations)
+			_sock.send_connected_value(record);
 	}
 
 	void InlinePacketHandler::recv_response_data(pkt::UpdateResponse& out)
@@ -297,6 +302,7 @@ namespace senc
 		auto onLookupCount = _sock.recv_connected_primitive<lookup_count_t>();
 		auto toDecryptCount = _sock.recv_connected_primitive<pending_count_t>();
 		auto finishedDecryptionsCount = _sock.recv_connected_primitive<res_count_t>();
+		auto expiredOperationsCount = _sock.recv_connected_primitive<res_count_t>();
 
 		// recv added_as_owner records
 		out.added_as_owner.resize(addedAsOwnerCount);
@@ -322,6 +328,11 @@ namespace senc
 		out.finished_decryptions.resize(finishedDecryptionsCount);
 		for (auto& record : out.finished_decryptions)
 			recv_update_record(record);
+
+		// recv expired_operations records
+		out.expired_operations.resize(expiredOperationsCount);
+		for (auto& record : out.expired_operations)
+			_sock.recv_connected_value(record);
 	}
 
 	void InlinePacketHandler::send_request_data(const pkt::DecryptParticipateRequest& packet)
@@ -44,6 +44,16 @@ namespace senc
 			return get_sync_data().validate_synchronization(other->get_sync_data());
 		}
 
+		/**
+		 * @brief Checks, without blocking, if peer has sent data not yet received (e.g. its next packet).
+		 * @return `true` if there is data to receive, otherwise `false`.
+		 * @throw senc::utils::SocketException On failure.
+		 */
+		bool has_pending_data() const
+		{
+			return _sock.has_pending_data();
+		}
+
 		/**
 		 * @brief Sends given request with fitting code.
 		 * @param packet Packet to send.
@@ -51,8 +61,7 @@ namespace senc
 		template <typename T>
 		inline void send_request(const T& packet)
 		{
-			_sock.send_connected_primitive(T::CODE);
-			send_request_data(packet);
+			send_packet<PacketKind::Request>(packet);
 		}
 
 		/**
@@ -74,8 +83,7 @@ namespace senc
 		template <typename T>
 		inline void send_response(const T& packet)
 		{
-			_sock.send_connected_primitive(T::CODE);
-			send_response_data(packet);
+			send_packet<PacketKind::Response>(packet);
 		}
 
 		/**
@@ -154,16 +162,67 @@ namespace senc
 		virtual void recv_response_data(pkt::SendDecryptionPartResponse& out) = 0;
 
 	protected:
+		/**
+		 * @enum senc::PacketHandler::PacketKind
+		 * @brief Signifies request or response.
+		 */
+		enum class PacketKind : std::uint8_t { Request, Response };
+
 		utils::Socket& _sock;
 
 		PacketHandler(utils::Socket& sock) : _sock(sock) { }
 
+		/**
+		 * @brief Called before a packet (code and data) is sent; Default does nothing.
+		 * @param kind Whether a request or a response is sent.
+		 */
+		virtual void begin_send(PacketKind kind) { (void)kind; }
+
+		/**
+		 * @brief Called after a packet was sent (or failed to be sent); Default does nothing.
+		 * @param kind Whether a request or a response was sent.
+		 * @param failed Whether sending failed (in which case the stream may be left corrupted).
+		 */
+		virtual void end_send(PacketKind kind, bool failed) { (void)kind; (void)failed; }
+
+		/**
+		 * @brief Called before a packet (code and data) is received; Default does nothing.
+		 * @param kind Whether a request or a response is received.
+		 */
+		virtual void begin_recv(PacketKind kind) { (void)kind; }
+
+		/**
+		 * @brief Called after a packet was received (or failed to be received); Default does nothing.
+		 * @param kind Whether a request or a response was received.
+		 * @param failed Whether receiving failed (in which case the stream may be left corrupted).
+		 */
+		virtual void end_recv(PacketKind kind, bool failed) { (void)kind; (void)failed; }
+
 	private:
 		/**
-		 * @enum senc::PacketReceiver::PacketKind
-		 * @brief For internal use; Signified request or response.
+		 * @brief Sends given packet with fitting code, between `begin_send` and `end_send`.
+		 * @tparam kind Whether sending request or response.
+		 * @param packet Packet to send.
 		 */
-		enum class PacketKind : std::uint8_t { Request, Response };
+		template <PacketKind kind, typename T>
+		inline void send_packet(const T& packet)
+		{
+			begin_send(kind);
+			try
+			{
+				_sock.send_connected_primitive(T::CODE);
+				if constexpr (PacketKind::Request == kind)
+					send_request_data(packet);
+				else
+					send_response_data(packet);
+			}
+			catch (...)
+			{
+				end_send(kind, true);
+				throw;
+			}
+			end_send(kind, false);
+		}
 
 		/**
 		 * @brief Receives data for specific packet.
@@ -192,6 +251,29 @@ namespace senc
 		 */
 		template <PacketKind kind, typename... Ts>
 		inline std::optional<utils::VariantOrSingular<Ts...>> recv_packet()
+		{
+			begin_recv(kind);
+			try
+			{
+				auto ret = recv_packet_unguarded<kind, Ts...>();
+				end_recv(kind, false);
+				return ret;
+			}
+			catch (...)
+			{
+				end_recv(kind, true);
+				throw;
+			}
+		}
+
+		/**
+		 * @brief Receives a packet of one of the given types (without calling `begin_recv` and `end_recv`).
+		 * @tparam kind Whether should receive request or response.
+		 * @tparam Ts Potential packet types (structs).
+		 * @return Received packet, or `std::nullopt` if was of wrong type.
+		 */
+		template <PacketKind kind, typename... Ts>
+		inline std::optional<utils::VariantOrSingular<Ts...>> recv_packet_unguarded()
 		{
 			std::optional<utils::VariantOrSingular<Ts...>> ret;
 			const auto code = _sock.recv_connected_primitive<pkt::Code>();
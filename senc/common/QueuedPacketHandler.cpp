@@ -10,6 +10,30 @@
 
 namespace senc
 {
+	QueuedPacketHandler::Sync::Sync(Sync&& other)
+		: Sync()
+	{
+		other.notify_stop();
+
+		// wait for running onQueueEmpty, and for packets being sent
+		std::unique_lock lock(other.mtxOnQueueEmpty);
+		other.cvOnQueueEmpty.wait(lock, [&other]() { return !other.onQueueEmptyRunning; });
+		const std::lock_guard<std::mutex> a(other.mtxSend);
+	}
+
+	void QueuedPacketHandler::Sync::notify_stop()
+	{
+		stop = true;
+
+		// lock each mutex before notifying, so that no waiter misses stop
+		{ const std::lock_guard<std::mutex> lock(mtxQueue); }
+		cvQueue.notify_all();
+		{ const std::lock_guard<std::mutex> lock(mtxRecv); }
+		cvRecv.notify_all();
+		{ const std::lock_guard<std::mutex> lock(mtxOnQueueEmpty); }
+		cvOnQueueEmpty.notify_all();
+	}
+
 	QueuedPacketHandler::QueuedPacketHandler(Self&& other) noexcept
 		: Base(std::move(other)),
 		  _sync(std::move(other._sync)),
@@ -18,11 +42,15 @@ namespace senc
 		  _delay(std::move(other._delay)),
 		  _nextTicket(other._nextTicket),
 		  _ticketBeingServed(other._ticketBeingServed),
-		  _queueThread(&Self::queue_thread, this) { }
+		  _nextRecvTurn(other._nextRecvTurn),
+		  _recvTurnBeingServed(other._recvTurnBeingServed),
+		  _recvTurns(std::move(other._recvTurns)),
+		  _queueThread(&Self::queue_thread, this),
+		  _onQueueEmptyThread(&Self::on_queue_empty_thread, this) { }
 
 	QueuedPacketHandler::~QueuedPacketHandler()
 	{
-		_sync.stop = true;
+		_sync.notify_stop();
 	}
 
 	QueuedPacketHandler::Self QueuedPacketHandler::server(
@@ -50,235 +78,272 @@ namespace senc
 
 	void QueuedPacketHandler::send_response_data(const pkt::ErrorResponse& packet)
 	{
-		queue_response(packet);
+		this->_underlying->send_response_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_response_data(pkt::ErrorResponse& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_response_data(out);
 	}
 
 	void QueuedPacketHandler::send_request_data(const pkt::SignupRequest& packet)
 	{
-		queue_request(packet);
+		this->_underlying->send_request_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_request_data(pkt::SignupRequest& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_request_data(out);
 	}
 
 	void QueuedPacketHandler::send_response_data(const pkt::SignupResponse& packet)
 	{
-		queue_response(packet);
+		this->_underlying->send_response_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_response_data(pkt::SignupResponse& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_response_data(out);
 	}
 
 	void QueuedPacketHandler::send_request_data(const pkt::LoginRequest& packet)
 	{
-		queue_request(packet);
+		this->_underlying->send_request_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_request_data(pkt::LoginRequest& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_request_data(out);
 	}
 
 	void QueuedPacketHandler::send_response_data(const pkt::LoginResponse& packet)
 	{
-		queue_response(packet);
+		this->_underlying->send_response_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_response_data(pkt::LoginResponse& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_response_data(out);
 	}
 
 	void QueuedPacketHandler::send_request_data(const pkt::LogoutRequest& packet)
 	{
-		queue_request(packet);
+		this->_underlying->send_request_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_request_data(pkt::LogoutRequest& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_request_data(out);
 	}
 
 	void QueuedPacketHandler::send_response_data(const pkt::LogoutResponse& packet)
 	{
-		queue_response(packet);
+		this->_underlying->send_response_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_response_data(pkt::LogoutResponse& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_response_data(out);
 	}
 
 	void QueuedPacketHandler::send_request_data(const pkt::MakeUserSetRequest& packet)
 	{
-		queue_request(packet);
+		this->_underlying->send_request_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_request_data(pkt::MakeUserSetRequest& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_request_data(out);
 	}
 
 	void QueuedPacketHandler::send_response_data(const pkt::MakeUserSetResponse& packet)
 	{
-		queue_response(packet);
+		this->_underlying->send_response_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_response_data(pkt::MakeUserSetResponse& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_response_data(out);
 	}
 
 	void QueuedPacketHandler::send_request_data(const pkt::GetUserSetsRequest& packet)
 	{
-		queue_request(packet);
+		this->_underlying->send_request_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_request_data(pkt::GetUserSetsRequest& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_request_data(out);
 	}
 
 	void QueuedPacketHandler::send_response_data(const pkt::GetUserSetsResponse& packet)
 	{
-		queue_response(packet);
+		this->_underlying->send_response_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_response_data(pkt::GetUserSetsResponse& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_response_data(out);
 	}
 
 	void QueuedPacketHandler::send_request_data(const pkt::GetMembersRequest& packet)
 	{
-		queue_request(packet);
+		this->_underlying->send_request_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_request_data(pkt::GetMembersRequest& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_request_data(out);
 	}
 
 	void QueuedPacketHandler::send_response_data(const pkt::GetMembersResponse& packet)
 	{
-		queue_response(packet);
+		this->_underlying->send_response_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_response_data(pkt::GetMembersResponse& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_response_data(out);
 	}
 
 	void QueuedPacketHandler::send_request_data(const pkt::DecryptRequest& packet)
 	{
-		queue_request(packet);
+		this->_underlying->send_request_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_request_data(pkt::DecryptRequest& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_request_data(out);
 	}
 
 	void QueuedPacketHandler::send_response_data(const pkt::DecryptResponse& packet)
 	{
-		queue_response(packet);
+		this->_underlying->send_response_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_response_data(pkt::DecryptResponse& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_response_data(out);
 	}
 
 	void QueuedPacketHandler::send_request_data(const pkt::UpdateRequest& packet)
 	{
-		queue_request(packet);
+		this->_underlying->send_request_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_request_data(pkt::UpdateRequest& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_request_data(out);
 	}
 
 	void QueuedPacketHandler::send_response_data(const pkt::UpdateResponse& packet)
 	{
-		queue_response(packet);
+		this->_underlying->send_response_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_response_data(pkt::UpdateResponse& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_response_data(out);
 	}
 
 	void QueuedPacketHandler::send_request_data(const pkt::DecryptParticipateRequest& packet)
 	{
-		queue_request(packet);
+		this->_underlying->send_request_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_request_data(pkt::DecryptParticipateRequest& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_request_data(out);
 	}
 
 	void QueuedPacketHandler::send_response_data(const pkt::DecryptParticipateResponse& packet)
 	{
-		queue_response(packet);
+		this->_underlying->send_response_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_response_data(pkt::DecryptParticipateResponse& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_response_data(out);
 	}
 
 	void QueuedPacketHandler::send_request_data(const pkt::SendDecryptionPartRequest& packet)
 	{
-		queue_request(packet);
+		this->_underlying->send_request_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_request_data(pkt::SendDecryptionPartRequest& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_request_data(out);
 	}
 
 	void QueuedPacketHandler::send_response_data(const pkt::SendDecryptionPartResponse& packet)
 	{
-		queue_response(packet);
+		this->_underlying->send_response_data(packet);
 	}
 
 	void QueuedPacketHandler::recv_response_data(pkt::SendDecryptionPartResponse& out)
 	{
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
 		this->_underlying->recv_response_data(out);
 	}
 
+	void QueuedPacketHandler::begin_send(PacketKind kind)
+	{
+		// requests sent by `onQueueEmpty` skip the queue (it only runs when the queue is empty)
+		if (std::this_thread::get_id() != _onQueueEmptyThread.get_id())
+			wait_queue();
+
+		_sync.mtxSend.lock(); // unlocked by `end_send`
+
+		// sender of a request receives its response in the order requests were sent
+		if (PacketKind::Request == kind)
+		{
+			const std::lock_guard<std::mutex> lock(_sync.mtxRecv);
+			_recvTurns[std::this_thread::get_id()].push(_nextRecvTurn++);
+		}
+	}
+
+	void QueuedPacketHandler::end_send(PacketKind kind, bool failed)
+	{
+		(void)kind;
+		_sync.mtxSend.unlock();
+		if (failed)
+			_sync.notify_stop(); // stream may be corrupted, and response turn taken will never be received
+	}
+
+	void QueuedPacketHandler::begin_recv(PacketKind kind)
+	{
+		std::unique_lock<std::mutex> lock(_sync.mtxRecv);
+
+		std::size_t myTurn{};
+		const auto it = _recvTurns.find(std::this_thread::get_id());
+		if (PacketKind::Response == kind && it != _recvTurns.end())
+		{
+			myTurn = it->second.front();
+			it->second.pop();
+			if (it->second.empty())
+				_recvTurns.erase(it);
+		}
+		else
+			myTurn = _nextRecvTurn++; // packets received not in response to own request are received in arrival order
+
+		_sync.cvRecv.wait(
+			lock,
+			[this, myTurn]() { return this->_sync.stop || myTurn == this->_recvTurnBeingServed; }
+		);
+	}
+
+	void QueuedPacketHandler::end_recv(PacketKind kind, bool failed)
+	{
+		(void)kind;
+		{
+			const std::lock_guard<std::mutex> lock(_sync.mtxRecv);
+			++_recvTurnBeingServed;
+		}
+		_sync.cvRecv.notify_all();
+		if (failed)
+			_sync.notify_stop(); // stream may be corrupted
+	}
+
 	QueuedPacketHandler::QueuedPacketHandler(
 		utils::Socket& sock,
 		std::unique_ptr<PacketHandler>&& underlying,
@@ -289,13 +354,17 @@ namespace senc
 		  _onQueueEmpty(onQueueEmpty),
 		  _delay(delay),
 		  _nextTicket(0), _ticketBeingServed(0),
-		  _queueThread(&Self::queue_thread, this) { }
+		  _nextRecvTurn(0), _recvTurnBeingServed(0),
+		  _queueThread(&Self::queue_thread, this),
+		  _onQueueEmptyThread(&Self::on_queue_empty_thread, this) { }
 
 	void QueuedPacketHandler::queue_thread()
 	{
 		while (!_sync.stop)
 		{
 			std::this_thread::sleep_for(_delay);
+			if (_sync.stop)
+				break;
 
 			std::unique_lock lock(_sync.mtxQueue);
 
@@ -309,14 +378,41 @@ namespace senc
 			}
 			else
 			{
-				const std::lock_guard l1(_sync.mtxOnQueueEmpty);
-				const std::lock_guard l2(_sync.mtxUnderlying);
-				_onQueueEmpty(*_underlying);
+				// run onQueueEmpty on its own thread (unless still running),
+				// so that tickets keep being served while it runs (e.g. long-polls)
+				const std::lock_guard l(_sync.mtxOnQueueEmpty);
+				if (!_sync.onQueueEmptyRunning)
+				{
+					_sync.onQueueEmptyRunning = true;
+					_sync.cvOnQueueEmpty.notify_all();
+				}
 			}
 		}
 		_sync.cvQueue.notify_all(); // wake up all remaining threads
 	}
 
+	void QueuedPacketHandler::on_queue_empty_thread()
+	{
+		std::unique_lock lock(_sync.mtxOnQueueEmpty);
+		while (true)
+		{
+			_sync.cvOnQueueEmpty.wait(
+				lock,
+				[this]() { return this->_sync.stop || this->_sync.onQueueEmptyRunning; }
+			);
+			if (_sync.stop)
+				break;
+
+			// no lock is held while running, so queued packets are sent (and received) meanwhile
+			lock.unlock();
+			_onQueueEmpty(*this);
+			lock.lock();
+
+			_sync.onQueueEmptyRunning = false;
+			_sync.cvOnQueueEmpty.notify_all(); // for move constructor waiting on it
+		}
+	}
+
 	void QueuedPacketHandler::wait_queue()
 	{
 		std::unique_lock lock(_sync.mtxQueue);
@@ -328,26 +424,4 @@ namespace senc
 			[this, myTicket]() { return this->_sync.stop || myTicket == this->_ticketBeingServed; }
 		);
 	}
-
-	template <typename R>
-	void QueuedPacketHandler::queue_request(R&& request)
-	{
-		wait_queue();
-		if (_sync.stop)
-			return;
-
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
-		_underlying->send_request_data(request);
-	}
-
-	template <typename R>
-	void QueuedPacketHandler::queue_response(R&& response)
-	{
-		wait_queue();
-		if (_sync.stop)
-			return;
-
-		const std::lock_guard<std::mutex> lock(_sync.mtxUnderlying);
-		_underlying->send_response_data(response);
-	}
 }
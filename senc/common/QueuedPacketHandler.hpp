@@ -12,9 +12,11 @@
 #include "ClientPacketHandlerFactory.hpp"
 #include "PacketHandler.hpp"
 #include <condition_variable>
+#include <unordered_map>
 #include <functional>
 #include <memory>
 #include <thread>
+#include <queue>
 #include <atomic>
 #include <chrono>
 #include <mutex>
@@ -24,6 +26,8 @@ namespace senc
 	/**
 	 * @class senc::QueuedPacketHandler
 	 * @brief Implementation of `senc::PacketHandler` which wraps another implementation with a packets queue.
+	 * @note Sent packets are not blocked by a running `onQueueEmpty` (e.g. a long-poll): Each thread
+	 *       receives its responses in the order requests were sent, so requests are pipelined.
 	 */
 	class QueuedPacketHandler : public PacketHandler
 	{
@@ -44,7 +48,8 @@ namespace senc
 		/**
 		 * @brief Gets handler instance for server side.
 		 * @param sock Socket to send and receive packets through.
-		 * @param onQueueEmpty Function to run on underlying handler when queue is empty.
+		 * @param onQueueEmpty Function to run (given this handler) when queue is empty; Runs on its own
+		 *                     thread, and packets queued meanwhile are sent without waiting for it.
 		 * @param delay Delay to wait between queue invocations.
 		 * @param underlyingFactory Packet handler factory used to construct underlying handler.
 		 * @throw ConnEstablishException If failed to establish connection.
@@ -57,7 +62,8 @@ namespace senc
 		/**
 		 * @brief Gets handler instance for client side.
 		 * @param sock Socket to send and receive packets through.
-		 * @param onQueueEmpty Function to run on underlying handler when queue is empty.
+		 * @param onQueueEmpty Function to run (given this handler) when queue is empty; Runs on its own
+		 *                     thread, and packets queued meanwhile are sent without waiting for it.
 		 * @param delay Delay to wait between queue invocations.
 		 * @param underlyingFactory Packet handler factory used to construct underlying handler.
 		 * @throw ConnEstablishException If failed to establish connection.
@@ -132,6 +138,27 @@ namespace senc
 		void send_response_data(const pkt::SendDecryptionPartResponse& packet) override;
 		void recv_response_data(pkt::SendDecryptionPartResponse& out) override;
 
+	protected:
+		/**
+		 * @brief Waits turn in queue (unless called by `onQueueEmpty`) and locks sending.
+		 */
+		void begin_send(PacketKind kind) override;
+
+		/**
+		 * @brief Unlocks sending.
+		 */
+		void end_send(PacketKind kind, bool failed) override;
+
+		/**
+		 * @brief Waits turn to receive (responses are received by order of sent requests).
+		 */
+		void begin_recv(PacketKind kind) override;
+
+		/**
+		 * @brief Passes turn to receive to next receiver.
+		 */
+		void end_recv(PacketKind kind, bool failed) override;
+
 	private:
 		/**
 		 * @struct senc::QueuedPacketHandler::Sync
@@ -139,8 +166,12 @@ namespace senc
 		 */
 		struct Sync
 		{
-			std::mutex mtxUnderlying;
+			std::mutex mtxSend; // held while a packet is sent
+			std::mutex mtxRecv; // guards receive turns
+			std::condition_variable cvRecv;
 			std::mutex mtxOnQueueEmpty;
+			std::condition_variable cvOnQueueEmpty;
+			bool onQueueEmptyRunning = false;
 			std::mutex mtxQueue;
 			std::condition_variable cvQueue;
 			std::atomic_bool stop;
@@ -148,16 +179,15 @@ namespace senc
 			Sync() = default;
 
 			/**
-			 * @brief Dummy move constructor of Sync: Awaits all mutexes to release, and sets stop to true.
+			 * @brief Dummy move constructor of Sync: Sets stop to true, and awaits running operations.
 			 * @details This is used to make sure all operations inished before moving QueuedPacketHandler.
 			 */
-			Sync(Sync&& other) : Sync()
-			{
-				const std::lock_guard<std::mutex> a(other.mtxUnderlying);
-				const std::lock_guard<std::mutex> b(other.mtxOnQueueEmpty);
-				const std::lock_guard<std::mutex> c(other.mtxQueue);
-				other.stop = true;
-			}
+			Sync(Sync&& other);
+
+			/**
+			 * @brief Sets stop to true and wakes all waiters.
+			 */
+			void notify_stop();
 		};
 
 		Sync _sync;
@@ -166,13 +196,18 @@ namespace senc
 		std::chrono::milliseconds _delay;
 		std::size_t _nextTicket;
 		std::size_t _ticketBeingServed;
+		std::size_t _nextRecvTurn; // guarded by `_sync.mtxRecv`, as are the next two
+		std::size_t _recvTurnBeingServed;
+		std::unordered_map<std::thread::id, std::queue<std::size_t>> _recvTurns; // per thread, by send order
 		std::jthread _queueThread;
+		std::jthread _onQueueEmptyThread;
 
 		/**
 		 * @brief Constructs queued packet handler from underlying handler instance.
 		 * @param sock Socket to send and receive packets through.
 		 * @param underlying Underlying handler instance.
-		 * @param onQueueEmpty Function to run on underlying handler when queue is empty.
+		 * @param onQueueEmpty Function to run (given this handler) when queue is empty; Runs on its own
+		 *                     thread, and packets queued meanwhile are sent without waiting for it.
 		 * @param delay Delay to wait between queue invocations.
 		 */
 		QueuedPacketHandler(utils::Socket& sock,
@@ -181,27 +216,18 @@ namespace senc
 							std::chrono::milliseconds delay);
 
 		/**
-		 * @brief Thread periodically invoking queue (or onQueueEmpty if empty).
+		 * @brief Thread periodically invoking queue (or triggering onQueueEmpty if empty).
 		 */
 		void queue_thread();
 
 		/**
-		 * @brief Joins queue and waits turn (or waits stop if that happens first).
+		 * @brief Thread running onQueueEmpty whenever triggered by queue thread.
 		 */
-		void wait_queue();
+		void on_queue_empty_thread();
 
 		/**
-		 * @brief Queues request to be sent.
-		 * @param request Request to queue.
-		 */
-		template <typename R>
-		void queue_request(R&& request);
-
-		/**
-		 * @brief Queues response to be sent.
-		 * @param response Response to queue.
+		 * @brief Joins queue and waits turn (or waits stop if that happens first).
 		 */
-		template <typename R>
-		void queue_response(R&& response);
+		void wait_queue();
 	};
 }
@@ -43,8 +43,9 @@ namespace senc
 			send_big_int(sock, std::nullopt);
 			return;
 		}
-		send_big_int(sock, elem.x());
-		send_big_int(sock, elem.y());
+		const auto [x, y] = elem.xy();
+		send_big_int(sock, x);
+		send_big_int(sock, y);
 	}
 
 	void SockUtils::recv_ecgroup_elem(utils::Socket& sock, utils::ECGroup& out)
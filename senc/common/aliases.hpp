@@ -9,8 +9,10 @@
 #pragma once
 
 #include "../utils/enc/HybridElGamal2L.hpp"
+#include "../utils/enc/KeyPool.hpp"
 #include "../utils/enc/ECHKDF2L.hpp"
 #include "../utils/enc/AES1L.hpp"
+#include "../utils/P256Group.hpp"
 #include "../utils/ECGroup.hpp"
 #include "../utils/Shamir.hpp"
 #include "../utils/uuid.hpp"
@@ -29,20 +31,33 @@ namespace senc
 	 */
 	constexpr auto OWNER_LAYER = 2;
 
+	/**
+	 * @typedef senc::EncGroup
+	 * @brief Algebric group used by encryption schema (and threshold decryption).
+	 * @note `utils::P256Group` (dedicated backend for the same curve and encoding) can be used instead.
+	 */
+	using EncGroup = utils::ECGroup;
+
 	/**
 	 * @typedef senc::Schema
 	 * @brief Encryption schema used by both client and server.
 	 */
 	using Schema = utils::enc::HybridElGamal2L<
-		utils::ECGroup, utils::enc::AES1L, utils::enc::ECHKDF2L
+		EncGroup, utils::enc::AES1L, utils::enc::ECHKDF2L
 	>;
 
+	/**
+	 * @typedef senc::KeyPool
+	 * @brief Pool of ready key-pairs of encryption schema (used by server for userset creation).
+	 */
+	using KeyPool = utils::enc::KeyPool<Schema>;
+
 	/**
 	 * @typedef senc::Shamir
 	 * @brief Holds implementations of Shamir utilities for threshold decryption.
 	 */
 	using Shamir = utils::ShamirHybridElGamal<
-		utils::ECGroup, utils::enc::AES1L, utils::enc::ECHKDF2L,
+		EncGroup, utils::enc::AES1L, utils::enc::ECHKDF2L,
 		utils::BigInt
 	>;
 
@@ -19,9 +19,10 @@ namespace senc::pkt
 {
 	// protocol versions:
 	// 1 : v1.0.0-v1.0.1
-	// 2 : v1.1.0+
+	// 2 : v1.1.0
+	// 3 : v1.2.0+ (long-poll updates, expired operations)
 	using protocol_version_t = std::uint8_t;
-	constexpr protocol_version_t PROTOCOL_VERSION = 2; // v1.1.0+
+	constexpr protocol_version_t PROTOCOL_VERSION = 3; // v1.2.0+
 
 	/**
 	 * @enum Code
@@ -373,7 +374,8 @@ namespace senc::pkt
 	// Update cycle
 	// Client requests to run an update iteration.
 	// Server responds with update information (see details in doc of 
-	// `struct UpdateResponse`).
+	// `struct UpdateResponse`). If client allows waiting, server holds
+	// the response until it has updates for client (or wait expires).
 	// =================================================================
 
 	/**
@@ -384,6 +386,9 @@ namespace senc::pkt
 	{
 		static constexpr auto CODE = Code::UpdateRequest;
 		bool operator==(const UpdateRequest&) const = default;
+
+		/// Maximum time (in milliseconds) server may wait for updates before responding (zero to respond at once).
+		update_wait_t max_wait_ms;
 	};
 
 	/**
@@ -500,6 +505,10 @@ namespace senc::pkt
 
 		/// Finished decryptions requested by this client.
 		std::vector<FinishedDecryptionsRecord> finished_decryptions;
+
+
+		/// IDs of decryption operations requested by this client, which expired before finishing.
+		std::vector<OperationID> expired_operations;
 	};
 
 
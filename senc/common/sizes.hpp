@@ -69,6 +69,12 @@ namespace senc
 	 */
 	constexpr std::size_t MAX_RESULTS = std::numeric_limits<res_count_t>::max();
 
+	/**
+	 * @typedef senc::update_wait_t
+	 * @brief Fundamental used for update wait durations (in milliseconds).
+	 */
+	using update_wait_t = std::uint32_t;
+
 	/**
 	 * @typedef senc::buffer_size_t
 	 * @brief Fundamental used for sending/recving buffer sizes.
@@ -13,9 +13,20 @@
 #include "loggers/DummyLogger.hpp"
 #include "loggers/ILogger.hpp"
 #include "ServerException.hpp"
+#include "ServerOptions.hpp"
+#include "limits/AdmissionController.hpp"
+#include "limits/RateLimiter.hpp"
+#include "storage/MeteredServerStorage.hpp"
+#include "metrics/Registry.hpp"
+#include "io/Reactor.hpp"
 #include "IServer.hpp"
 #include <condition_variable>
 #include <functional>
+#include <optional>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
 #include <thread>
 #include <atomic>
 #include <mutex>
@@ -43,6 +54,7 @@ namespace senc::server
 		 * @param packetHandlerFactory Factory constructing implementation of `PacketHandler`.
 		 * @param updateManager Instance of `UpdateManager`.
 		 * @param decryptionsManager Instance of `DecryptionsManager`.
+		 * @param options Server runtime options.
 		 * @note `storage` and `packetHandler` are assumed to be thread-safe.
 		 */
 		explicit Server(utils::Port listenPort,
@@ -51,7 +63,8 @@ namespace senc::server
 						storage::IServerStorage& storage,
 						ServerPacketHandlerFactory packetHandlerFactory,
 						managers::UpdateManager& updateManager,
-						managers::DecryptionsManager& decryptionsManager);
+						managers::DecryptionsManager& decryptionsManager,
+						const ServerOptions& options = {});
 
 		/**
 		 * @brief Constructs a new server instance.
@@ -61,6 +74,7 @@ namespace senc::server
 		 * @param packetHandlerFactory Factory constructing implementation of `PacketHandler`.
 		 * @param updateManager Instance of `UpdateManager`.
 		 * @param decryptionsManager Instance of `DecryptionsManager`.
+		 * @param options Server runtime options.
 		 * @note `storage` and `packetHandler` are assumed to be thread-safe.
 		 */
 		explicit Server(utils::Port listenPort,
@@ -68,7 +82,8 @@ namespace senc::server
 						storage::IServerStorage& storage,
 						ServerPacketHandlerFactory packetHandlerFactory,
 						managers::UpdateManager& updateManager,
-						managers::DecryptionsManager& decryptionsManager);
+						managers::DecryptionsManager& decryptionsManager,
+						const ServerOptions& options = {});
 
 		utils::Port port() const override;
 
@@ -78,73 +93,356 @@ namespace senc::server
 
 		void wait() override;
 
+		/**
+		 * @brief Gets a snapshot of worker pool counters (queue depth, wait times).
+		 */
+		workers::WorkerPool::Stats worker_pool_stats() const;
+
+		/**
+		 * @brief Gets a snapshot of admission counters (open connections, handshakes, rejections).
+		 */
+		limits::AdmissionController::Stats admission_stats() const;
+
+		/**
+		 * @brief Gets a snapshot of rate limiter counters (rejected requests).
+		 */
+		limits::RateLimiter::Stats rate_limiter_stats();
+
+		/**
+		 * @brief Gets a snapshot of userset key pool counters (ready pairs, misses generated inline).
+		 */
+		KeyPool::Stats key_pool_stats() const;
+
+		/**
+		 * @brief Gets registry of server metrics (request latencies, storage latencies, queue depths).
+		 */
+		metrics::Registry& metrics();
+
 	private:
+		/**
+		 * @enum senc::server::Server::ConnState
+		 * @brief State of a reactor connection after handling its requests.
+		 */
+		enum class ConnState
+		{
+			Open,	 // watched for further requests
+			Pending, // not watched until a worker answers its request (so that requests stay ordered)
+			Parked,	 // not watched until its parked update request is woken (answered by event loop)
+			Closed	 // dropped
+		};
+
+		/**
+		 * @struct senc::server::Server::PendingResult
+		 * @brief Result of a request handed to workers, waited for by its (thread-per-client) connection.
+		 * @tparam T Result type.
+		 */
+		template <typename T>
+		struct PendingResult
+		{
+			std::optional<T> value; // uses mtx
+			std::mutex mtx;
+			std::condition_variable cv;
+
+			void set(T&& res)
+			{
+				// notified under lock, so that waiter can't drop result meanwhile
+				const std::lock_guard<std::mutex> lock(mtx);
+				value.emplace(std::move(res));
+				cv.notify_one();
+			}
+
+			T take()
+			{
+				std::unique_lock<std::mutex> lock(mtx);
+				cv.wait(lock, [this]() { return value.has_value(); });
+				T res = std::move(*value);
+				value.reset();
+				return res;
+			}
+		};
+
+		/**
+		 * @struct senc::server::Server::ReactorConn
+		 * @brief State of a client connection handled in reactor mode.
+		 */
+		struct ReactorConn
+		{
+			Socket sock;
+			IP ip;
+			utils::Port port;
+			limits::AdmissionController::Ticket connTicket;
+			limits::AdmissionController::Ticket handshakeTicket; // released once logged in
+			limits::RateLimiter::Connection rateLimiter;
+			std::unique_ptr<PacketHandler> packetHandler; // set once handshake is done
+			std::optional<handlers::ConnectingClientHandler> connecting;
+			std::optional<handlers::ConnectedClientHandler> connected;
+			std::string username;
+			bool watched = false; // registered with reactor (re-armed, rather than added, to watch again)
+			bool parked = false;  // has an update request parked in update manager (answered once resumed)
+
+			// set by worker once a pending request is answered, applied once connection is resumed
+			std::optional<std::tuple<handlers::ConnectingClientHandler::Status, std::string>> connectingDone;
+			std::optional<handlers::ConnectedClientHandler::Status> connectedDone;
+
+			// parties done with pending request (event loop handing it off, and worker answering it),
+			// the second of which resumes connection
+			std::atomic<int> pendingParties = 0;
+
+			ReactorConn(Socket&& sock, const IP& ip, utils::Port port,
+						limits::AdmissionController::Ticket&& connTicket,
+						limits::AdmissionController::Ticket&& handshakeTicket,
+						limits::RateLimiter::Connection&& rateLimiter)
+				: sock(std::move(sock)), ip(ip), port(port),
+				  connTicket(std::move(connTicket)), handshakeTicket(std::move(handshakeTicket)),
+				  rateLimiter(std::move(rateLimiter)) { }
+		};
+
+		/**
+		 * @struct senc::server::Server::Acceptor
+		 * @brief Listening socket, its acceptor thread and registry of clients it accepted.
+		 */
+		struct Acceptor
+		{
+			Socket listenSock;
+
+			// maps connection ID to client thread and socket reference (uses mtx)
+			utils::HashMap<utils::UUID, std::jthread> clientThreads;
+			utils::HashMap<utils::UUID, std::reference_wrapper<Socket>> clientSocks;
+
+			// contains connection IDs of connections that have finished
+			utils::HashSet<utils::UUID> finishedConns;
+			std::condition_variable cvFinishedConns; // uses mtx to prevent deadlock
+
+			std::mutex mtx;
+
+			std::optional<std::jthread> acceptThread;
+			std::optional<std::jthread> cleanupThread;
+		};
+
 		static loggers::DummyLogger _dummyLogger;
 
-		Socket _listenSock;
 		utils::Port _listenPort;
 		loggers::ILogger& _logger;
 		ServerPacketHandlerFactory _packetHandlerFactory;
+		workers::WorkerPool _workerPool;
+		KeyPool _keyPool;
+		managers::UpdateManager& _updateManager;
+		managers::DecryptionsManager& _decryptionsManager;
+		metrics::Registry _metrics;
+		storage::MeteredServerStorage _storage;
 		handlers::ClientHandlerFactory _clientHandlerFactory;
+		ServerOptions _options;
+		limits::AdmissionController _admission;
+		limits::RateLimiter _rateLimiter;
+		metrics::Histogram& _handshakeLatency;
+		metrics::Counter& _failedHandshakes;
 		std::atomic<bool> _isRunning;
 
-		// maps connection ID to client thread and socket reference
-		utils::HashMap<utils::UUID, std::jthread> _clientThreads;
-		utils::HashMap<utils::UUID, std::reference_wrapper<Socket>> _clientSocks;
-		std::mutex _mtxClients;
+		// reactor mode only: event loops and connections by reactor key (uses mtxReactorConns)
+		std::optional<io::Reactor> _reactor;
+		utils::HashMap<io::Reactor::Key, std::shared_ptr<ReactorConn>> _reactorConns;
+		io::Reactor::Key _nextReactorKey = 0;
+		std::mutex _mtxReactorConns;
 
-		// contains connection IDs of connections that have finished
-		utils::HashSet<utils::UUID> _finishedConns;
-		std::condition_variable _cvFinishedConns; // uses mtxClients to prevent deadlock
+		// one per listening socket (pointers, as acceptors are not movable)
+		std::vector<std::unique_ptr<Acceptor>> _acceptors;
 
 		std::mutex _mtxWait;
 		std::condition_variable _cvWait;
 
-		std::optional<std::jthread> _acceptThread;
-		std::optional<std::jthread> _cleanupThread;
+		std::condition_variable _cvExpiry; // uses mtxWait
+		std::optional<std::jthread> _expiryThread;
+
+		std::condition_variable _cvMetricsDump; // uses mtxWait
+		std::optional<std::jthread> _metricsDumpThread;
+
+		// reactor mode only: wakes parked update requests once their wait passes
+		std::condition_variable _cvParkSweep; // uses mtxWait
+		std::optional<std::jthread> _parkSweepThread;
+
+		/**
+		 * @brief Registers sampled gauges of server components (managers, worker pool, limits, storage).
+		 */
+		void register_gauges();
+
+		/**
+		 * @brief Establishes connection with a client (e.g. key exchange), recording its latency.
+		 * @param sock Socket connected to client.
+		 * @return Packet handler of connection.
+		 * @throw ConnEstablishException If failed to establish connection.
+		 */
+		std::unique_ptr<PacketHandler> handshake(Socket& sock);
+
+		/**
+		 * @brief Periodically writes metrics report into `ServerOptions::metricsDumpPath`.
+		 */
+		void metrics_dump_loop();
+
+		/**
+		 * @brief Periodically wakes parked update requests whose wait passed, or whose client sent more.
+		 */
+		void park_sweep_loop();
 
 		/**
 		 * @brief Runs background cleanup of client threads.
+		 * @param acceptor Acceptor whose client threads to clean up.
 		 */
-		void cleanup_loop();
+		void cleanup_loop(Acceptor& acceptor);
+
+		/**
+		 * @brief Periodically removes expired decryption operations, informing their requesters.
+		 */
+		void expiry_loop();
 
 		/**
 		 * @brief Accepts new clients in a loop.
+		 * @param acceptor Acceptor to accept clients through.
 		 */
-		void accept_loop();
+		void accept_loop(Acceptor& acceptor);
 
 		/**
 		 * @brief Handles a newly connected client, until it disconnects.
+		 * @param acceptor Acceptor which accepted client.
 		 * @param connID Connection ID.
 		 * @param sock Socket connected to client (moved).
 		 * @param ip IP address by which client connected.
 		 * @param port Port by which client connected.
+		 * @param connTicket Admission of connection, held until it is closed (moved).
+		 * @param handshakeTicket Admission of handshake, held until client logs in (moved).
 		 */
-		void handle_new_client(utils::UUID connID, Socket sock, IP ip, utils::Port port);
+		void handle_new_client(Acceptor& acceptor, utils::UUID connID, Socket sock, IP ip, utils::Port port,
+							   limits::AdmissionController::Ticket connTicket,
+							   limits::AdmissionController::Ticket handshakeTicket);
 
 		/**
 		 * @brief Handles client connection request(s).
 		 * @param packetHandler Implementation of `PacketHandler`.
+		 * @param rateLimiter Rate limiter buckets of client's connection.
 		 * @param ip Client's IP address.
 		 * @param port Client's port number.
 		 * @return A flag indicating if client successfully connected or not,
 		 *		   and client's username (if successfully connected).
 		 */
 		std::pair<bool, std::string> connect_client(PacketHandler& packetHandler,
+													limits::RateLimiter::Connection& rateLimiter,
 													const IP& ip,
 													utils::Port port);
 
 		/**
 		 * @brief Handles client requests in a loop.
 		 * @param packetHandler Implementation of `PacketHandler`.
+		 * @param rateLimiter Rate limiter buckets of client's connection.
 		 * @param ip Client's IP address.
 		 * @param port Client's port number.
 		 * @param username Client's connected username.
 		 */
 		void client_loop(PacketHandler& packetHandler,
+						 limits::RateLimiter::Connection& rateLimiter,
 						 const IP& ip,
 						 utils::Port port,
 						 const std::string& username);
+
+		/**
+		 * @brief Registers a newly accepted client as a reactor connection (not yet watched by
+		 *		  reactor, until its handshake is done).
+		 * @param sock Socket connected to client (moved).
+		 * @param ip IP address by which client connected.
+		 * @param port Port by which client connected.
+		 * @param connTicket Admission of connection, held until it is closed (moved).
+		 * @param handshakeTicket Admission of handshake, held until client logs in (moved).
+		 * @return Reactor key of connection, or `std::nullopt` if server stopped.
+		 */
+		std::optional<io::Reactor::Key> add_reactor_client(Socket sock, const IP& ip, utils::Port port,
+														   limits::AdmissionController::Ticket connTicket,
+														   limits::AdmissionController::Ticket handshakeTicket);
+
+		/**
+		 * @brief Establishes connection with a reactor client, then has reactor watch it.
+		 * @note Handshakes read and write in turns, so they run on their own threads (bounded by
+		 *		 handshake admission) rather than on event loops.
+		 * @param acceptor Acceptor which accepted client.
+		 * @param connID Connection ID (of handshake thread).
+		 * @param key Reactor key of connection.
+		 */
+		void handshake_reactor_client(Acceptor& acceptor, utils::UUID connID, io::Reactor::Key key);
+
+		/**
+		 * @brief Handles a readable reactor connection (called from event loops).
+		 * @param key Reactor key of connection.
+		 */
+		void reactor_step(io::Reactor::Key key);
+
+		/**
+		 * @brief Handles all requests fully received on a reactor connection so far, without
+		 *		  blocking: an incomplete request is kept for following readable events, and
+		 *		  serving stops at a request handed to workers or parked (until it is answered).
+		 * @param key Reactor key of connection.
+		 * @param conn Reactor connection.
+		 * @return Connection state.
+		 * @throw senc::utils::SocketException If client disconnected.
+		 */
+		ConnState reactor_serve(io::Reactor::Key key, ReactorConn& conn);
+
+		/**
+		 * @brief Runs a single iteration of reactor connection's state machine.
+		 * @param key Reactor key of connection.
+		 * @param conn Reactor connection.
+		 * @return Connection state.
+		 * @throw senc::utils::SocketWouldBlockException If request was not fully received yet.
+		 * @throw senc::utils::SocketException If client disconnected.
+		 */
+		ConnState reactor_iteration(io::Reactor::Key key, ReactorConn& conn);
+
+		/**
+		 * @brief Applies outcome of a pending request answered by a worker, if connection has one.
+		 * @param key Reactor key of connection.
+		 * @param conn Reactor connection.
+		 * @return Connection state.
+		 */
+		ConnState reactor_resume(io::Reactor::Key key, ReactorConn& conn);
+
+		/**
+		 * @brief Applies status of a connecting client's request (e.g. moving it to connected state).
+		 * @param key Reactor key of connection.
+		 * @param conn Reactor connection.
+		 * @param status Status returned for request (not pending).
+		 * @param username Client's username (if connected).
+		 * @return Connection state.
+		 */
+		ConnState reactor_connecting_done(io::Reactor::Key key, ReactorConn& conn,
+										  handlers::ConnectingClientHandler::Status status,
+										  std::string&& username);
+
+		/**
+		 * @brief Applies status of a connected client's request.
+		 * @param conn Reactor connection.
+		 * @param status Status returned for request (not pending).
+		 * @return Connection state.
+		 */
+		ConnState reactor_connected_done(ReactorConn& conn, handlers::ConnectedClientHandler::Status status);
+
+		/**
+		 * @brief Marks a party (event loop or worker) as done with a connection's pending request,
+		 *		  resuming connection on an event loop once both are.
+		 * @param key Reactor key of connection.
+		 * @param conn Reactor connection.
+		 */
+		void reactor_handoff(io::Reactor::Key key, ReactorConn& conn);
+
+		/**
+		 * @brief Has reactor watch a connection for its next readable event, hands it off to its
+		 *		  pending request, or closes it.
+		 * @param key Reactor key of connection.
+		 * @param conn Reactor connection.
+		 * @param state Connection state.
+		 */
+		void reactor_watch(io::Reactor::Key key, ReactorConn& conn, ConnState state);
+
+		/**
+		 * @brief Unregisters and closes a reactor connection.
+		 * @param key Reactor key of connection.
+		 */
+		void remove_reactor_client(io::Reactor::Key key);
 	};
 }
 
@@ -0,0 +1,101 @@
+/*********************************************************************
+ * \file   ServerOptions.hpp
+ * \brief  Contains ServerOptions struct.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include "workers/WorkerPool.hpp"
+#include "limits/RateLimiter.hpp"
+#include "../common/aliases.hpp"
+#include <cstddef>
+#include <chrono>
+#include <string>
+
+namespace senc::server
+{
+	/**
+	 * @struct senc::server::ServerOptions
+	 * @brief Tunable options of server runtime (all have sensible defaults).
+	 */
+	struct ServerOptions
+	{
+		/**
+		 * @enum senc::server::ServerOptions::Mode
+		 * @brief Connection handling mode.
+		 */
+		enum class Mode
+		{
+			ThreadPerClient, // a dedicated thread blocks on each client's socket
+			Reactor			 // fixed amount of event-loop threads, driven by socket readiness (Linux only)
+		};
+
+		static constexpr std::size_t DEFAULT_REACTOR_THREADS = 4;
+
+		static constexpr std::size_t DEFAULT_REUSE_PORT_ACCEPTORS = 4;
+
+		static constexpr std::size_t DEFAULT_WORKER_THREADS = 4;
+
+		static constexpr std::chrono::milliseconds DEFAULT_MAX_UPDATE_WAIT{ 1000 };
+
+		static constexpr std::chrono::milliseconds DEFAULT_EXPIRY_SWEEP_INTERVAL{ 1000 };
+
+		static constexpr std::size_t DEFAULT_MAX_CONNECTIONS = 4096;
+
+		static constexpr std::size_t DEFAULT_MAX_HANDSHAKES = 256;
+
+		static constexpr std::chrono::milliseconds DEFAULT_METRICS_DUMP_INTERVAL{ 10000 };
+
+		static constexpr std::size_t DEFAULT_KEY_POOL_DEPTH = KeyPool::DEFAULT_DEPTH;
+
+		static constexpr std::size_t DEFAULT_HANDSHAKE_KEY_POOL_DEPTH = 64;
+
+		Mode mode = Mode::ThreadPerClient;
+
+		// amount of listening sockets sharing the port (via `SO_REUSEPORT`, if more than one),
+		// each with its own acceptor thread and registry of client threads
+		std::size_t acceptors = 1;
+
+		// amount of event-loop threads (used by `Mode::Reactor` only)
+		std::size_t reactorThreads = DEFAULT_REACTOR_THREADS;
+
+		// amount of worker threads running CPU-heavy requests (zero to run them on connection threads);
+		// `Mode::Reactor` runs at least one, as its event loops never run such requests themselves
+		std::size_t workerThreads = DEFAULT_WORKER_THREADS;
+
+		// maximum amount of requests queued for workers, before connection threads block
+		std::size_t workerQueueCapacity = workers::WorkerPool::DEFAULT_QUEUE_CAPACITY;
+
+		// maximum time an update request may be held until updates arrive (long-poll); `Mode::Reactor` parks such
+		// requests without holding an event loop, checking their waits every `UpdateManager::WAIT_SLICE`
+		std::chrono::milliseconds maxUpdateWait = DEFAULT_MAX_UPDATE_WAIT;
+
+		// interval between sweeps of expired decryption operations
+		std::chrono::milliseconds expirySweepInterval = DEFAULT_EXPIRY_SWEEP_INTERVAL;
+
+		// maximum amount of open connections, further ones are closed at once (zero for unlimited)
+		std::size_t maxConnections = DEFAULT_MAX_CONNECTIONS;
+
+		// maximum amount of connections not yet logged in (zero for unlimited)
+		std::size_t maxHandshakes = DEFAULT_MAX_HANDSHAKES;
+
+		// request rates allowed per connection and per username
+		limits::RateLimits rateLimits = {};
+
+		// file to periodically write metrics report into (empty for no dumps)
+		std::string metricsDumpPath = "";
+
+		// interval between metrics dumps (used only if `metricsDumpPath` is set)
+		std::chrono::milliseconds metricsDumpInterval = DEFAULT_METRICS_DUMP_INTERVAL;
+
+		// maximum amount of userset key-pairs pre-generated in background (zero to generate them on request)
+		std::size_t keyPoolDepth = DEFAULT_KEY_POOL_DEPTH;
+
+		// maximum amount of ready handshake ephemeral keys, absorbing reconnect storms (zero to compute
+		// each on its handshake); used for the pool given to the packet handler factory, not by server itself
+		std::size_t handshakeKeyPoolDepth = DEFAULT_HANDSHAKE_KEY_POOL_DEPTH;
+	};
+}
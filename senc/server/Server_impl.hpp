@@ -8,10 +8,13 @@
 
 #include "Server.hpp"
 
+#include <algorithm>
 #include <optional>
 #include "loggers/ConnectingClientLogger.hpp"
 #include "loggers/ConnectedClientLogger.hpp"
 #include "../utils/AtScopeExit.hpp"
+#include "metrics/ScopedTimer.hpp"
+#include <fstream>
 
 namespace senc::server
 {
@@ -25,11 +28,44 @@ namespace senc::server
 							  storage::IServerStorage& storage,
 							  ServerPacketHandlerFactory packetHandlerFactory,
 							  managers::UpdateManager& updateManager,
-							  managers::DecryptionsManager& decryptionsManager)
+							  managers::DecryptionsManager& decryptionsManager,
+							  const ServerOptions& options)
 		: _listenPort(listenPort), _logger(logger), _packetHandlerFactory(packetHandlerFactory),
-		  _clientHandlerFactory(schema, storage, updateManager, decryptionsManager)
+		  // event loops must never run CPU-heavy requests, so reactor mode always has workers for them
+		  _workerPool((ServerOptions::Mode::Reactor == options.mode)
+						  ? std::max<std::size_t>(options.workerThreads, 1) : options.workerThreads,
+					  options.workerQueueCapacity,
+					  // event loops must never block, so reactor mode rejects work while workers are full
+					  (ServerOptions::Mode::Reactor == options.mode)
+						  ? workers::WorkerPool::FullPolicy::Reject : workers::WorkerPool::FullPolicy::Block),
+		  _keyPool(options.keyPoolDepth),
+		  _updateManager(updateManager), _decryptionsManager(decryptionsManager),
+		  _storage(storage, _metrics),
+		  _clientHandlerFactory(schema, _keyPool, _storage, updateManager, decryptionsManager, _workerPool,
+								options.maxUpdateWait,
+								// event loops must never block, so reactor mode parks update requests instead
+								ServerOptions::Mode::Reactor == options.mode,
+								_metrics),
+		  _options(options),
+		  _admission(options.maxConnections, options.maxHandshakes),
+		  _rateLimiter(options.rateLimits),
+		  _handshakeLatency(_metrics.histogram("handshake_us")),
+		  _failedHandshakes(_metrics.counter("handshakes.failed"))
 	{
-		_listenSock.bind(_listenPort);
+		register_gauges();
+
+		// bind listening sockets, sharing the port if there are several
+		const std::size_t acceptorCount = std::max<std::size_t>(_options.acceptors, 1);
+		for (std::size_t i = 0; i < acceptorCount; ++i)
+		{
+			auto& acceptor = *_acceptors.emplace_back(std::make_unique<Acceptor>());
+			if (acceptorCount > 1)
+				acceptor.listenSock.set_reuse_port(true);
+			acceptor.listenSock.bind(_listenPort);
+		}
+
+		if (ServerOptions::Mode::Reactor == _options.mode)
+			_reactor.emplace(_options.reactorThreads, [this](io::Reactor::Key key) { reactor_step(key); });
 	}
 
 	template <utils::IPType IP>
@@ -38,9 +74,10 @@ namespace senc::server
 							  storage::IServerStorage& storage,
 							  ServerPacketHandlerFactory packetHandlerFactory,
 							  managers::UpdateManager& updateManager,
-							  managers::DecryptionsManager& decryptionsManager)
+							  managers::DecryptionsManager& decryptionsManager,
+							  const ServerOptions& options)
 		: Self(listenPort, _dummyLogger, schema, storage,
-			   packetHandlerFactory, updateManager, decryptionsManager) { }
+			   packetHandlerFactory, updateManager, decryptionsManager, options) { }
 
 	template <utils::IPType IP>
 	inline utils::Port Server<IP>::port() const
@@ -54,10 +91,22 @@ namespace senc::server
 		if (_isRunning.exchange(true))
 			throw ServerException("Server is already running");
 		
-		_listenSock.listen();
+		for (auto& acceptor : _acceptors)
+			acceptor->listenSock.listen();
 
-		_acceptThread.emplace(&Self::accept_loop, this);
-		_cleanupThread.emplace(&Self::cleanup_loop, this);
+		if (_reactor)
+			_reactor->start();
+
+		for (auto& acceptor : _acceptors)
+		{
+			acceptor->acceptThread.emplace(&Self::accept_loop, this, std::ref(*acceptor));
+			acceptor->cleanupThread.emplace(&Self::cleanup_loop, this, std::ref(*acceptor));
+		}
+		_expiryThread.emplace(&Self::expiry_loop, this);
+		if (_reactor)
+			_parkSweepThread.emplace(&Self::park_sweep_loop, this);
+		if (!_options.metricsDumpPath.empty())
+			_metricsDumpThread.emplace(&Self::metrics_dump_loop, this);
 	}
 
 	template <utils::IPType IP>
@@ -66,32 +115,71 @@ namespace senc::server
 		if (!_isRunning.exchange(false))
 			throw ServerException("Server is not running");
 
-		_listenSock.close(); // forces stop of any hanging accepts
+		for (auto& acceptor : _acceptors)
+		{
+			acceptor->listenSock.close(); // forces stop of any hanging accepts
+
+			// final cleanups, locking to not miss cleanup loop between check and wait
+			const std::lock_guard<std::mutex> lock(acceptor->mtx);
+			acceptor->cvFinishedConns.notify_all();
+		}
+
+		// wake expiry, metrics dump and park sweep loops, locking to not miss them between check and wait
+		{
+			const std::lock_guard<std::mutex> lock(_mtxWait);
+			_cvExpiry.notify_all();
+			_cvMetricsDump.notify_all();
+			_cvParkSweep.notify_all();
+		}
+		_parkSweepThread.reset(); // before sockets are closed, as it checks sockets of parked requests
 
-		_cvFinishedConns.notify_all(); // final cleanups
+		_updateManager.interrupt_waits(); // release clients held on long-polled update requests
 
 		// force close all client sockets
+		for (auto& acceptor : _acceptors)
 		{
-			const std::lock_guard<std::mutex> lock(_mtxClients);
-			for (auto& p : _clientSocks)
+			const std::lock_guard<std::mutex> lock(acceptor->mtx);
+			for (auto& p : acceptor->clientSocks)
 				p.second.get().close();
-			_clientSocks.clear();
-			_finishedConns.clear();
+			acceptor->clientSocks.clear();
+			acceptor->finishedConns.clear();
+		}
+		{
+			const std::lock_guard<std::mutex> lock(_mtxReactorConns);
+			for (auto& p : _reactorConns)
+				p.second->sock.close(); // unblocks handshakes waiting on client
+		}
+
+		for (auto& acceptor : _acceptors)
+		{
+			// wait for all client threads to exit gracefully
+			// NOTE: we move the map to not hold the mutex while joining
+			utils::HashMap<utils::UUID, std::jthread> threadsToJoin;
+			{
+				const std::lock_guard<std::mutex> lock(acceptor->mtx);
+				threadsToJoin = std::move(acceptor->clientThreads);
+				acceptor->clientThreads.clear(); // ensure valid state after move
+			}
+			threadsToJoin.clear(); // joins client threads
+
+			// wait for accept loop and cleanup loop threads to finish gracefully
+			acceptor->acceptThread.reset();
+			acceptor->cleanupThread.reset();
 		}
 
-		// wait for all client threads to exit gracefully
-		// NOTE: we move the map to not hold the mutex while joining
-		utils::HashMap<utils::UUID, std::jthread> threadsToJoin;
+		// wait for event loops to exit and for workers answering their connections, then drop them
+		// (after handshake threads are joined, so that none hands a connection to workers anymore)
+		if (_reactor)
 		{
-			const std::lock_guard<std::mutex> lock(_mtxClients);
-			threadsToJoin = std::move(_clientThreads);
-			_clientThreads.clear(); // ensure valid state after move
+			_reactor->stop();
+			_updateManager.interrupt_waits(); // drop requests parked meanwhile, as their wake-ups post to reactor
+			_workerPool.wait_idle();
+			const std::lock_guard<std::mutex> lock(_mtxReactorConns);
+			_reactorConns.clear();
 		}
-		threadsToJoin.clear(); // joins client threads
 
-		// wait for accept loop and cleanup loop threads to finish gracefully
-		_acceptThread.reset();
-		_cleanupThread.reset();
+		_expiryThread.reset();
+		_metricsDumpThread.reset();
 
 		_cvWait.notify_all(); // notify all waiting threads that finished running
 	}
@@ -105,14 +193,164 @@ namespace senc::server
 	}
 
 	template <utils::IPType IP>
-	inline void Server<IP>::cleanup_loop()
+	inline workers::WorkerPool::Stats Server<IP>::worker_pool_stats() const
+	{
+		return _workerPool.stats();
+	}
+
+	template <utils::IPType IP>
+	inline limits::AdmissionController::Stats Server<IP>::admission_stats() const
+	{
+		return _admission.stats();
+	}
+
+	template <utils::IPType IP>
+	inline limits::RateLimiter::Stats Server<IP>::rate_limiter_stats()
+	{
+		return _rateLimiter.stats();
+	}
+
+	template <utils::IPType IP>
+	inline KeyPool::Stats Server<IP>::key_pool_stats() const
+	{
+		return _keyPool.stats();
+	}
+
+	template <utils::IPType IP>
+	inline metrics::Registry& Server<IP>::metrics()
+	{
+		return _metrics;
+	}
+
+	template <utils::IPType IP>
+	inline void Server<IP>::register_gauges()
+	{
+		_metrics.sampled_gauge("updates.pending_users", [this]() -> std::int64_t
+		{
+			return _updateManager.stats().pending_users;
+		});
+		_metrics.sampled_gauge("updates.max_stripe_pending", [this]() -> std::int64_t
+		{
+			return _updateManager.stats().max_stripe_pending;
+		});
+		_metrics.sampled_gauge("updates.waiting_clients", [this]() -> std::int64_t
+		{
+			return _updateManager.stats().waiting_clients;
+		});
+		_metrics.sampled_gauge("decryptions.live", [this]() -> std::int64_t
+		{
+			return _decryptionsManager.stats().live_operations;
+		});
+		_metrics.sampled_gauge("decryptions.preparing", [this]() -> std::int64_t
+		{
+			return _decryptionsManager.stats().preparing_operations;
+		});
+		_metrics.sampled_gauge("decryptions.collecting", [this]() -> std::int64_t
+		{
+			return _decryptionsManager.stats().collecting_operations;
+		});
+		_metrics.sampled_gauge("workers.queue_depth", [this]() -> std::int64_t
+		{
+			return _workerPool.stats().queue_depth;
+		});
+		_metrics.sampled_gauge("connections.open", [this]() -> std::int64_t
+		{
+			return _admission.stats().connections;
+		});
+		_metrics.sampled_gauge("connections.handshaking", [this]() -> std::int64_t
+		{
+			return _admission.stats().handshakes;
+		});
+		_metrics.sampled_gauge("key_pool.available", [this]() -> std::int64_t
+		{
+			return _keyPool.stats().available;
+		});
+		_metrics.sampled_gauge("key_pool.misses", [this]() -> std::int64_t
+		{
+			return _keyPool.stats().misses;
+		});
+		_storage.register_gauges(_metrics);
+	}
+
+	template <utils::IPType IP>
+	inline std::unique_ptr<PacketHandler> Server<IP>::handshake(Socket& sock)
+	{
+		const metrics::ScopedTimer timer(_handshakeLatency);
+		try { return _packetHandlerFactory(sock); }
+		catch (const std::exception&)
+		{
+			_failedHandshakes.add();
+			throw;
+		}
+	}
+
+	template <utils::IPType IP>
+	inline void Server<IP>::metrics_dump_loop()
+	{
+		while (_isRunning)
+		{
+			{
+				std::unique_lock<std::mutex> lock(_mtxWait);
+				_cvMetricsDump.wait_for(lock, _options.metricsDumpInterval, [this]() { return !_isRunning; });
+			}
+
+			// rewrite whole file, so that it always holds latest report
+			std::ofstream file(_options.metricsDumpPath, std::ios::trunc);
+			for (const auto& line : _metrics.report())
+				file << line << '\n';
+			if (!file)
+				_logger.log_warning("Failed to write metrics into \"" + _options.metricsDumpPath + "\".");
+		}
+	}
+
+	template <utils::IPType IP>
+	inline void Server<IP>::expiry_loop()
 	{
 		while (_isRunning)
 		{
-			std::unique_lock<std::mutex> lock(_mtxClients);
-			_cvFinishedConns.wait(lock, [this]()
 			{
-				return (!_isRunning || !this->_finishedConns.empty());
+				std::unique_lock<std::mutex> lock(_mtxWait);
+				_cvExpiry.wait_for(lock, _options.expirySweepInterval, [this]() { return !_isRunning; });
+			}
+
+			for (const auto& record : _decryptionsManager.remove_expired())
+			{
+				_updateManager.register_expired_operation(record.requester, record.op_id);
+				_logger.log_info(
+					"Decryption operation " + record.op_id.to_string() +
+					" of user \"" + record.requester + "\" expired"
+				);
+			}
+		}
+	}
+
+	template <utils::IPType IP>
+	inline void Server<IP>::park_sweep_loop()
+	{
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(_mtxWait);
+				_cvParkSweep.wait_for(lock, managers::UpdateManager::WAIT_SLICE, [this]() { return !_isRunning; });
+			}
+
+			// if server stopped mid-way, stop here (parked requests are released by `stop`)
+			if (!_isRunning)
+				return;
+
+			_updateManager.expire_parks();
+		}
+	}
+
+	template <utils::IPType IP>
+	inline void Server<IP>::cleanup_loop(Acceptor& acceptor)
+	{
+		while (_isRunning)
+		{
+			std::unique_lock<std::mutex> lock(acceptor.mtx);
+			acceptor.cvFinishedConns.wait(lock, [this, &acceptor]()
+			{
+				return (!_isRunning || !acceptor.finishedConns.empty());
 			});
 
 			// if server stopped mid-way, return
@@ -120,87 +358,143 @@ namespace senc::server
 				return;
 
 			// for each finished connection, remove its matching thread
-			for (const auto& connID : _finishedConns)
+			for (const auto& connID : acceptor.finishedConns)
 			{
-				const auto it = _clientThreads.find(connID);
-				if (it != _clientThreads.end())
-					_clientThreads.erase(it);
+				const auto it = acceptor.clientThreads.find(connID);
+				if (it != acceptor.clientThreads.end())
+					acceptor.clientThreads.erase(it);
 			}
 
-			_finishedConns.clear();
+			acceptor.finishedConns.clear();
 		}
 	}
 
 	template <utils::IPType IP>
-	inline void Server<IP>::accept_loop()
+	inline void Server<IP>::accept_loop(Acceptor& acceptor)
 	{
 		while (_isRunning)
 		{
 			std::optional<std::pair<Socket, std::tuple<IP, utils::Port>>> acceptRet;
-			try { acceptRet = _listenSock.accept(); }
+			try { acceptRet = acceptor.listenSock.accept(); }
 			catch (const utils::SocketException&) { continue; }
 			// silently ignores failed accepts - might be due to server stop
 
 			auto& [sock, addr] = *acceptRet;
 			const auto& [ip, port] = addr;
 
-			const std::lock_guard<std::mutex> lock(_mtxClients);
-			auto connID = utils::UUID::generate_not_in(_clientThreads);
-			_clientThreads.emplace(
+			// admit before spending anything on client, over limits it is closed at once (on scope exit)
+			auto connTicket = _admission.try_admit_connection();
+			if (!connTicket)
+			{
+				loggers::ConnectingClientLogger<IP>(_logger, ip, port).log_warning("Rejected: too many connections.");
+				continue;
+			}
+			auto handshakeTicket = _admission.try_begin_handshake();
+			if (!handshakeTicket)
+			{
+				loggers::ConnectingClientLogger<IP>(_logger, ip, port).log_warning("Rejected: too many handshakes.");
+				continue;
+			}
+
+			if (_reactor)
+			{
+				const auto key = add_reactor_client(
+					std::move(sock), ip, port, std::move(*connTicket), std::move(*handshakeTicket)
+				);
+				if (!key)
+					continue;
+
+				const std::lock_guard<std::mutex> lock(acceptor.mtx);
+				auto connID = utils::UUID::generate_not_in(acceptor.clientThreads);
+				acceptor.clientThreads.emplace(
+					connID, std::jthread(
+						&Self::handshake_reactor_client, this, std::ref(acceptor), connID, *key
+					)
+				);
+				continue;
+			}
+
+			const std::lock_guard<std::mutex> lock(acceptor.mtx);
+			auto connID = utils::UUID::generate_not_in(acceptor.clientThreads);
+			acceptor.clientThreads.emplace(
 				connID, std::jthread(
-					&Self::handle_new_client, this,
-					std::move(connID), std::move(sock), std::move(ip), port
+					&Self::handle_new_client, this, std::ref(acceptor),
+					std::move(connID), std::move(sock), std::move(ip), port,
+					std::move(*connTicket), std::move(*handshakeTicket)
 				)
 			);
 		}
 	}
 
 	template <utils::IPType IP>
-	inline void Server<IP>::handle_new_client(utils::UUID connID, Socket sock, IP ip, utils::Port port)
+	inline void Server<IP>::handle_new_client(Acceptor& acceptor,
+											  utils::UUID connID,
+											  Socket sock,
+											  IP ip,
+											  utils::Port port,
+											  limits::AdmissionController::Ticket connTicket,
+											  limits::AdmissionController::Ticket handshakeTicket)
 	{
+		(void)connTicket; // held until connection is closed
+
 		// register client socket
 		{
-			const std::lock_guard<std::mutex> lock(_mtxClients);
-			_clientSocks.emplace(connID, sock);
+			const std::lock_guard<std::mutex> lock(acceptor.mtx);
+			acceptor.clientSocks.emplace(connID, sock);
 		}
 
 		// at scope exit, clean up socket and mark connection as finished
-		utils::AtScopeExit cleanup([this, &connID]()
+		utils::AtScopeExit cleanup([&acceptor, &connID]()
 		{
-			const std::lock_guard<std::mutex> lock(_mtxClients);
-			this->_clientSocks.erase(connID);
-			this->_finishedConns.insert(connID);
-			_cvFinishedConns.notify_one();
+			const std::lock_guard<std::mutex> lock(acceptor.mtx);
+			acceptor.clientSocks.erase(connID);
+			acceptor.finishedConns.insert(connID);
+			acceptor.cvFinishedConns.notify_one();
 		});
 
 		// if server stopped mid-way, return
 		if (!_isRunning)
 			return;
 
-		auto packetHandler = _packetHandlerFactory(sock);
+		auto packetHandler = handshake(sock);
+		auto rateLimiter = _rateLimiter.new_connection();
 		
-		const auto [connected, username] = connect_client(*packetHandler, ip, port);
+		const auto [connected, username] = connect_client(*packetHandler, rateLimiter, ip, port);
+		handshakeTicket.release();
 
 		if (connected)
-			client_loop(*packetHandler, ip, port, username);
+			client_loop(*packetHandler, rateLimiter, ip, port, username);
 	}
 
 	template <utils::IPType IP>
-	inline std::pair<bool, std::string> Server<IP>::connect_client(PacketHandler& packetHandler, const IP& ip, utils::Port port)
+	inline std::pair<bool, std::string> Server<IP>::connect_client(PacketHandler& packetHandler,
+																  limits::RateLimiter::Connection& rateLimiter,
+																  const IP& ip,
+																  utils::Port port)
 	{
 		using Status = handlers::ConnectingClientHandler::Status;
 
 		loggers::ConnectingClientLogger<IP> logger(_logger, ip, port);
 		logger.log_info("Connected.");
+		PendingResult<std::tuple<Status, std::string>> pending;
 		auto clientHandler = _clientHandlerFactory.make_connecting_client_handler(
-			packetHandler
+			packetHandler,
+			rateLimiter,
+			[&pending](Status status, std::string username) { pending.set({ status, std::move(username) }); }
 		);
 
 		Status status = Status::Error;
 		std::string username;
 		while (Status::Error == status && _isRunning)
 		{
-			try { std::tie(status, username) = clientHandler.iteration(); }
+			try
+			{
+				std::tie(status, username) = clientHandler.iteration();
+
+				// connection thread has nothing else to do, so it waits for workers to answer
+				if (Status::Pending == status)
+					std::tie(status, username) = pending.take();
+			}
 			catch (const utils::SocketException& e)
 			{
 				// might have happened because server stopped, if not - client disconnected
@@ -229,21 +523,32 @@ namespace senc::server
 
 	template <utils::IPType IP>
 	inline void Server<IP>::client_loop(PacketHandler& packetHandler,
+										limits::RateLimiter::Connection& rateLimiter,
 										const IP& ip,
 										utils::Port port,
 										const std::string& username)
 	{
 		using Status = handlers::ConnectedClientHandler::Status;
 		loggers::ConnectedClientLogger<IP> logger(_logger, ip, port, username);
+		PendingResult<Status> pending;
 		auto handler = _clientHandlerFactory.make_connected_client_handler(
 			packetHandler,
-			username
+			username,
+			rateLimiter,
+			[&pending](Status status) { pending.set(std::move(status)); }
 		);
 
 		Status status = Status::Connected;
 		while (Status::Connected == status && _isRunning)
 		{
-			try { status = handler.iteration(); }
+			try
+			{
+				status = handler.iteration();
+
+				// connection thread has nothing else to do, so it waits for workers to answer
+				if (Status::Pending == status)
+					status = pending.take();
+			}
 			catch (const utils::SocketException& e)
 			{
 				// might have happened because server stopped, if not - client disconnected
@@ -263,4 +568,326 @@ namespace senc::server
 
 		logger.log_info("Disconnected.");
 	}
+
+	template <utils::IPType IP>
+	inline std::optional<io::Reactor::Key> Server<IP>::add_reactor_client(
+		Socket sock, const IP& ip, utils::Port port,
+		limits::AdmissionController::Ticket connTicket,
+		limits::AdmissionController::Ticket handshakeTicket)
+	{
+		auto conn = std::make_shared<ReactorConn>(
+			std::move(sock), ip, port,
+			std::move(connTicket), std::move(handshakeTicket), _rateLimiter.new_connection()
+		);
+
+		const std::lock_guard<std::mutex> lock(_mtxReactorConns);
+		if (!_isRunning)
+			return std::nullopt; // server stopped mid-way, connection closed on scope exit
+
+		const auto key = _nextReactorKey++;
+		_reactorConns.emplace(key, std::move(conn));
+		return key;
+	}
+
+	template <utils::IPType IP>
+	inline void Server<IP>::handshake_reactor_client(Acceptor& acceptor, utils::UUID connID,
+													 io::Reactor::Key key)
+	{
+		// at scope exit, mark handshake thread as finished
+		// NOTE: socket is registered as reactor connection, so `stop` closes it
+		utils::AtScopeExit cleanup([&acceptor, &connID]()
+		{
+			const std::lock_guard<std::mutex> lock(acceptor.mtx);
+			acceptor.finishedConns.insert(connID);
+			acceptor.cvFinishedConns.notify_one();
+		});
+
+		std::shared_ptr<ReactorConn> conn;
+		{
+			const std::lock_guard<std::mutex> lock(_mtxReactorConns);
+			const auto it = _reactorConns.find(key);
+			if (it == _reactorConns.end())
+				return;
+			conn = it->second;
+		}
+
+		ConnState state = ConnState::Open;
+		try
+		{
+			conn->packetHandler = handshake(conn->sock);
+			conn->connecting.emplace(_clientHandlerFactory.make_connecting_client_handler(
+				*conn->packetHandler, conn->rateLimiter,
+				[this, key, &c = *conn](handlers::ConnectingClientHandler::Status status, std::string username)
+				{
+					c.connectingDone.emplace(status, std::move(username));
+					reactor_handoff(key, c);
+				}
+			));
+			loggers::ConnectingClientLogger<IP>(_logger, conn->ip, conn->port).log_info("Connected.");
+
+			// leftover data is invisible to reactor, so handle it before watching
+			state = reactor_serve(key, *conn);
+		}
+		catch (const utils::SocketException& e)
+		{
+			// might have happened because server stopped, if not - client disconnected
+			if (_isRunning)
+			{
+				loggers::ConnectingClientLogger<IP> logger(_logger, conn->ip, conn->port);
+				logger.log_info(std::string("Lost connection: ") + e.what() + ".");
+			}
+			state = ConnState::Closed;
+		}
+		catch (const std::exception& e)
+		{
+			// e.g. failed connection establishment - can't recover, drop connection
+			loggers::ConnectingClientLogger<IP> logger(_logger, conn->ip, conn->port);
+			logger.log_error(std::string("Dropped connection: ") + e.what() + ".");
+			state = ConnState::Closed;
+		}
+
+		reactor_watch(key, *conn, state);
+	}
+
+	template <utils::IPType IP>
+	inline void Server<IP>::reactor_step(io::Reactor::Key key)
+	{
+		// keep connection alive while handling, even if removed mid-way
+		std::shared_ptr<ReactorConn> conn;
+		{
+			const std::lock_guard<std::mutex> lock(_mtxReactorConns);
+			const auto it = _reactorConns.find(key);
+			if (it == _reactorConns.end())
+				return;
+			conn = it->second;
+		}
+
+		ConnState state = ConnState::Open;
+		try
+		{
+			// dispatched either since socket is readable, or since its pending request was answered
+			state = reactor_resume(key, *conn);
+			if (ConnState::Open == state)
+			{
+				conn->sock.recv_available();
+				state = reactor_serve(key, *conn);
+			}
+		}
+		catch (const utils::SocketException& e)
+		{
+			// might have happened because server stopped, if not - client disconnected
+			if (_isRunning)
+			{
+				loggers::ConnectingClientLogger<IP> logger(_logger, conn->ip, conn->port);
+				logger.log_info(std::string("Lost connection: ") + e.what() + ".");
+			}
+			state = ConnState::Closed;
+		}
+		catch (const std::exception& e)
+		{
+			loggers::ConnectingClientLogger<IP> logger(_logger, conn->ip, conn->port);
+			logger.log_error(std::string("Dropped connection: ") + e.what() + ".");
+			state = ConnState::Closed;
+		}
+
+		reactor_watch(key, *conn, state);
+	}
+
+	template <utils::IPType IP>
+	inline typename Server<IP>::ConnState Server<IP>::reactor_serve(io::Reactor::Key key, ReactorConn& conn)
+	{
+		while (_isRunning && conn.sock.has_leftover_data())
+		{
+			// requests are fully received before being handled, so an incomplete one is simply
+			// restored (on scope exit) and read again once more of it arrives
+			utils::Socket::BufferedRecv recv(conn.sock);
+			ConnState state = ConnState::Open;
+			try { state = reactor_iteration(key, conn); }
+			catch (const utils::SocketWouldBlockException&) { return ConnState::Open; }
+			recv.commit();
+
+			if (ConnState::Open != state)
+				return state;
+		}
+		return ConnState::Open;
+	}
+
+	template <utils::IPType IP>
+	inline typename Server<IP>::ConnState Server<IP>::reactor_iteration(io::Reactor::Key key, ReactorConn& conn)
+	{
+		using ConnectingStatus = handlers::ConnectingClientHandler::Status;
+		using ConnectedStatus = handlers::ConnectedClientHandler::Status;
+
+		if (conn.connecting)
+		{
+			ConnectingStatus status = ConnectingStatus::Error;
+			std::string username;
+			try { std::tie(status, username) = conn.connecting->iteration(); }
+			catch (const utils::SocketException&) { throw; }
+			catch (const std::exception& e)
+			{
+				_logger.log_error(std::string("Failed to handle request: ") + e.what() + ".");
+			}
+
+			if (ConnectingStatus::Pending == status)
+				return ConnState::Pending;
+			return reactor_connecting_done(key, conn, status, std::move(username));
+		}
+
+		ConnectedStatus status = ConnectedStatus::Connected;
+		try { status = conn.connected->iteration(); }
+		catch (const utils::SocketException&) { throw; }
+		catch (const std::exception& e)
+		{
+			loggers::ConnectedClientLogger<IP> logger(_logger, conn.ip, conn.port, conn.username);
+			logger.log_error(std::string("Failed to handle request: ") + e.what() + ".");
+		}
+
+		if (ConnectedStatus::Pending == status)
+			return ConnState::Pending;
+		if (ConnectedStatus::Parked == status)
+			return ConnState::Parked;
+		return reactor_connected_done(conn, status);
+	}
+
+	template <utils::IPType IP>
+	inline typename Server<IP>::ConnState Server<IP>::reactor_resume(io::Reactor::Key key, ReactorConn& conn)
+	{
+		// parked update request is answered here (on event loop), rather than by whoever woke it
+		if (conn.parked)
+		{
+			conn.parked = false;
+			return reactor_connected_done(conn, conn.connected->answer_parked());
+		}
+
+		if (conn.connectingDone)
+		{
+			auto [status, username] = std::move(*conn.connectingDone);
+			conn.connectingDone.reset();
+			conn.pendingParties = 0;
+			return reactor_connecting_done(key, conn, status, std::move(username));
+		}
+
+		if (conn.connectedDone)
+		{
+			const auto status = *conn.connectedDone;
+			conn.connectedDone.reset();
+			conn.pendingParties = 0;
+			return reactor_connected_done(conn, status);
+		}
+
+		return ConnState::Open;
+	}
+
+	template <utils::IPType IP>
+	inline typename Server<IP>::ConnState Server<IP>::reactor_connecting_done(
+		io::Reactor::Key key, ReactorConn& conn,
+		handlers::ConnectingClientHandler::Status status,
+		std::string&& username)
+	{
+		using ConnectingStatus = handlers::ConnectingClientHandler::Status;
+
+		if (ConnectingStatus::Error == status)
+			return ConnState::Open;
+
+		loggers::ConnectingClientLogger<IP> logger(_logger, conn.ip, conn.port);
+		conn.connecting.reset();
+		conn.handshakeTicket.release();
+		if (ConnectingStatus::Disconnected == status)
+		{
+			logger.log_info("Disconnected.");
+			return ConnState::Closed;
+		}
+
+		conn.username = std::move(username);
+		logger.log_info("Logged in as \"" + conn.username + "\".");
+		conn.connected.emplace(_clientHandlerFactory.make_connected_client_handler(
+			*conn.packetHandler, conn.username, conn.rateLimiter,
+			[this, key, &conn](handlers::ConnectedClientHandler::Status status)
+			{
+				conn.connectedDone = status;
+				reactor_handoff(key, conn);
+			}
+		));
+		return ConnState::Open;
+	}
+
+	template <utils::IPType IP>
+	inline typename Server<IP>::ConnState Server<IP>::reactor_connected_done(
+		ReactorConn& conn,
+		handlers::ConnectedClientHandler::Status status)
+	{
+		if (handlers::ConnectedClientHandler::Status::Connected == status)
+			return ConnState::Open;
+
+		loggers::ConnectedClientLogger<IP>(_logger, conn.ip, conn.port, conn.username).log_info("Disconnected.");
+		return ConnState::Closed;
+	}
+
+	template <utils::IPType IP>
+	inline void Server<IP>::reactor_handoff(io::Reactor::Key key, ReactorConn& conn)
+	{
+		// connection is untouched until both parties are done, so only then it is resumed
+		if (1 == conn.pendingParties.fetch_add(1))
+			_reactor->post(key);
+	}
+
+	template <utils::IPType IP>
+	inline void Server<IP>::reactor_watch(io::Reactor::Key key, ReactorConn& conn, ConnState state)
+	{
+		// if server stopped mid-way, stop here (connections are dropped by `stop`)
+		if (!_isRunning)
+			return;
+
+		if (ConnState::Closed == state)
+			return remove_reactor_client(key);
+
+		// not watched while a worker answers its request, so that its next requests wait for it
+		if (ConnState::Pending == state)
+			return reactor_handoff(key, conn);
+
+		// likewise while its update request is parked, until woken (leaving connection to loop it is posted to)
+		if (ConnState::Parked == state)
+		{
+			conn.parked = true;
+			conn.connected->park_update([this, key]() { _reactor->post(key); });
+			return;
+		}
+
+		try
+		{
+			if (conn.watched)
+				_reactor->rearm(conn.sock.native_handle(), key);
+			else
+			{
+				// locking to not start watching after `stop` stopped reactor
+				const std::lock_guard<std::mutex> lock(_mtxReactorConns);
+				if (!_isRunning)
+					return;
+				_reactor->add(conn.sock.native_handle(), key);
+				conn.watched = true;
+			}
+		}
+		catch (const std::exception& e)
+		{
+			_logger.log_error(std::string("Failed to watch client: ") + e.what() + ".");
+			remove_reactor_client(key);
+		}
+	}
+
+	template <utils::IPType IP>
+	inline void Server<IP>::remove_reactor_client(io::Reactor::Key key)
+	{
+		std::shared_ptr<ReactorConn> conn;
+		{
+			const std::lock_guard<std::mutex> lock(_mtxReactorConns);
+			const auto it = _reactorConns.find(key);
+			if (it == _reactorConns.end())
+				return;
+			conn = std::move(it->second);
+			_reactorConns.erase(it);
+		}
+		_reactor->remove(conn->sock.native_handle());
+		conn->sock.close();
+	}
 }
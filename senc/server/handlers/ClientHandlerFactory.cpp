@@ -11,30 +11,52 @@
 namespace senc::server::handlers
 {
 	ClientHandlerFactory::ClientHandlerFactory(Schema& schema,
+											   KeyPool& keyPool,
 											   storage::IServerStorage& storage,
 											   managers::UpdateManager& updateManager,
-											   managers::DecryptionsManager& decryptionsManager)
-		: _schema(schema), _storage(storage), _updateManager(updateManager),
-		  _decryptionsManager(decryptionsManager) { }
+											   managers::DecryptionsManager& decryptionsManager,
+											   workers::WorkerPool& workerPool,
+											   std::chrono::milliseconds maxUpdateWait,
+											   bool parkUpdates,
+											   metrics::Registry& registry)
+		: _schema(schema), _keyPool(keyPool), _storage(storage), _updateManager(updateManager),
+		  _decryptionsManager(decryptionsManager), _workerPool(workerPool),
+		  _maxUpdateWait(maxUpdateWait), _parkUpdates(parkUpdates), _requestMetrics(registry) { }
 
-	ConnectingClientHandler ClientHandlerFactory::make_connecting_client_handler(PacketHandler& packetHandler)
+	ConnectingClientHandler ClientHandlerFactory::make_connecting_client_handler(
+		PacketHandler& packetHandler,
+		limits::RateLimiter::Connection& rateLimiter,
+		ConnectingClientHandler::OnDone onDone)
 	{
 		return ConnectingClientHandler(
 			packetHandler,
-			_storage
+			_storage,
+			_workerPool,
+			rateLimiter,
+			_requestMetrics,
+			std::move(onDone)
 		);
 	}
 
 	ConnectedClientHandler ClientHandlerFactory::make_connected_client_handler(PacketHandler& packetHandler,
-																			   const std::string& username)
+																			   const std::string& username,
+																			   limits::RateLimiter::Connection& rateLimiter,
+																			   ConnectedClientHandler::OnDone onDone)
 	{
 		return ConnectedClientHandler(
 			packetHandler,
 			username,
 			_schema,
+			_keyPool,
 			_storage,
 			_updateManager,
-			_decryptionsManager
+			_decryptionsManager,
+			_workerPool,
+			_maxUpdateWait,
+			_parkUpdates,
+			rateLimiter,
+			_requestMetrics,
+			std::move(onDone)
 		);
 	}
 }
@@ -12,6 +12,8 @@
 #include "../managers/DecryptionsManager.hpp"
 #include "../managers/UpdateManager.hpp"
 #include "../storage/IServerStorage.hpp"
+#include "../workers/WorkerPool.hpp"
+#include "../metrics/RequestMetrics.hpp"
 #include "ConnectingClientHandler.hpp"
 #include "ConnectedClientHandler.hpp"
 
@@ -29,35 +31,59 @@ namespace senc::server::handlers
 		/**
 		 * @brief Constructs a new client handler factory.
 		 * @param schema Decryptions schema to use for decryptions.
+		 * @param keyPool Pool of ready key-pairs for userset creation (falling back to `schema`).
 		 * @param storage Implementation of `IServerStorage`.
 		 * @param updateManager Instance of `UpdateManager`.
 		 * @param decryptionsManager Instance of `DecryptionsManager`.
+		 * @param workerPool Worker pool running CPU-heavy requests.
+		 * @param maxUpdateWait Maximum time an update request may be held until updates arrive.
+		 * @param parkUpdates Whether update requests are parked rather than held on connection threads
+		 *					  (see `ConnectedClientHandler::Status::Parked`).
+		 * @param registry Registry to record request metrics into.
 		 * @note `storage` and `packetHandler` are assumed to be thread-safe.
 		 */
 		explicit ClientHandlerFactory(Schema& schema,
+									  KeyPool& keyPool,
 									  storage::IServerStorage& storage,
 									  managers::UpdateManager& updateManager,
-									  managers::DecryptionsManager& decryptionsManager);
+									  managers::DecryptionsManager& decryptionsManager,
+									  workers::WorkerPool& workerPool,
+									  std::chrono::milliseconds maxUpdateWait,
+									  bool parkUpdates,
+									  metrics::Registry& registry);
 
 		/**
 		 * @brief Constructs a new handler for a connecting client.
 		 * @param packetHandler Implementation of `PacketHandler`.
+		 * @param rateLimiter Rate limiter buckets of client's connection.
+		 * @param onDone Function called once a pending request was answered.
 		 * @return Constructed handler.
 		 */
-		ConnectingClientHandler make_connecting_client_handler(PacketHandler& packetHandler);
+		ConnectingClientHandler make_connecting_client_handler(PacketHandler& packetHandler,
+															   limits::RateLimiter::Connection& rateLimiter,
+															   ConnectingClientHandler::OnDone onDone);
 
 		/**
 		 * @brief Constructs a new handler for a connected client.
 		 * @param packetHandler Implementation of `PacketHandler`.
 		 * @param username Connected client's username.
+		 * @param rateLimiter Rate limiter buckets of client's connection.
+		 * @param onDone Function called once a pending request was answered.
 		 */
 		ConnectedClientHandler make_connected_client_handler(PacketHandler& packetHandler,
-															 const std::string& username);
+															 const std::string& username,
+															 limits::RateLimiter::Connection& rateLimiter,
+															 ConnectedClientHandler::OnDone onDone);
 
 	private:
 		Schema& _schema;
+		KeyPool& _keyPool;
 		storage::IServerStorage& _storage;
 		managers::UpdateManager& _updateManager;
 		managers::DecryptionsManager& _decryptionsManager;
+		workers::WorkerPool& _workerPool;
+		std::chrono::milliseconds _maxUpdateWait;
+		bool _parkUpdates;
+		metrics::RequestMetrics _requestMetrics;
 	};
 }
@@ -8,17 +8,31 @@
 
 #include "ConnectedClientHandler.hpp"
 
+#include "../metrics/ScopedTimer.hpp"
+
+#include <utility>
+#include <array>
+
 namespace senc::server::handlers
 {
 	ConnectedClientHandler::ConnectedClientHandler(PacketHandler& packetHandler,
 												   const std::string& username,
 												   Schema& schema,
+												   KeyPool& keyPool,
 												   storage::IServerStorage& storage,
 												   managers::UpdateManager& updateManager,
-												   managers::DecryptionsManager& decryptionsManager)
+												   managers::DecryptionsManager& decryptionsManager,
+												   workers::WorkerPool& workerPool,
+												   std::chrono::milliseconds maxUpdateWait,
+												   bool parkUpdates,
+												   limits::RateLimiter::Connection& rateLimiter,
+												   metrics::RequestMetrics& requestMetrics,
+												   OnDone onDone)
 		: _packetHandler(packetHandler), _username(username),
-		  _schema(schema), _storage(storage),
-		  _updateManager(updateManager), _decryptionsManager(decryptionsManager) { }
+		  _schema(schema), _keyPool(keyPool), _storage(storage),
+		  _updateManager(updateManager), _decryptionsManager(decryptionsManager),
+		  _workerPool(workerPool), _maxUpdateWait(maxUpdateWait), _parkUpdates(parkUpdates),
+		  _rateLimiter(rateLimiter), _requestMetrics(requestMetrics), _onDone(std::move(onDone)) { }
 
 	ConnectedClientHandler::Status ConnectedClientHandler::iteration()
 	{
@@ -33,17 +47,55 @@ namespace senc::server::handlers
 			pkt::SendDecryptionPartRequest
 		>();
 
+		// reject at once if client exceeds its rate (logout is always allowed)
+		if (req.has_value() && !std::holds_alternative<pkt::LogoutRequest>(*req))
+		{
+			const auto cls = std::holds_alternative<pkt::MakeUserSetRequest>(*req)
+				? limits::RequestClass::Expensive
+				: limits::RequestClass::Cheap;
+			if (!_rateLimiter.try_acquire(cls, _username))
+			{
+				_packetHandler.send_response(pkt::ErrorResponse{ limits::RateLimiter::REJECTED_MSG });
+				return Status::Connected;
+			}
+		}
+
 		if (req.has_value())
-			return std::visit(
+		{
+			const auto code = std::visit(
+				[](const auto& r) { return std::remove_cvref_t<decltype(r)>::CODE; },
+				*req
+			);
+			_requestTimer = std::make_shared<metrics::ScopedTimer>(_requestMetrics.latency(code));
+			const Status status = std::visit(
 				[this](auto& r) { return handle_request(r); },
 				*req
 			);
+			_requestTimer->exclude(std::exchange(_parkedTime, {}));
+			_requestTimer.reset(); // recorded here, unless a worker still holds it
+			return status;
+		}
 
 		// if reached here, bad request
 		_packetHandler.send_response(pkt::ErrorResponse{ "Bad request" });
 		return Status::Connected;
 	}
 
+	void ConnectedClientHandler::park_update(managers::UpdateManager::Wake wake)
+	{
+		_updateManager.park(
+			_username, _parkedWait, std::move(wake),
+			[this]() { return client_sent_more(); }
+		);
+	}
+
+	ConnectedClientHandler::Status ConnectedClientHandler::answer_parked()
+	{
+		_parkTimer.reset(); // records park time
+		_packetHandler.send_response(_updateManager.retrieve_updates(_username));
+		return Status::Connected;
+	}
+
 	pkt::MakeUserSetResponse ConnectedClientHandler::make_userset(
 		const std::string& creator,
 		const std::vector<std::string>& owners,
@@ -60,10 +112,10 @@ namespace senc::server::handlers
 			ownersThreshold, regMembersThreshold
 		);
 
-		// generate keys, and shards for each member
+		// take keys (pre-generated in background if pool keeps up), and make shards for each member
 		PrivKey regLayerPrivKey{}, ownerLayerPrivKey{};
-		std::tie(res.reg_layer_pub_key, regLayerPrivKey) = _schema.keygen();
-		std::tie(res.owner_layer_pub_key, ownerLayerPrivKey) = _schema.keygen();
+		std::tie(res.reg_layer_pub_key, regLayerPrivKey) = _keyPool.take(_schema);
+		std::tie(res.owner_layer_pub_key, ownerLayerPrivKey) = _keyPool.take(_schema);
 
 		auto regLayerPoly = Shamir::sample_poly(regLayerPrivKey, regMembersThreshold);
 		auto ownerLayerPoly = Shamir::sample_poly(ownerLayerPrivKey, ownersThreshold);
@@ -73,16 +125,20 @@ namespace senc::server::handlers
 		{
 			return _storage.get_shard_id(username, res.user_set_id);
 		};
-		auto creatorShardID = _storage.get_shard_id(creator, res.user_set_id);
-		auto ownersShardsIDs = owners | std::views::transform(getShardID);
-		auto regMembersShardsIDs = regMembers | std::views::transform(getShardID);
-
-		// make private key shards for all members
-		res.reg_layer_priv_key_shard = Shamir::make_shard(regLayerPoly, creatorShardID);
-		res.owner_layer_priv_key_shard = Shamir::make_shard(ownerLayerPoly, creatorShardID);
-		auto regLayerOwnersShards = Shamir::make_shards(regLayerPoly, ownersShardsIDs);
-		auto ownerLayerOwnersShards = Shamir::make_shards(ownerLayerPoly, ownersShardsIDs);
-		auto regMembersShards = Shamir::make_shards(regLayerPoly, regMembersShardsIDs);
+		auto ownersShardsIDs = utils::to_vector<PrivKeyShardID>(allOwners | std::views::transform(getShardID));
+		auto regMembersShardsIDs = utils::to_vector<PrivKeyShardID>(regMembers | std::views::transform(getShardID));
+
+		// make private key shards for all members (owners, creator last, get shards of both layers in one pass)
+		const std::array<const Shamir::Poly*, 2> ownersPolys{ &regLayerPoly, &ownerLayerPoly };
+		const std::array<const Shamir::Poly*, 1> regMembersPolys{ &regLayerPoly };
+		auto ownersShards = Shamir::make_shards_batch(ownersPolys, ownersShardsIDs);
+		auto regMembersShards = std::move(Shamir::make_shards_batch(regMembersPolys, regMembersShardsIDs).front());
+		auto& regLayerOwnersShards = ownersShards[0];
+		auto& ownerLayerOwnersShards = ownersShards[1];
+		res.reg_layer_priv_key_shard = std::move(regLayerOwnersShards.back());
+		res.owner_layer_priv_key_shard = std::move(ownerLayerOwnersShards.back());
+		regLayerOwnersShards.pop_back();
+		ownerLayerOwnersShards.pop_back();
 
 		// for all non-creator members, register update for userset
 		// (note that the zip view provides all elements by reference wrapper)
@@ -112,7 +168,8 @@ namespace senc::server::handlers
 		// if both thresholds are zero, nothing to do, requires no members
 		if (0 == info.owners_threshold && 0 == info.reg_members_threshold)
 		{
-			// in this case, finish operation and return.
+			// in this case, finish operation (freeing its live slot) and return.
+			_decryptionsManager.finish_operation(opid);
 			finish_operation(opid, managers::DecryptionsManager::CollectedRecord(
 				_username, usersetID,
 				info.owners_threshold, info.reg_members_threshold
@@ -129,11 +186,13 @@ namespace senc::server::handlers
 			info.reg_members_threshold
 		);
 
-		// inform all relevant members of lookup
+		// inform all relevant members of lookup (in one batch)
 		auto members = utils::views::join(info.owners, info.reg_members) |
 			std::views::filter([this](const std::string& s) { return s != _username; });
+		std::vector<std::string> lookupUsernames;
 		for (const auto& member : members)
-			_updateManager.register_lookup(member, opid);
+			lookupUsernames.push_back(member);
+		_updateManager.register_lookup(lookupUsernames, opid);
 
 		return opid;
 	}
@@ -180,6 +239,25 @@ namespace senc::server::handlers
 		);
 	}
 
+	void ConnectedClientHandler::finish_pending(std::shared_ptr<metrics::ScopedTimer> timer,
+												const std::function<void()>& respond)
+	{
+		Status status = Status::Connected;
+		try { respond(); }
+		catch (const utils::SocketException&) { status = Status::Disconnected; } // client is gone
+		catch (const std::exception&) { } // request failed unanswered, connection is still usable
+		timer.reset(); // record latency before connection moves on
+
+		const OnDone onDone = _onDone; // copied, as connection may drop handler once resumed
+		onDone(status);
+	}
+
+	bool ConnectedClientHandler::client_sent_more() const
+	{
+		try { return _packetHandler.has_pending_data(); }
+		catch (const utils::SocketException&) { return true; } // next recv reports error
+	}
+
 	ConnectedClientHandler::Status ConnectedClientHandler::handle_request(pkt::LogoutRequest& request)
 	{
 		(void)request;
@@ -189,16 +267,34 @@ namespace senc::server::handlers
 
 	ConnectedClientHandler::Status ConnectedClientHandler::handle_request(pkt::MakeUserSetRequest& request)
 	{
-		pkt::MakeUserSetResponse response{};
+		// key generation and sharding are CPU-heavy, so they run on a worker, which also answers
 		try
 		{
-			response = make_userset(
-				_username,
-				request.owners, request.reg_members,
-				request.owners_threshold, request.reg_members_threshold
+			_workerPool.submit(
+				[this, request = std::move(request)]()
+				{
+					return make_userset(
+						_username,
+						request.owners, request.reg_members,
+						request.owners_threshold, request.reg_members_threshold
+					);
+				},
+				[this, timer = _requestTimer](std::future<pkt::MakeUserSetResponse> result) mutable
+				{
+					finish_pending(std::move(timer), [this, &result]()
+					{
+						try { _packetHandler.send_response(result.get()); }
+						catch (const ServerException& e)
+						{
+							_packetHandler.send_response(pkt::ErrorResponse{
+								std::string("Failed to create userset: ") + e.what()
+							});
+						}
+					});
+				}
 			);
 		}
-		catch (const ServerException& e)
+		catch (const workers::WorkerPoolFullException& e)
 		{
 			_packetHandler.send_response(pkt::ErrorResponse{
 				std::string("Failed to create userset: ") + e.what()
@@ -206,8 +302,7 @@ namespace senc::server::handlers
 			return Status::Connected;
 		}
 
-		_packetHandler.send_response(response);
-		return Status::Connected;
+		return Status::Pending;
 	}
 
 	ConnectedClientHandler::Status ConnectedClientHandler::handle_request(pkt::GetUserSetsRequest& request)
@@ -270,10 +365,38 @@ namespace senc::server::handlers
 
 	ConnectedClientHandler::Status ConnectedClientHandler::handle_request(pkt::UpdateRequest& request)
 	{
-		(void)request;
 		pkt::UpdateResponse response{};
 
-		try { response = _updateManager.retrieve_updates(_username); }
+		// hold request until updates arrive, up to the smaller of client's and server's limits
+		const auto wait = std::min(
+			std::chrono::milliseconds(request.max_wait_ms),
+			_maxUpdateWait
+		);
+
+		// park request instead of holding calling thread, unless it can be answered at once
+		// (updates are ready, or client won't wait, or already sent another request)
+		if (_parkUpdates)
+		{
+			response = _updateManager.retrieve_updates(_username);
+			if (wait.count() > 0 && response == pkt::UpdateResponse{} && !client_sent_more())
+			{
+				_parkedWait = wait;
+				_parkTimer = std::make_unique<metrics::ScopedTimer>(_requestMetrics.update_park());
+				return Status::Parked;
+			}
+			_packetHandler.send_response(response);
+			return Status::Connected;
+		}
+
+		// stop holding request once client sends another one (e.g. pipelined behind this long-poll)
+		const auto clientSentMore = [this]() { return client_sent_more(); };
+
+		try
+		{
+			const metrics::ScopedTimer parkTimer(_requestMetrics.update_park());
+			response = _updateManager.wait_updates(_username, wait, clientSentMore);
+			_parkedTime = parkTimer.elapsed();
+		}
 		catch (const ServerException& e)
 		{
 			_packetHandler.send_response(pkt::ErrorResponse{
@@ -12,8 +12,14 @@
 #include "../managers/DecryptionsManager.hpp"
 #include "../storage/IServerStorage.hpp"
 #include "../managers/UpdateManager.hpp"
+#include "../workers/WorkerPool.hpp"
+#include "../limits/RateLimiter.hpp"
+#include "../metrics/RequestMetrics.hpp"
+#include "../metrics/ScopedTimer.hpp"
 #include "../loggers/ILogger.hpp"
 #include "../ServerException.hpp"
+#include <functional>
+#include <memory>
 
 namespace senc::server::handlers
 {
@@ -26,37 +32,105 @@ namespace senc::server::handlers
 	public:
 		using Self = ConnectedClientHandler;
 
-		enum class Status { Connected, Disconnected };
+		/**
+		 * @enum senc::server::handlers::ConnectedClientHandler::Status
+		 * @brief Status of connection after an iteration.
+		 */
+		enum class Status
+		{
+			Connected,
+			Disconnected,
+			Pending, // request was handed to a worker, which answers it and reports status via `OnDone`
+			Parked	 // update request is held until updates arrive (see `park_update`)
+		};
+
+		/**
+		 * @typedef senc::server::handlers::ConnectedClientHandler::OnDone
+		 * @brief Function called (from a worker thread) once a pending request was answered,
+		 *		  with connection's status (never `Status::Pending`).
+		 */
+		using OnDone = std::function<void(Status)>;
 
 		/**
 		 * @brief Constructs a new handler for a connected client.
 		 * @param packetHandler Implementation of `PacketHandler`.
 		 * @param username Connected client's username.
 		 * @param schema Decryptions schema to use for decryptions.
+		 * @param keyPool Pool of ready key-pairs for userset creation (falling back to `schema`).
 		 * @param storage Implementation of `IServerStorage`.
 		 * @param updateManager Instance of `UpdateManager`.
 		 * @param decryptionsManager Instance of `DecryptionsManager`.
+		 * @param workerPool Worker pool running CPU-heavy requests (userset creation).
+		 * @param maxUpdateWait Maximum time an update request may be held until updates arrive.
+		 * @param parkUpdates Whether update requests are parked (see `Status::Parked`), rather than
+		 *					  held on calling thread.
+		 * @param rateLimiter Rate limiter buckets of client's connection.
+		 * @param requestMetrics Latency histograms to record requests into.
+		 * @param onDone Function called once a pending request was answered (see `Status::Pending`).
 		 * @note `storage` and `packetHandler` are assumed to be thread-safe.
 		 */
 		explicit ConnectedClientHandler(PacketHandler& packetHandler,
 										const std::string& username,
 										Schema& schema,
+										KeyPool& keyPool,
 										storage::IServerStorage& storage,
 										managers::UpdateManager& updateManager,
-										managers::DecryptionsManager& decryptionsManager);
+										managers::DecryptionsManager& decryptionsManager,
+										workers::WorkerPool& workerPool,
+										std::chrono::milliseconds maxUpdateWait,
+										bool parkUpdates,
+										limits::RateLimiter::Connection& rateLimiter,
+										metrics::RequestMetrics& requestMetrics,
+										OnDone onDone);
 
 		/**
 		 * @brief Runs a single iteration of the client loop.
+		 * @note Once `Status::Pending` is returned, no further iteration may run until `onDone` is
+		 *		 called (so that requests are answered in order). Once `Status::Parked` is returned,
+		 *		 no further iteration may run until parked request is answered via `answer_parked`.
 		 */
 		Status iteration();
 
+		/**
+		 * @brief Parks update request held by last iteration (see `Status::Parked`) in update manager,
+		 *		  until updates arrive, client sends another request, or request's wait passes.
+		 * @param wake Function called once request should be answered via `answer_parked`
+		 *			   (see `UpdateManager::park`).
+		 * @note Connection is not to be used by caller until `wake` is called.
+		 */
+		void park_update(managers::UpdateManager::Wake wake);
+
+		/**
+		 * @brief Answers update request parked via `park_update` (once woken), with updates registered meanwhile.
+		 * @return Connection status.
+		 * @throw senc::utils::SocketException If client disconnected.
+		 */
+		Status answer_parked();
+
 	private:
 		PacketHandler& _packetHandler;
 		const std::string& _username;
 		Schema& _schema;
+		KeyPool& _keyPool;
 		storage::IServerStorage& _storage;
 		managers::UpdateManager& _updateManager;
 		managers::DecryptionsManager& _decryptionsManager;
+		workers::WorkerPool& _workerPool;
+		std::chrono::milliseconds _maxUpdateWait;
+		bool _parkUpdates;
+		limits::RateLimiter::Connection& _rateLimiter;
+		metrics::RequestMetrics& _requestMetrics;
+		OnDone _onDone;
+
+		// latency timer of current request (shared with a worker while request is pending)
+		std::shared_ptr<metrics::ScopedTimer> _requestTimer;
+
+		// time current request was parked (excluded from its latency)
+		metrics::ScopedTimer::Clock::duration _parkedTime{};
+
+		// wait and park timer of update request held by last iteration (see `Status::Parked`)
+		std::chrono::milliseconds _parkedWait{};
+		std::unique_ptr<metrics::ScopedTimer> _parkTimer;
 
 		/**
 		 * @brief Creates a new userset.
@@ -99,6 +173,19 @@ namespace senc::server::handlers
 		void finish_operation(const OperationID& opid,
 							  managers::DecryptionsManager::CollectedRecord&& opCollRecord);
 
+		/**
+		 * @brief Answers a pending request (from worker thread), then reports connection status.
+		 * @param timer Latency timer of request (recorded once answered).
+		 * @param respond Function sending response.
+		 */
+		void finish_pending(std::shared_ptr<metrics::ScopedTimer> timer, const std::function<void()>& respond);
+
+		/**
+		 * @brief Checks if client sent another request (e.g. pipelined behind a long-poll), without blocking.
+		 * @return `true` if there is data to receive (or next recv reports an error), otherwise `false`.
+		 */
+		bool client_sent_more() const;
+
 		// NOTE: All handle_request methods accept non-const request for
 		//       efficiency (being able to move fields out of the requests)
 
@@ -8,11 +8,19 @@
 
 #include "ConnectingClientHandler.hpp"
 
+#include "../metrics/ScopedTimer.hpp"
+
 namespace senc::server::handlers
 {
 	ConnectingClientHandler::ConnectingClientHandler(PacketHandler& packetHandler,
-													 storage::IServerStorage& storage)
-		: _packetHandler(packetHandler), _storage(storage) { }
+													 storage::IServerStorage& storage,
+													 workers::WorkerPool& workerPool,
+													 limits::RateLimiter::Connection& rateLimiter,
+													 metrics::RequestMetrics& requestMetrics,
+													 OnDone onDone)
+		: _packetHandler(packetHandler), _storage(storage),
+		  _workerPool(workerPool), _rateLimiter(rateLimiter),
+		  _requestMetrics(requestMetrics), _onDone(std::move(onDone)) { }
 
 	std::tuple<ConnectingClientHandler::Status, std::string> ConnectingClientHandler::iteration()
 	{
@@ -22,53 +30,125 @@ namespace senc::server::handlers
 			pkt::LoginRequest,
 			pkt::LogoutRequest
 		>();
-		while (!connReq.has_value())
+		if (!connReq.has_value())
 		{
+			// a single request per iteration, so that event loops never wait on a next one
 			_packetHandler.send_response(pkt::ErrorResponse{ "Bad request" });
-			connReq = _packetHandler.recv_request<
-				pkt::SignupRequest,
-				pkt::LoginRequest,
-				pkt::LogoutRequest
-			>();
+			return { Status::Error, "" };
 		}
 
+		const auto code = std::visit(
+			[](const auto& req) { return std::remove_cvref_t<decltype(req)>::CODE; },
+			*connReq
+		);
+		_requestTimer = std::make_shared<metrics::ScopedTimer>(_requestMetrics.latency(code));
+
 		// call fitting client_loop implementation based on connection request
-		return std::visit(
+		auto res = std::visit(
 			[this](const auto& req) { return handle_request(req); },
 			*connReq
 		);
+		_requestTimer.reset(); // recorded here, unless a worker still holds it
+		return res;
+	}
+
+	void ConnectingClientHandler::finish_pending(std::shared_ptr<metrics::ScopedTimer> timer,
+												 const std::function<std::tuple<Status, std::string>()>& respond)
+	{
+		std::tuple<Status, std::string> res{ Status::Error, "" };
+		try { res = respond(); }
+		catch (const utils::SocketException&) { res = { Status::Disconnected, "" }; } // client is gone
+		catch (const std::exception&) { } // request failed unanswered, client may retry
+		timer.reset(); // record latency before connection moves on
+
+		const OnDone onDone = _onDone; // copied, as connection may drop handler once resumed
+		onDone(std::get<0>(res), std::move(std::get<1>(res)));
 	}
 
 	std::tuple<ConnectingClientHandler::Status, std::string>
 		ConnectingClientHandler::handle_request(const pkt::SignupRequest signup)
 	{
-		try { _storage.new_user(signup.username, signup.password); }
-		catch (const storage::UserExistsException&)
+		if (!_rateLimiter.try_acquire(limits::RequestClass::Expensive, signup.username))
 		{
-			_packetHandler.send_response(pkt::SignupResponse{ pkt::SignupResponse::Status::UsernameTaken });
+			_packetHandler.send_response(pkt::ErrorResponse{ limits::RateLimiter::REJECTED_MSG });
 			return { Status::Error, "" };
 		}
-		catch (const ServerException& e)
+
+		// password hashing is CPU-heavy, so it runs on a worker, which also answers
+		try
+		{
+			_workerPool.submit(
+				[this, signup]() { _storage.new_user(signup.username, signup.password); },
+				[this, signup, timer = _requestTimer](std::future<void> result) mutable
+				{
+					finish_pending(std::move(timer), [this, &signup, &result]() -> std::tuple<Status, std::string>
+					{
+						try { result.get(); }
+						catch (const storage::UserExistsException&)
+						{
+							_packetHandler.send_response(pkt::SignupResponse{
+								pkt::SignupResponse::Status::UsernameTaken
+							});
+							return { Status::Error, "" };
+						}
+						catch (const ServerException& e)
+						{
+							_packetHandler.send_response(pkt::ErrorResponse{ e.what() });
+							return { Status::Error, "" };
+						}
+
+						_packetHandler.send_response(pkt::SignupResponse{ pkt::SignupResponse::Status::Success });
+						return { Status::Connected, signup.username };
+					});
+				}
+			);
+		}
+		catch (const workers::WorkerPoolFullException& e)
 		{
 			_packetHandler.send_response(pkt::ErrorResponse{ e.what() });
 			return { Status::Error, "" };
 		}
 
-		_packetHandler.send_response(pkt::SignupResponse{ pkt::SignupResponse::Status::Success });
-		return { Status::Connected, signup.username };
+		return { Status::Pending, "" };
 	}
 
 	std::tuple<ConnectingClientHandler::Status, std::string>
 		ConnectingClientHandler::handle_request(const pkt::LoginRequest login)
 	{
-		if (!_storage.user_has_password(login.username, login.password))
+		if (!_rateLimiter.try_acquire(limits::RequestClass::Expensive, login.username))
+		{
+			_packetHandler.send_response(pkt::ErrorResponse{ limits::RateLimiter::REJECTED_MSG });
+			return { Status::Error, "" };
+		}
+
+		// password hashing is CPU-heavy, so it runs on a worker, which also answers
+		try
 		{
-			_packetHandler.send_response(pkt::LoginResponse{ pkt::LoginResponse::Status::BadLogin });
+			_workerPool.submit(
+				[this, login]() { return _storage.user_has_password(login.username, login.password); },
+				[this, login, timer = _requestTimer](std::future<bool> goodLogin) mutable
+				{
+					finish_pending(std::move(timer), [this, &login, &goodLogin]() -> std::tuple<Status, std::string>
+					{
+						if (!goodLogin.get())
+						{
+							_packetHandler.send_response(pkt::LoginResponse{ pkt::LoginResponse::Status::BadLogin });
+							return { Status::Error, "" };
+						}
+
+						_packetHandler.send_response(pkt::LoginResponse{ pkt::LoginResponse::Status::Success });
+						return { Status::Connected, login.username }; // handled, connected
+					});
+				}
+			);
+		}
+		catch (const workers::WorkerPoolFullException& e)
+		{
+			_packetHandler.send_response(pkt::ErrorResponse{ e.what() });
 			return { Status::Error, "" };
 		}
 
-		_packetHandler.send_response(pkt::LoginResponse{ pkt::LoginResponse::Status::Success });
-		return { Status::Connected, login.username }; // handled, connected
+		return { Status::Pending, "" };
 	}
 
 	std::tuple<ConnectingClientHandler::Status, std::string>
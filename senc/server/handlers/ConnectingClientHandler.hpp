@@ -10,8 +10,14 @@
 
 #include "../../common/PacketHandler.hpp"
 #include "../storage/IServerStorage.hpp"
+#include "../workers/WorkerPool.hpp"
+#include "../limits/RateLimiter.hpp"
+#include "../metrics/RequestMetrics.hpp"
 #include "../loggers/ILogger.hpp"
+#include "../metrics/ScopedTimer.hpp"
 #include "../ServerException.hpp"
+#include <functional>
+#include <memory>
 #include <tuple>
 
 namespace senc::server::handlers
@@ -25,26 +31,68 @@ namespace senc::server::handlers
 	public:
 		using Self = ConnectingClientHandler;
 
-		enum class Status { Error, Disconnected, Connected };
+		/**
+		 * @enum senc::server::handlers::ConnectingClientHandler::Status
+		 * @brief Status of connection after an iteration.
+		 */
+		enum class Status
+		{
+			Error,
+			Disconnected,
+			Connected,
+			Pending // request was handed to a worker, which answers it and reports status via `OnDone`
+		};
+
+		/**
+		 * @typedef senc::server::handlers::ConnectingClientHandler::OnDone
+		 * @brief Function called (from a worker thread) once a pending request was answered,
+		 *		  with connection's status (never `Status::Pending`) and username (if connected).
+		 */
+		using OnDone = std::function<void(Status, std::string)>;
 
 		/**
 		 * @brief Constructs a new handler for a connecting client.
 		 * @param packetHandler Implementation of `PacketHandler`.
 		 * @param storage Implementation of `IServerStorage`.
+		 * @param workerPool Worker pool running CPU-heavy requests (password hashing).
+		 * @param rateLimiter Rate limiter buckets of client's connection.
+		 * @param requestMetrics Latency histograms to record requests into.
+		 * @param onDone Function called once a pending request was answered (see `Status::Pending`).
 		 * @note `storage` and `packetHandler` are assumed to be thread-safe.
 		 */
 		explicit ConnectingClientHandler(PacketHandler& packetHandler,
-										 storage::IServerStorage& storage);
+										 storage::IServerStorage& storage,
+										 workers::WorkerPool& workerPool,
+										 limits::RateLimiter::Connection& rateLimiter,
+										 metrics::RequestMetrics& requestMetrics,
+										 OnDone onDone);
 
 		/**
 		 * @brief Runs a single iteration of client conenction loop.
 		 * @return Status, and username (if succeeded).
+		 * @note Once `Status::Pending` is returned, no further iteration may run until `onDone` is
+		 *		 called (so that requests are answered in order).
 		 */
 		std::tuple<Status, std::string> iteration();
 
 	private:
 		PacketHandler& _packetHandler;
 		storage::IServerStorage& _storage;
+		workers::WorkerPool& _workerPool;
+		limits::RateLimiter::Connection& _rateLimiter;
+		metrics::RequestMetrics& _requestMetrics;
+		OnDone _onDone;
+
+		// latency timer of current request (shared with a worker while request is pending)
+		std::shared_ptr<metrics::ScopedTimer> _requestTimer;
+
+		/**
+		 * @brief Answers a pending request (from worker thread), then reports connection status.
+		 * @param timer Latency timer of request (recorded once answered).
+		 * @param respond Function sending response, returning status and username (if connected).
+		 */
+		void finish_pending(std::shared_ptr<metrics::ScopedTimer> timer,
+							const std::function<std::tuple<Status, std::string>()>& respond);
 
 		/**
 		 * @brief Handles signup request.
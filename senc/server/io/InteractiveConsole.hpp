@@ -34,9 +34,8 @@ namespace senc::server::io
 
 		/**
 		 * @brief Constructs interactive console.
-		 * @param handleInput A function used to handle user input, returning `true` if should stop.
 		 */
-		InteractiveConsole(std::function<bool(Self&, const std::string&)> handleInput);
+		InteractiveConsole();
 
 		/**
 		 * @brief Destructor of InteractiveConsole, ensures console is stopped.
@@ -44,9 +43,11 @@ namespace senc::server::io
 		~InteractiveConsole();
 
 		/**
-		 * @brief Starts interactive console.
+		 * @brief Starts interactive console (and waits for it to stop).
+		 * @param handleInput A function used to handle user input, returning `true` if should stop
+		 *                    (only called on this thread, and only until this call returns).
 		 */
-		void start_inputs();
+		void start_inputs(std::function<bool(Self&, const std::string&)> handleInput);
 
 		/**
 		 * @brief Prints message to interactive console.
@@ -18,9 +18,8 @@
 
 namespace senc::server::io
 {
-	InteractiveConsole::InteractiveConsole(std::function<bool(Self&, const std::string&)> handleInput)
-		: _handleInput(handleInput),
-		 _running(false),
+	InteractiveConsole::InteractiveConsole()
+		: _running(false),
 		 _handlingInput(false),
 		 _stdin_fd(STDIN_FILENO),
 		 _stdout_fd(STDOUT_FILENO)
@@ -38,11 +37,13 @@ namespace senc::server::io
 		stop_inputs();
 	}
 
-	void InteractiveConsole::start_inputs()
+	void InteractiveConsole::start_inputs(std::function<bool(Self&, const std::string&)> handleInput)
 	{
 		if (_running.exchange(true))
 			return; // already running
 
+		_handleInput = std::move(handleInput);
+
 		// set terminal to raw mode
 		struct termios raw = _original_termios;
 		raw.c_lflag &= ~(ICANON | ECHO); // disable canonical mode and echo
@@ -57,6 +58,7 @@ namespace senc::server::io
 
 		// run input loop on this thread
 		input_loop();
+		_handleInput = nullptr; // handler may refer to caller's locals
 
 		// restore terminal settings when done
 		tcsetattr(_stdin_fd, TCSAFLUSH, &_original_termios);
@@ -14,9 +14,8 @@
 
 namespace senc::server::io
 {
-	InteractiveConsole::InteractiveConsole(std::function<bool(Self&, const std::string&)> handleInput)
-		: _handleInput(handleInput),
-		  _running(false), _handlingInput(false),
+	InteractiveConsole::InteractiveConsole()
+		: _running(false), _handlingInput(false),
 		  _hStdin(GetStdHandle(STD_INPUT_HANDLE)),
 		  _hStdout(GetStdHandle(STD_OUTPUT_HANDLE))
 	{
@@ -29,11 +28,13 @@ namespace senc::server::io
 		stop_inputs();
 	}
 
-	void InteractiveConsole::start_inputs()
+	void InteractiveConsole::start_inputs(std::function<bool(Self&, const std::string&)> handleInput)
 	{
 		if (_running.exchange(true))
 			return; // already running
 
+		_handleInput = std::move(handleInput);
+
 		DWORD oldMode = 0;
 
 		// save original console mode and set to raw input mode
@@ -45,6 +46,7 @@ namespace senc::server::io
 
 		// run input loop on this thread
 		input_loop();
+		_handleInput = nullptr; // handler may refer to caller's locals
 
 		// restore console mode when done
 		SetConsoleMode(_hStdin, oldMode);
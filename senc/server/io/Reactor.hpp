@@ -0,0 +1,124 @@
+/*********************************************************************
+ * \file   Reactor.hpp
+ * \brief  Header of Reactor class.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include "../../utils/Socket.hpp"
+#include <functional>
+#include <cstdint>
+#include <optional>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+namespace senc::server::io
+{
+	/**
+	 * @class senc::server::io::Reactor
+	 * @brief Dispatches socket readability events over a fixed number of event-loop threads.
+	 * @note Registrations are one-shot: after a key is dispatched, its socket is not polled
+	 *		 again until it is re-armed (so a key is never handled by two threads at once).
+	 * @note Only supported on Linux (epoll based); constructor throws elsewhere.
+	 */
+	class Reactor
+	{
+	public:
+		using Self = Reactor;
+		using Handle = utils::Socket::NativeHandle;
+		using Key = std::uint64_t;
+
+		/**
+		 * @brief Constructs a new reactor.
+		 * @param threadCount Amount of event-loop threads to run.
+		 * @param onReadable Function called (from an event-loop thread) with a registered key
+		 *					 whenever its socket becomes readable (or hangs up).
+		 * @throw senc::server::ServerException On failure.
+		 */
+		Reactor(std::size_t threadCount, std::function<void(Key)> onReadable);
+
+		Reactor(const Self&) = delete;
+
+		Self& operator=(const Self&) = delete;
+
+		/**
+		 * @brief Destructor of reactor, stops event loops if running.
+		 */
+		~Reactor();
+
+		/**
+		 * @brief Starts event-loop threads.
+		 */
+		void start();
+
+		/**
+		 * @brief Stops event-loop threads and waits for them to finish.
+		 * @note Callbacks currently running are waited for, so sockets they block on
+		 *		 should be closed beforehand.
+		 */
+		void stop();
+
+		/**
+		 * @brief Registers socket handle for a one-shot readability event.
+		 * @param handle Socket handle.
+		 * @param key Key passed to callback when socket becomes readable.
+		 * @throw senc::server::ServerException On failure.
+		 */
+		void add(Handle handle, Key key);
+
+		/**
+		 * @brief Re-arms (previously added and dispatched) socket handle for another event.
+		 * @param handle Socket handle.
+		 * @param key Key passed to callback when socket becomes readable.
+		 * @throw senc::server::ServerException On failure.
+		 */
+		void rearm(Handle handle, Key key);
+
+		/**
+		 * @brief Unregisters socket handle.
+		 * @param handle Socket handle.
+		 */
+		void remove(Handle handle);
+
+		/**
+		 * @brief Dispatches a key to an event-loop thread as if its socket became readable
+		 *		  (e.g. to resume a connection once work it waited for is done).
+		 * @param key Key passed to callback (its socket should not be armed meanwhile).
+		 * @note Thread-safe, may be called from any thread.
+		 */
+		void post(Key key);
+
+	private:
+		std::size_t _threadCount;
+		std::function<void(Key)> _onReadable;
+		std::atomic<bool> _isRunning;
+		std::vector<std::jthread> _loops;
+
+		// keys posted for dispatch (uses mtxPosted)
+		std::deque<Key> _posted;
+		std::mutex _mtxPosted;
+
+#ifndef SENC_WINDOWS
+		int _epfd;
+		int _wakefd; // eventfd used to wake up event loops on stop
+		int _postfd; // eventfd signaled while keys are posted
+#endif
+
+		/**
+		 * @brief Runs a single event loop, until reactor is stopped.
+		 */
+		void loop();
+
+		/**
+		 * @brief Takes next posted key (called by the event loop which got post event).
+		 * @return Posted key, or `std::nullopt` if none are left.
+		 */
+		std::optional<Key> take_posted();
+	};
+}
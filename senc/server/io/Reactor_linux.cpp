@@ -0,0 +1,202 @@
+/*********************************************************************
+ * \file   Reactor_linux.cpp
+ * \brief  Implementation of Reactor class for Linux (epoll based).
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "Reactor.hpp"
+
+#ifndef SENC_WINDOWS
+
+#include "../ServerException.hpp"
+
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <limits>
+
+namespace senc::server::io
+{
+	// key reserved for the wake-up eventfd
+	static constexpr Reactor::Key WAKE_KEY = std::numeric_limits<Reactor::Key>::max();
+
+	// key reserved for the post eventfd
+	static constexpr Reactor::Key POST_KEY = WAKE_KEY - 1;
+
+	// events taken per `epoll_wait` call; kept at one so a slow callback
+	// never delays events that another (idle) loop could have handled
+	static constexpr int EVENTS_PER_WAIT = 1;
+
+	// events connections are registered for
+	static constexpr std::uint32_t CONN_EVENTS = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+
+	// events post eventfd is registered for (one-shot, so that a single loop takes each post)
+	static constexpr std::uint32_t POST_EVENTS = EPOLLIN | EPOLLONESHOT;
+
+	Reactor::Reactor(std::size_t threadCount, std::function<void(Key)> onReadable)
+		: _threadCount(threadCount), _onReadable(onReadable), _isRunning(false),
+		  _epfd(-1), _wakefd(-1), _postfd(-1)
+	{
+		if (0 == _threadCount)
+			throw ServerException("Failed to create reactor", "Thread count must be positive");
+
+		_epfd = epoll_create1(EPOLL_CLOEXEC);
+		if (_epfd < 0)
+			throw ServerException("Failed to create reactor", utils::SocketUtils::get_last_sock_err());
+
+		_wakefd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+		if (_wakefd < 0)
+		{
+			const auto err = utils::SocketUtils::get_last_sock_err();
+			::close(_epfd);
+			throw ServerException("Failed to create reactor", err);
+		}
+
+		// wake fd is level-triggered and never read, so once written it wakes every loop
+		epoll_event ev{};
+		ev.events = EPOLLIN;
+		ev.data.u64 = WAKE_KEY;
+		if (epoll_ctl(_epfd, EPOLL_CTL_ADD, _wakefd, &ev) < 0)
+		{
+			const auto err = utils::SocketUtils::get_last_sock_err();
+			::close(_wakefd);
+			::close(_epfd);
+			throw ServerException("Failed to create reactor", err);
+		}
+
+		_postfd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+		ev.events = POST_EVENTS;
+		ev.data.u64 = POST_KEY;
+		if (_postfd < 0 || epoll_ctl(_epfd, EPOLL_CTL_ADD, _postfd, &ev) < 0)
+		{
+			const auto err = utils::SocketUtils::get_last_sock_err();
+			if (_postfd >= 0)
+				::close(_postfd);
+			::close(_wakefd);
+			::close(_epfd);
+			throw ServerException("Failed to create reactor", err);
+		}
+	}
+
+	Reactor::~Reactor()
+	{
+		stop();
+		::close(_postfd);
+		::close(_wakefd);
+		::close(_epfd);
+	}
+
+	void Reactor::start()
+	{
+		if (_isRunning.exchange(true))
+			return;
+
+		_loops.reserve(_threadCount);
+		for (std::size_t i = 0; i < _threadCount; ++i)
+			_loops.emplace_back(&Self::loop, this);
+	}
+
+	void Reactor::stop()
+	{
+		if (!_isRunning.exchange(false))
+			return;
+
+		const std::uint64_t one = 1;
+		(void)!::write(_wakefd, &one, sizeof(one));
+
+		_loops.clear(); // joins event loops
+	}
+
+	void Reactor::add(Handle handle, Key key)
+	{
+		epoll_event ev{};
+		ev.events = CONN_EVENTS;
+		ev.data.u64 = key;
+		if (epoll_ctl(_epfd, EPOLL_CTL_ADD, handle, &ev) < 0)
+			throw ServerException("Failed to register socket", utils::SocketUtils::get_last_sock_err());
+	}
+
+	void Reactor::rearm(Handle handle, Key key)
+	{
+		epoll_event ev{};
+		ev.events = CONN_EVENTS;
+		ev.data.u64 = key;
+		if (epoll_ctl(_epfd, EPOLL_CTL_MOD, handle, &ev) < 0)
+			throw ServerException("Failed to re-arm socket", utils::SocketUtils::get_last_sock_err());
+	}
+
+	void Reactor::remove(Handle handle)
+	{
+		// failure is ignored - socket might have already been closed (and thus removed)
+		epoll_ctl(_epfd, EPOLL_CTL_DEL, handle, nullptr);
+	}
+
+	void Reactor::post(Key key)
+	{
+		{
+			const std::lock_guard<std::mutex> lock(_mtxPosted);
+			_posted.push_back(key);
+		}
+		const std::uint64_t one = 1;
+		(void)!::write(_postfd, &one, sizeof(one));
+	}
+
+	void Reactor::loop()
+	{
+		epoll_event events[EVENTS_PER_WAIT]{};
+		while (_isRunning)
+		{
+			const int count = epoll_wait(_epfd, events, EVENTS_PER_WAIT, -1);
+			if (count < 0)
+			{
+				if (EINTR == errno)
+					continue;
+				return;
+			}
+
+			for (int i = 0; i < count && _isRunning; ++i)
+			{
+				const Key key = events[i].data.u64;
+				if (POST_KEY == key)
+				{
+					if (const auto posted = take_posted())
+						_onReadable(*posted);
+				}
+				else if (WAKE_KEY != key)
+					_onReadable(key);
+			}
+		}
+	}
+
+	std::optional<Reactor::Key> Reactor::take_posted()
+	{
+		std::optional<Key> res;
+		{
+			const std::lock_guard<std::mutex> lock(_mtxPosted);
+			if (!_posted.empty())
+			{
+				res = _posted.front();
+				_posted.pop_front();
+			}
+
+			// once drained, reset eventfd (under lock, so that no post is missed)
+			if (_posted.empty())
+			{
+				std::uint64_t count = 0;
+				(void)!::read(_postfd, &count, sizeof(count));
+			}
+		}
+
+		// re-arm before dispatching, so that another loop takes remaining posts meanwhile
+		epoll_event ev{};
+		ev.events = POST_EVENTS;
+		ev.data.u64 = POST_KEY;
+		epoll_ctl(_epfd, EPOLL_CTL_MOD, _postfd, &ev);
+
+		return res;
+	}
+}
+
+#endif
@@ -0,0 +1,42 @@
+/*********************************************************************
+ * \file   Reactor_windows.cpp
+ * \brief  Implementation of Reactor class for windows (unsupported).
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "Reactor.hpp"
+
+#ifdef SENC_WINDOWS
+
+#include "../ServerException.hpp"
+
+namespace senc::server::io
+{
+	Reactor::Reactor(std::size_t threadCount, std::function<void(Key)> onReadable)
+		: _threadCount(threadCount), _onReadable(onReadable), _isRunning(false)
+	{
+		throw ServerException("Failed to create reactor", "Reactor mode is only supported on Linux");
+	}
+
+	Reactor::~Reactor() { }
+
+	void Reactor::start() { }
+
+	void Reactor::stop() { }
+
+	void Reactor::add(Handle, Key) { }
+
+	void Reactor::rearm(Handle, Key) { }
+
+	void Reactor::remove(Handle) { }
+
+	void Reactor::post(Key) { }
+
+	void Reactor::loop() { }
+
+	std::optional<Reactor::Key> Reactor::take_posted() { return std::nullopt; }
+}
+
+#endif
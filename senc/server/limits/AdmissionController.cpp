@@ -0,0 +1,79 @@
+/*********************************************************************
+ * \file   AdmissionController.cpp
+ * \brief  Implementation of AdmissionController class.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "AdmissionController.hpp"
+
+#include <utility>
+
+namespace senc::server::limits
+{
+	AdmissionController::Ticket::Ticket(Self&& other) noexcept
+		: _count(std::exchange(other._count, nullptr)) { }
+
+	AdmissionController::Ticket::Self& AdmissionController::Ticket::operator=(Self&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			_count = std::exchange(other._count, nullptr);
+		}
+		return *this;
+	}
+
+	AdmissionController::Ticket::~Ticket()
+	{
+		release();
+	}
+
+	void AdmissionController::Ticket::release()
+	{
+		if (_count)
+			--*std::exchange(_count, nullptr);
+	}
+
+	AdmissionController::Ticket::Ticket(std::atomic<std::size_t>& count)
+		: _count(&count) { }
+
+	AdmissionController::AdmissionController(std::size_t maxConnections, std::size_t maxHandshakes)
+		: _maxConnections(maxConnections), _maxHandshakes(maxHandshakes) { }
+
+	std::optional<AdmissionController::Ticket> AdmissionController::try_admit_connection()
+	{
+		return try_take(_connections, _maxConnections, _rejectedConnections);
+	}
+
+	std::optional<AdmissionController::Ticket> AdmissionController::try_begin_handshake()
+	{
+		return try_take(_handshakes, _maxHandshakes, _rejectedHandshakes);
+	}
+
+	AdmissionController::Stats AdmissionController::stats() const
+	{
+		return Stats{
+			.connections = _connections,
+			.max_connections = _maxConnections,
+			.handshakes = _handshakes,
+			.max_handshakes = _maxHandshakes,
+			.rejected_connections = _rejectedConnections,
+			.rejected_handshakes = _rejectedHandshakes
+		};
+	}
+
+	std::optional<AdmissionController::Ticket> AdmissionController::try_take(std::atomic<std::size_t>& count,
+																			  std::size_t max,
+																			  std::atomic<std::uint64_t>& rejected)
+	{
+		if (count.fetch_add(1) >= max && max > 0)
+		{
+			--count;
+			++rejected;
+			return std::nullopt;
+		}
+		return Ticket(count);
+	}
+}
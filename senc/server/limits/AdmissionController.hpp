@@ -0,0 +1,120 @@
+/*********************************************************************
+ * \file   AdmissionController.hpp
+ * \brief  Header of AdmissionController class.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include <optional>
+#include <cstdint>
+#include <atomic>
+
+namespace senc::server::limits
+{
+	/**
+	 * @class senc::server::limits::AdmissionController
+	 * @brief Caps amounts of open connections and of connections still establishing (handshakes).
+	 */
+	class AdmissionController
+	{
+	public:
+		using Self = AdmissionController;
+
+		/**
+		 * @class senc::server::limits::AdmissionController::Ticket
+		 * @brief Holds an admitted slot, releasing it on destruction.
+		 */
+		class Ticket
+		{
+		public:
+			using Self = Ticket;
+
+			Ticket(Self&& other) noexcept;
+
+			Self& operator=(Self&& other) noexcept;
+
+			/**
+			 * @brief Destructor of ticket, releases slot.
+			 */
+			~Ticket();
+
+			/**
+			 * @brief Releases slot (before destruction).
+			 */
+			void release();
+
+		private:
+			friend class AdmissionController;
+
+			std::atomic<std::size_t>* _count;
+
+			/**
+			 * @brief Constructs a ticket holding a slot.
+			 * @param count Counter the slot was taken from.
+			 */
+			explicit Ticket(std::atomic<std::size_t>& count);
+		};
+
+		/**
+		 * @struct senc::server::limits::AdmissionController::Stats
+		 * @brief Snapshot of admission counters.
+		 */
+		struct Stats
+		{
+			std::size_t connections;			  // currently open connections
+			std::size_t max_connections;		  // zero for unlimited
+			std::size_t handshakes;				  // connections currently establishing
+			std::size_t max_handshakes;			  // zero for unlimited
+			std::uint64_t rejected_connections;   // rejected since construction
+			std::uint64_t rejected_handshakes;	  // rejected since construction
+		};
+
+		/**
+		 * @brief Constructs an admission controller.
+		 * @param maxConnections Maximum amount of open connections (zero for unlimited).
+		 * @param maxHandshakes Maximum amount of connections establishing at once (zero for unlimited).
+		 */
+		explicit AdmissionController(std::size_t maxConnections, std::size_t maxHandshakes);
+
+		/**
+		 * @brief Admits a new connection, if below limit.
+		 * @return Ticket held for connection's lifetime, or `std::nullopt` if rejected.
+		 */
+		std::optional<Ticket> try_admit_connection();
+
+		/**
+		 * @brief Admits a new handshake, if below limit.
+		 * @return Ticket held until connection is established, or `std::nullopt` if rejected.
+		 */
+		std::optional<Ticket> try_begin_handshake();
+
+		/**
+		 * @brief Gets a snapshot of admission counters.
+		 */
+		Stats stats() const;
+
+	private:
+		const std::size_t _maxConnections;
+		const std::size_t _maxHandshakes;
+
+		std::atomic<std::size_t> _connections = 0;
+		std::atomic<std::size_t> _handshakes = 0;
+
+		std::atomic<std::uint64_t> _rejectedConnections = 0;
+		std::atomic<std::uint64_t> _rejectedHandshakes = 0;
+
+		/**
+		 * @brief Takes a slot from a counter, if below limit.
+		 * @param count Counter to take slot from.
+		 * @param max Limit of counter (zero for unlimited).
+		 * @param rejected Counter of rejections to increase if rejected.
+		 * @return Ticket holding slot, or `std::nullopt` if rejected.
+		 */
+		static std::optional<Ticket> try_take(std::atomic<std::size_t>& count,
+											  std::size_t max,
+											  std::atomic<std::uint64_t>& rejected);
+	};
+}
@@ -0,0 +1,99 @@
+/*********************************************************************
+ * \file   RateLimiter.cpp
+ * \brief  Implementation of RateLimiter class.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "RateLimiter.hpp"
+
+#include <algorithm>
+
+namespace senc::server::limits
+{
+	bool RateLimiter::Connection::try_acquire(RequestClass cls, const std::string& username)
+	{
+		auto& bucket = (RequestClass::Cheap == cls) ? _cheap : _expensive;
+		if (!bucket.try_take())
+		{
+			_limiter.count_rejected(cls);
+			return false;
+		}
+		return _limiter.try_acquire_user(cls, username);
+	}
+
+	RateLimiter::Connection::Connection(RateLimiter& limiter)
+		: _limiter(limiter),
+		  _cheap(limiter._limits.cheapPerConnection),
+		  _expensive(limiter._limits.expensivePerConnection) { }
+
+	RateLimiter::RateLimiter(const RateLimits& limits)
+		: _limits(limits) { }
+
+	RateLimiter::Connection RateLimiter::new_connection()
+	{
+		return Connection(*this);
+	}
+
+	RateLimiter::Stats RateLimiter::stats()
+	{
+		Stats res{
+			.rejected_cheap = _rejectedCheap,
+			.rejected_expensive = _rejectedExpensive,
+			.tracked_users = 0
+		};
+		for (auto& stripe : _stripes)
+		{
+			const std::lock_guard<std::mutex> lock(stripe.mtx);
+			res.tracked_users += stripe.users.size();
+		}
+		return res;
+	}
+
+	bool RateLimiter::try_acquire_user(RequestClass cls, const std::string& username)
+	{
+		auto& stripe = stripe_of(username);
+		const std::lock_guard<std::mutex> lock(stripe.mtx);
+		const auto now = TokenBucket::Clock::now();
+
+		// drop idle buckets, so that made up usernames don't accumulate
+		// (if most are active, next pruning is postponed, to not scan all on each request)
+		if (stripe.users.size() >= stripe.pruneAt)
+		{
+			std::erase_if(stripe.users, [now](const auto& p)
+			{
+				return p.second.cheap.is_full(now) && p.second.expensive.is_full(now);
+			});
+			stripe.pruneAt = std::max(USERS_PRUNE_THRESHOLD / STRIPE_COUNT, 2 * stripe.users.size());
+		}
+
+		auto it = stripe.users.find(username);
+		if (it == stripe.users.end())
+			it = stripe.users.emplace(username, UserBuckets{
+				TokenBucket(_limits.cheapPerUser),
+				TokenBucket(_limits.expensivePerUser)
+			}).first;
+
+		auto& bucket = (RequestClass::Cheap == cls) ? it->second.cheap : it->second.expensive;
+		if (!bucket.try_take(now))
+		{
+			count_rejected(cls);
+			return false;
+		}
+		return true;
+	}
+
+	RateLimiter::Stripe& RateLimiter::stripe_of(const std::string& username)
+	{
+		return _stripes[std::hash<std::string>{}(username) % STRIPE_COUNT];
+	}
+
+	void RateLimiter::count_rejected(RequestClass cls)
+	{
+		if (RequestClass::Cheap == cls)
+			++_rejectedCheap;
+		else
+			++_rejectedExpensive;
+	}
+}
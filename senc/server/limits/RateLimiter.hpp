@@ -0,0 +1,178 @@
+/*********************************************************************
+ * \file   RateLimiter.hpp
+ * \brief  Header of RateLimiter class.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include "../../utils/hash.hpp"
+#include "TokenBucket.hpp"
+#include <cstdint>
+#include <atomic>
+#include <array>
+#include <string>
+#include <mutex>
+
+namespace senc::server::limits
+{
+	/**
+	 * @enum senc::server::limits::RequestClass
+	 * @brief Cost class of a request, each limited by its own buckets.
+	 */
+	enum class RequestClass
+	{
+		Cheap,	  // e.g. update
+		Expensive // e.g. signup, login, userset creation (password hashing, key generation)
+	};
+
+	/**
+	 * @struct senc::server::limits::RateLimits
+	 * @brief Bucket parameters of each request class.
+	 */
+	struct RateLimits
+	{
+		RateLimit cheapPerConnection{ 200, 400 };
+		RateLimit expensivePerConnection{ 5, 10 };
+		RateLimit cheapPerUser{ 400, 800 };
+		RateLimit expensivePerUser{ 5, 10 };
+	};
+
+	/**
+	 * @class senc::server::limits::RateLimiter
+	 * @brief Limits request rates per connection and per username, using token buckets.
+	 * @note Username buckets are striped over `STRIPE_COUNT` independently locked stripes (by
+	 *		 username hash), so that requests of different users rarely contend.
+	 */
+	class RateLimiter
+	{
+	public:
+		using Self = RateLimiter;
+
+		static constexpr std::size_t STRIPE_COUNT = 16;
+
+		// amount of tracked usernames above which idle (full) buckets are dropped
+		// (each stripe drops its own, once holding its share of this amount)
+		static constexpr std::size_t USERS_PRUNE_THRESHOLD = 4096;
+
+		// message of error response sent for rejected requests
+		static constexpr const char* REJECTED_MSG = "Too many requests, try again later";
+
+		/**
+		 * @struct senc::server::limits::RateLimiter::Stats
+		 * @brief Snapshot of rate limiter counters.
+		 */
+		struct Stats
+		{
+			std::uint64_t rejected_cheap;	  // cheap requests rejected since construction
+			std::uint64_t rejected_expensive; // expensive requests rejected since construction
+			std::size_t tracked_users;		  // usernames currently holding buckets
+		};
+
+		/**
+		 * @class senc::server::limits::RateLimiter::Connection
+		 * @brief Buckets of a single connection (not thread-safe, used by connection's handler).
+		 */
+		class Connection
+		{
+		public:
+			using Self = Connection;
+
+			/**
+			 * @brief Takes a token for a request, from both connection's and username's buckets.
+			 * @param cls Cost class of request.
+			 * @param username Username request is made for (connected or claimed by request).
+			 * @return `true` if request is allowed, `false` if it should be rejected.
+			 */
+			bool try_acquire(RequestClass cls, const std::string& username);
+
+		private:
+			friend class RateLimiter;
+
+			RateLimiter& _limiter;
+			TokenBucket _cheap;
+			TokenBucket _expensive;
+
+			/**
+			 * @brief Constructs connection buckets.
+			 * @param limiter Rate limiter holding per-username buckets.
+			 */
+			explicit Connection(RateLimiter& limiter);
+		};
+
+		/**
+		 * @brief Constructs a rate limiter.
+		 * @param limits Bucket parameters of each request class.
+		 */
+		explicit RateLimiter(const RateLimits& limits = {});
+
+		RateLimiter(const Self&) = delete;
+
+		Self& operator=(const Self&) = delete;
+
+		/**
+		 * @brief Creates buckets for a new connection.
+		 * @return Connection buckets.
+		 */
+		Connection new_connection();
+
+		/**
+		 * @brief Gets a snapshot of rate limiter counters.
+		 */
+		Stats stats();
+
+	private:
+		/**
+		 * @struct senc::server::limits::RateLimiter::UserBuckets
+		 * @brief Buckets of a single username.
+		 */
+		struct UserBuckets
+		{
+			TokenBucket cheap;
+			TokenBucket expensive;
+		};
+
+		/**
+		 * @struct senc::server::limits::RateLimiter::Stripe
+		 * @brief Buckets of usernames hashed to the same stripe.
+		 */
+		struct alignas(64) Stripe // aligned to avoid false sharing between stripes' mutexes
+		{
+			// maps username to its buckets
+			utils::HashMap<std::string, UserBuckets> users;
+			std::size_t pruneAt = USERS_PRUNE_THRESHOLD / STRIPE_COUNT;
+
+			std::mutex mtx;
+		};
+
+		RateLimits _limits;
+
+		std::array<Stripe, STRIPE_COUNT> _stripes;
+
+		std::atomic<std::uint64_t> _rejectedCheap = 0;
+		std::atomic<std::uint64_t> _rejectedExpensive = 0;
+
+		/**
+		 * @brief Takes a token for a request from username's buckets.
+		 * @param cls Cost class of request.
+		 * @param username Username request is made for.
+		 * @return `true` if request is allowed, `false` if it should be rejected.
+		 */
+		bool try_acquire_user(RequestClass cls, const std::string& username);
+
+		/**
+		 * @brief Gets stripe holding a username's buckets.
+		 * @param username Username.
+		 * @return Username's stripe.
+		 */
+		Stripe& stripe_of(const std::string& username);
+
+		/**
+		 * @brief Counts a rejected request.
+		 * @param cls Cost class of request.
+		 */
+		void count_rejected(RequestClass cls);
+	};
+}
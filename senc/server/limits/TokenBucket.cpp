@@ -0,0 +1,42 @@
+/*********************************************************************
+ * \file   TokenBucket.cpp
+ * \brief  Implementation of TokenBucket class.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "TokenBucket.hpp"
+
+#include <algorithm>
+
+namespace senc::server::limits
+{
+	TokenBucket::TokenBucket(const RateLimit& limit)
+		: _limit(limit), _tokens(limit.burst), _lastRefill(Clock::now()) { }
+
+	bool TokenBucket::try_take(Clock::time_point now)
+	{
+		if (0 == _limit.rate)
+			return true; // unlimited
+
+		_tokens = tokens_at(now);
+		_lastRefill = now;
+		if (_tokens < 1)
+			return false;
+		--_tokens;
+		return true;
+	}
+
+	bool TokenBucket::is_full(Clock::time_point now) const
+	{
+		return 0 == _limit.rate || tokens_at(now) >= _limit.burst;
+	}
+
+	double TokenBucket::tokens_at(Clock::time_point now) const
+	{
+		// time may seem to go back if `now` was taken before last refill by caller
+		const std::chrono::duration<double> elapsed = std::max(now - _lastRefill, Clock::duration::zero());
+		return std::min(_limit.burst, _tokens + elapsed.count() * _limit.rate);
+	}
+}
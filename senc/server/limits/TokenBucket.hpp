@@ -0,0 +1,67 @@
+/*********************************************************************
+ * \file   TokenBucket.hpp
+ * \brief  Header of TokenBucket class.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include <chrono>
+
+namespace senc::server::limits
+{
+	/**
+	 * @struct senc::server::limits::RateLimit
+	 * @brief Parameters of a token bucket.
+	 */
+	struct RateLimit
+	{
+		double rate;  // tokens refilled per second (zero for unlimited)
+		double burst; // bucket capacity (maximum amount of requests in a burst)
+	};
+
+	/**
+	 * @class senc::server::limits::TokenBucket
+	 * @brief Token bucket rate limiter (not thread-safe).
+	 */
+	class TokenBucket
+	{
+	public:
+		using Self = TokenBucket;
+		using Clock = std::chrono::steady_clock;
+
+		/**
+		 * @brief Constructs a full token bucket.
+		 * @param limit Refill rate and capacity of bucket.
+		 */
+		explicit TokenBucket(const RateLimit& limit);
+
+		/**
+		 * @brief Takes a single token from bucket, if available.
+		 * @param now Current time.
+		 * @return `true` if token was taken (request allowed), otherwise `false`.
+		 */
+		bool try_take(Clock::time_point now = Clock::now());
+
+		/**
+		 * @brief Checks if bucket has refilled completely (so it can be dropped without effect).
+		 * @param now Current time.
+		 * @return `true` if bucket is full, otherwise `false`.
+		 */
+		bool is_full(Clock::time_point now = Clock::now()) const;
+
+	private:
+		RateLimit _limit;
+		double _tokens;
+		Clock::time_point _lastRefill;
+
+		/**
+		 * @brief Computes amount of tokens in bucket at a given time.
+		 * @param now Current time.
+		 * @return Amount of tokens.
+		 */
+		double tokens_at(Clock::time_point now) const;
+	};
+}
@@ -13,22 +13,34 @@ namespace senc::server
 
 	constexpr auto STORAGE_PATH = "storage.sqlite";
 
-	std::tuple<bool, Port> parse_args(int argc, char** argv);
+	constexpr auto METRICS_ARG_PREFIX = "metrics=";
 
-	bool handle_cmd(io::InteractiveConsole& console, const std::string& cmd);
+	constexpr auto READERS_ARG_PREFIX = "readers="; // read-only storage connections
+
+	constexpr auto HANDSHAKE_KEYS_ARG_PREFIX = "hskeys="; // ready handshake keys
+
+	std::tuple<bool, Port, ServerOptions, std::size_t> parse_args(int argc, char** argv);
+
+	std::size_t parse_count_arg(const std::string& arg, const std::string& prefix);
+
+	bool handle_cmd(io::InteractiveConsole& console, metrics::Registry& metrics, const std::string& cmd);
 
 	template <utils::IPType IP>
 	int start_server(Port port, loggers::ILogger& logger, io::InteractiveConsole& console, Schema& schema,
 					 storage::IServerStorage& storage, ServerPacketHandlerFactory packetHandlerFactory,
-					 managers::UpdateManager& updateManager, managers::DecryptionsManager& decryptionsManager);
+					 managers::UpdateManager& updateManager, managers::DecryptionsManager& decryptionsManager,
+					 EphemeralKeyPool& handshakeKeyPool, const ServerOptions& options);
 
-	void run_server(IServer& server, loggers::ILogger& logger, io::InteractiveConsole& console);
+	void run_server(IServer& server, metrics::Registry& metrics, loggers::ILogger& logger,
+					io::InteractiveConsole& console);
 
 	int main(int argc, char** argv)
 	{
 		bool isIPv6 = false;
 		Port port{};
-		try { std::tie(isIPv6, port) = parse_args(argc, argv); }
+		ServerOptions options{};
+		std::size_t storageReaders = 0;
+		try { std::tie(isIPv6, port, options, storageReaders) = parse_args(argc, argv); }
 		catch (const std::exception& e)
 		{
 			std::cerr << e.what() << std::endl;
@@ -36,7 +48,7 @@ namespace senc::server
 		}
 
 		std::optional<io::InteractiveConsole> console;
-		try { console.emplace(handle_cmd); }
+		try { console.emplace(); }
 		catch (const std::exception&)
 		{
 			std::cerr << "Failed to initialize console" << std::endl;
@@ -46,37 +58,108 @@ namespace senc::server
 		loggers::ConsoleLogger logger(*console);
 
 		Schema schema;
-		storage::SqliteServerStorage storage(STORAGE_PATH);
+		storage::SqliteServerStorage storage(STORAGE_PATH, storageReaders);
 		managers::UpdateManager updateManager;
 		managers::DecryptionsManager decryptionsManager;
+		EphemeralKeyPool keyPool(options.handshakeKeyPoolDepth);
+		const ServerPacketHandlerImplFactory<EncryptedPacketHandler, std::reference_wrapper<EphemeralKeyPool>>
+			packetHandlerFactory(std::ref(keyPool));
 		
-		if (isIPv6)
-			return start_server<utils::IPv6>(
-				port, logger, *console, schema, storage,
-				ServerPacketHandlerImplFactory<EncryptedPacketHandler>{},
-				updateManager, decryptionsManager
-			);
-		else
-			return start_server<utils::IPv4>(
-				port, logger, *console, schema, storage,
-				ServerPacketHandlerImplFactory<EncryptedPacketHandler>{},
-				updateManager, decryptionsManager
+		const int res = isIPv6
+			? start_server<utils::IPv6>(
+				port, logger, *console, schema, storage, packetHandlerFactory,
+				updateManager, decryptionsManager, keyPool, options
+			)
+			: start_server<utils::IPv4>(
+				port, logger, *console, schema, storage, packetHandlerFactory,
+				updateManager, decryptionsManager, keyPool, options
 			);
+
+		const auto keyPoolStats = keyPool.stats();
+		logger.log_info(
+			"Handshake key pool: " + std::to_string(keyPoolStats.hits) + " hits, " +
+			std::to_string(keyPoolStats.misses) + " misses."
+		);
+
+		const auto storagePoolStats = storage.pool_stats();
+		logger.log_info(
+			"Storage connections: " + std::to_string(storagePoolStats.reads) + " reads (" +
+			std::to_string(storagePoolStats.read_waits) + " waited for one of " +
+			std::to_string(storagePoolStats.readers) + " readers), " +
+			std::to_string(storagePoolStats.writes) + " writes."
+		);
+
+		return res;
 	}
 
 	/**
 	 * @brief Parses program arguments.
-	 * @return isIPv6, port
+	 * @return isIPv6, port, server options, amount of read-only storage connections
 	 * @throw utils::Exception On error.
 	 */
-	std::tuple<bool, Port> parse_args(int argc, char** argv)
+	std::tuple<bool, Port, ServerOptions, std::size_t> parse_args(int argc, char** argv)
 	{
-		static const std::string USAGE = std::string("Usage: ") + argv[0] + " [IPv4|IPv6] [port]";
-		if (argc > 3)
+		static const std::string USAGE = std::string("Usage: ") + argv[0] + " [IPv4|IPv6] [reactor] [reuseport] [metrics=<path>] [readers=<count>] [hskeys=<count>] [port]";
+		if (argc > 8)
 			throw utils::Exception(USAGE);
 
 		std::vector<std::string> args(argv + 1, argv + argc);
 		bool isIPv6 = false;
+		ServerOptions options{};
+		std::size_t storageReaders = storage::SqliteServerStorage::DEFAULT_READERS;
+
+		// pop if has "reactor", and switch to reactor mode:
+		auto itReactor = std::find(args.begin(), args.end(), "reactor");
+		if (itReactor != args.end())
+		{
+			args.erase(itReactor);
+			options.mode = ServerOptions::Mode::Reactor;
+		}
+
+		// pop if has "reuseport", and accept through several listening sockets sharing the port:
+		auto itReusePort = std::find(args.begin(), args.end(), "reuseport");
+		if (itReusePort != args.end())
+		{
+			if (!utils::TcpSocket<utils::IPv4>::REUSE_PORT_SUPPORTED)
+				throw utils::Exception("Option \"reuseport\" is not supported on this platform");
+			args.erase(itReusePort);
+			options.acceptors = ServerOptions::DEFAULT_REUSE_PORT_ACCEPTORS;
+		}
+
+		// pop if has "metrics=<path>", and periodically dump metrics into path:
+		auto itMetrics = std::find_if(args.begin(), args.end(), [](const std::string& arg)
+		{
+			return arg.starts_with(METRICS_ARG_PREFIX);
+		});
+		if (itMetrics != args.end())
+		{
+			options.metricsDumpPath = itMetrics->substr(std::string(METRICS_ARG_PREFIX).size());
+			if (options.metricsDumpPath.empty())
+				throw utils::Exception(USAGE);
+			args.erase(itMetrics);
+		}
+
+		// pop if has "readers=<count>", and use count read-only storage connections:
+		auto itReaders = std::find_if(args.begin(), args.end(), [](const std::string& arg)
+		{
+			return arg.starts_with(READERS_ARG_PREFIX);
+		});
+		if (itReaders != args.end())
+		{
+			storageReaders = parse_count_arg(*itReaders, READERS_ARG_PREFIX);
+			args.erase(itReaders);
+		}
+
+		// pop if has "hskeys=<count>", and keep up to count handshake keys ready:
+		auto itHandshakeKeys = std::find_if(args.begin(), args.end(), [](const std::string& arg)
+		{
+			return arg.starts_with(HANDSHAKE_KEYS_ARG_PREFIX);
+		});
+		if (itHandshakeKeys != args.end())
+		{
+			options.handshakeKeyPoolDepth = parse_count_arg(*itHandshakeKeys, HANDSHAKE_KEYS_ARG_PREFIX);
+			args.erase(itHandshakeKeys);
+		}
 
 		// pop if has either "IPv4" or "IPv6", for "IPv6" set isIPv6 to true:
 		auto itIPv4 = std::find(args.begin(), args.end(), "IPv4");
@@ -93,6 +176,9 @@ namespace senc::server
 			else throw utils::Exception(USAGE);
 		}
 
+		if (args.size() > 1)
+			throw utils::Exception(USAGE);
+
 		Port port = DEFAULT_LISTEN_PORT;
 		if (args.size() >= 1)
 		{
@@ -103,18 +189,49 @@ namespace senc::server
 			}
 		}
 
-		return { isIPv6, port };
+		return { isIPv6, port, options, storageReaders };
+	}
+
+	/**
+	 * @brief Parses count of a "<prefix><count>" program argument.
+	 * @param arg Program argument.
+	 * @param prefix Argument prefix (preceding count).
+	 * @return Parsed count.
+	 * @throw utils::Exception If count is not a plain non-negative number.
+	 */
+	std::size_t parse_count_arg(const std::string& arg, const std::string& prefix)
+	{
+		std::string count = arg.substr(prefix.size());
+		std::size_t res = 0;
+		try { res = std::stoul(count); }
+		catch (const std::exception&) { count.clear(); }
+		if (std::to_string(res) != count) // not a plain non-negative number
+			throw utils::Exception("Bad count: " + arg);
+		return res;
 	}
 
 	/**
 	 * @brief Handles a server command input.
 	 * @param console Server console (by ref).
+	 * @param metrics Running server's metrics registry (by ref).
 	 * @param cmd Inputed command.
 	 * @return `true` if server should stop, otherwise `false`.
 	 */
-	bool handle_cmd(io::InteractiveConsole& console, const std::string& cmd)
+	bool handle_cmd(io::InteractiveConsole& console, metrics::Registry& metrics, const std::string& cmd)
 	{
-		(void)console;
+		if (cmd == "stats")
+		{
+			for (const auto& line : metrics.report())
+				console.print(line);
+		}
+		else if (cmd == "stats reset")
+		{
+			metrics.reset();
+			console.print("Metrics reset.");
+		}
+		else if (cmd != "stop")
+			console.print("Unknown command \"" + cmd + "\" (use \"stats\", \"stats reset\" or \"stop\").");
+
 		return cmd == "stop"; // stop if command is "stop"
 	}
 
@@ -128,12 +245,15 @@ namespace senc::server
 	 * @param packetHandlerFactory Factory used for constructing packet handlers (by ref).
 	 * @param updateManager Server's update manager instance (by ref).
 	 * @param decryptionsManager Server's decryptions manager instance (by ref).
+	 * @param handshakeKeyPool Pool of ready handshake keys used by `packetHandlerFactory` (by ref).
+	 * @param options Server runtime options.
 	 * @return Server exit code.
 	 */
 	template <utils::IPType IP>
 	int start_server(Port port, loggers::ILogger& logger, io::InteractiveConsole& console, Schema& schema,
 					 storage::IServerStorage& storage, ServerPacketHandlerFactory packetHandlerFactory,
-					 managers::UpdateManager& updateManager, managers::DecryptionsManager& decryptionsManager)
+					 managers::UpdateManager& updateManager, managers::DecryptionsManager& decryptionsManager,
+					 EphemeralKeyPool& handshakeKeyPool, const ServerOptions& options)
 	{
 		std::optional<Server<IP>> server;
 		try
@@ -145,7 +265,8 @@ namespace senc::server
 				storage,
 				packetHandlerFactory,
 				updateManager,
-				decryptionsManager
+				decryptionsManager,
+				options
 			);
 		}
 		catch (const std::exception& e)
@@ -154,7 +275,22 @@ namespace senc::server
 			return 1;
 		}
 
-		run_server(*server, logger, console);
+		// handshake key pool is owned outside server, so its gauges are registered here
+		auto& metrics = server->metrics();
+		metrics.sampled_gauge("handshake_key_pool.available", [&handshakeKeyPool]() -> std::int64_t
+		{
+			return handshakeKeyPool.stats().available;
+		});
+		metrics.sampled_gauge("handshake_key_pool.hits", [&handshakeKeyPool]() -> std::int64_t
+		{
+			return handshakeKeyPool.stats().hits;
+		});
+		metrics.sampled_gauge("handshake_key_pool.misses", [&handshakeKeyPool]() -> std::int64_t
+		{
+			return handshakeKeyPool.stats().misses;
+		});
+
+		run_server(*server, metrics, logger, console);
 
 		return 0;
 	}
@@ -162,17 +298,23 @@ namespace senc::server
 	/**
 	 * @brief Runs server (and waits for it to finish running).
 	 * @param server Server to run (by ref).
+	 * @param metrics Server's metrics registry, used by console commands (by ref).
 	 * @param logger `ILogger` instance used for logs (by ref).
 	 * @param console Server console (by ref).
 	 */
-	void run_server(IServer& server, loggers::ILogger& logger, io::InteractiveConsole& console)
+	void run_server(IServer& server, metrics::Registry& metrics, loggers::ILogger& logger,
+					io::InteractiveConsole& console)
 	{
 		server.start();
 
 		logger.log_info("Server listening at port " + std::to_string(server.port()) + ".");
-		logger.log_info("Use \"stop\" to stop server.");
+		logger.log_info("Use \"stats\" to show metrics, \"stats reset\" to reset them, \"stop\" to stop server.");
 
-		console.start_inputs(); // start input loop
+		// start input loop (returns once "stop" is inputed)
+		console.start_inputs([&metrics](io::InteractiveConsole& console, const std::string& cmd)
+		{
+			return handle_cmd(console, metrics, cmd);
+		});
 
 		server.stop();
 		server.wait();
@@ -24,12 +24,29 @@ namespace senc::server::managers
 			reg_layer_parts.size() >= required_reg_members;
 	}
 
+	DecryptionsManager::DecryptionsManager(std::chrono::milliseconds operationLifetime,
+										   std::size_t maxLiveOperations)
+		: _operationLifetime(operationLifetime), _maxLiveOperations(maxLiveOperations) { }
+
 	OperationID DecryptionsManager::new_operation()
 	{
-		const std::unique_lock<std::mutex> lock(_mtxAllOpIDs);
-		auto opid = OperationID::generate_not_in(_allOpIDs);
-		_allOpIDs.insert(opid);
-		return opid;
+		// reserve a live operation slot
+		if (_liveCount.fetch_add(1) >= _maxLiveOperations)
+		{
+			--_liveCount;
+			throw ServerException("Too many decryption operations in progress, try again later");
+		}
+
+		while (true)
+		{
+			auto opid = OperationID::generate();
+			auto& shard = shard_of(opid);
+			const std::unique_lock<std::mutex> lock(shard.mtx);
+			if (!shard.ops.try_emplace(opid).second)
+				continue; // already taken, generate another
+			shard.deadlines.emplace_back(Clock::now() + _operationLifetime, opid);
+			return opid;
+		}
 	}
 
 	void DecryptionsManager::prepare_operation(const OperationID& opid,
@@ -39,14 +56,19 @@ namespace senc::server::managers
 											   member_count_t requiredOwners,
 											   member_count_t requiredRegMembers)
 	{
-		const std::unique_lock<std::mutex> lock(_mtxPrep);
-		_prep.emplace(opid, PrepareRecord{
+		auto& shard = shard_of(opid);
+		const std::unique_lock<std::mutex> lock(shard.mtx);
+		const auto it = shard.ops.find(opid);
+		if (it == shard.ops.end())
+			throw ServerException("Operation with ID " + opid.to_string() + " expired before preperation");
+		set_state(shard, it->second, State::Preparing);
+		it->second.prep.emplace(
 			requester,
 			usersetID,
 			std::move(ciphertext),
 			requiredOwners,
 			requiredRegMembers
-		});
+		);
 	}
 
 	std::pair<std::optional<DecryptionsManager::PrepareRecord>, DecryptionsManager::PartRequirement>
@@ -57,45 +79,45 @@ namespace senc::server::managers
 		std::optional<PrepareRecord> res;
 
 		// register participant
-		const std::unique_lock<std::mutex> lockPrep(_mtxPrep);
-		const auto it = _prep.find(opid);
-		if (it == _prep.end())
-		{
-			if (_allOpIDs.contains(opid))
-				return { res, PartRequirement::NotRequired }; // opid valid, already has enough users
-			else
-				throw ServerException("No operation with ID " + opid.to_string()); // no such operation
-		}
+		auto& shard = shard_of(opid);
+		const std::unique_lock<std::mutex> lock(shard.mtx);
+		const auto it = shard.ops.find(opid);
+		if (it == shard.ops.end())
+			throw ServerException("No operation with ID " + opid.to_string()); // no such operation
+		auto& op = it->second;
+		if (State::Preparing != op.state)
+			return { res, PartRequirement::NotRequired }; // opid valid, already has enough users
+		auto& prep = *op.prep;
 
 		// push participant to matching vector:
 		// - if owner, try pushing into owners vec, if full then try pushing into non-owners vec
 		// - if non-owner, try pushing into non-owners vec
 		// - return false if failed (member isn't needed)
 		PartRequirement partRequirement = PartRequirement::NotRequired;
-		if (isOwner && it->second.owners_found.size() < it->second.required_owners)
+		if (isOwner && prep.owners_found.size() < prep.required_owners)
 		{
-			it->second.owners_found.insert(username);
+			prep.owners_found.insert(username);
 			partRequirement = PartRequirement::OwnerPart;
 		}
-		else if (it->second.reg_members_found.size() < it->second.required_reg_members)
+		else if (prep.reg_members_found.size() < prep.required_reg_members)
 		{
-			it->second.reg_members_found.insert(username);
+			prep.reg_members_found.insert(username);
 			partRequirement = PartRequirement::RegPart;
 		}
 		else return { res, PartRequirement::NotRequired }; // opid valid, already has enough members
 
 		// if has enough members, move from prepare stage to collect stage
-		if (it->second.has_enough_participants())
+		if (prep.has_enough_participants())
 		{
-			const std::unique_lock<std::mutex> lockColl(_mtxCollected);
-			_collected.emplace(opid, CollectedRecord{
-				it->second.requester,
-				it->second.userset_id,
-				it->second.required_owners,
-				it->second.required_reg_members
-			});
-			res.emplace(std::move(it->second));
-			_prep.erase(it);
+			op.collected.emplace(
+				prep.requester,
+				prep.userset_id,
+				prep.required_owners,
+				prep.required_reg_members
+			);
+			set_state(shard, op, State::Collecting);
+			res.emplace(std::move(prep));
+			op.prep.reset();
 		}
 
 		return { res, partRequirement };
@@ -110,39 +132,129 @@ namespace senc::server::managers
 		std::optional<CollectedRecord> res;
 
 		// register parts
-		const std::unique_lock<std::mutex> lock(_mtxCollected);
-		auto it = _collected.find(opid);
-		auto& parts = isOwner ? it->second.owner_layer_parts : it->second.reg_layer_parts;
-		auto& shardsIDs = isOwner ? it->second.owner_layer_shards_ids : it->second.reg_layer_shards_ids;
+		auto& shard = shard_of(opid);
+		const std::unique_lock<std::mutex> lock(shard.mtx);
+		const auto it = shard.ops.find(opid);
+		if (it == shard.ops.end() || State::Collecting != it->second.state)
+			throw ServerException("Operation with ID " + opid.to_string() + " is not collecting parts");
+		auto& op = it->second;
+		auto& parts = isOwner ? op.collected->owner_layer_parts : op.collected->reg_layer_parts;
+		auto& shardsIDs = isOwner ? op.collected->owner_layer_shards_ids : op.collected->reg_layer_shards_ids;
 		parts.push_back(std::move(part));
 		shardsIDs.push_back(std::move(shardID));
 
-		// if has enough parts, remove record and return collect record
-		if (it->second.has_enough_parts())
+		// if has enough parts, mark done (freeing its live slot) and return collect record
+		if (op.collected->has_enough_parts())
 		{
-			res.emplace(std::move(it->second));
-			_collected.erase(it);
+			set_state(shard, op, State::Done);
+			--_liveCount;
+			res.emplace(std::move(*op.collected));
+			op.collected.reset();
 		}
 
 		return res;
 	}
 
+	void DecryptionsManager::finish_operation(const OperationID& opid)
+	{
+		auto& shard = shard_of(opid);
+		const std::unique_lock<std::mutex> lock(shard.mtx);
+		const auto it = shard.ops.find(opid);
+		if (it == shard.ops.end())
+			throw ServerException("Operation with ID " + opid.to_string() + " expired before finishing");
+		auto& op = it->second;
+		if (State::Done == op.state)
+			return; // already freed its slot
+
+		set_state(shard, op, State::Done);
+		--_liveCount;
+		op.prep.reset();
+		op.collected.reset();
+	}
+
 	const UserSetID DecryptionsManager::get_operation_userset(const OperationID& opid)
 	{
+		auto& shard = shard_of(opid);
+		const std::unique_lock<std::mutex> lock(shard.mtx);
+		const auto it = shard.ops.find(opid);
+		if (it != shard.ops.end())
+		{
+			if (State::Preparing == it->second.state)
+				return it->second.prep->userset_id;
+			if (State::Collecting == it->second.state)
+				return it->second.collected->userset_id;
+		}
+
+		throw ServerException("Operation with ID " + opid.to_string() + " not found or already finished");
+	}
+
+	std::vector<DecryptionsManager::ExpiredRecord> DecryptionsManager::remove_expired(Clock::time_point now)
+	{
+		std::vector<ExpiredRecord> res;
+
+		for (auto& shard : _shards)
 		{
-			std::unique_lock<std::mutex> lock(_mtxPrep);
-			const auto itPrep = _prep.find(opid);
-			if (itPrep != _prep.end())
-				return itPrep->second.userset_id;
+			const std::unique_lock<std::mutex> lock(shard.mtx);
+			while (!shard.deadlines.empty() && shard.deadlines.front().first <= now)
+			{
+				auto node = shard.ops.extract(shard.deadlines.front().second);
+				shard.deadlines.pop_front();
+
+				// finished operations already freed their slot
+				auto& op = node.mapped();
+				if (State::Done != op.state)
+					--_liveCount;
+				if (std::size_t* count = state_count(shard, op.state))
+					--*count;
+
+				// report unfinished operations
+				if (State::Preparing == op.state)
+					res.emplace_back(node.key(), std::move(op.prep->requester));
+				else if (State::Collecting == op.state)
+					res.emplace_back(node.key(), std::move(op.collected->requester));
+			}
 		}
 
+		_expiredCount += res.size();
+		return res;
+	}
+
+	DecryptionsManager::Stats DecryptionsManager::stats()
+	{
+		Stats res{};
+		res.operation_lifetime = _operationLifetime;
+		res.max_live_operations = _maxLiveOperations;
+		res.live_operations = _liveCount;
+		res.expired_operations = _expiredCount;
+		for (auto& shard : _shards)
 		{
-			std::unique_lock<std::mutex> lock(_mtxCollected);
-			const auto itColl = _collected.find(opid);
-			if (itColl != _collected.end())
-				return itColl->second.userset_id;
+			const std::unique_lock<std::mutex> lock(shard.mtx);
+			res.preparing_operations += shard.preparing;
+			res.collecting_operations += shard.collecting;
 		}
+		return res;
+	}
 
-		throw ServerException("Operation with ID " + opid.to_string() + " not found or already finished");
+	void DecryptionsManager::set_state(Shard& shard, Operation& op, State state)
+	{
+		if (std::size_t* count = state_count(shard, op.state))
+			--*count;
+		op.state = state;
+		if (std::size_t* count = state_count(shard, state))
+			++*count;
+	}
+
+	std::size_t* DecryptionsManager::state_count(Shard& shard, State state)
+	{
+		if (State::Preparing == state)
+			return &shard.preparing;
+		if (State::Collecting == state)
+			return &shard.collecting;
+		return nullptr;
+	}
+
+	DecryptionsManager::Shard& DecryptionsManager::shard_of(const OperationID& opid)
+	{
+		return _shards[opid.hash() % SHARD_COUNT];
 	}
 }
@@ -12,6 +12,10 @@
 #include "../../common/sizes.hpp"
 #include "../../utils/hash.hpp"
 #include <optional>
+#include <atomic>
+#include <chrono>
+#include <array>
+#include <deque>
 #include <mutex>
 
 namespace senc::server::managers
@@ -19,11 +23,20 @@ namespace senc::server::managers
 	/**
 	 * @class senc::server::managers::DecryptionsManager
 	 * @brief Manages synchronized decryption operations.
+	 * @note Each operation lives for a fixed lifetime from its creation. Expired operations are
+	 *		 removed by `remove_expired`, and the amount of live (unfinished) operations is bounded.
+	 * @note Operations are sharded by ID over independently locked shards, so that requests of
+	 *		 unrelated operations rarely contend.
 	 */
 	class DecryptionsManager
 	{
 	public:
 		using Self = DecryptionsManager;
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr std::chrono::milliseconds DEFAULT_OPERATION_LIFETIME{ 5 * 60 * 1000 };
+
+		static constexpr std::size_t DEFAULT_MAX_LIVE_OPERATIONS = 1 << 16;
 
 		/**
 		 * @enum senc::server::DecryptionsManager::PartRequirement
@@ -84,9 +97,40 @@ namespace senc::server::managers
 			bool has_enough_participants() const;
 		};
 
+		/**
+		 * @brief Record of an operation that expired before finishing.
+		 */
+		struct ExpiredRecord
+		{
+			OperationID op_id;
+			std::string requester;
+		};
+
+		/**
+		 * @brief Limits and live amounts of operations.
+		 */
+		struct Stats
+		{
+			std::chrono::milliseconds operation_lifetime;
+			std::size_t max_live_operations;
+			std::size_t live_operations;	   // created and neither finished nor expired yet
+			std::size_t preparing_operations;  // looking for participants
+			std::size_t collecting_operations; // collecting decryption parts
+			std::size_t expired_operations;	   // expired before finishing, since construction
+		};
+
+		/**
+		 * @brief Constructs a new decryptions manager.
+		 * @param operationLifetime Time from creation of an operation until it expires.
+		 * @param maxLiveOperations Maximum amount of operations created and neither finished nor expired.
+		 */
+		explicit DecryptionsManager(std::chrono::milliseconds operationLifetime = DEFAULT_OPERATION_LIFETIME,
+									std::size_t maxLiveOperations = DEFAULT_MAX_LIVE_OPERATIONS);
+
 		/**
 		 * @brief Generates an operation ID for a new operation.
 		 * @return Unique operation ID.
+		 * @throw ServerException If maximum amount of live operations is reached.
 		 */
 		OperationID new_operation();
 
@@ -98,6 +142,7 @@ namespace senc::server::managers
 		 * @param ciphertext Ciphertext being decrypted (moved).
 		 * @param requiredOwners Amount of owners required for performing the decryption.
 		 * @param requiredRegMembers Amount of non-owner members required for performing the decryption.
+		 * @throw ServerException If operation already expired.
 		 */
 		void prepare_operation(const OperationID& opid,
 							   const std::string& requester,
@@ -126,12 +171,21 @@ namespace senc::server::managers
 		 * @param shardID ID of shard used for providing this part.
 		 * @param isOwner Whether or not this is an owner's part.
 		 * @return Record of collected parts if collecting completed, `std::nullopt` otherwise.
+		 * @throw ServerException If operation is not collecting parts (e.g. expired).
 		 */
 		std::optional<CollectedRecord> register_part(const OperationID& opid,
 													 DecryptionPart&& part,
 													 PrivKeyShardID&& shardID,
 													 bool isOwner);
 
+		/**
+		 * @brief Marks an operation as finished without collecting parts (e.g. when it requires none),
+		 *		  freeing its live slot.
+		 * @param opid Operation ID.
+		 * @throw ServerException If operation already expired.
+		 */
+		void finish_operation(const OperationID& opid);
+
 		/**
 		 * @brief Gets userset of operation.
 		 * @param opid Operation ID.
@@ -139,14 +193,94 @@ namespace senc::server::managers
 		 */
 		const UserSetID get_operation_userset(const OperationID& opid);
 
+		/**
+		 * @brief Removes all operations whose lifetime has passed.
+		 * @param now Time to check lifetimes against (current time by default).
+		 * @return Records of removed operations that had not finished yet.
+		 */
+		std::vector<ExpiredRecord> remove_expired(Clock::time_point now = Clock::now());
+
+		/**
+		 * @brief Gets limits and live amounts of operations.
+		 * @return Operations stats.
+		 * @note Only sums amounts kept per shard, so is cheap enough to be polled (e.g. by gauges).
+		 */
+		Stats stats();
+
 	private:
-		utils::HashMap<OperationID, PrepareRecord> _prep;
-		std::mutex _mtxPrep;
+		/**
+		 * @enum senc::server::managers::DecryptionsManager::State
+		 * @brief Stage of a live operation.
+		 */
+		enum class State
+		{
+			Created,	// ID generated, not prepared yet
+			Preparing,	// looking for participants
+			Collecting,	// collecting decryption parts
+			Done		// finished (kept until expired, to recognize late participants, but frees its slot)
+		};
+
+		/**
+		 * @struct senc::server::managers::DecryptionsManager::Operation
+		 * @brief Record of a single live operation.
+		 */
+		struct Operation
+		{
+			State state = State::Created;
+			std::optional<PrepareRecord> prep;		 // set while preparing
+			std::optional<CollectedRecord> collected; // set while collecting
+		};
 
-		utils::HashMap<OperationID, CollectedRecord> _collected;
-		std::mutex _mtxCollected;
+		/**
+		 * @struct senc::server::managers::DecryptionsManager::Shard
+		 * @brief Operations whose IDs hash to the same shard, under a single lock.
+		 */
+		struct alignas(64) Shard // aligned to avoid false sharing between shards' mutexes
+		{
+			utils::HashMap<OperationID, Operation> ops;
+
+			// expiry deadlines in creation order
+			// NOTE: all operations share a lifetime, so creation order is also deadline order
+			std::deque<std::pair<Clock::time_point, OperationID>> deadlines;
+
+			// amounts of operations in counted states (kept for stats, so they never walk `ops`)
+			std::size_t preparing = 0;
+			std::size_t collecting = 0;
+
+			std::mutex mtx;
+		};
 
-		utils::HashSet<OperationID> _allOpIDs;
-		std::mutex _mtxAllOpIDs;
+		static constexpr std::size_t SHARD_COUNT = 16;
+
+		const std::chrono::milliseconds _operationLifetime;
+		const std::size_t _maxLiveOperations;
+
+		std::array<Shard, SHARD_COUNT> _shards;
+
+		std::atomic<std::size_t> _liveCount = 0;
+		std::atomic<std::size_t> _expiredCount = 0;
+
+		/**
+		 * @brief Moves an operation to another state, keeping its shard's state amounts (shard lock should be held).
+		 * @param shard Shard holding operation.
+		 * @param op Operation to move.
+		 * @param state State to move operation to.
+		 */
+		static void set_state(Shard& shard, Operation& op, State state);
+
+		/**
+		 * @brief Gets a shard's amount of operations in a state (shard lock should be held).
+		 * @param shard Shard to get amount of.
+		 * @param state Operations state.
+		 * @return Pointer to amount, or `nullptr` if state is not counted.
+		 */
+		static std::size_t* state_count(Shard& shard, State state);
+
+		/**
+		 * @brief Gets shard holding an operation.
+		 * @param opid Operation ID.
+		 * @return Operation's shard.
+		 */
+		Shard& shard_of(const OperationID& opid);
 	};
 }
@@ -8,15 +8,136 @@
 
 #include "UpdateManager.hpp"
 
+#include <algorithm>
+
 namespace senc::server::managers
 {
 	pkt::UpdateResponse UpdateManager::retrieve_updates(const std::string& username)
 	{
-		const std::lock_guard<std::mutex> lock(_mtxUpdates);
-		const auto it = _updates.find(username);
-		if (it == _updates.end())
+		auto& stripe = stripe_of(username);
+		const std::lock_guard<std::mutex> lock(stripe.mtx);
+		const auto it = stripe.updates.find(username);
+		if (it == stripe.updates.end())
+			return {}; // no updates
+		return std::move(stripe.updates.extract(it).mapped());
+	}
+
+	pkt::UpdateResponse UpdateManager::wait_updates(const std::string& username,
+													std::chrono::milliseconds timeout,
+													const std::function<bool()>& stopWaiting)
+	{
+		auto& stripe = stripe_of(username);
+		std::unique_lock<std::mutex> lock(stripe.mtx);
+
+		// wait on user's waiter (node-based map, so reference stays valid while in use)
+		if (!stripe.updates.contains(username) && timeout.count() > 0)
+		{
+			const std::uint64_t epoch = stripe.interruptEpoch;
+			auto& waiter = stripe.waiters[username];
+			++waiter.count;
+			const auto ready = [&stripe, &username, epoch]()
+			{
+				return stripe.updates.contains(username) || epoch != stripe.interruptEpoch;
+			};
+			const auto deadline = std::chrono::steady_clock::now() + timeout;
+			while (!ready() && std::chrono::steady_clock::now() < deadline)
+			{
+				if (!stopWaiting)
+				{
+					waiter.cv.wait_until(lock, deadline, ready);
+					break;
+				}
+
+				// wait in slices, checking stop condition in between (waiter stays alive while counted)
+				const auto sliceEnd = std::min(deadline, std::chrono::steady_clock::now() + WAIT_SLICE);
+				waiter.cv.wait_until(lock, sliceEnd, ready);
+				lock.unlock();
+				const bool stop = stopWaiting();
+				lock.lock();
+				if (stop)
+					break;
+			}
+			if (0 == --waiter.count)
+				stripe.waiters.erase(username);
+		}
+
+		const auto it = stripe.updates.find(username);
+		if (it == stripe.updates.end())
 			return {}; // no updates
-		return std::move(_updates.extract(it).mapped());
+		return std::move(stripe.updates.extract(it).mapped());
+	}
+
+	void UpdateManager::park(const std::string& username, std::chrono::milliseconds timeout,
+							 Wake wake, std::function<bool()> stopWaiting)
+	{
+		auto& stripe = stripe_of(username);
+		const std::lock_guard<std::mutex> lock(stripe.mtx);
+		if (stripe.updates.contains(username))
+			return wake(); // nothing to wait for
+
+		stripe.parks[username].push_back(Park{
+			.deadline = std::chrono::steady_clock::now() + timeout,
+			.epoch = stripe.interruptEpoch,
+			.wake = std::move(wake),
+			.stopWaiting = std::move(stopWaiting)
+		});
+	}
+
+	void UpdateManager::expire_parks()
+	{
+		for (auto& stripe : _stripes)
+		{
+			// take parks out of stripe, so that stop conditions are checked without lock held
+			// (and so that none of them is woken by an update meanwhile)
+			utils::HashMap<std::string, std::vector<Park>> parks;
+			{
+				const std::lock_guard<std::mutex> lock(stripe.mtx);
+				if (stripe.parks.empty())
+					continue;
+				parks = std::move(stripe.parks);
+				stripe.parks.clear(); // ensure valid state after move
+			}
+
+			const auto now = std::chrono::steady_clock::now();
+			for (auto& [username, userParks] : parks)
+				for (auto& park : userParks)
+					if (park.stopWaiting && now < park.deadline && park.stopWaiting())
+						park.deadline = now; // stop condition holds, so due at once
+
+			// wake due parks (or ones whose user got updates or was interrupted meanwhile), put back the rest
+			std::vector<Wake> wakes;
+			{
+				const std::lock_guard<std::mutex> lock(stripe.mtx);
+				for (auto& [username, userParks] : parks)
+				{
+					const bool hasUpdates = stripe.updates.contains(username);
+					for (auto& park : userParks)
+					{
+						if (hasUpdates || park.epoch != stripe.interruptEpoch || now >= park.deadline)
+							wakes.push_back(std::move(park.wake));
+						else
+							stripe.parks[username].push_back(std::move(park));
+					}
+				}
+			}
+			for (const auto& wake : wakes)
+				wake();
+		}
+	}
+
+	void UpdateManager::interrupt_waits()
+	{
+		for (auto& stripe : _stripes)
+		{
+			const std::lock_guard<std::mutex> lock(stripe.mtx);
+			++stripe.interruptEpoch;
+			for (auto& [username, waiter] : stripe.waiters)
+				waiter.cv.notify_all();
+			for (auto& [username, userParks] : stripe.parks)
+				for (const auto& park : userParks)
+					park.wake();
+			stripe.parks.clear();
+		}
 	}
 
 	void UpdateManager::register_reg_member(const std::string& username,
@@ -25,12 +146,14 @@ namespace senc::server::managers
 											const PubKey& ownerLayerPubKey,
 											PrivKeyShard&& privKeyShard)
 	{
-		const std::lock_guard<std::mutex> lock(_mtxUpdates);
-		_updates[username].added_as_reg_member.emplace_back(
+		auto& stripe = stripe_of(username);
+		const std::lock_guard<std::mutex> lock(stripe.mtx);
+		stripe.updates[username].added_as_reg_member.emplace_back(
 			usersetID,
 			regLayerPubKey, ownerLayerPubKey,
 			std::move(privKeyShard)
 		);
+		notify_user(stripe, username);
 	}
 
 	void UpdateManager::register_owner(const std::string& username,
@@ -40,18 +163,43 @@ namespace senc::server::managers
 									   PrivKeyShard&& regLayerPrivKeyShard,
 									   PrivKeyShard&& ownerLayerPrivKeyShard)
 	{
-		const std::lock_guard<std::mutex> lock(_mtxUpdates);
-		_updates[username].added_as_owner.emplace_back(
+		auto& stripe = stripe_of(username);
+		const std::lock_guard<std::mutex> lock(stripe.mtx);
+		stripe.updates[username].added_as_owner.emplace_back(
 			usersetID,
 			regLayerPubKey, ownerLayerPubKey,
 			std::move(regLayerPrivKeyShard), std::move(ownerLayerPrivKeyShard)
 		);
+		notify_user(stripe, username);
 	}
 
 	void UpdateManager::register_lookup(const std::string& username, const OperationID& opid)
 	{
-		const std::lock_guard<std::mutex> lock(_mtxUpdates);
-		_updates[username].on_lookup.push_back(opid);
+		auto& stripe = stripe_of(username);
+		const std::lock_guard<std::mutex> lock(stripe.mtx);
+		stripe.updates[username].on_lookup.push_back(opid);
+		notify_user(stripe, username);
+	}
+
+	void UpdateManager::register_lookup(const std::vector<std::string>& usernames, const OperationID& opid)
+	{
+		// group users by stripe, so that each stripe is locked once
+		std::array<std::vector<const std::string*>, STRIPE_COUNT> byStripe;
+		for (const auto& username : usernames)
+			byStripe[stripe_index(username)].push_back(&username);
+
+		for (std::size_t i = 0; i < STRIPE_COUNT; ++i)
+		{
+			if (byStripe[i].empty())
+				continue;
+			auto& stripe = _stripes[i];
+			const std::lock_guard<std::mutex> lock(stripe.mtx);
+			for (const std::string* username : byStripe[i])
+			{
+				stripe.updates[*username].on_lookup.push_back(opid);
+				notify_user(stripe, *username);
+			}
+		}
 	}
 
 	void UpdateManager::register_decryption_participating(const std::string& username,
@@ -59,10 +207,12 @@ namespace senc::server::managers
 														  const Ciphertext& ciphertext,
 														  const std::vector<PrivKeyShardID>& shardsIDs)
 	{
-		const std::lock_guard<std::mutex> lock(_mtxUpdates);
-		_updates[username].to_decrypt.emplace_back(
+		auto& stripe = stripe_of(username);
+		const std::lock_guard<std::mutex> lock(stripe.mtx);
+		stripe.updates[username].to_decrypt.emplace_back(
 			opid, ciphertext, shardsIDs
 		);
+		notify_user(stripe, username);
 	}
 
 	void UpdateManager::register_finished_decrpytion(const std::string& username,
@@ -72,10 +222,61 @@ namespace senc::server::managers
 													 std::vector<PrivKeyShardID>&& regLayerShardsIDs,
 													 std::vector<PrivKeyShardID>&& ownerLayerShardsIDs)
 	{
-		const std::lock_guard<std::mutex> lock(_mtxUpdates);
-		_updates[username].finished_decryptions.emplace_back(
+		auto& stripe = stripe_of(username);
+		const std::lock_guard<std::mutex> lock(stripe.mtx);
+		stripe.updates[username].finished_decryptions.emplace_back(
 			opid, std::move(regLayerParts), std::move(ownerLayerParts),
 			std::move(regLayerShardsIDs), std::move(ownerLayerShardsIDs)
 		);
+		notify_user(stripe, username);
+	}
+
+	void UpdateManager::register_expired_operation(const std::string& username, const OperationID& opid)
+	{
+		auto& stripe = stripe_of(username);
+		const std::lock_guard<std::mutex> lock(stripe.mtx);
+		stripe.updates[username].expired_operations.push_back(opid);
+		notify_user(stripe, username);
+	}
+
+	UpdateManager::Stats UpdateManager::stats()
+	{
+		Stats res{};
+		for (auto& stripe : _stripes)
+		{
+			const std::lock_guard<std::mutex> lock(stripe.mtx);
+			res.pending_users += stripe.updates.size();
+			res.max_stripe_pending = std::max(res.max_stripe_pending, stripe.updates.size());
+			for (const auto& [username, waiter] : stripe.waiters)
+				res.waiting_clients += waiter.count;
+			for (const auto& [username, userParks] : stripe.parks)
+				res.waiting_clients += userParks.size();
+		}
+		return res;
+	}
+
+	std::size_t UpdateManager::stripe_index(const std::string& username)
+	{
+		return std::hash<std::string>{}(username) % STRIPE_COUNT;
+	}
+
+	UpdateManager::Stripe& UpdateManager::stripe_of(const std::string& username)
+	{
+		return _stripes[stripe_index(username)];
+	}
+
+	void UpdateManager::notify_user(Stripe& stripe, const std::string& username)
+	{
+		const auto it = stripe.waiters.find(username);
+		if (it != stripe.waiters.end())
+			it->second.cv.notify_all();
+
+		const auto itParks = stripe.parks.find(username);
+		if (itParks != stripe.parks.end())
+		{
+			for (const auto& park : itParks->second)
+				park.wake();
+			stripe.parks.erase(itParks);
+		}
 	}
 }
@@ -11,6 +11,12 @@
 #include "../../common/packets.hpp"
 #include "../../common/aliases.hpp"
 #include "../../utils/hash.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <chrono>
+#include <vector>
+#include <array>
 #include <mutex>
 
 namespace senc::server::managers
@@ -18,12 +24,36 @@ namespace senc::server::managers
 	/**
 	 * @class senc::server::managers::UpdateManager
 	 * @brief Managers registry of user updates (before sent).
+	 * @note Users are striped over `STRIPE_COUNT` independently locked stripes (by username hash),
+	 *		 so that registrations and retrievals of different users rarely contend.
 	 */
 	class UpdateManager
 	{
 	public:
 		using Self = UpdateManager;
 
+		static constexpr std::size_t STRIPE_COUNT = 16;
+
+		// interval in which `wait_updates` checks its stop condition (and `expire_parks` should be called)
+		static constexpr std::chrono::milliseconds WAIT_SLICE{ 20 };
+
+		/**
+		 * @typedef senc::server::managers::UpdateManager::Wake
+		 * @brief Function called once a parked update request should be answered (see `park`).
+		 */
+		using Wake = std::function<void()>;
+
+		/**
+		 * @struct senc::server::managers::UpdateManager::Stats
+		 * @brief Snapshot of update queue depths.
+		 */
+		struct Stats
+		{
+			std::size_t pending_users;		// users with updates not yet retrieved
+			std::size_t max_stripe_pending; // pending users of most loaded stripe
+			std::size_t waiting_clients;	// clients currently held in `wait_updates` or parked
+		};
+
 		UpdateManager() = default;
 
 		/**
@@ -33,6 +63,50 @@ namespace senc::server::managers
 		 */
 		pkt::UpdateResponse retrieve_updates(const std::string& username);
 
+		/**
+		 * @brief Retrieves updates for a specific user, waiting until any are registered (long-poll).
+		 * @param username Username of user to retrieve updates for.
+		 * @param timeout Maximum time to wait for updates.
+		 * @param stopWaiting Optional condition checked every `WAIT_SLICE` (without lock held, must not
+		 *					  throw), stops waiting once it holds (e.g. when client sent another request).
+		 * @return Retireved updates (empty if none were registered until timeout).
+		 * @note Returns early (possibly empty) if `interrupt_waits` is called.
+		 */
+		pkt::UpdateResponse wait_updates(const std::string& username, std::chrono::milliseconds timeout,
+										 const std::function<bool()>& stopWaiting = {});
+
+		/**
+		 * @brief Parks an update request of a user until updates are registered for them, without
+		 *		  holding a thread (long-poll for event loops); once woken, it is answered via `retrieve_updates`.
+		 * @param username Username of user whose request to park.
+		 * @param timeout Maximum time to park request (enforced by `expire_parks`).
+		 * @param wake Function called exactly once, when request should be answered (updates registered,
+		 *			   timeout passed, `stopWaiting` holds or `interrupt_waits` called); might be called with
+		 *			   user's stripe locked, so it must be short and must not call back into manager.
+		 * @param stopWaiting Optional condition checked by `expire_parks` (without lock held, must not throw),
+		 *					  wakes request once it holds (e.g. when client sent another request).
+		 * @note If user already has updates, `wake` is called at once.
+		 */
+		void park(const std::string& username, std::chrono::milliseconds timeout,
+				  Wake wake, std::function<bool()> stopWaiting = {});
+
+		/**
+		 * @brief Wakes up parked requests whose timeout passed, or whose stop condition holds.
+		 * @note Should be called every `WAIT_SLICE` while requests might be parked.
+		 */
+		void expire_parks();
+
+		/**
+		 * @brief Wakes up all users currently waiting in `wait_updates` or parked (e.g. on server stop).
+		 */
+		void interrupt_waits();
+
+		/**
+		 * @brief Gets a snapshot of update queue depths.
+		 * @note Locks each stripe in turn, so snapshot is not atomic across stripes.
+		 */
+		Stats stats();
+
 		/**
 		 * @brief Registers that a user was added to a userset as non-owner.
 		 * @param username Username of user that was added to userset.
@@ -70,6 +144,14 @@ namespace senc::server::managers
 		 */
 		void register_lookup(const std::string& username, const OperationID& opid);
 
+		/**
+		 * @brief Registers users to look for in order to perform a decryption operation.
+		 * @param usernames Usernames of users to include in lookup for operation.
+		 * @param opid Operation ID.
+		 * @note Locks each stripe once for all of its users, rather than once per user.
+		 */
+		void register_lookup(const std::vector<std::string>& usernames, const OperationID& opid);
+
 		/**
 		 * @brief Registers a user's participance in a decryption operation.
 		 * @param username Username of user participating in decryption.
@@ -98,9 +180,77 @@ namespace senc::server::managers
 										  std::vector<PrivKeyShardID>&& regLayerShardsIDs,
 										  std::vector<PrivKeyShardID>&& ownerLayerShardsIDs);
 
+		/**
+		 * @brief Registers a decryption operation that expired before finishing.
+		 * @param username Username of user who initiated the operation.
+		 * @param opid Operation ID.
+		 */
+		void register_expired_operation(const std::string& username, const OperationID& opid);
+
 	private:
-		// maps username to updates prepared so far
-		utils::HashMap<std::string, pkt::UpdateResponse> _updates;
-		std::mutex _mtxUpdates;
+		/**
+		 * @struct senc::server::managers::UpdateManager::Waiter
+		 * @brief Condition variable shared by waits of a single user.
+		 */
+		struct Waiter
+		{
+			std::condition_variable cv;
+			std::size_t count = 0; // amount of threads waiting
+		};
+
+		/**
+		 * @struct senc::server::managers::UpdateManager::Park
+		 * @brief Update request parked until updates arrive (see `park`).
+		 */
+		struct Park
+		{
+			std::chrono::steady_clock::time_point deadline;
+			std::uint64_t epoch; // interrupt epoch of stripe when parked
+			Wake wake;
+			std::function<bool()> stopWaiting;
+		};
+
+		/**
+		 * @struct senc::server::managers::UpdateManager::Stripe
+		 * @brief Updates and waiters of users hashed to the same stripe.
+		 */
+		struct alignas(64) Stripe // aligned to avoid false sharing between stripes' mutexes
+		{
+			// maps username to updates prepared so far
+			utils::HashMap<std::string, pkt::UpdateResponse> updates;
+
+			// maps username to waiter (only while user has waits)
+			utils::HashMap<std::string, Waiter> waiters;
+
+			// maps username to its parked requests (only while user has any)
+			utils::HashMap<std::string, std::vector<Park>> parks;
+			std::uint64_t interruptEpoch = 0;
+
+			std::mutex mtx;
+		};
+
+		std::array<Stripe, STRIPE_COUNT> _stripes;
+
+		/**
+		 * @brief Gets index of stripe holding a user's updates.
+		 * @param username Username of user.
+		 * @return Index of user's stripe in `_stripes`.
+		 */
+		static std::size_t stripe_index(const std::string& username);
+
+		/**
+		 * @brief Gets stripe holding a user's updates.
+		 * @param username Username of user.
+		 * @return User's stripe.
+		 */
+		Stripe& stripe_of(const std::string& username);
+
+		/**
+		 * @brief Wakes up waits and parked requests of a user that got new updates.
+		 * @param stripe User's stripe.
+		 * @param username Username of user.
+		 * @note Assumes `stripe.mtx` is locked by caller.
+		 */
+		static void notify_user(Stripe& stripe, const std::string& username);
 	};
 }
@@ -0,0 +1,53 @@
+/*********************************************************************
+ * \file   Counter.hpp
+ * \brief  Contains Counter class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+
+namespace senc::server::metrics
+{
+	/**
+	 * @class senc::server::metrics::Counter
+	 * @brief Monotonic event counter (lock-free).
+	 */
+	class Counter
+	{
+	public:
+		using Self = Counter;
+
+		/**
+		 * @brief Increases counter.
+		 * @param amount Amount to increase by.
+		 */
+		void add(std::uint64_t amount = 1)
+		{
+			_value.fetch_add(amount, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Gets current counter value.
+		 */
+		std::uint64_t value() const
+		{
+			return _value.load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Resets counter to zero.
+		 */
+		void reset()
+		{
+			_value.store(0, std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<std::uint64_t> _value = 0;
+	};
+}
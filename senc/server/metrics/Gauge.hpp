@@ -0,0 +1,54 @@
+/*********************************************************************
+ * \file   Gauge.hpp
+ * \brief  Contains Gauge class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+
+namespace senc::server::metrics
+{
+	/**
+	 * @class senc::server::metrics::Gauge
+	 * @brief Value that goes up and down, e.g. amount of open connections (lock-free).
+	 */
+	class Gauge
+	{
+	public:
+		using Self = Gauge;
+
+		/**
+		 * @brief Sets gauge value.
+		 * @param value Value to set.
+		 */
+		void set(std::int64_t value)
+		{
+			_value.store(value, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Changes gauge value.
+		 * @param delta Amount to add (negative to subtract).
+		 */
+		void add(std::int64_t delta)
+		{
+			_value.fetch_add(delta, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Gets current gauge value.
+		 */
+		std::int64_t value() const
+		{
+			return _value.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<std::int64_t> _value = 0;
+	};
+}
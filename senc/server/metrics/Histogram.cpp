@@ -0,0 +1,110 @@
+/*********************************************************************
+ * \file   Histogram.cpp
+ * \brief  Implementation of Histogram class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "Histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <bit>
+
+namespace senc::server::metrics
+{
+	std::uint64_t Histogram::Snapshot::count() const
+	{
+		return _count;
+	}
+
+	std::uint64_t Histogram::Snapshot::sum() const
+	{
+		return _sum;
+	}
+
+	std::uint64_t Histogram::Snapshot::max() const
+	{
+		return _max;
+	}
+
+	double Histogram::Snapshot::mean() const
+	{
+		if (0 == _count)
+			return 0;
+		return static_cast<double>(_sum) / static_cast<double>(_count);
+	}
+
+	std::uint64_t Histogram::Snapshot::percentile(double percentile) const
+	{
+		if (0 == _count)
+			return 0;
+
+		// amount of values that should be at or below result (at least one)
+		const auto target = std::max<std::uint64_t>(
+			1, static_cast<std::uint64_t>(std::ceil(percentile / 100 * static_cast<double>(_count)))
+		);
+
+		std::uint64_t seen = 0;
+		for (std::size_t i = 0; i < _counts.size(); ++i)
+		{
+			seen += _counts[i];
+			if (seen >= target)
+				return std::min(bucket_max(i), _max);
+		}
+		return _max; // counters were read mid-record, and don't sum up to count
+	}
+
+	void Histogram::record(std::uint64_t value)
+	{
+		_counts[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+		_count.fetch_add(1, std::memory_order_relaxed);
+		_sum.fetch_add(value, std::memory_order_relaxed);
+
+		auto max = _max.load(std::memory_order_relaxed);
+		while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) { }
+	}
+
+	Histogram::Snapshot Histogram::snapshot() const
+	{
+		Snapshot res;
+		res._counts.reserve(BUCKET_COUNT);
+		for (const auto& count : _counts)
+			res._counts.push_back(count.load(std::memory_order_relaxed));
+		res._count = _count.load(std::memory_order_relaxed);
+		res._sum = _sum.load(std::memory_order_relaxed);
+		res._max = _max.load(std::memory_order_relaxed);
+		return res;
+	}
+
+	void Histogram::reset()
+	{
+		for (auto& count : _counts)
+			count.store(0, std::memory_order_relaxed);
+		_count.store(0, std::memory_order_relaxed);
+		_sum.store(0, std::memory_order_relaxed);
+		_max.store(0, std::memory_order_relaxed);
+	}
+
+	std::size_t Histogram::bucket_index(std::uint64_t value)
+	{
+		if (value < 2 * SUB_BUCKETS)
+			return static_cast<std::size_t>(value);
+
+		// keep top `SUB_BUCKET_BITS + 1` bits of value: exponent selects range, rest select bucket in it
+		const std::size_t shift = std::bit_width(value) - 1 - SUB_BUCKET_BITS;
+		const std::size_t top = static_cast<std::size_t>(value >> shift); // in [SUB_BUCKETS, 2 * SUB_BUCKETS)
+		return (shift + 1) * SUB_BUCKETS + (top - SUB_BUCKETS);
+	}
+
+	std::uint64_t Histogram::bucket_max(std::size_t index)
+	{
+		if (index < 2 * SUB_BUCKETS)
+			return index;
+
+		const std::size_t shift = index / SUB_BUCKETS - 1;
+		const std::uint64_t top = index % SUB_BUCKETS + SUB_BUCKETS;
+		return (top << shift) + ((std::uint64_t{ 1 } << shift) - 1);
+	}
+}
@@ -0,0 +1,125 @@
+/*********************************************************************
+ * \file   Histogram.hpp
+ * \brief  Header of Histogram class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <atomic>
+#include <vector>
+#include <array>
+
+namespace senc::server::metrics
+{
+	/**
+	 * @class senc::server::metrics::Histogram
+	 * @brief Lock-free histogram of non-negative values, with log-linear (HDR-style) buckets.
+	 * @note Each power of two is split into `SUB_BUCKETS` equal buckets, so recorded values
+	 *		 are reported with a relative error of at most `1 / SUB_BUCKETS` (about 3%).
+	 */
+	class Histogram
+	{
+	public:
+		using Self = Histogram;
+
+		static constexpr std::size_t SUB_BUCKET_BITS = 5;
+
+		static constexpr std::size_t SUB_BUCKETS = std::size_t{ 1 } << SUB_BUCKET_BITS;
+
+		// values below `2 * SUB_BUCKETS` get a bucket each, then every power of two gets `SUB_BUCKETS`
+		static constexpr std::size_t BUCKET_COUNT = (65 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+		/**
+		 * @class senc::server::metrics::Histogram::Snapshot
+		 * @brief Copy of histogram's counters at some point.
+		 */
+		class Snapshot
+		{
+		public:
+			using Self = Snapshot;
+
+			/**
+			 * @brief Gets amount of recorded values.
+			 */
+			std::uint64_t count() const;
+
+			/**
+			 * @brief Gets sum of recorded values.
+			 */
+			std::uint64_t sum() const;
+
+			/**
+			 * @brief Gets maximum recorded value (zero if none were recorded).
+			 */
+			std::uint64_t max() const;
+
+			/**
+			 * @brief Gets mean of recorded values (zero if none were recorded).
+			 */
+			double mean() const;
+
+			/**
+			 * @brief Gets value below or at which a given percentage of recorded values are.
+			 * @param percentile Percentage, in range [0, 100].
+			 * @return Highest value of matching bucket (capped by maximum recorded value).
+			 */
+			std::uint64_t percentile(double percentile) const;
+
+		private:
+			friend class Histogram;
+
+			std::vector<std::uint64_t> _counts;
+			std::uint64_t _count = 0;
+			std::uint64_t _sum = 0;
+			std::uint64_t _max = 0;
+		};
+
+		Histogram() = default;
+
+		Histogram(const Self&) = delete;
+
+		Self& operator=(const Self&) = delete;
+
+		/**
+		 * @brief Records a value.
+		 * @param value Value to record.
+		 */
+		void record(std::uint64_t value);
+
+		/**
+		 * @brief Gets a copy of histogram's counters.
+		 * @note Values recorded concurrently may be partially included.
+		 */
+		Snapshot snapshot() const;
+
+		/**
+		 * @brief Clears all recorded values.
+		 * @note Values recorded concurrently may be partially cleared.
+		 */
+		void reset();
+
+		/**
+		 * @brief Gets index of bucket a value is counted in.
+		 * @param value Value.
+		 * @return Bucket index, below `BUCKET_COUNT`.
+		 */
+		static std::size_t bucket_index(std::uint64_t value);
+
+		/**
+		 * @brief Gets highest value counted in a bucket.
+		 * @param index Bucket index.
+		 * @return Highest value of bucket.
+		 */
+		static std::uint64_t bucket_max(std::size_t index);
+
+	private:
+		std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> _counts{};
+		std::atomic<std::uint64_t> _count = 0;
+		std::atomic<std::uint64_t> _sum = 0;
+		std::atomic<std::uint64_t> _max = 0;
+	};
+}
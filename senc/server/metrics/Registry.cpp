@@ -0,0 +1,90 @@
+/*********************************************************************
+ * \file   Registry.cpp
+ * \brief  Implementation of Registry class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "Registry.hpp"
+
+#include <iomanip>
+#include <sstream>
+
+namespace senc::server::metrics
+{
+	Counter& Registry::counter(const std::string& name)
+	{
+		return get_or_add(_counters, name);
+	}
+
+	Gauge& Registry::gauge(const std::string& name)
+	{
+		return get_or_add(_gauges, name);
+	}
+
+	Histogram& Registry::histogram(const std::string& name)
+	{
+		return get_or_add(_histograms, name);
+	}
+
+	void Registry::sampled_gauge(const std::string& name, Sampler sampler)
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		_samplers.insert_or_assign(name, std::move(sampler));
+	}
+
+	std::vector<std::string> Registry::report() const
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		std::vector<std::string> res;
+
+		for (const auto& [name, counter] : _counters)
+			res.push_back("counter " + name + " = " + std::to_string(counter->value()));
+
+		// plain and sampled gauges, merged by name
+		std::map<std::string, std::int64_t> gauges;
+		for (const auto& [name, gauge] : _gauges)
+			gauges.emplace(name, gauge->value());
+		for (const auto& [name, sampler] : _samplers)
+			gauges.emplace(name, sampler());
+		for (const auto& [name, value] : gauges)
+			res.push_back("gauge " + name + " = " + std::to_string(value));
+
+		for (const auto& [name, histogram] : _histograms)
+		{
+			const auto snapshot = histogram->snapshot();
+			std::ostringstream line;
+			line << "histogram " << name
+				 << " count=" << snapshot.count()
+				 << " mean=" << std::fixed << std::setprecision(1) << snapshot.mean()
+				 << " p50=" << snapshot.percentile(50)
+				 << " p90=" << snapshot.percentile(90)
+				 << " p99=" << snapshot.percentile(99)
+				 << " p99.9=" << snapshot.percentile(99.9)
+				 << " max=" << snapshot.max();
+			res.push_back(line.str());
+		}
+
+		return res;
+	}
+
+	void Registry::reset()
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		for (auto& [name, counter] : _counters)
+			counter->reset();
+		for (auto& [name, histogram] : _histograms)
+			histogram->reset();
+	}
+
+	template <typename T>
+	T& Registry::get_or_add(std::map<std::string, std::unique_ptr<T>>& metrics, const std::string& name)
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		auto& metric = metrics[name];
+		if (!metric)
+			metric = std::make_unique<T>();
+		return *metric;
+	}
+}
@@ -0,0 +1,104 @@
+/*********************************************************************
+ * \file   Registry.hpp
+ * \brief  Header of Registry class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include "Histogram.hpp"
+#include "Counter.hpp"
+#include "Gauge.hpp"
+#include <functional>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <map>
+
+namespace senc::server::metrics
+{
+	/**
+	 * @class senc::server::metrics::Registry
+	 * @brief Named registry of server metrics (counters, gauges and histograms).
+	 * @note Lookups lock the registry, so hot paths should keep references to their metrics;
+	 *		 recording into a metric is lock-free. Metrics live as long as the registry.
+	 */
+	class Registry
+	{
+	public:
+		using Self = Registry;
+
+		/**
+		 * @typedef senc::server::metrics::Registry::Sampler
+		 * @brief Function computing a gauge value when reported.
+		 */
+		using Sampler = std::function<std::int64_t()>;
+
+		Registry() = default;
+
+		Registry(const Self&) = delete;
+
+		Self& operator=(const Self&) = delete;
+
+		/**
+		 * @brief Gets counter of a given name, registering it if needed.
+		 * @param name Name of counter.
+		 * @return Counter reference (valid for registry's lifetime).
+		 */
+		Counter& counter(const std::string& name);
+
+		/**
+		 * @brief Gets gauge of a given name, registering it if needed.
+		 * @param name Name of gauge.
+		 * @return Gauge reference (valid for registry's lifetime).
+		 */
+		Gauge& gauge(const std::string& name);
+
+		/**
+		 * @brief Gets histogram of a given name, registering it if needed.
+		 * @param name Name of histogram.
+		 * @return Histogram reference (valid for registry's lifetime).
+		 */
+		Histogram& histogram(const std::string& name);
+
+		/**
+		 * @brief Registers a gauge whose value is computed only when reported.
+		 * @param name Name of gauge.
+		 * @param sampler Function computing gauge value (must outlive registry, or be removed).
+		 * @note Suits values already kept elsewhere (e.g. queue depths), costing nothing until reported.
+		 */
+		void sampled_gauge(const std::string& name, Sampler sampler);
+
+		/**
+		 * @brief Formats all metrics, one per line (sorted by kind, then name).
+		 * @return Report lines.
+		 */
+		std::vector<std::string> report() const;
+
+		/**
+		 * @brief Resets all counters and histograms (gauges are left as they are).
+		 */
+		void reset();
+
+	private:
+		std::map<std::string, std::unique_ptr<Counter>> _counters;
+		std::map<std::string, std::unique_ptr<Gauge>> _gauges;
+		std::map<std::string, std::unique_ptr<Histogram>> _histograms;
+		std::map<std::string, Sampler> _samplers;
+		mutable std::mutex _mtx;
+
+		/**
+		 * @brief Gets metric of a given name from a map, registering it if needed.
+		 * @tparam T Metric type.
+		 * @param metrics Map of metrics of type.
+		 * @param name Name of metric.
+		 * @return Metric reference.
+		 */
+		template <typename T>
+		T& get_or_add(std::map<std::string, std::unique_ptr<T>>& metrics, const std::string& name);
+	};
+}
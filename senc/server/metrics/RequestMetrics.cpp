@@ -0,0 +1,49 @@
+/*********************************************************************
+ * \file   RequestMetrics.cpp
+ * \brief  Implementation of RequestMetrics class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "RequestMetrics.hpp"
+
+namespace senc::server::metrics
+{
+	RequestMetrics::RequestMetrics(Registry& registry)
+		: _updatePark(&registry.histogram("request.update_park_us"))
+	{
+		for (std::size_t i = 0; i < CODE_COUNT; ++i)
+			_latencies[i] = &registry.histogram(
+				std::string("request.") + request_name(static_cast<pkt::Code>(i)) + "_us"
+			);
+	}
+
+	Histogram& RequestMetrics::latency(pkt::Code code)
+	{
+		return *_latencies[static_cast<std::size_t>(code)];
+	}
+
+	Histogram& RequestMetrics::update_park()
+	{
+		return *_updatePark;
+	}
+
+	const char* RequestMetrics::request_name(pkt::Code code)
+	{
+		switch (code)
+		{
+		case pkt::Code::SignupRequest: return "signup";
+		case pkt::Code::LoginRequest: return "login";
+		case pkt::Code::LogoutRequest: return "logout";
+		case pkt::Code::MakeUserSetRequest: return "make_userset";
+		case pkt::Code::GetUserSetsRequest: return "get_usersets";
+		case pkt::Code::GetMembersRequest: return "get_members";
+		case pkt::Code::DecryptRequest: return "decrypt";
+		case pkt::Code::UpdateRequest: return "update";
+		case pkt::Code::DecryptParticipateRequest: return "decrypt_participate";
+		case pkt::Code::SendDecryptionPartRequest: return "send_decryption_part";
+		default: return "other";
+		}
+	}
+}
@@ -0,0 +1,61 @@
+/*********************************************************************
+ * \file   RequestMetrics.hpp
+ * \brief  Header of RequestMetrics class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include "../../common/packets.hpp"
+#include "Registry.hpp"
+#include <array>
+
+namespace senc::server::metrics
+{
+	/**
+	 * @class senc::server::metrics::RequestMetrics
+	 * @brief Latency histograms of requests, by packet code (resolved once, so lookups are lock-free).
+	 * @note Histogram of each request is named "request.<name>_us" (e.g. "request.login_us").
+	 * @note Time an update request is parked waiting for updates (long-poll) is recorded in
+	 *		 "request.update_park_us", and excluded from "request.update_us".
+	 */
+	class RequestMetrics
+	{
+	public:
+		using Self = RequestMetrics;
+
+		static constexpr std::size_t CODE_COUNT = static_cast<std::size_t>(pkt::Code::SendDecryptionPartResponse) + 1;
+
+		/**
+		 * @brief Registers request histograms.
+		 * @param registry Registry to register histograms in.
+		 */
+		explicit RequestMetrics(Registry& registry);
+
+		/**
+		 * @brief Gets latency histogram of a request (in microseconds, counting requests as well).
+		 * @param code Code of request packet.
+		 * @return Histogram reference.
+		 */
+		Histogram& latency(pkt::Code code);
+
+		/**
+		 * @brief Gets histogram of time update requests are parked waiting for updates (in microseconds).
+		 * @return Histogram reference.
+		 */
+		Histogram& update_park();
+
+	private:
+		std::array<Histogram*, CODE_COUNT> _latencies;
+		Histogram* _updatePark;
+
+		/**
+		 * @brief Gets name of a request, as used in histogram names.
+		 * @param code Code of request packet.
+		 * @return Request name ("other" for non-request codes).
+		 */
+		static const char* request_name(pkt::Code code);
+	};
+}
@@ -0,0 +1,70 @@
+/*********************************************************************
+ * \file   ScopedTimer.hpp
+ * \brief  Contains ScopedTimer class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include "Histogram.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace senc::server::metrics
+{
+	/**
+	 * @class senc::server::metrics::ScopedTimer
+	 * @brief Records time spent in its scope into a histogram (in microseconds).
+	 */
+	class ScopedTimer
+	{
+	public:
+		using Self = ScopedTimer;
+		using Clock = std::chrono::steady_clock;
+
+		/**
+		 * @brief Starts timer.
+		 * @param histogram Histogram to record time into.
+		 */
+		explicit ScopedTimer(Histogram& histogram)
+			: _histogram(histogram), _start(Clock::now()) { }
+
+		ScopedTimer(const Self&) = delete;
+
+		Self& operator=(const Self&) = delete;
+
+		/**
+		 * @brief Stops timer, recording time since started.
+		 */
+		~ScopedTimer()
+		{
+			const auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+				std::max(elapsed(), Clock::duration::zero())
+			);
+			_histogram.record(static_cast<std::uint64_t>(us.count()));
+		}
+
+		/**
+		 * @brief Gets time since started (less excluded time).
+		 */
+		Clock::duration elapsed() const
+		{
+			return Clock::now() - _start;
+		}
+
+		/**
+		 * @brief Excludes time from recorded time (e.g. time spent parked, recorded elsewhere).
+		 * @param duration Time to exclude.
+		 */
+		void exclude(Clock::duration duration)
+		{
+			_start += duration;
+		}
+
+	private:
+		Histogram& _histogram;
+		Clock::time_point _start;
+	};
+}
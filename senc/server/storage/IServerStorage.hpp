@@ -15,6 +15,11 @@
 #include <string>
 #include <vector>
 
+namespace senc::server::metrics
+{
+	class Registry;
+}
+
 namespace senc::server::storage
 {
 	/**
@@ -221,5 +226,12 @@ namespace senc::server::storage
 		 * @throw ServerStorageException In case of error.
 		 */
 		virtual PrivKeyShardID get_shard_id(const std::string& user, const UserSetID& userset) = 0;
+
+		/**
+		 * @brief Registers storage gauges (if any) on a metrics registry.
+		 * @param registry Registry to register gauges on (storage must outlive its reports).
+		 * @note Storages have no gauges by default.
+		 */
+		virtual void register_gauges(metrics::Registry& registry) { (void)registry; }
 	};
 }
@@ -0,0 +1,81 @@
+/*********************************************************************
+ * \file   MeteredServerStorage.cpp
+ * \brief  Implementation of MeteredServerStorage class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "MeteredServerStorage.hpp"
+
+#include "../metrics/ScopedTimer.hpp"
+
+namespace senc::server::storage
+{
+	MeteredServerStorage::MeteredServerStorage(IServerStorage& storage, metrics::Registry& registry)
+		: _storage(storage),
+		  _newUser(registry.histogram("storage.new_user_us")),
+		  _userExists(registry.histogram("storage.user_exists_us")),
+		  _userHasPassword(registry.histogram("storage.user_has_password_us")),
+		  _newUserSet(registry.histogram("storage.new_userset_us")),
+		  _getUserSets(registry.histogram("storage.get_usersets_us")),
+		  _userOwnsUserSet(registry.histogram("storage.user_owns_userset_us")),
+		  _getUserSetInfo(registry.histogram("storage.get_userset_info_us")),
+		  _getShardID(registry.histogram("storage.get_shard_id_us")) { }
+
+	void MeteredServerStorage::new_user(const std::string& username, const std::string& password)
+	{
+		const metrics::ScopedTimer timer(_newUser);
+		_storage.new_user(username, password);
+	}
+
+	bool MeteredServerStorage::user_exists(const std::string& username)
+	{
+		const metrics::ScopedTimer timer(_userExists);
+		return _storage.user_exists(username);
+	}
+
+	bool MeteredServerStorage::user_has_password(const std::string& username, const std::string& password)
+	{
+		const metrics::ScopedTimer timer(_userHasPassword);
+		return _storage.user_has_password(username, password);
+	}
+
+	UserSetID MeteredServerStorage::new_userset(utils::ranges::StringViewRange&& owners,
+												utils::ranges::StringViewRange&& regMembers,
+												member_count_t ownersThreshold,
+												member_count_t regMembersThreshold)
+	{
+		const metrics::ScopedTimer timer(_newUserSet);
+		return _storage.new_userset(std::move(owners), std::move(regMembers), ownersThreshold, regMembersThreshold);
+	}
+
+	std::vector<UserSetID> MeteredServerStorage::get_usersets(const std::string& owner)
+	{
+		const metrics::ScopedTimer timer(_getUserSets);
+		return _storage.get_usersets(owner);
+	}
+
+	bool MeteredServerStorage::user_owns_userset(const std::string& user, const UserSetID& userset)
+	{
+		const metrics::ScopedTimer timer(_userOwnsUserSet);
+		return _storage.user_owns_userset(user, userset);
+	}
+
+	UserSetInfo MeteredServerStorage::get_userset_info(const UserSetID& userset)
+	{
+		const metrics::ScopedTimer timer(_getUserSetInfo);
+		return _storage.get_userset_info(userset);
+	}
+
+	PrivKeyShardID MeteredServerStorage::get_shard_id(const std::string& user, const UserSetID& userset)
+	{
+		const metrics::ScopedTimer timer(_getShardID);
+		return _storage.get_shard_id(user, userset);
+	}
+
+	void MeteredServerStorage::register_gauges(metrics::Registry& registry)
+	{
+		_storage.register_gauges(registry);
+	}
+}
@@ -0,0 +1,66 @@
+/*********************************************************************
+ * \file   MeteredServerStorage.hpp
+ * \brief  Header of MeteredServerStorage class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include "../metrics/Registry.hpp"
+#include "IServerStorage.hpp"
+
+namespace senc::server::storage
+{
+	/**
+	 * @class senc::server::storage::MeteredServerStorage
+	 * @brief Implementation of `IServerStorage` which wraps another one, recording latency of each call.
+	 * @note Histogram of each method is named "storage.<method>_us" (e.g. "storage.new_user_us").
+	 * @note Gauges of underlying storage are registered through `register_gauges`.
+	 */
+	class MeteredServerStorage : public IServerStorage
+	{
+	public:
+		using Self = MeteredServerStorage;
+
+		/**
+		 * @brief Constructs a metered storage.
+		 * @param storage Underlying storage (assumed to be thread-safe).
+		 * @param registry Registry to record call latencies into.
+		 */
+		explicit MeteredServerStorage(IServerStorage& storage, metrics::Registry& registry);
+
+		void new_user(const std::string& username, const std::string& password) override;
+
+		bool user_exists(const std::string& username) override;
+
+		bool user_has_password(const std::string& username, const std::string& password) override;
+
+		UserSetID new_userset(utils::ranges::StringViewRange&& owners,
+							  utils::ranges::StringViewRange&& regMembers,
+							  member_count_t ownersThreshold,
+							  member_count_t regMembersThreshold) override;
+
+		std::vector<UserSetID> get_usersets(const std::string& owner) override;
+
+		bool user_owns_userset(const std::string& user, const UserSetID& userset) override;
+
+		UserSetInfo get_userset_info(const UserSetID& userset) override;
+
+		PrivKeyShardID get_shard_id(const std::string& user, const UserSetID& userset) override;
+
+		void register_gauges(metrics::Registry& registry) override;
+
+	private:
+		IServerStorage& _storage;
+		metrics::Histogram& _newUser;
+		metrics::Histogram& _userExists;
+		metrics::Histogram& _userHasPassword;
+		metrics::Histogram& _newUserSet;
+		metrics::Histogram& _getUserSets;
+		metrics::Histogram& _userOwnsUserSet;
+		metrics::Histogram& _getUserSetInfo;
+		metrics::Histogram& _getShardID;
+	};
+}
@@ -8,29 +8,33 @@
 
 #include "SqliteServerStorage.hpp"
 
+#include "../metrics/Registry.hpp"
+
 namespace sql = senc::utils::sqlite;
 
 namespace senc::server::storage
 {
-	SqliteServerStorage::SqliteServerStorage(const std::string& path)
-		: _db(path),
+	SqliteServerStorage::SqliteServerStorage(const std::string& path, std::size_t readers)
+		: _pool(path, readers),
 		  _shardsDist(utils::Random<PrivKeyShardID>::get_range_dist(1, MAX_MEMBERS)) { }
 
 	void SqliteServerStorage::new_user(const std::string& username, const std::string& password)
 	{
-		if (user_exists(username))
-			throw UserExistsException(username);
-
 		auto pwdSalt = _pwdHasher.generate_salt();
 		auto pwdHash = _pwdHasher.hash(password, pwdSalt);
 
-		const std::lock_guard<std::mutex> lock(_mtxDB);
 		try
 		{
-			this->_db.insert<"Users">(
-				sql::TextView(username),
-				sql::BlobView(pwdSalt), sql::BlobView(pwdHash)
-			);
+			// checked on writer connection, so no other write can insert user in between
+			_pool.write([&](Connection& db)
+			{
+				if (query_user_exists(db, username))
+					throw UserExistsException(username);
+				db.insert<"Users">(
+					sql::TextView(username),
+					sql::BlobView(pwdSalt), sql::BlobView(pwdHash)
+				);
+			});
 		}
 		catch (utils::sqlite::SQLiteException& e)
 		{
@@ -43,24 +47,7 @@ namespace senc::server::storage
 
 	bool SqliteServerStorage::user_exists(const std::string& username)
 	{
-		bool found = false;
-		const std::lock_guard<std::mutex> lock(_mtxDB);
-
-		try
-		{
-			this->_db.select<"Users", sql::SelectArg<"username">>()
-				.where("username = " + sql::Text(username).as_sqlite())
-				>> [&found](sql::TextView) { found = true; };
-		}
-		catch (utils::sqlite::SQLiteException& e)
-		{
-			throw ServerStorageException(
-				"Failed to search user in database",
-				e.what()
-			);
-		}
-
-		return found;
+		return _pool.read([&username](Connection& db) { return query_user_exists(db, username); });
 	}
 
 	bool SqliteServerStorage::user_has_password(const std::string& username, const std::string& password)
@@ -71,16 +58,18 @@ namespace senc::server::storage
 
 		try
 		{
-			const std::lock_guard<std::mutex> lock(_mtxDB);
-			this->_db.select<"Users", sql::SelectArg<"pwd_salt">, sql::SelectArg<"pwd_hash">>()
-				.where("username = " + sql::Text(username).as_sqlite())
-				>> [&found, &pwdSalt, &pwdHash](sql::BlobView salt, sql::BlobView hash)
-				{
-					// TODO: Replace memcpy calls with direct call once pwdhash supports views
-					std::memcpy(pwdSalt.data(), salt.get().data(), std::min(salt.get().size(), pwdSalt.size()));
-					std::memcpy(pwdHash.data(), hash.get().data(), std::min(hash.get().size(), pwdHash.size()));
-					found = true;
-				};
+			_pool.read([&](Connection& db)
+			{
+				db.select<"Users", sql::SelectArg<"pwd_salt">, sql::SelectArg<"pwd_hash">>()
+					.where<"username">(sql::TextView(username))
+					>> [&found, &pwdSalt, &pwdHash](sql::BlobView salt, sql::BlobView hash)
+					{
+						// TODO: Replace memcpy calls with direct call once pwdhash supports views
+						std::memcpy(pwdSalt.data(), salt.get().data(), std::min(salt.get().size(), pwdSalt.size()));
+						std::memcpy(pwdHash.data(), hash.get().data(), std::min(hash.get().size(), pwdHash.size()));
+						found = true;
+					};
+			});
 		}
 		catch (utils::sqlite::SQLiteException& e)
 		{
@@ -104,22 +93,57 @@ namespace senc::server::storage
 		auto readOwners = utils::to_ordered_set<std::string>(owners);
 		auto readRegMembers = utils::to_ordered_set<std::string>(regMembers);
 
-		// check if all members exist
-		for (const auto& member : utils::views::join(readOwners, readRegMembers))
-			if (!user_exists(member))
-				throw UserNotFoundException(member);
+		// generate shard IDs for all members
+		// (unique within userset, and userset is new so no existing member can collide)
+		utils::HashSet<PrivKeyShardID> shardIDs;
+		std::vector<std::tuple<sql::TextView, sql::Blob, sql::Int>> members; // (username, shard ID, is owner)
+		const auto addMember = [this, &shardIDs, &members](const std::string& member, bool isOwner)
+		{
+			auto shardID = _shardsDist(shardIDs);
+			shardIDs.insert(shardID);
+
+			utils::Buffer shardIDBytes(shardID.MinEncodedSize());
+			shardID.Encode(shardIDBytes.data(), shardIDBytes.size());
+			members.emplace_back(sql::TextView(member), sql::Blob(std::move(shardIDBytes)), sql::Int(isOwner));
+		};
+		for (const auto& owner : readOwners)
+			addMember(owner, true);
+		for (const auto& regMember : readRegMembers)
+			addMember(regMember, false);
 
-		// generate set ID and insert new userset
-		const auto setID = generate_unique_userset_id();
-		const sql::BlobView setIDBlobView(setID.data(), setID.size());
+		// check members, then insert userset and its members, all in one transaction
 		try
 		{
-			const std::lock_guard<std::mutex> lock(_mtxDB);
-			this->_db.insert<"UserSets">(
-				setIDBlobView,
-				sql::Int(ownersThreshold),
-				sql::Int(regMembersThreshold)
-			);
+			return _pool.write([&](Connection& db)
+			{
+				return db.transaction([&]()
+				{
+					// check if all members exist
+					for (const auto& member : utils::views::join(readOwners, readRegMembers))
+						if (!query_user_exists(db, member))
+							throw UserNotFoundException(member);
+
+					// generate set ID and insert new userset
+					const auto setID = generate_unique_userset_id(db);
+					const sql::BlobView setIDBlobView(setID.data(), setID.size());
+					db.insert<"UserSets">(
+						setIDBlobView,
+						sql::Int(ownersThreshold),
+						sql::Int(regMembersThreshold)
+					);
+
+					// register shard IDs for all members
+					db.insert_many<"Members">(
+						members | std::views::transform([&setIDBlobView](const auto& row)
+						{
+							const auto& [member, shardIDBytes, isOwner] = row;
+							return std::make_tuple(member, setIDBlobView, shardIDBytes, isOwner);
+						})
+					);
+
+					return setID;
+				});
+			});
 		}
 		catch (utils::sqlite::SQLiteException& e)
 		{
@@ -128,59 +152,28 @@ namespace senc::server::storage
 				e.what()
 			);
 		}
-
-		// register shard IDs for all members
-		auto markedMembers = utils::views::join(
-			readOwners | std::views::transform([](auto&& x) { return std::make_pair(x, true); }),
-			readRegMembers | std::views::transform([](auto&& x) { return std::make_pair(x, false); })
-		);
-		for (const auto& [member, isOwner] : markedMembers)
-		{
-			auto shardID = generate_unique_shard_id(setID);
-
-			utils::Buffer shardIDBytes(shardID.MinEncodedSize());
-			shardID.Encode(shardIDBytes.data(), shardIDBytes.size());
-
-			const std::lock_guard<std::mutex> lock(_mtxDB);
-			try
-			{
-				this->_db.insert<"Members">(
-					sql::TextView(member),
-					setIDBlobView,
-					sql::BlobView(shardIDBytes),
-					sql::Int(isOwner)
-				);
-			}
-			catch (utils::sqlite::SQLiteException& e)
-			{
-				throw ServerStorageException(
-					"Failed to register shard ID into database",
-					e.what()
-				);
-			}
-		}
-
-		return setID;
 	}
 
 	std::vector<UserSetID> SqliteServerStorage::get_usersets(const std::string& owner)
 	{
 		std::vector<UserSetID> res;
-		const std::lock_guard<std::mutex> lock(_mtxDB);
 		try
 		{
-			this->_db.select<"Members", sql::SelectArg<"userset_id">>()
-				.where("username = " + sql::TextView(owner).as_sqlite())
-				.where("is_owner != 0")
-				>> [&res](sql::BlobView usersetIDBytes)
-				{
-					res.emplace_back();
-					std::memcpy(
-						res.back().data(),
-						usersetIDBytes.get().data(),
-						std::min(res.back().size(), usersetIDBytes.get().size())
-					);
-				};
+			_pool.read([&](Connection& db)
+			{
+				db.select<"Members", sql::SelectArg<"userset_id">>()
+					.where<"username">(sql::TextView(owner))
+					.where("is_owner != 0")
+					>> [&res](sql::BlobView usersetIDBytes)
+					{
+						res.emplace_back();
+						std::memcpy(
+							res.back().data(),
+							usersetIDBytes.get().data(),
+							std::min(res.back().size(), usersetIDBytes.get().size())
+						);
+					};
+			});
 		}
 		catch (utils::sqlite::SQLiteException& e)
 		{
@@ -195,14 +188,16 @@ namespace senc::server::storage
 	bool SqliteServerStorage::user_owns_userset(const std::string& user, const UserSetID& userset)
 	{
 		bool found = false;
-		const std::lock_guard<std::mutex> lock(_mtxDB);
 		try
 		{
-			this->_db.select<"Members", sql::SelectArg<"username">>()
-				.where("username = " + sql::TextView(user).as_sqlite())
-				.where("userset_id = " + sql::BlobView(userset.data(), userset.size()).as_sqlite())
-				.where("is_owner != 0")
-				>> [&found](sql::TextView) { found = true; };
+			_pool.read([&](Connection& db)
+			{
+				db.select<"Members", sql::SelectArg<"username">>()
+					.where<"username">(sql::TextView(user))
+					.where<"userset_id">(sql::BlobView(userset.data(), userset.size()))
+					.where("is_owner != 0")
+					>> [&found](sql::TextView) { found = true; };
+			});
 		}
 		catch (utils::sqlite::SQLiteException& e)
 		{
@@ -219,43 +214,31 @@ namespace senc::server::storage
 		UserSetInfo res{};
 		const sql::BlobView usersetBlob(userset.data(), userset.size());
 
-		// read thresholds from DB
+		// read thresholds and locate members, on the same connection
+		try
 		{
-			std::tuple<sql::Int, sql::Int> thresholds;
-			const std::lock_guard<std::mutex> lock(_mtxDB);
-			try
+			_pool.read([&](Connection& db)
 			{
-				this->_db.select<"UserSets",
+				std::tuple<sql::Int, sql::Int> thresholds;
+				db.select<"UserSets",
 					sql::SelectArg<"owners_threshold">,
 					sql::SelectArg<"reg_members_threshold">>()
-					.where("id = " + usersetBlob.as_sqlite())
+					.where<"id">(usersetBlob)
 					>> thresholds;
 				auto [ownersThreshold, regMembersThreshold] = thresholds;
 				res.owners_threshold = static_cast<member_count_t>(ownersThreshold);
 				res.reg_members_threshold = static_cast<member_count_t>(regMembersThreshold);
-			}
-			catch (utils::sqlite::SQLiteException& e)
-			{
-				throw ServerStorageException(
-					"Failed to search userset in database",
-					e.what()
-				);
-			}
-		}
 
-		// locate members from DB
-		try
-		{
-			const std::lock_guard<std::mutex> lock(_mtxDB);
-			this->_db.select<"Members", sql::SelectArg<"username">, sql::SelectArg<"is_owner">>()
-				.where("userset_id = " + usersetBlob.as_sqlite())
-				>> [&res](sql::TextView name, sql::IntView isOwner)
-				{
-					if (isOwner.get())
-						res.owners.emplace_back(name.get());
-					else
-						res.reg_members.emplace_back(name.get());
-				};
+				db.select<"Members", sql::SelectArg<"username">, sql::SelectArg<"is_owner">>()
+					.where<"userset_id">(usersetBlob)
+					>> [&res](sql::TextView name, sql::IntView isOwner)
+					{
+						if (isOwner.get())
+							res.owners.emplace_back(name.get());
+						else
+							res.reg_members.emplace_back(name.get());
+					};
+			});
 		}
 		catch (utils::sqlite::SQLiteException& e)
 		{
@@ -271,17 +254,19 @@ namespace senc::server::storage
 	PrivKeyShardID SqliteServerStorage::get_shard_id(const std::string& user, const UserSetID& userset)
 	{
 		PrivKeyShardID res{};
-		const std::lock_guard<std::mutex> lock(_mtxDB);
 		try
 		{
-			this->_db.select<"Members", sql::SelectArg<"shard_id">>()
-				.where("username = " + sql::TextView(user).as_sqlite())
-				.where("userset_id = " + sql::BlobView(userset.data(), userset.size()).as_sqlite())
-				>> [&res](sql::BlobView bytes)
-				{
-					auto view = bytes.get();
-					res.Decode(view.data(), view.size());
-				};
+			_pool.read([&](Connection& db)
+			{
+				db.select<"Members", sql::SelectArg<"shard_id">>()
+					.where<"username">(sql::TextView(user))
+					.where<"userset_id">(sql::BlobView(userset.data(), userset.size()))
+					>> [&res](sql::BlobView bytes)
+					{
+						auto view = bytes.get();
+						res.Decode(view.data(), view.size());
+					};
+			});
 		}
 		catch (utils::sqlite::SQLiteException& e)
 		{
@@ -293,61 +278,77 @@ namespace senc::server::storage
 		return res;
 	}
 
-	bool SqliteServerStorage::userset_exists(const UserSetID& usersetID)
+	void SqliteServerStorage::register_gauges(metrics::Registry& registry)
+	{
+		registry.sampled_gauge("storage.readers", [this]() -> std::int64_t
+		{
+			return _pool.stats().readers;
+		});
+		registry.sampled_gauge("storage.readers_in_use", [this]() -> std::int64_t
+		{
+			return _pool.stats().readers_in_use;
+		});
+		registry.sampled_gauge("storage.reads", [this]() -> std::int64_t
+		{
+			return _pool.stats().reads;
+		});
+		registry.sampled_gauge("storage.read_waits", [this]() -> std::int64_t
+		{
+			return _pool.stats().read_waits;
+		});
+		registry.sampled_gauge("storage.writes", [this]() -> std::int64_t
+		{
+			return _pool.stats().writes;
+		});
+	}
+
+	utils::sqlite::ConnectionPoolStats SqliteServerStorage::pool_stats() const
+	{
+		return _pool.stats();
+	}
+
+	bool SqliteServerStorage::query_user_exists(Connection& db, const std::string& username)
 	{
 		bool found = false;
-		const std::lock_guard<std::mutex> lock(_mtxDB);
 		try
 		{
-			this->_db.select<"UserSets", sql::SelectArg<"id">>()
-				.where("id = " + sql::BlobView(usersetID.data(), usersetID.size()).as_sqlite())
-				>> [&found](sql::BlobView) { found = true; };
+			db.select<"Users", sql::SelectArg<"username">>()
+				.where<"username">(sql::TextView(username))
+				>> [&found](sql::TextView) { found = true; };
 		}
 		catch (utils::sqlite::SQLiteException& e)
 		{
 			throw ServerStorageException(
-				"Failed to search userset in database",
+				"Failed to search user in database",
 				e.what()
 			);
 		}
 		return found;
 	}
 
-	UserSetID SqliteServerStorage::generate_unique_userset_id()
+	bool SqliteServerStorage::query_userset_exists(Connection& db, const UserSetID& usersetID)
 	{
-		return UserSetID::generate_not_pred(
-			[this](const UserSetID& id) { return this->userset_exists(id); }
-		);
-	}
-
-	bool SqliteServerStorage::shard_id_exists(const PrivKeyShardID& shardID, const UserSetID& usersetID)
-	{
-		utils::Buffer shardIDBytes(shardID.MinEncodedSize());
-		shardID.Encode(shardIDBytes.data(), shardIDBytes.size());
-
 		bool found = false;
-		const std::lock_guard<std::mutex> lock(_mtxDB);
 		try
 		{
-			this->_db.select<"Members", sql::SelectArg<"username">>()
-				.where("shard_id = " + sql::BlobView(shardIDBytes).as_sqlite())
-				.where("userset_id = " + sql::BlobView(usersetID.data(), usersetID.size()).as_sqlite())
-				>> [&found](sql::TextView) { found = true; };
+			db.select<"UserSets", sql::SelectArg<"id">>()
+				.where<"id">(sql::BlobView(usersetID.data(), usersetID.size()))
+				>> [&found](sql::BlobView) { found = true; };
 		}
 		catch (utils::sqlite::SQLiteException& e)
 		{
 			throw ServerStorageException(
-				"Failed to search userset member in database",
+				"Failed to search userset in database",
 				e.what()
 			);
 		}
 		return found;
 	}
 
-	PrivKeyShardID SqliteServerStorage::generate_unique_shard_id(const UserSetID& usersetID)
+	UserSetID SqliteServerStorage::generate_unique_userset_id(Connection& db)
 	{
-		return _shardsDist(
-			[this, &usersetID](const PrivKeyShardID& id) { return this->shard_id_exists(id, usersetID); }
+		return UserSetID::generate_not_pred(
+			[&db](const UserSetID& id) { return query_userset_exists(db, id); }
 		);
 	}
 }
@@ -8,27 +8,31 @@
 
 #pragma once
 
-#include "../../utils/sqlite/Database.hpp"
+#include "../../utils/sqlite/ConnectionPool.hpp"
 #include "IServerStorage.hpp"
 #include "../aliases.hpp"
-#include <mutex>
 
 namespace senc::server::storage
 {
 	/**
 	 * @class senc::server::storage::SqliteServerStorage
 	 * @brief Implementation of `IServerStorage` which uses an SQLite database.
+	 * @note Database is in WAL mode: writes go through a single connection, while reads run in
+	 *       parallel on a pool of read-only connections.
 	 */
 	class SqliteServerStorage : public IServerStorage
 	{
 	public:
 		using Self = SqliteServerStorage;
 
+		static constexpr std::size_t DEFAULT_READERS = 4;
+
 		/**
 		 * @brief Constructs a new SQLite server storage instance.
 		 * @param path Path to SQLite database file.
+		 * @param readers Amount of read-only database connections (zero to read through writer).
 		 */
-		SqliteServerStorage(const std::string& path);
+		SqliteServerStorage(const std::string& path, std::size_t readers = DEFAULT_READERS);
 
 		void new_user(const std::string& username, const std::string& password) override;
 
@@ -49,12 +53,21 @@ namespace senc::server::storage
 
 		PrivKeyShardID get_shard_id(const std::string& user, const UserSetID& userset) override;
 
+		void register_gauges(metrics::Registry& registry) override;
+
+		/**
+		 * @brief Gets database connection pool counters.
+		 * @return Connection pool counters.
+		 */
+		utils::sqlite::ConnectionPoolStats pool_stats() const;
+
 	private:
 		// Schema:
 		// Users(username TEXT PK, pwd_salt BLOB, pwd_hash BLOB)
 		// UserSets(id PK BLOB, owners_threshold INT, reg_members_threshold INT)
 		// Members(username TEXT FK[Users.username], userset_id BLOB FK[UserSets.id], shard_id BLOB, is_owner INT)
-		utils::sqlite::Database<utils::sqlite::schemas::DB<
+		// Indexes: Members(username, userset_id), UNIQUE Members(userset_id, shard_id)
+		using Schema = utils::sqlite::schemas::DB<
 			utils::sqlite::schemas::Table<"Users",
 				utils::sqlite::schemas::PrimaryKey<"username", utils::sqlite::Text>,
 				utils::sqlite::schemas::Col       <"pwd_salt", utils::sqlite::Blob>,
@@ -70,39 +83,38 @@ namespace senc::server::storage
 				utils::sqlite::schemas::ForeignKey<"userset_id", utils::sqlite::Blob, "UserSets", "id">,
 				utils::sqlite::schemas::Col       <"shard_id"  , utils::sqlite::Blob                  >,
 				utils::sqlite::schemas::Col       <"is_owner"  , utils::sqlite::Int                   >
-			>
-		>> _db;
-		std::mutex _mtxDB;
+			>,
+			utils::sqlite::schemas::Index      <"Members", "username"  , "userset_id">,
+			utils::sqlite::schemas::UniqueIndex<"Members", "userset_id", "shard_id"  >
+		>;
+		using Connection = utils::sqlite::ConnectionPool<Schema>::Connection;
+
+		utils::sqlite::ConnectionPool<Schema> _pool;
 
 		utils::Distribution<PrivKeyShardID> _shardsDist;
 		PwdHasher _pwdHasher;
 
+		/**
+		 * @brief Checks if a user exists.
+		 * @param db Database connection to query (lent by `_pool`).
+		 * @param username Username to check if exists.
+		 * @return `true` if user exists, otherwise `false`.
+		 */
+		static bool query_user_exists(Connection& db, const std::string& username);
+
 		/**
 		 * @brief Checks if a userset ID is of an existing userset.
+		 * @param db Database connection to query (lent by `_pool`).
 		 * @param usersetID Userset ID to check if is of an existing userset.
 		 * @return `true` if `usersetID` is an ID of an existing userset, otherwise `false`.
 		 */
-		bool userset_exists(const UserSetID& usersetID);
+		static bool query_userset_exists(Connection& db, const UserSetID& usersetID);
 
 		/**
 		 * @brief Generates a unique userset ID.
+		 * @param db Database connection to query (writer connection, so ID stays unique).
 		 * @return Generated userset ID.
 		 */
-		UserSetID generate_unique_userset_id();
-
-		/**
-		 * @brief Checks if a shard ID exists within a userset.
-		 * @param shardID Shard ID to check if exists, in the form of a blob view.
-		 * @param usersetID Userset ID.
-		 * @return `true` if `shardID` exists in userset with ID `usersetID`, otherwise `false`.
-		 */
-		bool shard_id_exists(const PrivKeyShardID& shardID, const UserSetID& usersetID);
-
-		/**
-		 * @brief Generates a unique shard ID for a userset member.
-		 * @param usersetID ID of userset.
-		 * @return Generated shard ID.
-		 */
-		PrivKeyShardID generate_unique_shard_id(const UserSetID& usersetID);
+		static UserSetID generate_unique_userset_id(Connection& db);
 	};
 }
@@ -0,0 +1,132 @@
+/*********************************************************************
+ * \file   WorkerPool.cpp
+ * \brief  Implementation of WorkerPool class.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+namespace senc::server::workers
+{
+	WorkerPool::WorkerPool(std::size_t threadCount, std::size_t queueCapacity, FullPolicy fullPolicy)
+		: _queueCapacity(std::max<std::size_t>(queueCapacity, 1)), _fullPolicy(fullPolicy)
+	{
+		_workers.reserve(threadCount);
+		for (std::size_t i = 0; i < threadCount; ++i)
+			_workers.emplace_back(&Self::work, this);
+	}
+
+	WorkerPool::~WorkerPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock(_mtxQueue);
+			_isStopping = true;
+		}
+		_cvNotEmpty.notify_all();
+		_workers.clear(); // joins workers (after queue is drained)
+	}
+
+	WorkerPool::Stats WorkerPool::stats() const
+	{
+		std::size_t queueDepth = 0;
+		{
+			const std::lock_guard<std::mutex> lock(_mtxQueue);
+			queueDepth = _queue.size();
+		}
+
+		return Stats{
+			.threads = _workers.size(),
+			.queue_capacity = _queueCapacity,
+			.queue_depth = queueDepth,
+			.max_queue_depth = _maxQueueDepth,
+			.executed = _executed,
+			.blocked_submits = _blockedSubmits,
+			.rejected_submits = _rejectedSubmits,
+			.total_wait = std::chrono::nanoseconds(_totalWaitNs),
+			.max_wait = std::chrono::nanoseconds(_maxWaitNs)
+		};
+	}
+
+	void WorkerPool::reset_stats()
+	{
+		// peak depth is updated under queue lock (see `push`), so reset it under lock too
+		const std::lock_guard<std::mutex> lock(_mtxQueue);
+		_maxQueueDepth = 0;
+		_executed = 0;
+		_blockedSubmits = 0;
+		_rejectedSubmits = 0;
+		_totalWaitNs = 0;
+		_maxWaitNs = 0;
+	}
+
+	void WorkerPool::push(std::function<void()> run)
+	{
+		std::unique_lock<std::mutex> lock(_mtxQueue);
+		if (_queue.size() >= _queueCapacity)
+		{
+			if (FullPolicy::Reject == _fullPolicy)
+			{
+				++_rejectedSubmits;
+				throw WorkerPoolFullException("Server is busy, try again later");
+			}
+			++_blockedSubmits;
+			_cvNotFull.wait(lock, [this]() { return _queue.size() < _queueCapacity; });
+		}
+
+		_queue.push_back(Job{ std::move(run), Clock::now() });
+
+		// update peak depth (only written under queue lock, so no CAS needed)
+		if (_queue.size() > _maxQueueDepth)
+			_maxQueueDepth = _queue.size();
+
+		lock.unlock();
+		_cvNotEmpty.notify_one();
+	}
+
+	void WorkerPool::work()
+	{
+		while (true)
+		{
+			Job job;
+			{
+				std::unique_lock<std::mutex> lock(_mtxQueue);
+				_cvNotEmpty.wait(lock, [this]() { return _isStopping || !_queue.empty(); });
+				if (_queue.empty())
+					return; // stopping, and nothing left to run
+				job = std::move(_queue.front());
+				_queue.pop_front();
+				++_running;
+			}
+			_cvNotFull.notify_one();
+
+			record_wait(Clock::now() - job.enqueued);
+			job.run(); // exceptions are captured into task's result (which also counts it as executed)
+			job.run = nullptr; // drop task's state (e.g. its callback) before counted as finished
+
+			{
+				const std::lock_guard<std::mutex> lock(_mtxQueue);
+				if (0 == --_running && _queue.empty())
+					_cvIdle.notify_all();
+			}
+		}
+	}
+
+	void WorkerPool::wait_idle()
+	{
+		std::unique_lock<std::mutex> lock(_mtxQueue);
+		_cvIdle.wait(lock, [this]() { return 0 == _running && _queue.empty(); });
+	}
+
+	void WorkerPool::record_wait(Clock::duration wait)
+	{
+		const std::int64_t waitNs = std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count();
+		_totalWaitNs += waitNs;
+
+		std::int64_t prevMax = _maxWaitNs;
+		while (waitNs > prevMax && !_maxWaitNs.compare_exchange_weak(prevMax, waitNs)) { }
+	}
+}
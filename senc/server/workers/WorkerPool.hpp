@@ -0,0 +1,208 @@
+/*********************************************************************
+ * \file   WorkerPool.hpp
+ * \brief  Header of WorkerPool class.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <type_traits>
+#include <functional>
+#include <concepts>
+#include <cstdint>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <future>
+#include <mutex>
+#include <deque>
+#include "../ServerException.hpp"
+
+namespace senc::server::workers
+{
+	/**
+	 * @class senc::server::workers::WorkerPoolFullException
+	 * @brief Type of exceptions thrown when a task is rejected since worker pool queue is full.
+	 */
+	class WorkerPoolFullException : public ServerException
+	{
+	public:
+		using Self = WorkerPoolFullException;
+		using Base = ServerException;
+
+		WorkerPoolFullException(const std::string& msg) : Base(msg) { }
+
+		WorkerPoolFullException(std::string&& msg) : Base(std::move(msg)) { }
+
+		WorkerPoolFullException(const std::string& msg, const std::string& info) : Base(msg, info) { }
+
+		WorkerPoolFullException(std::string&& msg, const std::string& info) : Base(std::move(msg), info) { }
+
+		WorkerPoolFullException(const Self&) = default;
+
+		Self& operator=(const Self&) = default;
+
+		WorkerPoolFullException(Self&&) = default;
+
+		Self& operator=(Self&&) = default;
+	};
+
+	/**
+	 * @class senc::server::workers::WorkerPool
+	 * @brief Bounded pool of worker threads, used for running CPU-heavy request work
+	 *		  apart from connection I/O threads.
+	 * @note A pool constructed with zero threads runs all tasks inline (in caller thread).
+	 */
+	class WorkerPool
+	{
+	public:
+		using Self = WorkerPool;
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr std::size_t DEFAULT_QUEUE_CAPACITY = 256;
+
+		/**
+		 * @enum senc::server::workers::WorkerPool::FullPolicy
+		 * @brief What a submit does while queue is full.
+		 */
+		enum class FullPolicy
+		{
+			Block,	// wait for queue space (backpressure on submitting connections)
+			Reject	// fail at once (for submitters that must never block, e.g. event loops)
+		};
+
+		/**
+		 * @struct senc::server::workers::WorkerPool::Stats
+		 * @brief Snapshot of worker pool counters.
+		 */
+		struct Stats
+		{
+			std::size_t threads;				// amount of worker threads
+			std::size_t queue_capacity;			// maximum amount of queued tasks
+			std::size_t queue_depth;			// tasks currently queued (not yet running)
+			std::size_t max_queue_depth;		// highest queue depth seen
+			std::uint64_t executed;				// tasks finished executing (counted before their result is set)
+			std::uint64_t blocked_submits;		// submits that had to wait for queue space
+			std::uint64_t rejected_submits;		// submits rejected since queue was full
+			std::chrono::nanoseconds total_wait; // sum of time tasks spent queued
+			std::chrono::nanoseconds max_wait;	 // longest time a task spent queued
+		};
+
+		/**
+		 * @brief Constructs a worker pool.
+		 * @param threadCount Amount of worker threads (zero to run tasks inline).
+		 * @param queueCapacity Maximum amount of queued tasks, before submitters block (or are rejected).
+		 * @param fullPolicy What a submit does while queue is full.
+		 */
+		explicit WorkerPool(std::size_t threadCount,
+							std::size_t queueCapacity = DEFAULT_QUEUE_CAPACITY,
+							FullPolicy fullPolicy = FullPolicy::Block);
+
+		WorkerPool(const Self&) = delete;
+
+		Self& operator=(const Self&) = delete;
+
+		/**
+		 * @brief Destructor of worker pool, runs remaining queued tasks then joins workers.
+		 */
+		~WorkerPool();
+
+		/**
+		 * @brief Runs a task on a worker thread, and waits for its result.
+		 * @param task Task to run.
+		 * @return Result returned by `task`.
+		 * @throw senc::server::workers::WorkerPoolFullException If queue is full and pool rejects
+		 *		  when full (see `FullPolicy`).
+		 * @throw Any exception thrown by `task` (rethrown in caller thread).
+		 * @note Unless pool rejects when full, blocks while queue is full.
+		 */
+		template <std::invocable F>
+		std::invoke_result_t<F> execute(F&& task);
+
+		/**
+		 * @brief Runs a task on a worker thread, without waiting for it.
+		 * @param task Task to run.
+		 * @param onDone Function called (from worker thread) once task is done, with a ready future
+		 *				 holding its result (or exception); must not throw.
+		 * @throw senc::server::workers::WorkerPoolFullException If queue is full and pool rejects
+		 *		  when full (see `FullPolicy`), in which case `onDone` is never called.
+		 * @note Unless pool rejects when full, blocks while queue is full.
+		 * @note A pool with zero threads runs both `task` and `onDone` inline, before returning.
+		 */
+		template <std::invocable F, std::invocable<std::future<std::invoke_result_t<F>>> C>
+		void submit(F&& task, C&& onDone);
+
+		/**
+		 * @brief Waits until no tasks are queued or running (e.g. before dropping state used by
+		 *		  callbacks of submitted tasks).
+		 */
+		void wait_idle();
+
+		/**
+		 * @brief Gets a snapshot of pool counters.
+		 */
+		Stats stats() const;
+
+		/**
+		 * @brief Resets accumulated counters (executed tasks, waits, peaks).
+		 */
+		void reset_stats();
+
+	private:
+		struct Job
+		{
+			std::function<void()> run;
+			Clock::time_point enqueued;
+		};
+
+		std::size_t _queueCapacity;
+		FullPolicy _fullPolicy;
+		std::deque<Job> _queue;
+		mutable std::mutex _mtxQueue;
+		std::condition_variable _cvNotEmpty;
+		std::condition_variable _cvNotFull;
+		std::condition_variable _cvIdle;
+		std::size_t _running = 0; // jobs currently running (uses mtxQueue)
+		bool _isStopping = false;
+		std::vector<std::jthread> _workers;
+
+		std::atomic<std::size_t> _maxQueueDepth = 0;
+		std::atomic<std::uint64_t> _executed = 0;
+		std::atomic<std::uint64_t> _blockedSubmits = 0;
+		std::atomic<std::uint64_t> _rejectedSubmits = 0;
+		std::atomic<std::int64_t> _totalWaitNs = 0;
+		std::atomic<std::int64_t> _maxWaitNs = 0;
+
+		/**
+		 * @brief Enqueues a job (blocking while queue is full, or rejecting it - see `FullPolicy`).
+		 * @param run Job function.
+		 * @throw senc::server::workers::WorkerPoolFullException If rejected.
+		 */
+		void push(std::function<void()> run);
+
+		/**
+		 * @brief Runs a task, capturing its result (or exception).
+		 * @param task Task to run.
+		 * @return Ready future holding result of `task`.
+		 */
+		template <std::invocable F>
+		static std::future<std::invoke_result_t<F>> run_task(F& task);
+
+		/**
+		 * @brief Runs jobs from queue, until pool is stopped.
+		 */
+		void work();
+
+		/**
+		 * @brief Records time a job spent queued.
+		 * @param wait Time spent queued.
+		 */
+		void record_wait(Clock::duration wait);
+	};
+}
+
+#include "WorkerPool_impl.hpp"
@@ -0,0 +1,76 @@
+/*********************************************************************
+ * \file   WorkerPool_impl.hpp
+ * \brief  Implementation of WorkerPool class.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "WorkerPool.hpp"
+
+#include <exception>
+#include <memory>
+
+namespace senc::server::workers
+{
+	template <std::invocable F>
+	inline std::invoke_result_t<F> WorkerPool::execute(F&& task)
+	{
+		using R = std::invoke_result_t<F>;
+
+		if (_workers.empty())
+			return std::invoke(std::forward<F>(task));
+
+		// outcome is shared with worker, so it stays alive until worker is done with it
+		auto outcome = std::make_shared<std::promise<std::future<R>>>();
+		auto ready = outcome->get_future();
+		submit(std::forward<F>(task), [outcome](std::future<R> result)
+		{
+			outcome->set_value(std::move(result));
+		});
+		return ready.get().get();
+	}
+
+	template <std::invocable F, std::invocable<std::future<std::invoke_result_t<F>>> C>
+	inline void WorkerPool::submit(F&& task, C&& onDone)
+	{
+		if (_workers.empty())
+		{
+			std::invoke(std::forward<C>(onDone), run_task(task));
+			return;
+		}
+
+		// state is shared since std::function requires a copyable target
+		auto job = std::make_shared<std::decay_t<F>>(std::forward<F>(task));
+		auto done = std::make_shared<std::decay_t<C>>(std::forward<C>(onDone));
+		push([this, job, done]()
+		{
+			auto result = run_task(*job);
+
+			// counted before completion, so that a completed task is always counted
+			++_executed;
+
+			std::invoke(*done, std::move(result));
+		});
+	}
+
+	template <std::invocable F>
+	inline std::future<std::invoke_result_t<F>> WorkerPool::run_task(F& task)
+	{
+		using R = std::invoke_result_t<F>;
+
+		std::promise<R> promise;
+		try
+		{
+			if constexpr (std::is_void_v<R>)
+			{
+				std::invoke(task);
+				promise.set_value();
+			}
+			else
+				promise.set_value(std::invoke(task));
+		}
+		catch (...) { promise.set_exception(std::current_exception()); }
+		return promise.get_future();
+	}
+}
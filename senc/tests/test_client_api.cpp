@@ -240,3 +240,78 @@ TEST_F(ClientApiTest, RoundTripFlow)
 
 	// disconnect happens in destructor
 }
+
+TEST_F(ClientApiTest, EncryptBatchRoundTrip)
+{
+	DecsMap decs;
+
+	// connect 4 clients and signup 4 users
+	SENC_Handle hClient1 = SENC_Connect(
+		ip, port,
+		append_decs,
+		reinterpret_cast<uintptr_t>(&decs)
+	);
+	SENC_Handle hClient2 = SENC_Connect(ip, port, nullptr, 0);
+	SENC_Handle hClient3 = SENC_Connect(ip, port, nullptr, 0);
+	SENC_Handle hClient4 = SENC_Connect(ip, port, nullptr, 0);
+	ASSERT_NO_ERROR(SENC_SignUp(hClient1, "aaa", "AAA"));
+	ASSERT_NO_ERROR(SENC_SignUp(hClient2, "bbb", "BBB"));
+	ASSERT_NO_ERROR(SENC_SignUp(hClient3, "ccc", "CCC"));
+	ASSERT_NO_ERROR(SENC_SignUp(hClient4, "ddd", "DDD"));
+
+	// create userset where aaa,bbb are owners and ccc,ddd are non-owners
+	std::vector<const char*> owners{ "bbb" };
+	std::vector<const char*> regs{ "ccc", "ddd" };
+	SENC_Handle hUserSetID = SENC_MakeUserSet(
+		hClient1,
+		owners.size(), regs.size(),
+		owners.data(), regs.data(),
+		1, 1
+	);
+	ASSERT_NO_ERROR(hUserSetID);
+	const char* usersetID = SENC_GetStringValue(hUserSetID);
+
+	// encrypt messages in one batch
+	const std::vector<std::string> msgs{ "first", "second message", "", "fourth" };
+	std::vector<const uint8_t*> msgsBytes;
+	std::vector<uint64_t> msgLens;
+	for (const auto& msg : msgs)
+	{
+		msgsBytes.push_back(reinterpret_cast<const uint8_t*>(msg.c_str()));
+		msgLens.push_back(msg.length());
+	}
+	std::vector<uintptr_t> hCiphertextsRaw(msgs.size(), 0);
+	ASSERT_NO_ERROR(SENC_EncryptBatch(
+		hClient1, usersetID, msgs.size(),
+		msgsBytes.data(), msgLens.data(), hCiphertextsRaw.data()
+	));
+	std::vector<SENC_Handle> hCiphertexts(hCiphertextsRaw.begin(), hCiphertextsRaw.end());
+	for (const auto& hCiphertext : hCiphertexts)
+		ASSERT_NO_ERROR(hCiphertext);
+
+	// queue decrypt of one of the messages
+	SENC_Handle hOPID = SENC_Decrypt(hClient1, usersetID, hCiphertexts[1]);
+	ASSERT_NO_ERROR(hOPID);
+	OperationID opid = SENC_GetStringValue(hOPID);
+
+	// wait until decryption was added to decs
+	while (decs.empty())
+		std::this_thread::sleep_for(std::chrono::seconds(1));
+
+	// check got decryption which is same as matching message
+	{
+		const std::lock_guard<std::mutex> lock(decs.mtx);
+		auto& decsVec = decs.map.at(opid);
+		ASSERT_EQ(decsVec.size(), 1);
+		auto& result = decsVec.front();
+		EXPECT_EQ(std::string(result.begin(), result.end()), msgs[1]);
+	}
+
+	// logout all users
+	ASSERT_NO_ERROR(SENC_LogOut(hClient1));
+	ASSERT_NO_ERROR(SENC_LogOut(hClient2));
+	ASSERT_NO_ERROR(SENC_LogOut(hClient3));
+	ASSERT_NO_ERROR(SENC_LogOut(hClient4));
+
+	// disconnect happens in destructor
+}
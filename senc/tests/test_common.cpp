@@ -9,9 +9,11 @@
 #include <gtest/gtest.h>
 #include <functional>
 #include <memory>
+#include <chrono>
 #include <deque>
 #include "tests_utils.hpp"
 #include "../common/EncryptedPacketHandler.hpp"
+#include "../common/EphemeralKeyPool.hpp"
 #include "../common/ServerPacketHandlerFactory.hpp"
 #include "../common/ClientPacketHandlerFactory.hpp"
 #include "../common/InlinePacketHandler.hpp"
@@ -23,12 +25,23 @@ using senc::ClientPacketHandlerImplFactory;
 using senc::ServerPacketHandlerFactory;
 using senc::ClientPacketHandlerFactory;
 using senc::EncryptedPacketHandler;
+using senc::EphemeralKeyPool;
+using senc::EphemeralKeyGen;
 using senc::InlinePacketHandler;
 using senc::QueuedPacketHandler;
 using senc::PacketHandler;
 using senc::utils::ECGroup;
 using senc::utils::Socket;
 
+/**
+ * @brief Gets a key pool of zero depth (all handshake keys computed inline).
+ */
+EphemeralKeyPool& unpooled_key_pool()
+{
+	static EphemeralKeyPool pool(0);
+	return pool;
+}
+
 struct PacketsTestParams
 {
 	ClientPacketHandlerFactory clientPacketHandlerFactory;
@@ -246,7 +259,7 @@ TEST_P(PacketsTest, DecryptCycleTest)
 
 static void update_cycle(PacketsTest& test)
 {
-	pkt::UpdateRequest req{};
+	pkt::UpdateRequest req{ 1500 };
 	pkt::UpdateResponse resp{
 		{
 			{
@@ -323,6 +336,9 @@ static void update_cycle(PacketsTest& test)
 				{ 5, 100 },
 				{ 100 }
 			}
+		},
+		{
+			"3c5e6f0a-8d1b-4f7e-9a2c-6b4d0e1f2a3b"
 		}
 	};
 	test.cycle_flow(req, resp);
@@ -448,6 +464,69 @@ INSTANTIATE_TEST_SUITE_P(
 		PacketsTestParams(
 			ClientPacketHandlerImplFactory<EncryptedPacketHandler>{},
 			ServerPacketHandlerImplFactory<EncryptedPacketHandler>{}
+		),
+		PacketsTestParams(
+			ClientPacketHandlerImplFactory<EncryptedPacketHandler, std::reference_wrapper<EphemeralKeyPool>>{
+				std::ref(unpooled_key_pool())
+			},
+			ServerPacketHandlerImplFactory<EncryptedPacketHandler, std::reference_wrapper<EphemeralKeyPool>>{
+				std::ref(unpooled_key_pool())
+			}
 		)
 	)
 );
+
+TEST(EphemeralKeyPoolTest, TakesMatchingPairs)
+{
+	EphemeralKeyGen gen;
+	EphemeralKeyPool pool(4);
+	for (int i = 0; i < 8; ++i)
+	{
+		const auto [y, gy] = pool.take(gen);
+		EXPECT_EQ(gy, ECGroup::generator().pow(y));
+	}
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.hits + stats.misses, 8);
+	EXPECT_EQ(stats.depth, 4);
+}
+
+TEST(EphemeralKeyPoolTest, TakesDistinctPairs)
+{
+	EphemeralKeyGen gen;
+	EphemeralKeyPool pool(4);
+	const auto first = pool.take(gen);
+	const auto second = pool.take(gen);
+	EXPECT_NE(first.priv, second.priv);
+	EXPECT_NE(first.pub, second.pub);
+}
+
+TEST(EphemeralKeyPoolTest, RefillsInBackground)
+{
+	EphemeralKeyGen gen;
+	EphemeralKeyPool pool(2);
+
+	// wait for refill thread to fill pool
+	ASSERT_TRUE(pool.wait_available(2, std::chrono::seconds(10)));
+	EXPECT_EQ(pool.stats().available, 2);
+
+	pool.take(gen);
+	pool.take(gen);
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.hits, 2);
+	EXPECT_EQ(stats.misses, 0);
+}
+
+TEST(EphemeralKeyPoolTest, ZeroDepthAlwaysMisses)
+{
+	EphemeralKeyGen gen;
+	EphemeralKeyPool pool(0);
+	pool.take(gen);
+	pool.take(gen);
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.hits, 0);
+	EXPECT_EQ(stats.misses, 2);
+	EXPECT_EQ(stats.available, 0);
+}
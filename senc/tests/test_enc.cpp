@@ -7,17 +7,28 @@
  *********************************************************************/
 
 #include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
+#include <thread>
+#include <utility>
 
 #include "../utils/enc/HybridElGamal2L.hpp"
+#include "../utils/enc/KeyPool.hpp"
 #include "../utils/enc/ECHKDF2L.hpp"
 #include "../utils/enc/AES1L.hpp"
 #include "../utils/bytes.hpp"
+#include "../utils/Random.hpp"
 
 using senc::utils::enc::HybridElGamal2L;
 using senc::utils::enc::ECHKDF2L;
+using senc::utils::enc::KeyPool;
 using senc::utils::enc::AES1L;
 using senc::utils::ECGroup;
 using senc::utils::Buffer;
+using senc::utils::BigInt;
+using senc::utils::Random;
+
+using TestSchema = HybridElGamal2L<ECGroup, AES1L, ECHKDF2L>;
 
 struct AES1L_EncDecTest : testing::Test, testing::WithParamInterface<Buffer> { };
 
@@ -41,7 +52,7 @@ INSTANTIATE_TEST_SUITE_P(AES, AES1L_EncDecTest, testing::Values(
 
 TEST_P(HybridElGamal_EncDecTest, HybridElGamal)
 {
-	HybridElGamal2L<ECGroup, AES1L, ECHKDF2L> schema;
+	TestSchema schema;
 	const auto [pubKey1, privKey1] = schema.keygen();
 	const auto [pubKey2, privKey2] = schema.keygen();
 	const Buffer& data = GetParam();
@@ -55,3 +66,260 @@ INSTANTIATE_TEST_SUITE_P(HybridElGamal, HybridElGamal_EncDecTest, testing::Value
 	Buffer({ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 }),
 	Buffer({ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF })
 ));
+
+/**
+ * @brief Raises a group element to a power by plain double-and-add (as reference).
+ * @param base Element to raise.
+ * @param exp Non-negative exponent.
+ * @return `base` raised to `exp`.
+ */
+static ECGroup double_and_add(const ECGroup& base, const BigInt& exp)
+{
+	ECGroup res = ECGroup::identity();
+	for (unsigned int i = exp.BitCount(); i > 0; --i)
+	{
+		res = res * res;
+		if (exp.GetBit(i - 1))
+			res = res * base;
+	}
+	return res;
+}
+
+TEST(ECGroupTest, GeneratorPowMatchesGenericPow)
+{
+	// g^2 is not the base point, so its pow does not use the precomputed table
+	const ECGroup g2 = ECGroup::generator() * ECGroup::generator();
+	for (int i = 0; i < 16; ++i)
+	{
+		const BigInt exp = Random<BigInt>::sample_below(ECGroup::order());
+		EXPECT_EQ(ECGroup::generator_pow(exp * 2), g2.pow(exp));
+		EXPECT_EQ(ECGroup::generator_pow(exp), double_and_add(ECGroup::generator(), exp));
+	}
+}
+
+TEST(ECGroupTest, GeneratorPowEdgeCases)
+{
+	const BigInt order = ECGroup::order();
+	const BigInt exp = Random<BigInt>::sample_below(order);
+
+	EXPECT_EQ(ECGroup::generator_pow(BigInt::Zero()), ECGroup::identity());
+	EXPECT_EQ(ECGroup::generator_pow(BigInt::One()), ECGroup::generator());
+	EXPECT_EQ(ECGroup::generator_pow(order), ECGroup::identity());
+	EXPECT_EQ(ECGroup::generator_pow(order + exp), ECGroup::generator_pow(exp));
+	EXPECT_EQ(ECGroup::generator_pow(order - 1), ECGroup::generator().inverse());
+	EXPECT_EQ(ECGroup::generator_pow(-exp), ECGroup::generator_pow(exp).inverse());
+	EXPECT_EQ(ECGroup::generator_pow(exp) * ECGroup::generator_pow(order - exp), ECGroup::identity());
+	EXPECT_EQ(ECGroup::from_scalar(exp), ECGroup::generator_pow(exp));
+}
+
+TEST(ECGroupTest, OperationsOnUnnormalizedPoints)
+{
+	const BigInt order = ECGroup::order();
+	ECGroup acc = ECGroup::identity();
+	BigInt sum = BigInt::Zero();
+	for (int i = 0; i < 8; ++i)
+	{
+		const BigInt exp = Random<BigInt>::sample_below(order);
+		acc *= ECGroup::generator_pow(exp);
+		sum = (sum + exp) % order;
+		EXPECT_EQ(acc, ECGroup::generator_pow(sum));
+	}
+
+	// doubling, inverse and division of an unnormalized point
+	EXPECT_EQ(acc * acc, ECGroup::generator_pow(sum * 2));
+	EXPECT_EQ(acc * acc.inverse(), ECGroup::identity());
+	EXPECT_EQ((acc * acc) / acc, acc);
+
+	// affine coordinates and encoding do not depend on representation
+	const ECGroup expected = ECGroup::generator_pow(sum);
+	EXPECT_EQ(acc.x(), expected.x());
+	EXPECT_EQ(acc.y(), expected.y());
+	EXPECT_EQ(acc.xy(), std::make_pair(expected.x(), expected.y()));
+	EXPECT_EQ(acc.encode(), expected.encode());
+	EXPECT_EQ(ECGroup::decode(acc.encode()), expected);
+}
+
+TEST(ECGroupTest, FixedBaseTableMatchesPow)
+{
+	const BigInt order = ECGroup::order();
+	for (const ECGroup& base : { ECGroup::generator(), ECGroup::sample(), ECGroup::sample() * ECGroup::sample() })
+	{
+		const ECGroup::FixedBaseTable table(base);
+		for (const BigInt& exp : { BigInt::Zero(), BigInt::One(), BigInt(15), BigInt(16), order - 1, order, order + 5 })
+			EXPECT_EQ(table.pow(exp), base.pow(exp));
+		for (int i = 0; i < 8; ++i)
+		{
+			const BigInt exp = Random<BigInt>::sample_below(order);
+			EXPECT_EQ(table.pow(exp), base.pow(exp));
+			EXPECT_EQ(table.pow(-exp), base.pow(-exp));
+		}
+	}
+
+	const ECGroup::FixedBaseTable identityTable(ECGroup::identity());
+	EXPECT_TRUE(identityTable.pow(BigInt(12345)).is_identity());
+}
+
+TEST(ECGroupTest, NormalizeBatch)
+{
+	std::vector<ECGroup> elems;
+	std::vector<ECGroup> expected;
+	ECGroup acc = ECGroup::identity();
+	for (int i = 0; i < 8; ++i)
+	{
+		acc *= ECGroup::sample();
+		elems.push_back(acc);
+		expected.push_back(acc);
+		expected.back().normalize();
+	}
+	elems.push_back(ECGroup::identity());
+	expected.push_back(ECGroup::identity());
+
+	ECGroup::normalize_batch(elems);
+	for (std::size_t i = 0; i < elems.size(); ++i)
+	{
+		EXPECT_TRUE(elems[i].is_normalized());
+		EXPECT_EQ(elems[i].x(), expected[i].x());
+		EXPECT_EQ(elems[i].y(), expected[i].y());
+	}
+}
+
+TEST(ECGroupTest, MultiPowMatchesSeparatePows)
+{
+	const BigInt order = ECGroup::order();
+
+	// sizes cover empty, single, Straus and Pippenger paths
+	for (std::size_t size : { 0, 1, 2, 5, 32, 33, 70 })
+	{
+		std::vector<ECGroup> bases;
+		std::vector<BigInt> exps;
+		ECGroup expected = ECGroup::identity();
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			bases.push_back((i % 7 == 3) ? ECGroup::identity() : ECGroup::sample());
+			BigInt exp = Random<BigInt>::sample_below(order);
+			if (i % 5 == 1)
+				exp = -exp;
+			else if (i % 5 == 2)
+				exp += order;
+			exps.push_back(exp);
+			expected *= bases.back().pow(exps.back());
+		}
+
+		EXPECT_EQ(ECGroup::multi_pow(bases, exps), expected);
+		EXPECT_EQ((senc::utils::multi_pow<ECGroup, BigInt>(bases, exps)), expected);
+	}
+
+	const std::vector<ECGroup> bases{ ECGroup::generator() };
+	const std::vector<BigInt> exps{ BigInt::One(), BigInt::One() };
+	EXPECT_THROW(ECGroup::multi_pow(bases, exps), std::invalid_argument);
+}
+
+TEST(KeyPoolTest, TakesWorkingPairs)
+{
+	TestSchema schema;
+	KeyPool<TestSchema> pool(4);
+	const Buffer data{ 0x00, 0x01, 0x02, 0x03 };
+	for (int i = 0; i < 4; ++i)
+	{
+		const auto [pubKey1, privKey1] = pool.take(schema);
+		const auto [pubKey2, privKey2] = pool.take(schema);
+		EXPECT_EQ(pubKey1, ECGroup::generator().pow(privKey1));
+		EXPECT_NE(privKey1, privKey2);
+		EXPECT_EQ(schema.decrypt(schema.encrypt(data, pubKey1, pubKey2), privKey1, privKey2), data);
+	}
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.hits + stats.misses, 8);
+	EXPECT_EQ(stats.depth, 4);
+}
+
+TEST(KeyPoolTest, RefillsInBackground)
+{
+	TestSchema schema;
+	KeyPool<TestSchema> pool(2);
+
+	// wait for refill thread to fill pool
+	ASSERT_TRUE(pool.wait_available(2, std::chrono::seconds(10)));
+	EXPECT_EQ(pool.stats().available, 2);
+
+	pool.take(schema);
+	pool.take(schema);
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.hits, 2);
+	EXPECT_EQ(stats.misses, 0);
+}
+
+TEST(KeyPoolTest, ZeroDepthAlwaysMisses)
+{
+	TestSchema schema;
+	KeyPool<TestSchema> pool(0);
+	pool.take(schema);
+	pool.take(schema);
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.hits, 0);
+	EXPECT_EQ(stats.misses, 2);
+	EXPECT_EQ(stats.available, 0);
+	EXPECT_FALSE(pool.wait_available(1, std::chrono::milliseconds(1)));
+}
+
+TEST(HybridElGamalTest, EncryptBatchDecrypts)
+{
+	TestSchema schema;
+	const auto [pubKey1, privKey1] = schema.keygen();
+	const auto [pubKey2, privKey2] = schema.keygen();
+	TestSchema::clear_table_cache();
+
+	// empty, below table threshold, and large enough to build tables
+	for (std::size_t size : { std::size_t(0), std::size_t(3), 2 * TestSchema::TABLE_MIN_BATCH + 1 })
+	{
+		std::vector<Buffer> plaintexts;
+		for (std::size_t i = 0; i < size; ++i)
+			plaintexts.push_back(Buffer(i % 20, static_cast<senc::utils::byte>(i)));
+
+		const auto ciphertexts = schema.encrypt_batch(plaintexts, pubKey1, pubKey2);
+		ASSERT_EQ(ciphertexts.size(), size);
+		for (std::size_t i = 0; i < size; ++i)
+			EXPECT_EQ(schema.decrypt(ciphertexts[i], privKey1, privKey2), plaintexts[i]);
+	}
+
+	// tables were built once (by large batch), then reused by further batches
+	const std::vector<Buffer> plaintexts(TestSchema::TABLE_MIN_BATCH, Buffer{ 0x01, 0x02 });
+	const auto ciphertexts = schema.encrypt_batch(plaintexts, pubKey1, pubKey2);
+	EXPECT_EQ(schema.decrypt(ciphertexts.back(), privKey1, privKey2), plaintexts.back());
+	const auto stats = TestSchema::table_cache_stats();
+	EXPECT_EQ(stats.hits, 2);
+}
+
+TEST(HybridElGamalTest, EncryptBatchConcurrently)
+{
+	constexpr std::size_t THREADS = 4;
+	TestSchema schema;
+	const auto [pubKey1, privKey1] = schema.keygen();
+	const auto [pubKey2, privKey2] = schema.keygen();
+
+	// several batches at once (callers parallelise batches), each large enough to build tables
+	std::vector<std::vector<Buffer>> plaintexts(THREADS);
+	for (std::size_t t = 0; t < THREADS; ++t)
+		for (std::size_t i = 0; i < 2 * TestSchema::TABLE_MIN_BATCH + 1; ++i)
+			plaintexts[t].push_back(Buffer{ static_cast<senc::utils::byte>(t), static_cast<senc::utils::byte>(i) });
+
+	std::vector<std::vector<TestSchema::Ciphertext>> ciphertexts(THREADS);
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < THREADS; ++t)
+		threads.emplace_back([&plaintexts, &ciphertexts, &pubKey1, &pubKey2, t]()
+		{
+			TestSchema threadSchema; // schemas are not thread-safe, so each thread has its own
+			ciphertexts[t] = threadSchema.encrypt_batch(plaintexts[t], pubKey1, pubKey2);
+		});
+	for (auto& thread : threads)
+		thread.join();
+
+	for (std::size_t t = 0; t < THREADS; ++t)
+	{
+		ASSERT_EQ(ciphertexts[t].size(), plaintexts[t].size());
+		for (std::size_t i = 0; i < plaintexts[t].size(); ++i)
+			EXPECT_EQ(schema.decrypt(ciphertexts[t][i], privKey1, privKey2), plaintexts[t][i]);
+	}
+}
@@ -0,0 +1,217 @@
+/*********************************************************************
+ * \file   test_limits.cpp
+ * \brief  Contains tests for server admission control and rate limiting.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <optional>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../server/limits/AdmissionController.hpp"
+#include "../server/limits/RateLimiter.hpp"
+#include "../server/limits/TokenBucket.hpp"
+
+using senc::server::limits::AdmissionController;
+using senc::server::limits::RequestClass;
+using senc::server::limits::RateLimiter;
+using senc::server::limits::RateLimits;
+using senc::server::limits::TokenBucket;
+
+TEST(TokenBucketTest, AllowsBurstThenRejects)
+{
+	const auto now = TokenBucket::Clock::now();
+	TokenBucket bucket({ .rate = 1, .burst = 3 });
+
+	for (int i = 0; i < 3; ++i)
+		EXPECT_TRUE(bucket.try_take(now));
+	EXPECT_FALSE(bucket.try_take(now));
+	EXPECT_FALSE(bucket.is_full(now));
+}
+
+TEST(TokenBucketTest, RefillsOverTime)
+{
+	const auto now = TokenBucket::Clock::now();
+	TokenBucket bucket({ .rate = 10, .burst = 2 });
+
+	EXPECT_TRUE(bucket.try_take(now));
+	EXPECT_TRUE(bucket.try_take(now));
+	EXPECT_FALSE(bucket.try_take(now));
+
+	// 100ms at 10 tokens per second refills a single token
+	const auto later = now + std::chrono::milliseconds(100);
+	EXPECT_TRUE(bucket.try_take(later));
+	EXPECT_FALSE(bucket.try_take(later));
+
+	// refill never exceeds capacity
+	EXPECT_TRUE(bucket.is_full(later + std::chrono::seconds(10)));
+}
+
+TEST(TokenBucketTest, ZeroRateIsUnlimited)
+{
+	const auto now = TokenBucket::Clock::now();
+	TokenBucket bucket({ .rate = 0, .burst = 1 });
+
+	for (int i = 0; i < 1000; ++i)
+		EXPECT_TRUE(bucket.try_take(now));
+}
+
+TEST(RateLimiterTest, LimitsPerConnection)
+{
+	RateLimiter limiter(RateLimits{
+		.cheapPerConnection = { .rate = 1e-3, .burst = 2 },
+		.expensivePerConnection = { .rate = 1e-3, .burst = 1 },
+		.cheapPerUser = { .rate = 0, .burst = 1 },
+		.expensivePerUser = { .rate = 0, .burst = 1 }
+	});
+	auto conn1 = limiter.new_connection();
+	auto conn2 = limiter.new_connection();
+
+	EXPECT_TRUE(conn1.try_acquire(RequestClass::Cheap, "avi"));
+	EXPECT_TRUE(conn1.try_acquire(RequestClass::Cheap, "avi"));
+	EXPECT_FALSE(conn1.try_acquire(RequestClass::Cheap, "avi"));
+
+	// request classes have separate buckets
+	EXPECT_TRUE(conn1.try_acquire(RequestClass::Expensive, "avi"));
+	EXPECT_FALSE(conn1.try_acquire(RequestClass::Expensive, "avi"));
+
+	// other connections are unaffected
+	EXPECT_TRUE(conn2.try_acquire(RequestClass::Cheap, "avi"));
+	EXPECT_TRUE(conn2.try_acquire(RequestClass::Expensive, "avi"));
+
+	const auto stats = limiter.stats();
+	EXPECT_EQ(stats.rejected_cheap, 1);
+	EXPECT_EQ(stats.rejected_expensive, 1);
+}
+
+TEST(RateLimiterTest, LimitsPerUserAcrossConnections)
+{
+	RateLimiter limiter(RateLimits{
+		.cheapPerConnection = { .rate = 0, .burst = 1 },
+		.expensivePerConnection = { .rate = 0, .burst = 1 },
+		.cheapPerUser = { .rate = 0, .burst = 1 },
+		.expensivePerUser = { .rate = 1e-3, .burst = 2 }
+	});
+	auto conn1 = limiter.new_connection();
+	auto conn2 = limiter.new_connection();
+
+	EXPECT_TRUE(conn1.try_acquire(RequestClass::Expensive, "avi"));
+	EXPECT_TRUE(conn2.try_acquire(RequestClass::Expensive, "avi"));
+	EXPECT_FALSE(conn1.try_acquire(RequestClass::Expensive, "avi"));
+	EXPECT_FALSE(conn2.try_acquire(RequestClass::Expensive, "avi"));
+
+	// other usernames are unaffected
+	EXPECT_TRUE(conn1.try_acquire(RequestClass::Expensive, "batya"));
+
+	const auto stats = limiter.stats();
+	EXPECT_EQ(stats.rejected_expensive, 2);
+	EXPECT_EQ(stats.tracked_users, 2);
+}
+
+TEST(RateLimiterTest, LimitsPerUserConcurrently)
+{
+	RateLimiter limiter(RateLimits{
+		.cheapPerConnection = { .rate = 0, .burst = 1 },
+		.expensivePerConnection = { .rate = 0, .burst = 1 },
+		.cheapPerUser = { .rate = 1e-3, .burst = 10 },
+		.expensivePerUser = { .rate = 0, .burst = 1 }
+	});
+
+	// two connections per username, spread over stripes, all competing at once
+	constexpr std::size_t USERS = 2 * RateLimiter::STRIPE_COUNT;
+	std::vector<std::size_t> allowed(2 * USERS);
+	{
+		std::vector<std::jthread> threads;
+		for (std::size_t i = 0; i < 2 * USERS; ++i)
+			threads.emplace_back([&limiter, &allowed, i]()
+			{
+				auto conn = limiter.new_connection();
+				for (int j = 0; j < 20; ++j)
+					allowed[i] += conn.try_acquire(RequestClass::Cheap, "user" + std::to_string(i % USERS));
+			});
+	}
+
+	// each username got exactly its burst, however its requests interleaved
+	for (std::size_t i = 0; i < USERS; ++i)
+		EXPECT_EQ(allowed[i] + allowed[i + USERS], 10);
+
+	const auto stats = limiter.stats();
+	EXPECT_EQ(stats.rejected_cheap, 2 * USERS * 20 - USERS * 10);
+	EXPECT_EQ(stats.tracked_users, USERS);
+}
+
+TEST(RateLimiterTest, PrunesIdleUsers)
+{
+	// unlimited buckets are always full, so all usernames are idle
+	RateLimiter limiter(RateLimits{
+		.cheapPerConnection = { .rate = 0, .burst = 1 },
+		.expensivePerConnection = { .rate = 0, .burst = 1 },
+		.cheapPerUser = { .rate = 0, .burst = 1 },
+		.expensivePerUser = { .rate = 0, .burst = 1 }
+	});
+	auto conn = limiter.new_connection();
+
+	for (std::size_t i = 0; i <= RateLimiter::USERS_PRUNE_THRESHOLD; ++i)
+		EXPECT_TRUE(conn.try_acquire(RequestClass::Cheap, "user" + std::to_string(i)));
+
+	EXPECT_LT(limiter.stats().tracked_users, RateLimiter::USERS_PRUNE_THRESHOLD);
+}
+
+TEST(AdmissionControllerTest, CapsConnections)
+{
+	AdmissionController admission(2, 0);
+
+	auto t1 = admission.try_admit_connection();
+	auto t2 = admission.try_admit_connection();
+	ASSERT_TRUE(t1.has_value());
+	ASSERT_TRUE(t2.has_value());
+	EXPECT_FALSE(admission.try_admit_connection().has_value());
+
+	// releasing a ticket frees its slot
+	t1->release();
+	EXPECT_EQ(admission.stats().connections, 1);
+	auto t3 = admission.try_admit_connection();
+	EXPECT_TRUE(t3.has_value());
+
+	const auto stats = admission.stats();
+	EXPECT_EQ(stats.connections, 2);
+	EXPECT_EQ(stats.rejected_connections, 1);
+}
+
+TEST(AdmissionControllerTest, TicketReleasesOnDestruction)
+{
+	AdmissionController admission(0, 1);
+
+	{
+		auto ticket = admission.try_begin_handshake();
+		ASSERT_TRUE(ticket.has_value());
+		EXPECT_FALSE(admission.try_begin_handshake().has_value());
+
+		// moving ticket keeps a single slot taken
+		auto moved = std::move(*ticket);
+		ticket.reset();
+		EXPECT_EQ(admission.stats().handshakes, 1);
+	}
+
+	EXPECT_EQ(admission.stats().handshakes, 0);
+	EXPECT_TRUE(admission.try_begin_handshake().has_value());
+	EXPECT_EQ(admission.stats().rejected_handshakes, 1);
+}
+
+TEST(AdmissionControllerTest, ZeroIsUnlimited)
+{
+	AdmissionController admission(0, 0);
+
+	std::vector<AdmissionController::Ticket> tickets;
+	for (int i = 0; i < 1000; ++i)
+	{
+		auto ticket = admission.try_admit_connection();
+		ASSERT_TRUE(ticket.has_value());
+		tickets.push_back(std::move(*ticket));
+	}
+	EXPECT_EQ(admission.stats().connections, 1000);
+}
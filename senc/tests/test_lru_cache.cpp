@@ -0,0 +1,95 @@
+/*********************************************************************
+ * \file   test_lru_cache.cpp
+ * \brief  Contains tests for LruCache class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../utils/LruCache.hpp"
+
+using senc::utils::LruCache;
+
+TEST(LruCacheTest, ComputesOnceAndCountsStats)
+{
+	LruCache<int, std::string> cache(4);
+	int computations = 0;
+	const auto compute = [&computations]() { ++computations; return std::string("value"); };
+
+	EXPECT_EQ(cache.get(1), nullptr);
+	EXPECT_EQ(*cache.get_or_compute(1, compute), "value");
+	EXPECT_EQ(*cache.get_or_compute(1, compute), "value");
+	EXPECT_EQ(*cache.get(1), "value");
+	EXPECT_EQ(computations, 1);
+
+	const auto stats = cache.stats();
+	EXPECT_EQ(stats.hits, 2);
+	EXPECT_EQ(stats.misses, 2);
+	EXPECT_EQ(stats.evictions, 0);
+
+	cache.reset_stats();
+	EXPECT_EQ(cache.stats().hits, 0);
+	EXPECT_EQ(cache.stats().misses, 0);
+}
+
+TEST(LruCacheTest, EvictsLeastRecentlyUsed)
+{
+	LruCache<int, int> cache(2);
+	cache.get_or_compute(1, []() { return 10; });
+	cache.get_or_compute(2, []() { return 20; });
+	const auto first = cache.get(1); // 2 is now least recently used
+	cache.get_or_compute(3, []() { return 30; });
+
+	EXPECT_EQ(cache.size(), 2);
+	EXPECT_EQ(cache.stats().evictions, 1);
+	EXPECT_EQ(cache.get(2), nullptr);
+	EXPECT_EQ(*cache.get(1), 10);
+	EXPECT_EQ(*cache.get(3), 30);
+
+	// handed out values outlive eviction and clearing
+	cache.clear();
+	EXPECT_EQ(cache.size(), 0);
+	EXPECT_EQ(*first, 10);
+}
+
+TEST(LruCacheTest, ThrowingComputeIsNotCached)
+{
+	LruCache<int, int> cache(2);
+	EXPECT_THROW(cache.get_or_compute(1, []() -> int { throw std::runtime_error("fail"); }), std::runtime_error);
+	EXPECT_EQ(cache.size(), 0);
+	EXPECT_EQ(*cache.get_or_compute(1, []() { return 1; }), 1);
+}
+
+TEST(LruCacheTest, ConcurrentLookups)
+{
+	constexpr int THREADS = 4;
+	constexpr int LOOKUPS = 10000;
+	constexpr int KEYS = 16;
+
+	LruCache<int, int> cache(KEYS / 2);
+	std::atomic<bool> wrong = false;
+	{
+		std::vector<std::jthread> threads;
+		for (int i = 0; i < THREADS; ++i)
+			threads.emplace_back([&cache, &wrong, i]()
+			{
+				for (int j = 0; j < LOOKUPS; ++j)
+				{
+					const int key = (i * 7 + j) % KEYS;
+					if (*cache.get_or_compute(key, [key]() { return key * key; }) != key * key)
+						wrong = true;
+				}
+			});
+	}
+
+	EXPECT_FALSE(wrong);
+	EXPECT_LE(cache.size(), cache.capacity());
+	const auto stats = cache.stats();
+	EXPECT_EQ(stats.hits + stats.misses, THREADS * LOOKUPS);
+}
@@ -0,0 +1,178 @@
+/*********************************************************************
+ * \file   test_metrics.cpp
+ * \brief  Contains tests for server metrics.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../server/metrics/RequestMetrics.hpp"
+#include "../server/metrics/ScopedTimer.hpp"
+#include "../server/metrics/Histogram.hpp"
+#include "../server/metrics/Registry.hpp"
+
+namespace pkt = senc::pkt;
+using senc::server::metrics::RequestMetrics;
+using senc::server::metrics::ScopedTimer;
+using senc::server::metrics::Histogram;
+using senc::server::metrics::Registry;
+
+/**
+ * @brief Checks if any report line starts with a given prefix.
+ */
+static bool has_line(const std::vector<std::string>& report, const std::string& prefix)
+{
+	return std::any_of(report.begin(), report.end(), [&prefix](const std::string& line)
+	{
+		return line.starts_with(prefix);
+	});
+}
+
+TEST(HistogramTest, BucketsCoverValues)
+{
+	std::size_t prevIndex = 0;
+	for (std::uint64_t value = 0; value < (1 << 16); ++value)
+	{
+		const auto index = Histogram::bucket_index(value);
+		ASSERT_LT(index, Histogram::BUCKET_COUNT);
+		EXPECT_GE(index, prevIndex); // monotonic
+		EXPECT_GE(Histogram::bucket_max(index), value);
+		if (index > 0)
+		{
+			EXPECT_LT(Histogram::bucket_max(index - 1), value);
+		}
+		prevIndex = index;
+	}
+
+	EXPECT_LT(Histogram::bucket_index(UINT64_MAX), Histogram::BUCKET_COUNT);
+	EXPECT_EQ(Histogram::bucket_max(Histogram::bucket_index(UINT64_MAX)), UINT64_MAX);
+}
+
+TEST(HistogramTest, PercentilesWithinPrecision)
+{
+	Histogram histogram;
+	for (std::uint64_t value = 1; value <= 10000; ++value)
+		histogram.record(value);
+
+	const auto snapshot = histogram.snapshot();
+	EXPECT_EQ(snapshot.count(), 10000);
+	EXPECT_EQ(snapshot.max(), 10000);
+	EXPECT_DOUBLE_EQ(snapshot.mean(), 5000.5);
+
+	const double precision = 1.0 / Histogram::SUB_BUCKETS;
+	for (double p : { 50.0, 90.0, 99.0, 99.9 })
+	{
+		const double expected = p * 100;
+		const auto got = static_cast<double>(snapshot.percentile(p));
+		EXPECT_GE(got, expected);
+		EXPECT_LE(got, expected * (1 + precision));
+	}
+	EXPECT_EQ(snapshot.percentile(100), 10000);
+}
+
+TEST(HistogramTest, EmptyAndReset)
+{
+	Histogram histogram;
+	EXPECT_EQ(histogram.snapshot().percentile(50), 0);
+	EXPECT_EQ(histogram.snapshot().mean(), 0);
+
+	histogram.record(42);
+	histogram.reset();
+	EXPECT_EQ(histogram.snapshot().count(), 0);
+	EXPECT_EQ(histogram.snapshot().max(), 0);
+}
+
+TEST(HistogramTest, ConcurrentRecords)
+{
+	constexpr std::size_t THREADS = 4;
+	constexpr std::size_t RECORDS = 10000;
+
+	Histogram histogram;
+	{
+		std::vector<std::jthread> threads;
+		for (std::size_t i = 0; i < THREADS; ++i)
+			threads.emplace_back([&histogram, i]()
+			{
+				for (std::size_t j = 0; j < RECORDS; ++j)
+					histogram.record(i * RECORDS + j);
+			});
+	}
+
+	const auto snapshot = histogram.snapshot();
+	EXPECT_EQ(snapshot.count(), THREADS * RECORDS);
+	EXPECT_EQ(snapshot.max(), THREADS * RECORDS - 1);
+}
+
+TEST(RegistryTest, ReturnsSameMetricByName)
+{
+	Registry registry;
+	auto& counter = registry.counter("a");
+	counter.add(2);
+	EXPECT_EQ(&registry.counter("a"), &counter);
+	EXPECT_EQ(registry.counter("a").value(), 2);
+	EXPECT_NE(&registry.counter("b"), &counter);
+}
+
+TEST(RegistryTest, ReportsAllKinds)
+{
+	Registry registry;
+	registry.counter("events").add(3);
+	registry.gauge("level").set(-4);
+	registry.sampled_gauge("sampled", []() -> std::int64_t { return 7; });
+	registry.histogram("latency_us").record(100);
+
+	const auto report = registry.report();
+	EXPECT_TRUE(has_line(report, "counter events = 3"));
+	EXPECT_TRUE(has_line(report, "gauge level = -4"));
+	EXPECT_TRUE(has_line(report, "gauge sampled = 7"));
+	EXPECT_TRUE(has_line(report, "histogram latency_us count=1"));
+}
+
+TEST(RegistryTest, ResetKeepsGauges)
+{
+	Registry registry;
+	registry.counter("events").add(3);
+	registry.gauge("level").set(5);
+	registry.histogram("latency_us").record(100);
+
+	registry.reset();
+
+	EXPECT_EQ(registry.counter("events").value(), 0);
+	EXPECT_EQ(registry.gauge("level").value(), 5);
+	EXPECT_EQ(registry.histogram("latency_us").snapshot().count(), 0);
+}
+
+TEST(RequestMetricsTest, NamesHistogramsByRequest)
+{
+	Registry registry;
+	RequestMetrics requestMetrics(registry);
+
+	requestMetrics.latency(pkt::Code::LoginRequest).record(10);
+	requestMetrics.latency(pkt::Code::UpdateRequest).record(20);
+
+	EXPECT_EQ(registry.histogram("request.login_us").snapshot().count(), 1);
+	EXPECT_EQ(registry.histogram("request.update_us").snapshot().count(), 1);
+	EXPECT_EQ(registry.histogram("request.signup_us").snapshot().count(), 0);
+
+	requestMetrics.update_park().record(30);
+	EXPECT_EQ(registry.histogram("request.update_park_us").snapshot().count(), 1);
+}
+
+TEST(ScopedTimerTest, ExcludesTime)
+{
+	Histogram histogram;
+	{
+		ScopedTimer timer(histogram);
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		timer.exclude(timer.elapsed()); // e.g. time spent parked
+	}
+	ASSERT_EQ(histogram.snapshot().count(), 1);
+	EXPECT_LT(histogram.snapshot().max(), 50000);
+}
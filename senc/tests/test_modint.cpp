@@ -8,11 +8,14 @@
 
 #include <gtest/gtest.h>
 #include <typeinfo> // needed for intellisense of exception detection
+#include "../utils/MontModInt.hpp"
 #include "../utils/ModInt.hpp"
 #include "../utils/math.hpp"
 
 using senc::utils::IntegralModTraits;
 using senc::utils::ModException;
+using senc::utils::MontModTraitsType;
+using senc::utils::MontModInt;
 using senc::utils::ModInt;
 using senc::utils::BigInt;
 
@@ -270,3 +273,94 @@ TEST(ModIntTests, IntDivModIntPrimeWithCryptoInt)
 	CMI7 x(3); // inverse is 5
 	EXPECT_EQ(static_cast<BigInt>(BigInt(2) / x), (BigInt(2) * BigInt(5)) % BigInt(7));
 }
+
+using Mont7 = MontModInt<IntegralModTraits<int, 7, true>>;
+using Mont15 = MontModInt<IntegralModTraits<int, 15, false>>; // odd composite modulus
+using MersenneTraits = IntegralModTraits<std::int64_t, 2147483647, true>; // 2^31 - 1
+using CMont7 = MontModInt<CMI7Traits>;
+using CMont6 = MontModInt<CMI6Traits>;
+
+static_assert(MontModTraitsType<IntegralModTraits<int, 7, true>>);
+static_assert(!MontModTraitsType<IntegralModTraits<int, 6, false>>); // even
+static_assert(!MontModTraitsType<IntegralModTraits<std::int64_t, 4294967311, true>>); // too large for R = 2^32
+static_assert(MontModTraitsType<CMI7Traits>);
+
+TEST(MontModIntTests, MatchesModIntWithInt)
+{
+	for (int a = 0; a < 7; ++a)
+	{
+		EXPECT_EQ(Mont7(a).value(), a);
+		EXPECT_EQ((-Mont7(a)).value(), static_cast<int>(-MI7(a)));
+		for (int e = 0; e < 10; ++e)
+		{
+			EXPECT_EQ(Mont7(a).pow(e).value(), static_cast<int>(MI7(a).pow(e)));
+		}
+		for (int b = 0; b < 7; ++b)
+		{
+			EXPECT_EQ((Mont7(a) + Mont7(b)).value(), static_cast<int>(MI7(a) + MI7(b)));
+			EXPECT_EQ((Mont7(a) - Mont7(b)).value(), static_cast<int>(MI7(a) - MI7(b)));
+			EXPECT_EQ((Mont7(a) * Mont7(b)).value(), static_cast<int>(MI7(a) * MI7(b)));
+			if (b != 0)
+			{
+				EXPECT_EQ((Mont7(a) / Mont7(b)).value(), static_cast<int>(MI7(a) / MI7(b)));
+			}
+			EXPECT_EQ(Mont7(a) == Mont7(b), a == b);
+		}
+	}
+
+	EXPECT_EQ(Mont7(9).value(), 2);
+	EXPECT_EQ(Mont7(-1).value(), 6);
+	EXPECT_EQ(Mont7(0).inverse().value(), 0); // same as ModInt
+	EXPECT_EQ(static_cast<MI7>(Mont7(5)), MI7(5));
+	EXPECT_EQ(Mont7(MI7(5)), Mont7(5));
+	EXPECT_EQ(Mont7(5).hash(), MI7(5).hash());
+	EXPECT_EQ(Mont7(5).to_string(), "5");
+}
+
+TEST(MontModIntTests, MatchesModIntWithLargeModulus)
+{
+	using MI = ModInt<MersenneTraits>;
+	using Mont = MontModInt<MersenneTraits>;
+	std::int64_t a = 123456789, b = 987654321;
+	for (int i = 0; i < 1000; ++i)
+	{
+		EXPECT_EQ((Mont(a) * Mont(b)).value(), static_cast<std::int64_t>(MI(a) * MI(b)));
+		EXPECT_EQ((Mont(a) + Mont(b)).value(), static_cast<std::int64_t>(MI(a) + MI(b)));
+		EXPECT_EQ((Mont(a) - Mont(b)).value(), static_cast<std::int64_t>(MI(a) - MI(b)));
+		EXPECT_EQ((Mont(a) * Mont(a).inverse()).value(), 1);
+
+		// cheap deterministic mixing
+		a = (a * 48271 + i) % MersenneTraits::modulus();
+		b = (b * 16807 + 1) % MersenneTraits::modulus();
+	}
+}
+
+TEST(MontModIntTests, InverseWithCompositeModulus)
+{
+	EXPECT_EQ(Mont15(2).inverse().value(), 8);
+	EXPECT_EQ((Mont15(7) / Mont15(4)).value(), (7 * 4) % 15); // 4 is its own inverse
+	EXPECT_THROW(Mont15(3).inverse(), ModException);
+	EXPECT_THROW(Mont15(1) / Mont15(5), ModException);
+}
+
+TEST(MontModIntTests, MatchesModIntWithCryptoInt)
+{
+	for (int a = 0; a < 7; ++a)
+	{
+		EXPECT_EQ(CMont7(BigInt(a)).value(), BigInt(a));
+		EXPECT_EQ(CMont7(BigInt(a)).pow(BigInt(5)).value(), static_cast<BigInt>(CMI7(BigInt(a)).pow(BigInt(5))));
+		for (int b = 1; b < 7; ++b)
+		{
+			const CMont7 x(BigInt{a}), y(BigInt{b});
+			EXPECT_EQ((x + y).value(), static_cast<BigInt>(CMI7(BigInt(a)) + CMI7(BigInt(b))));
+			EXPECT_EQ((x - y).value(), static_cast<BigInt>(CMI7(BigInt(a)) - CMI7(BigInt(b))));
+			EXPECT_EQ((x * y).value(), static_cast<BigInt>(CMI7(BigInt(a)) * CMI7(BigInt(b))));
+			EXPECT_EQ((x / y).value(), static_cast<BigInt>(CMI7(BigInt(a)) / CMI7(BigInt(b))));
+		}
+	}
+}
+
+TEST(MontModIntTests, ThrowsOnEvenCryptoIntModulus)
+{
+	EXPECT_THROW(CMont6(BigInt(1)), ModException);
+}
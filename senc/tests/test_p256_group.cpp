@@ -0,0 +1,182 @@
+/*********************************************************************
+ * \file   test_p256_group.cpp
+ * \brief  Contains differential tests of P256Group against ECGroup.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <ranges>
+#include <vector>
+
+#include "../utils/enc/HybridElGamal2L.hpp"
+#include "../utils/enc/ECHKDF2L.hpp"
+#include "../utils/enc/AES1L.hpp"
+#include "../utils/P256Group.hpp"
+#include "../utils/ECGroup.hpp"
+#include "../utils/Shamir.hpp"
+#include "../utils/Random.hpp"
+#include "../utils/bytes.hpp"
+
+using senc::utils::enc::HybridElGamal2L;
+using senc::utils::enc::ECHKDF2L;
+using senc::utils::enc::AES1L;
+using senc::utils::P256Group;
+using senc::utils::ECGroup;
+using senc::utils::BigInt;
+using senc::utils::Buffer;
+using senc::utils::Random;
+
+/**
+ * @brief Converts a P256Group element to the equivalent ECGroup element (by encoding).
+ */
+static ECGroup to_ec_group(const P256Group& elem)
+{
+	return ECGroup::decode(elem.encode());
+}
+
+/**
+ * @brief Samples an exponent below group order.
+ */
+static BigInt sample_exp()
+{
+	return Random<BigInt>::sample_below(P256Group::order());
+}
+
+TEST(P256GroupTest, SameGroupParams)
+{
+	EXPECT_EQ(P256Group::order(), ECGroup::order());
+	EXPECT_EQ(P256Group::generator().encode(), ECGroup::generator().encode());
+	EXPECT_EQ(P256Group::identity().encode(), ECGroup::identity().encode());
+	EXPECT_EQ(P256Group::generator().x(), ECGroup::generator().x());
+	EXPECT_EQ(P256Group::generator().y(), ECGroup::generator().y());
+}
+
+TEST(P256GroupTest, GeneratorPowMatchesECGroup)
+{
+	for (int i = 0; i < 32; ++i)
+	{
+		const BigInt exp = sample_exp();
+		const P256Group elem = P256Group::generator_pow(exp);
+		EXPECT_EQ(elem.encode(), ECGroup::generator_pow(exp).encode());
+		EXPECT_EQ(elem, P256Group::generator().pow(exp));
+	}
+}
+
+TEST(P256GroupTest, OperationsMatchECGroup)
+{
+	for (int i = 0; i < 16; ++i)
+	{
+		const BigInt exp = sample_exp();
+		const P256Group a = P256Group::sample();
+		const P256Group b = P256Group::sample();
+		const ECGroup ecA = to_ec_group(a);
+		const ECGroup ecB = to_ec_group(b);
+
+		EXPECT_EQ(to_ec_group(a * b), ecA * ecB);
+		EXPECT_EQ(to_ec_group(a / b), ecA / ecB);
+		EXPECT_EQ(to_ec_group(a * a), ecA * ecA);
+		EXPECT_EQ(to_ec_group(a.inverse()), ecA.inverse());
+		EXPECT_EQ(to_ec_group(a.pow(exp)), ecA.pow(exp));
+		EXPECT_EQ((a * b).x(), (ecA * ecB).x());
+		EXPECT_EQ((a * b).y(), (ecA * ecB).y());
+	}
+}
+
+TEST(P256GroupTest, MultiPowMatchesECGroup)
+{
+	std::vector<P256Group> bases;
+	std::vector<ECGroup> ecBases;
+	std::vector<BigInt> exps;
+	for (int i = 0; i < 8; ++i)
+	{
+		bases.push_back(P256Group::sample());
+		ecBases.push_back(to_ec_group(bases.back()));
+		exps.push_back(sample_exp());
+	}
+
+	EXPECT_EQ(
+		to_ec_group(senc::utils::multi_pow<P256Group, BigInt>(bases, exps)),
+		ECGroup::multi_pow(ecBases, exps)
+	);
+}
+
+TEST(P256GroupTest, DecodeMatchesECGroup)
+{
+	for (int i = 0; i < 16; ++i)
+	{
+		const ECGroup elem = ECGroup::sample();
+		const P256Group decoded = P256Group::decode(elem.encode());
+		EXPECT_EQ(decoded.x(), elem.x());
+		EXPECT_EQ(decoded.y(), elem.y());
+		EXPECT_EQ(decoded, P256Group(elem.x(), elem.y()));
+	}
+
+	EXPECT_THROW(P256Group::decode(Buffer(P256Group::ENCODED_SIZE - 1)), std::invalid_argument);
+	EXPECT_THROW(P256Group::decode(Buffer(P256Group::ENCODED_SIZE, 0x04)), std::invalid_argument);
+	EXPECT_THROW(P256Group::decode(Buffer(P256Group::ENCODED_SIZE, 0xFF)), std::invalid_argument);
+}
+
+TEST(P256GroupTest, EdgeCases)
+{
+	const BigInt order = P256Group::order();
+	const BigInt exp = sample_exp();
+	const P256Group elem = P256Group::generator_pow(exp);
+
+	EXPECT_TRUE(P256Group::generator_pow(BigInt::Zero()).is_identity());
+	EXPECT_TRUE(P256Group::generator_pow(order).is_identity());
+	EXPECT_TRUE(elem.pow(order).is_identity());
+	EXPECT_TRUE((elem * elem.inverse()).is_identity());
+	EXPECT_TRUE(P256Group::identity().pow(exp).is_identity());
+	EXPECT_EQ(elem * P256Group::identity(), elem);
+	EXPECT_EQ(P256Group::identity() * elem, elem);
+	EXPECT_EQ(P256Group::generator_pow(-exp), elem.inverse());
+	EXPECT_EQ(P256Group::generator_pow(order + exp), elem);
+	EXPECT_EQ(P256Group::decode(elem.encode()), elem);
+	EXPECT_EQ(P256Group::decode(P256Group::identity().encode()), P256Group::identity());
+	EXPECT_EQ(P256Group::from_string(elem.to_string()), elem);
+	EXPECT_EQ(P256Group::from_string(P256Group::identity().to_string()), P256Group::identity());
+}
+
+TEST(P256GroupTest, SchemaInteroperatesWithECGroup)
+{
+	HybridElGamal2L<P256Group, AES1L, ECHKDF2L> schema;
+	HybridElGamal2L<ECGroup, AES1L, ECHKDF2L> ecSchema;
+	const Buffer data{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06 };
+
+	const auto [pubKey1, privKey1] = schema.keygen();
+	const auto [pubKey2, privKey2] = schema.keygen();
+	const auto encrypted = schema.encrypt(data, pubKey1, pubKey2);
+	EXPECT_EQ(schema.decrypt(encrypted, privKey1, privKey2), data);
+
+	// same curve and KDF input, so ECGroup schema decrypts it as well
+	const auto& [c1, c2, c3] = encrypted;
+	const auto ecEncrypted = std::make_tuple(to_ec_group(c1), to_ec_group(c2), c3);
+	EXPECT_EQ(ecSchema.decrypt(ecEncrypted, privKey1, privKey2), data);
+}
+
+TEST(P256GroupTest, ThresholdDecryption)
+{
+	using Shamir = senc::utils::ShamirHybridElGamal<P256Group, AES1L, ECHKDF2L>;
+	using ShardID = typename Shamir::ShardID;
+	using Part = typename Shamir::Part;
+	HybridElGamal2L<P256Group, AES1L, ECHKDF2L> schema;
+	const Buffer data{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+	const auto [pubKey1, privKey1] = schema.keygen();
+	const auto [pubKey2, privKey2] = schema.keygen();
+	const auto shardsIDs1 = senc::utils::to_vector<ShardID>(std::views::iota(1, 4));
+	const auto shardsIDs2 = senc::utils::to_vector<ShardID>(std::views::iota(4, 7));
+	const auto shards1 = Shamir::make_shards(Shamir::sample_poly(privKey1, 2), shardsIDs1);
+	const auto shards2 = Shamir::make_shards(Shamir::sample_poly(privKey2, 2), shardsIDs2);
+
+	const auto encrypted = schema.encrypt(data, pubKey1, pubKey2);
+	std::vector<Part> parts1, parts2;
+	for (const auto& shard : shards1)
+		parts1.push_back(Shamir::decrypt_get_2l<1>(encrypted, shard, shardsIDs1));
+	for (const auto& shard : shards2)
+		parts2.push_back(Shamir::decrypt_get_2l<2>(encrypted, shard, shardsIDs2));
+
+	EXPECT_EQ(Shamir::decrypt_join_2l(encrypted, parts1, parts2), data);
+}
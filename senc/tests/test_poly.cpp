@@ -37,6 +37,19 @@ TEST_P(IntPolyTest, Output)
 		EXPECT_EQ(expectedOutput, poly(input));
 }
 
+TEST_P(IntPolyTest, BatchOutput)
+{
+	const auto& as = GetParam();
+	std::vector<int> inputs;
+	for (const auto& [input, expectedOutput] : as.expected)
+		inputs.push_back(input);
+
+	const auto outputs = as.poly.eval(inputs);
+	ASSERT_EQ(outputs.size(), inputs.size());
+	for (std::size_t j = 0; j < inputs.size(); ++j)
+		EXPECT_EQ(as.expected[j].second, outputs[j]);
+}
+
 INSTANTIATE_TEST_SUITE_P(IntegerPolynomials, IntPolyTest, testing::Values(
 	IntPolyTestParams
 	{
@@ -68,3 +81,31 @@ INSTANTIATE_TEST_SUITE_P(IntegerPolynomials, IntPolyTest, testing::Values(
 		}
 	}
 ));
+
+TEST(PolyTest, EvalManyMatchesSingleEvaluation)
+{
+	using IntPoly = Poly<long long, long long, long long>;
+	const IntPoly poly1(std::vector<long long>{ 3, -7, 1 });
+	const IntPoly poly2(std::vector<long long>{ 5 });
+	const IntPoly poly3(std::vector<long long>{ -1, 2, 0, 4, -3 });
+	const std::vector<const IntPoly*> polys{ &poly1, &poly2, &poly3 };
+
+	std::vector<long long> inputs;
+	for (long long x = -100; x < 200; ++x)
+		inputs.push_back(x);
+
+	const auto outputs = IntPoly::eval_many(polys, inputs);
+	ASSERT_EQ(outputs.size(), polys.size());
+	for (std::size_t p = 0; p < polys.size(); ++p)
+	{
+		ASSERT_EQ(outputs[p].size(), inputs.size());
+		for (std::size_t j = 0; j < inputs.size(); ++j)
+			EXPECT_EQ(outputs[p][j], (*polys[p])(inputs[j]));
+	}
+
+	EXPECT_TRUE(poly1.eval({}).empty());
+
+	// polynomial with no coefficients
+	const IntPoly empty(std::vector<long long>{});
+	EXPECT_EQ(empty.eval(inputs), std::vector<long long>(inputs.size()));
+}
@@ -8,8 +8,14 @@
 
 #include <gtest/gtest.h>
 #include <functional>
+#include <chrono>
+#include <thread>
 #include <filesystem>
 #include <memory>
+#include <condition_variable>
+#include <vector>
+#include <mutex>
+#include <atomic>
 #include "../utils/Socket.hpp" // has to be first because windows is stupid
 #include "tests_utils.hpp"
 #include "../server/storage/ShortTermServerStorage.hpp"
@@ -33,6 +39,7 @@ using senc::EncryptedPacketHandler;
 using senc::ServerPacketHandlerFactory;
 using senc::ClientPacketHandlerFactory;
 using senc::InlinePacketHandler;
+using senc::server::ServerOptions;
 using senc::server::IServer;
 using senc::server::Server;
 using senc::DecryptionPart;
@@ -171,6 +178,24 @@ TEST_P(ServerTest, LogoutWithoutLogin)
 	EXPECT_TRUE(lo.has_value());
 }
 
+TEST_P(ServerTest, IncompleteRequestsDoNotBlockOthers)
+{
+	// more clients than event loops, each sending only the start of a request
+	std::vector<std::pair<ClientSockPtr, std::unique_ptr<PacketHandler>>> stalled;
+	for (int i = 0; i < 4; ++i)
+	{
+		auto& [sock, packetHandler] = stalled.emplace_back(new_client());
+		sock->send_connected_primitive(pkt::SignupRequest::CODE);
+	}
+
+	// other clients are still served meanwhile
+	auto [avi, aviPacketHandler] = new_client();
+	auto su = post<pkt::SignupResponse>(*aviPacketHandler, pkt::SignupRequest{ "avi", "pass123" });
+	EXPECT_TRUE(su.has_value() && su->status == pkt::SignupResponse::Status::Success);
+	auto lo = post<pkt::LogoutResponse>(*aviPacketHandler, pkt::LogoutRequest{});
+	EXPECT_TRUE(lo.has_value());
+}
+
 TEST_P(ServerTest, SignupAndLogin)
 {
 	auto [avi, aviPacketHandler] = new_client();
@@ -384,6 +409,64 @@ TEST_P(ServerTest, EmptyUpdateCycle)
 	EXPECT_TRUE(lo.has_value());
 }
 
+TEST_P(ServerTest, LongPollEndsOnNextRequest)
+{
+	auto [client, clientPacketHandler] = new_client();
+
+	// signup
+	auto su = post<pkt::SignupResponse>(*clientPacketHandler, pkt::SignupRequest{ "avi", "pass123" });
+	EXPECT_TRUE(su.has_value() && su->status == pkt::SignupResponse::Status::Success);
+
+	// long-poll with no updates coming, with another request pipelined right behind it
+	const auto start = std::chrono::steady_clock::now();
+	clientPacketHandler->send_request(pkt::UpdateRequest{ 60000 });
+	clientPacketHandler->send_request(pkt::LogoutRequest{});
+
+	// long-poll is answered (empty) once next request arrives, rather than held until its limit
+	auto up = clientPacketHandler->recv_response<pkt::UpdateResponse>();
+	EXPECT_TRUE(up.has_value() && up->to_decrypt.empty());
+	auto lo = clientPacketHandler->recv_response<pkt::LogoutResponse>();
+	EXPECT_TRUE(lo.has_value());
+	EXPECT_LT(std::chrono::steady_clock::now() - start, ServerOptions::DEFAULT_MAX_UPDATE_WAIT / 2);
+}
+
+TEST_P(ServerTest, DecryptWithoutThresholdsFreesSlot)
+{
+	auto [owner, ownerPacketHandler] = new_client();
+
+	// signup
+	auto su = post<pkt::SignupResponse>(*ownerPacketHandler, pkt::SignupRequest{ "owner", "pass123" });
+	EXPECT_TRUE(su.has_value() && su->status == pkt::SignupResponse::Status::Success);
+
+	// make set requiring no other members
+	auto ms = post<pkt::MakeUserSetResponse>(*ownerPacketHandler, pkt::MakeUserSetRequest{
+		.reg_members = { },
+		.owners = { },
+		.reg_members_threshold = 0,
+		.owners_threshold = 0
+	});
+	ASSERT_TRUE(ms.has_value());
+
+	// decryption finishes at once, without holding a live operation
+	Schema schema;
+	const Buffer msg{ 1, 2, 3 };
+	auto dc = post<pkt::DecryptResponse>(*ownerPacketHandler, pkt::DecryptRequest{
+		ms->user_set_id,
+		schema.encrypt(msg, ms->reg_layer_pub_key, ms->owner_layer_pub_key)
+	});
+	ASSERT_TRUE(dc.has_value());
+	EXPECT_EQ(decryptionsManager.stats().live_operations, 0);
+
+	auto up = post<pkt::UpdateResponse>(*ownerPacketHandler, pkt::UpdateRequest{});
+	ASSERT_TRUE(up.has_value());
+	ASSERT_EQ(up->finished_decryptions.size(), 1);
+	EXPECT_EQ(up->finished_decryptions.front().op_id, dc->op_id);
+
+	// logout
+	auto lo = post<pkt::LogoutResponse>(*ownerPacketHandler, pkt::LogoutRequest{});
+	EXPECT_TRUE(lo.has_value());
+}
+
 TEST_P(ServerTest, DecryptFlowSimple)
 {
 	auto [owner, ownerPacketHandler] = new_client();
@@ -1573,6 +1656,227 @@ TEST_P(MultiCycleServerTest, MultiCycleDecryptFlow2L)
 	}
 }
 
+TEST(UpdateManagerTest, WaitUpdatesWakesOnRegister)
+{
+	UpdateManager updateManager;
+	const OperationID opid = OperationID::generate();
+
+	std::jthread registerer([&]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		updateManager.register_lookup("avi", opid);
+	});
+
+	// should return as soon as update is registered, long before timeout
+	const auto start = std::chrono::steady_clock::now();
+	auto up = updateManager.wait_updates("avi", std::chrono::seconds(10));
+	EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+
+	ASSERT_EQ(up.on_lookup.size(), 1);
+	EXPECT_EQ(up.on_lookup.front(), opid);
+}
+
+TEST(UpdateManagerTest, WaitUpdatesTimeout)
+{
+	UpdateManager updateManager;
+
+	auto up = updateManager.wait_updates("avi", std::chrono::milliseconds(20));
+	EXPECT_TRUE(up.on_lookup.empty());
+	EXPECT_TRUE(up.added_as_reg_member.empty());
+
+	// updates registered before wait are returned immediately
+	updateManager.register_lookup("avi", OperationID::generate());
+	up = updateManager.wait_updates("avi", std::chrono::seconds(10));
+	EXPECT_EQ(up.on_lookup.size(), 1);
+}
+
+TEST(UpdateManagerTest, BatchLookupReachesAllUsers)
+{
+	UpdateManager updateManager;
+	const OperationID opid = OperationID::generate();
+
+	// enough users to span several stripes
+	std::vector<std::string> usernames;
+	for (std::size_t i = 0; i < 4 * UpdateManager::STRIPE_COUNT; ++i)
+		usernames.push_back("user" + std::to_string(i));
+
+	updateManager.register_lookup(usernames, opid);
+
+	for (const auto& username : usernames)
+	{
+		auto up = updateManager.retrieve_updates(username);
+		ASSERT_EQ(up.on_lookup.size(), 1);
+		EXPECT_EQ(up.on_lookup.front(), opid);
+	}
+	EXPECT_TRUE(updateManager.retrieve_updates("user0").on_lookup.empty());
+}
+
+TEST(UpdateManagerTest, InterruptWaits)
+{
+	UpdateManager updateManager;
+
+	std::jthread interrupter([&]()
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		updateManager.interrupt_waits();
+	});
+
+	const auto start = std::chrono::steady_clock::now();
+	auto up = updateManager.wait_updates("avi", std::chrono::seconds(10));
+	EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+	EXPECT_TRUE(up.on_lookup.empty());
+}
+
+TEST(UpdateManagerTest, ParkWakesOnRegister)
+{
+	UpdateManager updateManager;
+	std::atomic<int> wakes = 0;
+
+	updateManager.park("avi", std::chrono::seconds(10), [&wakes]() { ++wakes; });
+	EXPECT_EQ(wakes, 0);
+	EXPECT_EQ(updateManager.stats().waiting_clients, 1);
+
+	// woken exactly once, as soon as update is registered
+	updateManager.register_lookup("avi", OperationID::generate());
+	updateManager.register_lookup("avi", OperationID::generate());
+	EXPECT_EQ(wakes, 1);
+	EXPECT_EQ(updateManager.stats().waiting_clients, 0);
+	EXPECT_EQ(updateManager.retrieve_updates("avi").on_lookup.size(), 2);
+
+	// woken at once if updates are already registered
+	updateManager.register_lookup("avi", OperationID::generate());
+	updateManager.park("avi", std::chrono::seconds(10), [&wakes]() { ++wakes; });
+	EXPECT_EQ(wakes, 2);
+}
+
+TEST(UpdateManagerTest, ParkExpires)
+{
+	UpdateManager updateManager;
+	std::atomic<int> wakes = 0;
+	std::atomic<bool> stop = false;
+
+	updateManager.park("avi", std::chrono::milliseconds(20), [&wakes]() { ++wakes; });
+	updateManager.park("batya", std::chrono::seconds(10), [&wakes]() { ++wakes; }, [&stop]() { return stop.load(); });
+
+	// not woken before its timeout passes
+	updateManager.expire_parks();
+	EXPECT_EQ(wakes, 0);
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	updateManager.expire_parks();
+	EXPECT_EQ(wakes, 1);
+
+	// woken once its stop condition holds
+	stop = true;
+	updateManager.expire_parks();
+	EXPECT_EQ(wakes, 2);
+	EXPECT_EQ(updateManager.stats().waiting_clients, 0);
+
+	// interrupted parks are woken as well
+	updateManager.park("avi", std::chrono::seconds(10), [&wakes]() { ++wakes; });
+	updateManager.interrupt_waits();
+	EXPECT_EQ(wakes, 3);
+}
+
+TEST(DecryptionsManagerTest, ExpiredOperationsRemoved)
+{
+	DecryptionsManager decryptionsManager;
+	const auto expiry = DecryptionsManager::Clock::now() + DecryptionsManager::DEFAULT_OPERATION_LIFETIME;
+
+	// one operation left preparing, one never prepared
+	const OperationID pending = decryptionsManager.new_operation();
+	decryptionsManager.prepare_operation(
+		pending, "owner", senc::UserSetID::generate(),
+		senc::Ciphertext{},
+		0, 1
+	);
+	decryptionsManager.new_operation();
+	EXPECT_EQ(decryptionsManager.stats().live_operations, 2);
+	EXPECT_EQ(decryptionsManager.stats().preparing_operations, 1);
+
+	// nothing expires before lifetime passes
+	EXPECT_TRUE(decryptionsManager.remove_expired().empty());
+
+	// only prepared operation is reported, but both are removed
+	auto expired = decryptionsManager.remove_expired(expiry);
+	ASSERT_EQ(expired.size(), 1);
+	EXPECT_EQ(expired.front().op_id, pending);
+	EXPECT_EQ(expired.front().requester, "owner");
+
+	const auto stats = decryptionsManager.stats();
+	EXPECT_EQ(stats.live_operations, 0);
+	EXPECT_EQ(stats.preparing_operations, 0);
+	EXPECT_EQ(stats.collecting_operations, 0);
+	EXPECT_EQ(stats.expired_operations, 1);
+
+	EXPECT_THROW(decryptionsManager.register_participant(pending, "member", false), senc::server::ServerException);
+}
+
+TEST(DecryptionsManagerTest, LiveOperationsBounded)
+{
+	DecryptionsManager decryptionsManager(DecryptionsManager::DEFAULT_OPERATION_LIFETIME, 2);
+	const auto expiry = DecryptionsManager::Clock::now() + DecryptionsManager::DEFAULT_OPERATION_LIFETIME;
+
+	decryptionsManager.new_operation();
+	decryptionsManager.new_operation();
+	EXPECT_THROW(decryptionsManager.new_operation(), senc::server::ServerException);
+
+	// room is freed once operations expire
+	decryptionsManager.remove_expired(expiry);
+	EXPECT_NO_THROW(decryptionsManager.new_operation());
+}
+
+TEST(DecryptionsManagerTest, OperationsFinishedWithoutPartsFreeSlots)
+{
+	DecryptionsManager decryptionsManager(DecryptionsManager::DEFAULT_OPERATION_LIFETIME, 1);
+
+	// operation requiring no parts (both thresholds zero) is finished right away
+	const OperationID opid = decryptionsManager.new_operation();
+	EXPECT_EQ(decryptionsManager.stats().live_operations, 1);
+	decryptionsManager.finish_operation(opid);
+	EXPECT_EQ(decryptionsManager.stats().live_operations, 0);
+	EXPECT_NO_THROW(decryptionsManager.finish_operation(opid)); // no-op once finished
+	EXPECT_EQ(decryptionsManager.stats().live_operations, 0);
+
+	// its slot is free for another operation, and it is neither reported nor freed again once expired
+	EXPECT_NO_THROW(decryptionsManager.new_operation());
+	EXPECT_EQ(decryptionsManager.stats().live_operations, 1);
+	auto expired = decryptionsManager.remove_expired(
+		DecryptionsManager::Clock::now() + 2 * DecryptionsManager::DEFAULT_OPERATION_LIFETIME
+	);
+	EXPECT_TRUE(expired.empty());
+	EXPECT_EQ(decryptionsManager.stats().live_operations, 0);
+}
+
+TEST(DecryptionsManagerTest, FinishedOperationsFreeSlots)
+{
+	DecryptionsManager decryptionsManager(DecryptionsManager::DEFAULT_OPERATION_LIFETIME, 1);
+
+	// operation requiring a single part
+	const OperationID opid = decryptionsManager.new_operation();
+	EXPECT_THROW(decryptionsManager.new_operation(), senc::server::ServerException);
+	decryptionsManager.prepare_operation(
+		opid, "owner", senc::UserSetID::generate(),
+		senc::Ciphertext{},
+		0, 1
+	);
+	auto [prep, requirement] = decryptionsManager.register_participant(opid, "member", false);
+	EXPECT_TRUE(prep.has_value());
+	EXPECT_EQ(requirement, DecryptionsManager::PartRequirement::RegPart);
+
+	// room is freed once operation finishes, long before it expires
+	auto collected = decryptionsManager.register_part(opid, DecryptionPart{}, PrivKeyShardID{}, false);
+	EXPECT_TRUE(collected.has_value());
+	EXPECT_EQ(decryptionsManager.stats().live_operations, 0);
+	EXPECT_NO_THROW(decryptionsManager.new_operation());
+
+	// late participants of finished operation are still recognized
+	EXPECT_EQ(
+		decryptionsManager.register_participant(opid, "late", false).second,
+		DecryptionsManager::PartRequirement::NotRequired
+	);
+}
+
 // ===== Instantiation of Parameterized Tests =====
 
 static std::unique_ptr<IServerStorage> make_sqlite_server_storage()
@@ -1584,6 +1888,17 @@ static std::unique_ptr<IServerStorage> make_sqlite_server_storage()
 	return std::make_unique<SqliteServerStorage>(PATH);
 }
 
+// reactor mode with few event loops, so that clients of a test share loops
+const ServerOptions REACTOR_OPTIONS{
+	.mode = ServerOptions::Mode::Reactor,
+	.reactorThreads = 2
+};
+
+// several listening sockets sharing the port, so that clients of a test spread between acceptors
+const ServerOptions REUSE_PORT_OPTIONS{
+	.acceptors = 3
+};
+
 const auto SERVER_IMPLS = testing::Values(
 	ServerTestParams{
 		[](Port port) { return std::make_unique<senc::utils::TcpSocket<IPv4>>(IPv4::loopback(), port); },
@@ -1613,6 +1928,33 @@ const auto SERVER_IMPLS = testing::Values(
 		std::make_unique<ServerPacketHandlerImplFactory<EncryptedPacketHandler>>,
 		std::make_unique<ClientPacketHandlerImplFactory<EncryptedPacketHandler>>
 	}
+#ifndef SENC_WINDOWS
+	,
+	ServerTestParams{
+		[](Port port) { return std::make_unique<senc::utils::TcpSocket<IPv4>>(IPv4::loopback(), port); },
+		[](auto&&... args) { return new_server<IPv4>(args..., REACTOR_OPTIONS); },
+		std::make_unique<ShortTermServerStorage>,
+		std::make_unique<ServerPacketHandlerImplFactory<InlinePacketHandler>>,
+		std::make_unique<ClientPacketHandlerImplFactory<InlinePacketHandler>>
+	},
+	ServerTestParams{
+		[](Port port) { return std::make_unique<senc::utils::TcpSocket<IPv6>>(IPv6::loopback(), port); },
+		[](auto&&... args) { return new_server<IPv6>(args..., REACTOR_OPTIONS); },
+		make_sqlite_server_storage,
+		std::make_unique<ServerPacketHandlerImplFactory<EncryptedPacketHandler>>,
+		std::make_unique<ClientPacketHandlerImplFactory<EncryptedPacketHandler>>
+	}
+#endif
+#ifdef SO_REUSEPORT
+	,
+	ServerTestParams{
+		[](Port port) { return std::make_unique<senc::utils::TcpSocket<IPv4>>(IPv4::loopback(), port); },
+		[](auto&&... args) { return new_server<IPv4>(args..., REUSE_PORT_OPTIONS); },
+		std::make_unique<ShortTermServerStorage>,
+		std::make_unique<ServerPacketHandlerImplFactory<EncryptedPacketHandler>>,
+		std::make_unique<ClientPacketHandlerImplFactory<EncryptedPacketHandler>>
+	}
+#endif
 );
 
 const auto CYCLE_PARAMS = testing::Values(
@@ -1683,3 +2025,186 @@ INSTANTIATE_TEST_SUITE_P(
 	MultiCycleServerTest,
 	testing::Combine(SERVER_IMPLS, CYCLE_PARAMS)
 );
+
+#ifndef SENC_WINDOWS
+TEST(ReactorTest, PostDispatchesEachKeyOnce)
+{
+	constexpr std::size_t POSTERS = 4;
+	constexpr std::size_t POSTS = 250;
+
+	std::mutex mtx;
+	std::condition_variable cv;
+	std::vector<std::size_t> dispatched(POSTERS * POSTS);
+	std::size_t total = 0;
+	senc::server::io::Reactor reactor(2, [&](senc::server::io::Reactor::Key key)
+	{
+		const std::lock_guard<std::mutex> lock(mtx);
+		++dispatched[key];
+		++total;
+		cv.notify_all();
+	});
+	reactor.start();
+
+	{
+		std::vector<std::jthread> posters;
+		for (std::size_t i = 0; i < POSTERS; ++i)
+			posters.emplace_back([&reactor, i]()
+			{
+				for (std::size_t j = 0; j < POSTS; ++j)
+					reactor.post(i * POSTS + j);
+			});
+	} // joins posters
+
+	std::unique_lock<std::mutex> lock(mtx);
+	EXPECT_TRUE(cv.wait_for(lock, std::chrono::seconds(10), [&]() { return total == dispatched.size(); }));
+	for (const auto count : dispatched)
+		EXPECT_EQ(count, 1);
+	lock.unlock();
+
+	reactor.stop();
+}
+
+class ReactorServerTest : public ServerTestBase
+{
+protected:
+	const ServerTestParams& get_server_test_params() override
+	{
+		static const ServerTestParams params{
+			[](Port port) { return std::make_unique<senc::utils::TcpSocket<IPv4>>(IPv4::loopback(), port); },
+			[](auto&&... args) { return new_server<IPv4>(args..., REACTOR_OPTIONS); },
+			std::make_unique<ShortTermServerStorage>,
+			std::make_unique<ServerPacketHandlerImplFactory<InlinePacketHandler>>,
+			std::make_unique<ClientPacketHandlerImplFactory<InlinePacketHandler>>
+		};
+		return params;
+	}
+};
+
+// storage whose userset creation is slow (standing in for CPU-heavy key generation and sharding)
+class SlowUsersetStorage : public ShortTermServerStorage
+{
+public:
+	static constexpr std::chrono::milliseconds DELAY{ 1000 };
+
+	senc::UserSetID new_userset(senc::utils::ranges::StringViewRange&& owners,
+								senc::utils::ranges::StringViewRange&& regMembers,
+								member_count_t ownersThreshold,
+								member_count_t regMembersThreshold) override
+	{
+		std::this_thread::sleep_for(DELAY);
+		return ShortTermServerStorage::new_userset(
+			std::move(owners), std::move(regMembers),
+			ownersThreshold, regMembersThreshold
+		);
+	}
+};
+
+// reactor mode with a single event loop, so that a request occupying it stalls all clients
+class SingleLoopReactorServerTest : public ServerTestBase
+{
+protected:
+	const ServerTestParams& get_server_test_params() override
+	{
+		static const ServerOptions options{
+			.mode = ServerOptions::Mode::Reactor,
+			.reactorThreads = 1
+		};
+		static const ServerTestParams params{
+			[](Port port) { return std::make_unique<senc::utils::TcpSocket<IPv4>>(IPv4::loopback(), port); },
+			[](auto&&... args) { return new_server<IPv4>(args..., options); },
+			std::make_unique<SlowUsersetStorage>,
+			std::make_unique<ServerPacketHandlerImplFactory<InlinePacketHandler>>,
+			std::make_unique<ClientPacketHandlerImplFactory<InlinePacketHandler>>
+		};
+		return params;
+	}
+};
+
+TEST_F(SingleLoopReactorServerTest, SlowUsersetDoesNotDelayOthers)
+{
+	auto [client1, client1PacketHandler] = new_client();
+	auto [client2, client2PacketHandler] = new_client();
+
+	// signup
+	auto su1 = post<pkt::SignupResponse>(*client1PacketHandler, pkt::SignupRequest{ "avi", "pass123" });
+	EXPECT_TRUE(su1.has_value() && su1->status == pkt::SignupResponse::Status::Success);
+	auto su2 = post<pkt::SignupResponse>(*client2PacketHandler, pkt::SignupRequest{ "batya", "pass123" });
+	EXPECT_TRUE(su2.has_value() && su2->status == pkt::SignupResponse::Status::Success);
+
+	// slow userset creation is handed to a worker, so the only event loop stays free
+	const auto start = std::chrono::steady_clock::now();
+	client1PacketHandler->send_request(pkt::MakeUserSetRequest{
+		.reg_members = { "batya" },
+		.owners = {},
+		.reg_members_threshold = 1,
+		.owners_threshold = 0
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(50)); // let event loop take it first
+	auto up = post<pkt::UpdateResponse>(*client2PacketHandler, pkt::UpdateRequest{});
+	EXPECT_TRUE(up.has_value());
+	EXPECT_LT(std::chrono::steady_clock::now() - start, SlowUsersetStorage::DELAY / 2);
+
+	// userset is still created, and its creator's next request is answered after it
+	auto ms = client1PacketHandler->recv_response<pkt::MakeUserSetResponse>();
+	EXPECT_TRUE(ms.has_value());
+	auto gs = post<pkt::GetUserSetsResponse>(*client1PacketHandler, pkt::GetUserSetsRequest{});
+	ASSERT_TRUE(gs.has_value());
+	EXPECT_CONTAINS(gs->user_sets_ids, ms->user_set_id);
+
+	// logout
+	for (auto& packetHandler : { std::ref(*client1PacketHandler), std::ref(*client2PacketHandler) })
+	{
+		auto lo = post<pkt::LogoutResponse>(packetHandler, pkt::LogoutRequest{});
+		EXPECT_TRUE(lo.has_value());
+	}
+}
+
+TEST_F(ReactorServerTest, LongPollParkedUntilUpdate)
+{
+	// more long-polling clients than event loops, so that holding loops would stall the server
+	const std::vector<std::string> members{ "batya", "gila", "dana" };
+	ASSERT_GT(members.size(), REACTOR_OPTIONS.reactorThreads);
+
+	std::vector<std::pair<ClientSockPtr, std::unique_ptr<PacketHandler>>> clients;
+	for (const auto& member : members)
+	{
+		auto& [client, packetHandler] = clients.emplace_back(new_client());
+		auto su = post<pkt::SignupResponse>(*packetHandler, pkt::SignupRequest{ member, "pass123" });
+		EXPECT_TRUE(su.has_value() && su->status == pkt::SignupResponse::Status::Success);
+		packetHandler->send_request(pkt::UpdateRequest{ 60000 });
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(50)); // let event loops park them
+
+	// parked requests leave event loops free, so another client is served meanwhile
+	const auto start = std::chrono::steady_clock::now();
+	auto [creator, creatorPacketHandler] = new_client();
+	auto su = post<pkt::SignupResponse>(*creatorPacketHandler, pkt::SignupRequest{ "avi", "pass123" });
+	EXPECT_TRUE(su.has_value() && su->status == pkt::SignupResponse::Status::Success);
+	auto ms = post<pkt::MakeUserSetResponse>(*creatorPacketHandler, pkt::MakeUserSetRequest{
+		.reg_members = members,
+		.owners = {},
+		.reg_members_threshold = 1,
+		.owners_threshold = 0
+	});
+	ASSERT_TRUE(ms.has_value());
+
+	// each parked request is answered once its update arrives, long before its wait passes
+	for (auto& [client, packetHandler] : clients)
+	{
+		auto up = packetHandler->recv_response<pkt::UpdateResponse>();
+		ASSERT_TRUE(up.has_value());
+		ASSERT_EQ(up->added_as_reg_member.size(), 1);
+		EXPECT_EQ(up->added_as_reg_member.front().user_set_id, ms->user_set_id);
+	}
+	EXPECT_LT(std::chrono::steady_clock::now() - start, ServerOptions::DEFAULT_MAX_UPDATE_WAIT / 2);
+	EXPECT_EQ(updateManager.stats().waiting_clients, 0);
+
+	// logout
+	clients.emplace_back(std::move(creator), std::move(creatorPacketHandler));
+	for (auto& [client, packetHandler] : clients)
+	{
+		auto lo = post<pkt::LogoutResponse>(*packetHandler, pkt::LogoutRequest{});
+		EXPECT_TRUE(lo.has_value());
+	}
+}
+#endif
@@ -132,3 +132,78 @@ INSTANTIATE_TEST_SUITE_P(ModularIntSharing, ShareModIntTest, testing::Values(
 	ShareModIntTestParams{ 5, 4, 4, false },   // Need 5, only have 4
 	ShareModIntTestParams{ 1, 5, 3, false }    // Need 6, only have 3
 ));
+
+/**
+ * @brief Checks that given coefficients interpolate the monomials `x^k` (for `k < n`) at zero.
+ */
+template <typename Coeff>
+static void expect_interpolate_at_zero(const std::vector<Coeff>& coeffs, const std::vector<std::uint32_t>& ids)
+{
+	ASSERT_EQ(coeffs.size(), ids.size());
+	for (std::size_t k = 0; k < ids.size(); ++k)
+	{
+		Coeff sum(0);
+		for (std::size_t i = 0; i < ids.size(); ++i)
+		{
+			Coeff term = coeffs[i];
+			for (std::size_t e = 0; e < k; ++e)
+				term = term * Coeff(static_cast<int>(ids[i]));
+			sum = sum + term;
+		}
+		EXPECT_EQ(sum, Coeff(0 == k ? 1 : 0));
+	}
+}
+
+TEST(ShamirTest, LagrangeCoeffsInterpolateAtZero)
+{
+	using IntShamir = senc::utils::Shamir<int>;
+	using ModShamir = senc::utils::Shamir<MI7>;
+
+	for (const std::vector<std::uint32_t>& ids : {
+		std::vector<std::uint32_t>{ 1 },
+		std::vector<std::uint32_t>{ 3, 1 },
+		std::vector<std::uint32_t>{ 1, 2, 4, 5 },
+		std::vector<std::uint32_t>{ 6, 5, 4, 3, 2, 1 } })
+	{
+		expect_interpolate_at_zero(IntShamir::lagrange_coeffs(ids), ids);
+		expect_interpolate_at_zero(ModShamir::lagrange_coeffs(ids), ids);
+
+		const auto coeffs = ModShamir::lagrange_coeffs(ids);
+		for (std::size_t i = 0; i < ids.size(); ++i)
+		{
+			EXPECT_EQ(ModShamir::lagrange_coeff(i, ids), coeffs[i]);
+			EXPECT_EQ(IntShamir::lagrange_coeff(i, ids), IntShamir::lagrange_coeffs(ids)[i]);
+		}
+	}
+
+	EXPECT_TRUE(ModShamir::lagrange_coeffs({}).empty());
+	EXPECT_THROW(ModShamir::lagrange_coeffs({ 1, 0, 2 }), ShamirException);
+	EXPECT_THROW(ModShamir::lagrange_coeffs({ 1, 2, 1 }), ShamirException);
+	EXPECT_THROW(IntShamir::lagrange_coeffs({ 3, 3 }), ShamirException);
+	EXPECT_THROW(ModShamir::lagrange_coeff(0, { 1, 2, 1 }), ShamirException);
+}
+
+TEST(ShamirTest, MakeShardsBatchMatchesMakeShards)
+{
+	using Shamir = senc::utils::Shamir<MI7>;
+	const auto poly1 = Shamir::sample_poly(MI7(3), 4, MI7::sample);
+	const auto poly2 = Shamir::sample_poly(MI7(5), 2, MI7::sample);
+	const std::vector<const Shamir::Poly*> polys{ &poly1, &poly2 };
+
+	for (std::uint32_t count : { 3u, 100u }) // 100 IDs are evaluated in parallel
+	{
+		std::vector<std::uint32_t> ids;
+		for (std::uint32_t id = 1; id <= count; ++id)
+			ids.push_back(id);
+
+		const auto shards = Shamir::make_shards_batch(polys, ids);
+		ASSERT_EQ(shards.size(), polys.size());
+		for (std::size_t p = 0; p < polys.size(); ++p)
+		{
+			EXPECT_EQ(shards[p], Shamir::make_shards(*polys[p], ids));
+		}
+	}
+
+	EXPECT_THROW(Shamir::make_shards_batch(polys, { 1, 0 }), ShamirException);
+	EXPECT_THROW(Shamir::make_shards_batch(polys, { 2, 1, 2 }), ShamirException);
+}
@@ -14,6 +14,7 @@ using senc::utils::UdpSocket;
 using senc::utils::TcpSocket;
 using senc::utils::IPType;
 using senc::utils::Buffer;
+using senc::utils::Port;
 using senc::utils::byte;
 using senc::utils::IPv4;
 using senc::utils::IPv6;
@@ -136,3 +137,115 @@ TYPED_TEST(SocketTests, TcpSerializesAndDeserializesTuples)
 
 	EXPECT_EQ(sendTpl, recvTpl);
 }
+
+TYPED_TEST(SocketTests, TcpBufferedRecvRestoresIncompleteMessage)
+{
+	using IP = TypeParam;
+	using senc::utils::SocketWouldBlockException;
+	using BufferedRecv = senc::utils::Socket::BufferedRecv;
+	auto [sendSock, recvSock] = prepare_tcp<IP>();
+
+	// recvs like an event loop: retries message from its start whenever more data arrives
+	auto recvWhole = [&recvSock](auto recvMsg)
+	{
+		while (true)
+		{
+			{
+				BufferedRecv recv(recvSock);
+				try
+				{
+					auto res = recvMsg();
+					recv.commit();
+					return res;
+				}
+				catch (const SocketWouldBlockException&) { }
+			}
+			recvSock.recv_available();
+		}
+	};
+
+	// nothing sent yet - reads nothing, without blocking
+	EXPECT_EQ(recvSock.recv_available(), 0);
+
+	// send only first half of message
+	sendSock.send_connected(Buffer{ 1, 2 });
+	while (!recvSock.has_leftover_data())
+		recvSock.recv_available();
+	{
+		BufferedRecv recv(recvSock);
+		EXPECT_THROW(recvSock.recv_connected_exact(4), SocketWouldBlockException);
+	}
+	EXPECT_TRUE(recvSock.has_leftover_data()); // incomplete message restored
+
+	// send rest of message, followed by a string and a value that are recieved together
+	sendSock.send_connected(Buffer{ 3, 4 });
+	sendSock.send_connected_str(std::string("ab"));
+	sendSock.send_connected_primitive(5);
+	EXPECT_EQ(recvWhole([&]() { return recvSock.recv_connected_exact(4); }), (Buffer{ 1, 2, 3, 4 }));
+	EXPECT_EQ(recvWhole([&]() { return recvSock.recv_connected_str(); }), "ab");
+	EXPECT_EQ(recvWhole([&]() { return recvSock.template recv_connected_primitive<int>(); }), 5);
+	EXPECT_FALSE(recvSock.has_leftover_data());
+}
+
+TYPED_TEST(SocketTests, TcpRecvAvailableThrowsOnClosedConnection)
+{
+	using IP = TypeParam;
+	auto [sendSock, recvSock] = prepare_tcp<IP>();
+
+	sendSock.close();
+	EXPECT_THROW(
+		{ while (true) recvSock.recv_available(); },
+		senc::utils::SocketException
+	);
+}
+
+TYPED_TEST(SocketTests, TcpSetsAndGetsOptions)
+{
+	using IP = TypeParam;
+	TcpSocket<IP> sock;
+
+	sock.set_reuse_address(true);
+	EXPECT_NE(sock.get_option(SOL_SOCKET, SO_REUSEADDR), 0);
+	sock.set_reuse_address(false);
+	EXPECT_EQ(sock.get_option(SOL_SOCKET, SO_REUSEADDR), 0);
+
+	sock.set_no_delay(true);
+	EXPECT_NE(sock.get_option(IPPROTO_TCP, TCP_NODELAY), 0);
+}
+
+TYPED_TEST(SocketTests, TcpReusePortSharesListeningPort)
+{
+	using IP = TypeParam;
+	if (!TcpSocket<IP>::REUSE_PORT_SUPPORTED)
+		GTEST_SKIP() << "SO_REUSEPORT is not supported on this platform";
+
+	// both sockets bind and listen on the same port (assigned to first one)
+	TcpSocket<IP> listener1, listener2;
+	listener1.set_reuse_port(true);
+	listener2.set_reuse_port(true);
+	listener1.bind(0);
+	const Port port = std::get<1>(listener1.local_address());
+	listener2.bind(port);
+	listener1.listen();
+	listener2.listen();
+
+	// without the option, binding to the port fails
+	TcpSocket<IP> other;
+	EXPECT_THROW(other.bind(port), senc::utils::SocketException);
+}
+
+TYPED_TEST(SocketTests, TcpLocalAddressReportsAssignedPort)
+{
+	using IP = TypeParam;
+	TcpSocket<IP> listener;
+	listener.bind(0);
+	listener.listen();
+	const Port port = std::get<1>(listener.local_address());
+	EXPECT_NE(port, 0);
+
+	// connecting to reported port reaches listener
+	TcpSocket<IP> client(IP::loopback(), port);
+	auto [conn, addr] = listener.accept();
+	client.send_connected_primitive(7);
+	EXPECT_EQ(conn.template recv_connected_primitive<int>(), 7);
+}
@@ -9,8 +9,11 @@
 #include <gtest/gtest.h>
 #include <filesystem>
 #include <optional>
+#include <thread>
+#include <atomic>
 #include <tuple>
 
+#include "../utils/sqlite/ConnectionPool.hpp"
 #include "../utils/sqlite/Database.hpp"
 
 namespace sql = senc::utils::sqlite;
@@ -895,3 +898,458 @@ TEST_F(SqlTest, JoinAggregateCount)
 		>> count;
 	EXPECT_EQ(count.get(), 2);
 }
+
+// ---------------------------------------------------------------------------
+// Prepared statement cache
+// ---------------------------------------------------------------------------
+
+// repeated inserts reuse the same prepared statement (SetUp already inserted into both tables)
+TEST_F(SqlTest, StatementCacheReusesInsert)
+{
+	const auto before = db->statement_cache_stats();
+	db->insert<"Users">(sql::Int(7), sql::Text("Eden"), sql::Real(40), sql::Null{});
+	db->insert<"Users">(sql::Int(8), sql::Text("Hila"), sql::Real(41), sql::Blob{ 0x01 });
+	const auto after = db->statement_cache_stats();
+	EXPECT_EQ(after.hits, before.hits + 2);
+	EXPECT_EQ(after.misses, before.misses);
+
+	// bindings are cleared between uses, so each row holds its own values
+	sql::Nullable<sql::Blob> data;
+	db->select<"Users", sql::SelectArg<"data">>().where("id = 7") >> data;
+	EXPECT_FALSE(data.has_value());
+	db->select<"Users", sql::SelectArg<"data">>().where("id = 8") >> data;
+	EXPECT_TRUE(data.has_value());
+
+	db->remove<"Users">("id = 7");
+	db->remove<"Users">("id = 8");
+}
+
+// repeated identical selects reuse the same prepared statement, with unchanged results
+TEST_F(SqlTest, StatementCacheReusesSelect)
+{
+	auto view = db->select<"Users", sql::SelectArg<"name">>()
+		.order_by<sql::OrderArg<"id", sql::Order::Asc>>();
+
+	std::vector<sql::Text> first, second;
+	const auto before = db->statement_cache_stats();
+	view >> first;
+	view >> second;
+	const auto after = db->statement_cache_stats();
+
+	EXPECT_EQ(after.misses, before.misses + 1);
+	EXPECT_EQ(after.hits, before.hits + 1);
+	ASSERT_EQ(first.size(), 2);
+	ASSERT_EQ(second.size(), 2);
+	EXPECT_EQ(first[0].get(), second[0].get());
+	EXPECT_EQ(first[1].get(), second[1].get());
+}
+
+// a statement that failed mid-way is reset before being reused
+TEST_F(SqlTest, StatementCacheResetsAfterFailure)
+{
+	auto view = db->select<"Users", sql::SelectArg<"name">>();
+
+	sql::Text name;
+	EXPECT_THROW(view >> name, sql::SQLiteException); // two rows, one expected
+
+	std::vector<sql::Text> names;
+	view >> names;
+	EXPECT_EQ(names.size(), 2);
+}
+
+// ---------------------------------------------------------------------------
+// Bound-parameter where
+// ---------------------------------------------------------------------------
+
+TEST_F(SqlTest, BoundWhereText)
+{
+	const std::string username = "Batya";
+	sql::Int id;
+	db->select<"Users", sql::SelectArg<"id">>()
+		.where<"name">(sql::TextView(username))
+		>> id;
+	EXPECT_EQ(id.get(), 2);
+}
+
+TEST_F(SqlTest, BoundWhereBlob)
+{
+	const senc::utils::Buffer bdata{ 0xAA, 0xBB, 0xCC };
+	sql::Text name;
+	db->select<"Users", sql::SelectArg<"name">>()
+		.where<"data">(sql::BlobView(bdata.data(), bdata.size()))
+		>> name;
+	EXPECT_EQ(name.get(), "Batya");
+}
+
+// bound where combines with string where clauses (on unselected columns as well)
+TEST_F(SqlTest, BoundWhereWithStringWhere)
+{
+	int count = 0;
+	db->select<"Users", sql::SelectArg<"name">>()
+		.where<"id">(sql::Int(1))
+		.where("age > 20")
+		>> [&count](sql::TextView) { ++count; };
+	EXPECT_EQ(count, 1);
+
+	count = 0;
+	db->select<"Users", sql::SelectArg<"name">>()
+		.where<"id">(sql::Int(2))
+		.where("age > 20")
+		>> [&count](sql::TextView) { ++count; };
+	EXPECT_EQ(count, 0);
+}
+
+// params of inner views are bound before params of outer views
+TEST_F(SqlTest, BoundWhereThroughInnerView)
+{
+	std::vector<sql::Text> names;
+	db->select<"Users", sql::SelectArg<"name">, sql::SelectArg<"age">>()
+		.where<"id">(sql::Int(2))
+		.select<sql::SelectArg<"name">>()
+		.where<"age">(sql::Real(18.5))
+		>> names;
+	ASSERT_EQ(names.size(), 1);
+	EXPECT_EQ(names[0].get(), "Batya");
+}
+
+TEST_F(SqlTest, BoundWhereOnJoin)
+{
+	sql::Int fav;
+	db->join<"Users", "id", "FavNumbers", "user_id">()
+		.select<sql::SelectArg<"fav_num">>()
+		.where<"name">(sql::Text("Avi"))
+		>> fav;
+	EXPECT_EQ(fav.get(), 434);
+}
+
+// bound where only accepts columns of underlying table, compared to params fitting their type
+using BoundWhereUsers = sql::schemas::Table<"Users",
+	sql::schemas::PrimaryKey<"id"  , sql::Int                >,
+	sql::schemas::Col       <"name", sql::Text               >,
+	sql::schemas::Col       <"data", sql::Nullable<sql::Blob>>
+>;
+static_assert(sql::schemas::TableWithParamCol<BoundWhereUsers, "id", sql::Int>);
+static_assert(sql::schemas::TableWithParamCol<BoundWhereUsers, "name", sql::TextView>);
+static_assert(sql::schemas::TableWithParamCol<BoundWhereUsers, "data", sql::BlobView>);
+static_assert(!sql::schemas::TableWithParamCol<BoundWhereUsers, "age", sql::Real>); // no such column
+static_assert(!sql::schemas::TableWithParamCol<BoundWhereUsers, "id", sql::Text>); // wrong type
+
+template <typename V, senc::utils::FixedString colName, typename P>
+concept BoundWhereable = requires(const V& view, const P& value)
+{
+	view.template where<colName>(value);
+};
+using BoundWhereView = sql::TableView<
+	sql::schemas::Select<BoundWhereUsers, sql::SelectArg<"name">>,
+	BoundWhereUsers
+>;
+static_assert(BoundWhereable<BoundWhereView, "id", sql::Int>); // unselected column
+static_assert(!BoundWhereable<BoundWhereView, "age", sql::Real>);
+static_assert(!BoundWhereable<BoundWhereView, "name", sql::Int>);
+
+// different bound values share one prepared statement
+TEST_F(SqlTest, BoundWhereReusesStatement)
+{
+	const auto before = db->statement_cache_stats();
+	for (std::int64_t id : { 1, 2, 1, 2 })
+	{
+		sql::Text name;
+		db->select<"Users", sql::SelectArg<"name">>()
+			.where<"id">(sql::Int(id))
+			>> name;
+		EXPECT_EQ(name.get(), (1 == id) ? "Avi" : "Batya");
+	}
+	const auto after = db->statement_cache_stats();
+	EXPECT_EQ(after.misses, before.misses + 1);
+	EXPECT_EQ(after.hits, before.hits + 3);
+}
+
+// ---------------------------------------------------------------------------
+// Indexes
+// ---------------------------------------------------------------------------
+
+TEST(SqlIndexTest, IndexesAreCreated)
+{
+	const std::string path = "database_indexes.sqlite";
+	if (std::filesystem::exists(path))
+		std::remove(path.c_str());
+
+	sql::TempDatabase<sql::schemas::DB<
+		sql::schemas::Index<"Pets", "owner", "name">,
+		sql::schemas::Table<"Pets",
+			sql::schemas::PrimaryKey<"id"   , sql::Int >,
+			sql::schemas::Col       <"owner", sql::Text>,
+			sql::schemas::Col       <"name" , sql::Text>,
+			sql::schemas::Col       <"chip" , sql::Int >
+		>,
+		sql::schemas::UniqueIndex<"Pets", "chip">
+	>> db(path);
+
+	db.insert<"Pets">(sql::Int(1), sql::Text("Avi"), sql::Text("Rex"), sql::Int(100));
+	db.insert<"Pets">(sql::Int(2), sql::Text("Avi"), sql::Text("Rex"), sql::Int(101)); // non-unique index
+
+	// unique index rejects duplicated values
+	EXPECT_THROW(
+		db.insert<"Pets">(sql::Int(3), sql::Text("Batya"), sql::Text("Tom"), sql::Int(100)),
+		sql::SQLiteException
+	);
+
+	// both indexes are in database, and used for lookups on their columns
+	sqlite3* raw = nullptr;
+	ASSERT_EQ(sqlite3_open(path.c_str(), &raw), SQLITE_OK);
+	std::vector<std::string> names;
+	sqlite3_exec(raw, "SELECT name FROM sqlite_master WHERE type = 'index' AND tbl_name = 'Pets' AND name LIKE 'idx%' ORDER BY name",
+		[](void* out, int, char** values, char**)
+		{
+			static_cast<std::vector<std::string>*>(out)->emplace_back(values[0]);
+			return 0;
+		}, &names, nullptr);
+	std::string plan;
+	sqlite3_exec(raw, "EXPLAIN QUERY PLAN SELECT name FROM Pets WHERE owner = 'Avi'",
+		[](void* out, int cols, char** values, char**)
+		{
+			*static_cast<std::string*>(out) += values[cols - 1];
+			return 0;
+		}, &plan, nullptr);
+	sqlite3_close(raw);
+
+	ASSERT_EQ(names.size(), 2);
+	EXPECT_EQ(names[0], "idx_Pets_chip");
+	EXPECT_EQ(names[1], "idx_Pets_owner_name");
+	EXPECT_NE(plan.find("idx_Pets_owner_name"), std::string::npos);
+}
+
+// ---------------------------------------------------------------------------
+// Transactions and batch insertion
+// ---------------------------------------------------------------------------
+
+TEST_F(SqlTest, TransactionCommits)
+{
+	const int res = db->transaction([this]()
+	{
+		db->insert<"Users">(sql::Int(10), sql::Text("Yael"), sql::Real(33), sql::Null{});
+		db->insert<"FavNumbers">(sql::Int(10), sql::Int(7));
+		return 7;
+	});
+	EXPECT_EQ(res, 7);
+
+	sql::Int fav;
+	db->select<"FavNumbers", sql::SelectArg<"fav_num">>().where<"user_id">(sql::Int(10)) >> fav;
+	EXPECT_EQ(fav.get(), 7);
+}
+
+TEST_F(SqlTest, TransactionRollsBackOnThrow)
+{
+	EXPECT_THROW(db->transaction([this]()
+	{
+		db->insert<"Users">(sql::Int(11), sql::Text("Tal"), sql::Real(33), sql::Null{});
+		db->insert<"Users">(sql::Int(11), sql::Text("Tal"), sql::Real(33), sql::Null{}); // duplicate key
+	}), sql::SQLiteException);
+
+	EXPECT_THROW(db->transaction([this]()
+	{
+		db->insert<"Users">(sql::Int(12), sql::Text("Noa"), sql::Real(33), sql::Null{});
+		throw std::runtime_error("abort");
+	}), std::runtime_error);
+
+	sql::Int count;
+	db->select<"Users", sql::AggrSelectArg<sql::Count<"id">>>() >> count;
+	EXPECT_EQ(count.get(), 2);
+}
+
+// nested transactions join outer one, so a failing outer transaction rolls back everything
+TEST_F(SqlTest, NestedTransactionJoinsOuter)
+{
+	EXPECT_THROW(db->transaction([this]()
+	{
+		db->transaction([this]()
+		{
+			db->insert<"Users">(sql::Int(13), sql::Text("Ori"), sql::Real(33), sql::Null{});
+		});
+		throw std::runtime_error("abort");
+	}), std::runtime_error);
+
+	sql::Int count;
+	db->select<"Users", sql::AggrSelectArg<sql::Count<"id">>>() >> count;
+	EXPECT_EQ(count.get(), 2);
+}
+
+// insert more rows than a single multi-row statement holds (plus a partial chunk)
+TEST_F(SqlTest, InsertManyRoundTrip)
+{
+	std::vector<std::string> names;
+	for (int i = 0; i < 300; ++i)
+		names.push_back("user" + std::to_string(i));
+
+	std::vector<std::tuple<sql::Int, sql::TextView, sql::Real, sql::Null>> rows;
+	for (int i = 0; i < 300; ++i)
+		rows.emplace_back(sql::Int(100 + i), sql::TextView(names[i]), sql::Real(i), sql::Null{});
+	db->insert_many<"Users">(rows);
+
+	sql::Int count;
+	db->select<"Users", sql::AggrSelectArg<sql::Count<"id">>>() >> count;
+	EXPECT_EQ(count.get(), 302);
+
+	std::vector<sql::Text> selected;
+	db->select<"Users", sql::SelectArg<"name">>()
+		.where("id >= 100")
+		.order_by<sql::OrderArg<"id", sql::Order::Asc>>()
+		>> selected;
+	ASSERT_EQ(selected.size(), 300);
+	for (int i = 0; i < 300; ++i)
+		EXPECT_EQ(selected[i].get(), names[i]);
+}
+
+// a failing row rolls back rows of previous (multi-row) statements as well
+TEST_F(SqlTest, InsertManyIsAtomic)
+{
+	std::vector<std::tuple<sql::Int, sql::Text, sql::Real, sql::Null>> rows;
+	for (int i = 0; i < 100; ++i)
+		rows.emplace_back(sql::Int(100 + i), sql::Text("user" + std::to_string(i)), sql::Real(i), sql::Null{});
+	rows.emplace_back(sql::Int(1), sql::Text("Avi"), sql::Real(22), sql::Null{}); // duplicate key
+	EXPECT_THROW(db->insert_many<"Users">(rows), sql::SQLiteException);
+
+	sql::Int count;
+	db->select<"Users", sql::AggrSelectArg<sql::Count<"id">>>() >> count;
+	EXPECT_EQ(count.get(), 2);
+}
+
+// ---------------------------------------------------------------------------
+// Connection pool (WAL mode)
+// ---------------------------------------------------------------------------
+
+class SqlPoolTest : public testing::Test
+{
+protected:
+	using Schema = sql::schemas::DB<
+		sql::schemas::Table<"Users",
+			sql::schemas::PrimaryKey<"id"  , sql::Int >,
+			sql::schemas::Col       <"name", sql::Text>
+		>
+	>;
+
+	static constexpr auto PATH = "database_pool.sqlite";
+
+	void SetUp() override
+	{
+		remove_files();
+	}
+
+	void TearDown() override
+	{
+		remove_files();
+	}
+
+	static void remove_files()
+	{
+		for (const std::string suffix : { "", "-wal", "-shm" })
+			if (std::filesystem::exists(PATH + suffix))
+				std::remove((PATH + suffix).c_str());
+	}
+};
+
+TEST_F(SqlPoolTest, OpensInWalMode)
+{
+	sql::ConnectionPool<Schema> pool(PATH, 2);
+	EXPECT_EQ(pool.readers(), 2);
+	EXPECT_EQ(pool.write([](auto& db) { return db.get_pragma("journal_mode"); }), "wal");
+	EXPECT_EQ(pool.read([](auto& db) { return db.get_pragma("journal_mode"); }), "wal");
+	EXPECT_EQ(pool.read([](auto& db) { return db.get_pragma("synchronous"); }), "1"); // NORMAL
+}
+
+TEST_F(SqlPoolTest, ReadersSeeCommittedWrites)
+{
+	sql::ConnectionPool<Schema> pool(PATH, 2);
+	pool.write([](auto& db) { db.template insert<"Users">(sql::Int(1), sql::Text("Avi")); });
+
+	sql::Text name;
+	pool.read([&name](auto& db) { db.template select<"Users", sql::SelectArg<"name">>().where("id = 1") >> name; });
+	EXPECT_EQ(name.get(), "Avi");
+}
+
+// read-only connections reject writes
+TEST_F(SqlPoolTest, ReadersAreReadOnly)
+{
+	sql::ConnectionPool<Schema> pool(PATH, 1);
+	EXPECT_THROW(
+		pool.read([](auto& db) { db.template insert<"Users">(sql::Int(1), sql::Text("Avi")); }),
+		sql::SQLiteException
+	);
+	EXPECT_EQ(pool.stats().readers_in_use, 0); // returned even though read threw
+}
+
+// an in-memory database can't be shared, so reads go through the writer connection
+TEST_F(SqlPoolTest, InMemoryHasNoReaders)
+{
+	sql::ConnectionPool<Schema> pool(":memory:", 4);
+	EXPECT_EQ(pool.readers(), 0);
+	pool.write([](auto& db) { db.template insert<"Users">(sql::Int(1), sql::Text("Avi")); });
+
+	sql::Int count;
+	pool.read([&count](auto& db) { db.template select<"Users", sql::AggrSelectArg<sql::Count<"id">>>() >> count; });
+	EXPECT_EQ(count.get(), 1);
+}
+
+// reads hold distinct connections at once, so they run in parallel
+TEST_F(SqlPoolTest, ReadsRunInParallel)
+{
+	constexpr std::size_t READERS = 4;
+	sql::ConnectionPool<Schema> pool(PATH, READERS);
+	pool.write([](auto& db) { db.template insert<"Users">(sql::Int(1), sql::Text("Avi")); });
+
+	// each read waits (holding its connection) until all readers are in use
+	std::atomic<std::size_t> inside = 0;
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < READERS; ++i)
+		threads.emplace_back([&pool, &inside]()
+		{
+			pool.read([&inside](auto& db)
+			{
+				sql::Text name;
+				db.template select<"Users", sql::SelectArg<"name">>().where("id = 1") >> name;
+				EXPECT_EQ(name.get(), "Avi");
+				inside++;
+				while (inside < READERS)
+					std::this_thread::yield();
+			});
+		});
+	for (auto& thread : threads)
+		thread.join();
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.readers, READERS);
+	EXPECT_EQ(stats.readers_in_use, 0);
+	EXPECT_EQ(stats.reads, READERS);
+	EXPECT_EQ(stats.read_waits, 0);
+	EXPECT_EQ(stats.writes, 1);
+}
+
+// a read waits for a free connection when all are in use
+TEST_F(SqlPoolTest, ReadWaitsForFreeReader)
+{
+	sql::ConnectionPool<Schema> pool(PATH, 1);
+	std::atomic<bool> holding = false, release = false;
+	std::thread holder([&]()
+	{
+		pool.read([&](auto&)
+		{
+			holding = true;
+			while (!release)
+				std::this_thread::yield();
+		});
+	});
+	while (!holding)
+		std::this_thread::yield();
+
+	std::thread waiter([&pool]() { pool.read([](auto&) { }); });
+	while (pool.stats().read_waits < 1)
+		std::this_thread::yield();
+	release = true;
+	holder.join();
+	waiter.join();
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.reads, 2);
+	EXPECT_EQ(stats.read_waits, 1);
+	EXPECT_EQ(stats.readers_in_use, 0);
+}
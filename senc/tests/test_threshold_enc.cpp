@@ -87,3 +87,48 @@ INSTANTIATE_TEST_SUITE_P(VariousThresholds, ThresholdEncTest, testing::Values(
 	ThresholdEncTestParams{ Buffer{0x00, 0x11, 0x22}, 0, 0, 1, 1 }, // one shard given
 	ThresholdEncTestParams{ Buffer{0x00, 0x11, 0x22}, 0, 0, 2, 3 }  // more than one shard given
 ));
+
+TEST(ThresholdEncTest, LagrangeCoeffsCachedPerParticipantSet)
+{
+	using Shamir = senc::utils::ShamirHybridElGamal<ECGroup, AES1L, ECHKDF2L>;
+	using ShardID = typename Shamir::ShardID;
+	using Part = typename Shamir::Part;
+	HybridElGamal2L<ECGroup, AES1L, ECHKDF2L> schema;
+	const Buffer data{ 0x01, 0x23, 0x45 };
+
+	const auto [pubKey1, privKey1] = schema.keygen();
+	const auto [pubKey2, privKey2] = schema.keygen();
+	const std::vector<ShardID> shardsIDs1{ 3, 1, 2 };
+	const std::vector<ShardID> shardsIDs2{ 4, 5 };
+	const std::vector<ShardID> reorderedIDs1{ 2, 3, 1 }; // same set, different order
+	const auto shards1 = Shamir::make_shards(Shamir::sample_poly(privKey1, 2), shardsIDs1);
+	const auto shards2 = Shamir::make_shards(Shamir::sample_poly(privKey2, 1), shardsIDs2);
+
+	Shamir::clear_lagrange_cache();
+	for (int i = 0; i < 3; ++i)
+	{
+		const auto encrypted = schema.encrypt(data, pubKey1, pubKey2);
+		std::vector<Part> parts1, parts2;
+		for (const auto& shard : shards1)
+			parts1.push_back(Shamir::decrypt_get_2l<1>(encrypted, shard, 0 == i ? shardsIDs1 : reorderedIDs1));
+		for (const auto& shard : shards2)
+			parts2.push_back(Shamir::decrypt_get_2l<2>(encrypted, shard, shardsIDs2));
+		EXPECT_EQ(Shamir::decrypt_join_2l(encrypted, parts1, parts2), data);
+	}
+
+	// one miss per (layer, set, shard), all other lookups hit
+	const std::size_t shardsCount = shards1.size() + shards2.size();
+	const auto stats = Shamir::lagrange_cache_stats();
+	EXPECT_EQ(stats.misses, shardsCount);
+	EXPECT_EQ(stats.hits, 2 * shardsCount);
+
+	// same set on the other layer is a separate entry
+	const auto encrypted = schema.encrypt(data, pubKey1, pubKey2);
+	(void)Shamir::decrypt_get_2l<2>(encrypted, shards1[0], shardsIDs1);
+	EXPECT_EQ(Shamir::lagrange_cache_stats().misses, shardsCount + 1);
+
+	// invalid sets are not cached
+	EXPECT_THROW(Shamir::decrypt_get_2l<1>(encrypted, shards1[1], { 1, 1, 2 }), senc::utils::ShamirException);
+	EXPECT_THROW(Shamir::decrypt_get_2l<1>(encrypted, shards1[1], { 1, 1, 2 }), senc::utils::ShamirException);
+	EXPECT_EQ(Shamir::lagrange_cache_stats().misses, shardsCount + 3);
+}
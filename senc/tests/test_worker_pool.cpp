@@ -0,0 +1,176 @@
+/*********************************************************************
+ * \file   test_worker_pool.cpp
+ * \brief  Contains tests for server worker pool.
+ * 
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+#include "../server/workers/WorkerPool.hpp"
+
+using senc::server::workers::WorkerPoolFullException;
+using senc::server::workers::WorkerPool;
+
+TEST(WorkerPoolTest, ExecuteReturnsResult)
+{
+	WorkerPool pool(2);
+	EXPECT_EQ(pool.execute([]() { return 6 * 7; }), 42);
+	EXPECT_EQ(pool.stats().executed, 1);
+}
+
+TEST(WorkerPoolTest, ExecuteRunsOnWorkerThread)
+{
+	WorkerPool pool(1);
+	const auto caller = std::this_thread::get_id();
+	EXPECT_NE(pool.execute([]() { return std::this_thread::get_id(); }), caller);
+}
+
+TEST(WorkerPoolTest, ZeroThreadsRunsInline)
+{
+	WorkerPool pool(0);
+	const auto caller = std::this_thread::get_id();
+	EXPECT_EQ(pool.execute([]() { return std::this_thread::get_id(); }), caller);
+}
+
+TEST(WorkerPoolTest, ExecutePropagatesException)
+{
+	WorkerPool pool(2);
+	EXPECT_THROW(
+		pool.execute([]() -> int { throw std::runtime_error("boom"); }),
+		std::runtime_error
+	);
+
+	// pool should still be usable after a failed task
+	EXPECT_EQ(pool.execute([]() { return 1; }), 1);
+}
+
+TEST(WorkerPoolTest, SubmitDoesNotWait)
+{
+	WorkerPool pool(1);
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future().share();
+	std::promise<int> result;
+
+	// submit returns while task is still blocked, result arrives through callback
+	pool.submit(
+		[released]() { released.wait(); return 6 * 7; },
+		[&result](std::future<int> res) { result.set_value(res.get()); }
+	);
+	auto resultFuture = result.get_future();
+	EXPECT_EQ(resultFuture.wait_for(std::chrono::milliseconds(20)), std::future_status::timeout);
+
+	release.set_value();
+	EXPECT_EQ(resultFuture.get(), 42);
+	pool.wait_idle();
+	EXPECT_EQ(pool.stats().executed, 1);
+}
+
+TEST(WorkerPoolTest, SubmitPassesException)
+{
+	WorkerPool pool(2);
+	std::promise<bool> thrown;
+	pool.submit(
+		[]() -> int { throw std::runtime_error("boom"); },
+		[&thrown](std::future<int> res)
+		{
+			try { res.get(); thrown.set_value(false); }
+			catch (const std::runtime_error&) { thrown.set_value(true); }
+		}
+	);
+	EXPECT_TRUE(thrown.get_future().get());
+}
+
+TEST(WorkerPoolTest, WaitIdleWaitsForCallbacks)
+{
+	WorkerPool pool(2);
+	std::atomic<std::size_t> done = 0;
+	for (int i = 0; i < 8; ++i)
+		pool.submit(
+			[]() { std::this_thread::sleep_for(std::chrono::milliseconds(5)); },
+			[&done](std::future<void>) { ++done; }
+		);
+
+	pool.wait_idle();
+	EXPECT_EQ(done, 8);
+	EXPECT_EQ(pool.stats().queue_depth, 0);
+}
+
+TEST(WorkerPoolTest, BoundsConcurrency)
+{
+	constexpr std::size_t THREADS = 2;
+	constexpr std::size_t SUBMITTERS = 8;
+
+	WorkerPool pool(THREADS, 1);
+	std::atomic<std::size_t> running = 0, maxRunning = 0;
+
+	{
+		std::vector<std::jthread> submitters;
+		for (std::size_t i = 0; i < SUBMITTERS; ++i)
+			submitters.emplace_back([&]()
+			{
+				pool.execute([&]()
+				{
+					const std::size_t cur = ++running;
+					std::size_t prev = maxRunning;
+					while (cur > prev && !maxRunning.compare_exchange_weak(prev, cur)) { }
+					std::this_thread::sleep_for(std::chrono::milliseconds(10));
+					--running;
+				});
+			});
+	} // joins submitters
+
+	EXPECT_LE(maxRunning, THREADS);
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.executed, SUBMITTERS);
+	EXPECT_EQ(stats.queue_depth, 0);
+	EXPECT_LE(stats.max_queue_depth, 1);
+	EXPECT_GT(stats.total_wait.count(), 0);
+	EXPECT_GE(stats.total_wait, stats.max_wait);
+}
+
+TEST(WorkerPoolTest, RejectsWhenFull)
+{
+	WorkerPool pool(1, 1, WorkerPool::FullPolicy::Reject);
+	std::promise<void> release;
+	std::shared_future<void> released = release.get_future().share();
+	std::promise<void> started;
+
+	// occupy worker, then fill queue
+	std::jthread running([&]() { pool.execute([&]() { started.set_value(); released.wait(); }); });
+	started.get_future().wait();
+	std::jthread queued([&]() { pool.execute([&]() { released.wait(); }); });
+	while (pool.stats().queue_depth < 1)
+		std::this_thread::yield();
+
+	// queue is full, so next task is rejected at once (rather than blocking)
+	EXPECT_THROW(pool.execute([]() { }), WorkerPoolFullException);
+
+	release.set_value();
+	running.join();
+	queued.join();
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.rejected_submits, 1);
+	EXPECT_EQ(stats.blocked_submits, 0);
+	EXPECT_EQ(stats.executed, 2);
+}
+
+TEST(WorkerPoolTest, ResetStats)
+{
+	WorkerPool pool(1);
+	pool.execute([]() { });
+	pool.reset_stats();
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.executed, 0);
+	EXPECT_EQ(stats.max_queue_depth, 0);
+	EXPECT_EQ(stats.total_wait.count(), 0);
+}
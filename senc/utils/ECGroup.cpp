@@ -8,11 +8,48 @@
 
 #include "ECGroup.hpp"
 
+#include <algorithm>
 #include <sstream>
+#include <vector>
+#include <bit>
 #include "StrParseException.hpp"
 
 namespace senc::utils
 {
+	// field arithmetic helpers (values are kept reduced to [0, p))
+	namespace
+	{
+		inline BigInt fmul(const BigInt& a, const BigInt& b, const BigInt& p)
+		{
+			return a_times_b_mod_c(a, b, p);
+		}
+
+		inline BigInt fadd(const BigInt& a, const BigInt& b, const BigInt& p)
+		{
+			BigInt res = a + b;
+			if (res >= p)
+				res -= p;
+			return res;
+		}
+
+		inline BigInt fsub(const BigInt& a, const BigInt& b, const BigInt& p)
+		{
+			BigInt res = a - b;
+			if (res.IsNegative())
+				res += p;
+			return res;
+		}
+
+		// gets `width` bits of `exp` starting at bit `offset`
+		inline std::size_t exp_window(const BigInt& exp, unsigned int offset, unsigned int width)
+		{
+			std::size_t res = 0;
+			for (unsigned int i = width; i-- > 0; )
+				res = (res << 1) | static_cast<std::size_t>(exp.GetBit(offset + i));
+			return res;
+		}
+	}
+
 	GroupOrder ECGroup::order()
 	{
 		return ec_params().GetSubgroupOrder();
@@ -33,16 +70,55 @@ namespace senc::utils
 	ECGroup::ECGroup() : Self(true) { } // isIdentity = true
 
 	ECGroup::ECGroup(const BigInt& x, const BigInt& y)
-		: _point(x, y), _isIdentity(false) { }
+		: _x(x), _y(y), _z(BigInt::One()), _isIdentity(false) { }
 
 	ECGroup::ECGroup(BigInt&& x, BigInt&& y)
-		: _point(std::move(x), std::move(y)), _isIdentity(false) { }
+		: _x(std::move(x)), _y(std::move(y)), _z(BigInt::One()), _isIdentity(false) { }
 
 	ECGroup::Self ECGroup::from_scalar(const BigInt& scalar)
 	{
-		if (scalar.IsZero())
+		return generator_pow(scalar);
+	}
+
+	ECGroup::Self ECGroup::generator_pow(const BigInt& exp)
+	{
+		return generator_table().pow(exp);
+	}
+
+	ECGroup::Self ECGroup::multi_pow(std::span<const Self> bases, std::span<const BigInt> exps)
+	{
+		if (bases.size() != exps.size())
+			throw std::invalid_argument("Failed to compute multi-exponentiation: Bases and exponents count mismatch");
+
+		// drop trivial terms, make exponents positive and below order
+		std::vector<Self> points;
+		std::vector<BigInt> scalars;
+		unsigned int bits = 0;
+		for (std::size_t i = 0; i < bases.size(); ++i)
+		{
+			if (bases[i].is_identity() || exps[i].IsZero())
+				continue;
+			Self base = exps[i].IsNegative() ? bases[i].inverse() : bases[i];
+			BigInt exp = exps[i].AbsoluteValue();
+			if (exp >= order())
+				exp %= order();
+			if (exp.IsZero())
+				continue;
+			bits = std::max(bits, exp.BitCount());
+			points.push_back(std::move(base));
+			scalars.push_back(std::move(exp));
+		}
+
+		if (points.empty())
 			return identity();
-		return Self(ec_curve().Multiply(scalar, ec_base_point()));
+		if (1 == points.size())
+			return points.front().pow(scalars.front());
+
+		normalize_batch(points); // affine bases make additions cheaper
+
+		if (points.size() <= STRAUS_MAX_SIZE)
+			return multi_pow_straus(points, scalars, bits);
+		return multi_pow_pippenger(points, scalars, bits);
 	}
 
 	ECGroup::Self ECGroup::sample()
@@ -75,17 +151,21 @@ namespace senc::utils
 		if (is_identity())
 			return Buffer(1, 0); // size 1, value 0
 
+		const Self affine = normalized();
+		const BigInt& x = affine._x;
+		const BigInt& y = affine._y;
+
 		// buffer will contain x size then y size then x then y
-		Buffer res((2 * sizeof(bigint_size_t)) + x().MinEncodedSize() + y().MinEncodedSize());
+		Buffer res((2 * sizeof(bigint_size_t)) + x.MinEncodedSize() + y.MinEncodedSize());
 		bigint_size_t* pXSize = reinterpret_cast<bigint_size_t*>(res.data());
 		bigint_size_t* pYSize = pXSize + 1;
 		byte* pX = reinterpret_cast<byte*>(pYSize + 1);
-		byte* pY = pX + x().MinEncodedSize();
+		byte* pY = pX + x.MinEncodedSize();
 
-		*pXSize = x().MinEncodedSize();
-		*pYSize = y().MinEncodedSize();
-		x().Encode(pX, x().MinEncodedSize());
-		y().Encode(pY, y().MinEncodedSize());
+		*pXSize = x.MinEncodedSize();
+		*pYSize = y.MinEncodedSize();
+		x.Encode(pX, x.MinEncodedSize());
+		y.Encode(pY, y.MinEncodedSize());
 
 		return res;
 	}
@@ -125,9 +205,11 @@ namespace senc::utils
 			return res;
 		}
 
+		const Self affine = normalized();
+
 		// prefix: 0x02 if Y even, 0x03 if Y odd
-		res[0] = y().IsOdd() ? 0x03 : 0x02;
-		x().Encode(res.data() + 1, ENCODED_FIELD_SIZE); // zero-pads on the left automatically
+		res[0] = affine._y.IsOdd() ? 0x03 : 0x02;
+		affine._x.Encode(res.data() + 1, ENCODED_FIELD_SIZE); // zero-pads on the left automatically
 		return res;
 	}
 
@@ -166,7 +248,8 @@ namespace senc::utils
 	{
 		if (elem.is_identity())
 			return os << "ECGroup(IDENTITY)";
-		return os << "ECGroup(" << elem._point.x << "," << elem._point.y << ")";
+		const ECGroup affine = elem.normalized();
+		return os << "ECGroup(" << affine._x << "," << affine._y << ")";
 	}
 
 	bool ECGroup::is_identity() const
@@ -180,35 +263,102 @@ namespace senc::utils
 			return true;
 		if (this->is_identity() || other.is_identity())
 			return false;
-		return (this->_point.x == other._point.x && this->_point.y == other._point.y);
+		if (this->is_normalized() && other.is_normalized())
+			return (this->_x == other._x && this->_y == other._y);
+
+		// compare without inversions: X1*Z2^2 == X2*Z1^2 and Y1*Z2^3 == Y2*Z1^3
+		const BigInt& p = field_modulus();
+		const BigInt z1z1 = fmul(this->_z, this->_z, p);
+		const BigInt z2z2 = fmul(other._z, other._z, p);
+		if (fmul(this->_x, z2z2, p) != fmul(other._x, z1z1, p))
+			return false;
+		return fmul(this->_y, fmul(other._z, z2z2, p), p) == fmul(other._y, fmul(this->_z, z1z1, p), p);
 	}
 
-	const BigInt& ECGroup::x() const
+	BigInt ECGroup::x() const
 	{
-		return this->_point.x;
+		if (this->is_normalized())
+			return this->_x;
+		return normalized()._x;
 	}
 
-	const BigInt& ECGroup::y() const
+	BigInt ECGroup::y() const
 	{
-		return this->_point.y;
+		if (this->is_normalized())
+			return this->_y;
+		return normalized()._y;
+	}
+
+	std::pair<BigInt, BigInt> ECGroup::xy() const
+	{
+		if (this->is_normalized())
+			return { this->_x, this->_y };
+		const Self affine = normalized();
+		return { affine._x, affine._y };
+	}
+
+	bool ECGroup::is_normalized() const
+	{
+		return this->is_identity() || this->_z == BigInt::One();
+	}
+
+	void ECGroup::normalize()
+	{
+		if (this->is_normalized())
+			return;
+		const BigInt& p = field_modulus();
+		const BigInt zInv = this->_z.InverseMod(p);
+		const BigInt zInv2 = fmul(zInv, zInv, p);
+		this->_x = fmul(this->_x, zInv2, p);
+		this->_y = fmul(this->_y, fmul(zInv2, zInv, p), p);
+		this->_z = BigInt::One();
+	}
+
+	void ECGroup::normalize_batch(std::span<Self> elems)
+	{
+		const BigInt& p = field_modulus();
+
+		// prefix products of Z values of points which need normalization
+		std::vector<Self*> pending;
+		std::vector<BigInt> prefixes;
+		for (Self& elem : elems)
+		{
+			if (elem.is_normalized())
+				continue;
+			prefixes.push_back(pending.empty() ? elem._z : fmul(prefixes.back(), elem._z, p));
+			pending.push_back(&elem);
+		}
+		if (pending.empty())
+			return;
+
+		// single inversion of all Z values product, then peel off one Z at a time (backwards)
+		BigInt inv = prefixes.back().InverseMod(p);
+		for (std::size_t i = pending.size(); i-- > 0; )
+		{
+			Self& elem = *pending[i];
+			const BigInt zInv = (0 == i) ? inv : fmul(inv, prefixes[i - 1], p);
+			inv = fmul(inv, elem._z, p);
+
+			const BigInt zInv2 = fmul(zInv, zInv, p);
+			elem._x = fmul(elem._x, zInv2, p);
+			elem._y = fmul(elem._y, fmul(zInv2, zInv, p), p);
+			elem._z = BigInt::One();
+		}
 	}
 
 	ECGroup::Self ECGroup::inverse() const
 	{
 		if (this->is_identity())
 			return identity();
-		BigInt p = ec_curve().GetField().GetModulus();
-		BigInt negY = (p - this->_point.y) % p;
-		return Self(this->_point.x, negY);
+		Self res = *this;
+		res._y = fsub(BigInt::Zero(), this->_y, field_modulus());
+		return res;
 	}
 
 	ECGroup::Self ECGroup::operator*(const Self& other) const
 	{
-		if (this->is_identity())
-			return other;
-		if (other.is_identity())
-			return *this;
-		return Self(ec_curve().Add(this->_point, other._point));
+		Self res = *this;
+		return res *= other;
 	}
 
 	ECGroup::Self& ECGroup::operator*=(const Self& other)
@@ -217,7 +367,54 @@ namespace senc::utils
 			return *this;
 		if (this->is_identity())
 			return *this = other;
-		this->_point = ec_curve().Add(this->_point, other._point);
+
+		// Jacobian addition (Z = 1 of affine points lets multiplications by it be skipped)
+		const BigInt& p = field_modulus();
+		const bool isZ1One = (this->_z == BigInt::One());
+		const bool isZ2One = (other._z == BigInt::One());
+
+		BigInt u1 = this->_x, s1 = this->_y;
+		if (!isZ2One)
+		{
+			const BigInt z2z2 = fmul(other._z, other._z, p);
+			u1 = fmul(u1, z2z2, p);
+			s1 = fmul(s1, fmul(other._z, z2z2, p), p);
+		}
+
+		BigInt u2 = other._x, s2 = other._y;
+		if (!isZ1One)
+		{
+			const BigInt z1z1 = fmul(this->_z, this->_z, p);
+			u2 = fmul(u2, z1z1, p);
+			s2 = fmul(s2, fmul(this->_z, z1z1, p), p);
+		}
+
+		const BigInt h = fsub(u2, u1, p);
+		const BigInt r = fsub(s2, s1, p);
+		if (h.IsZero())
+		{
+			if (r.IsZero()) // same point
+				double_in_place();
+			else // opposite points
+				*this = identity();
+			return *this;
+		}
+
+		const BigInt hh = fmul(h, h, p);
+		const BigInt hhh = fmul(h, hh, p);
+		const BigInt v = fmul(u1, hh, p);
+
+		BigInt x3 = fsub(fsub(fmul(r, r, p), hhh, p), fadd(v, v, p), p);
+		BigInt y3 = fsub(fmul(r, fsub(v, x3, p), p), fmul(s1, hhh, p), p);
+		BigInt z3 = h;
+		if (!isZ1One)
+			z3 = fmul(z3, this->_z, p);
+		if (!isZ2One)
+			z3 = fmul(z3, other._z, p);
+
+		this->_x = std::move(x3);
+		this->_y = std::move(y3);
+		this->_z = std::move(z3);
 		return *this;
 	}
 
@@ -239,7 +436,53 @@ namespace senc::utils
 		if (exp.IsNegative())
 			return this->inverse().pow(-exp);
 
-		return Self(ec_curve().Multiply(exp, this->_point));
+		const Point point = to_point();
+		if (point == ec_base_point()) // identity was handled above
+			return generator_pow(exp);
+
+		return Self(ec_curve().Multiply(exp, point));
+	}
+
+	ECGroup::FixedBaseTable::FixedBaseTable(const Self& base)
+	{
+		if (base.is_identity())
+			return;
+
+		const unsigned int windows = (order().BitCount() + FIXED_BASE_WINDOW - 1) / FIXED_BASE_WINDOW;
+		this->_table.reserve(windows * FIXED_BASE_WINDOW_SIZE);
+		Self windowBase = base;
+		for (unsigned int i = 0; i < windows; ++i)
+		{
+			if (i > 0)
+				for (unsigned int k = 0; k < FIXED_BASE_WINDOW; ++k)
+					windowBase.double_in_place();
+			this->_table.push_back(windowBase);
+			for (std::size_t d = 1; d < FIXED_BASE_WINDOW_SIZE; ++d)
+				this->_table.push_back(this->_table.back() * windowBase);
+		}
+		normalize_batch(this->_table); // affine entries make additions cheaper
+	}
+
+	ECGroup::Self ECGroup::FixedBaseTable::pow(const BigInt& exp) const
+	{
+		if (this->_table.empty() || exp.IsZero())
+			return identity();
+
+		if (exp.IsNegative())
+			return pow(-exp).inverse();
+
+		// table covers exponents below order (every point's order divides it, as cofactor is one)
+		const BigInt reduced = (exp < order()) ? exp : (exp % order());
+
+		Self res = identity();
+		const std::size_t windows = this->_table.size() / FIXED_BASE_WINDOW_SIZE;
+		for (std::size_t i = 0; i < windows; ++i)
+		{
+			const std::size_t digit = exp_window(reduced, static_cast<unsigned int>(i) * FIXED_BASE_WINDOW, FIXED_BASE_WINDOW);
+			if (digit)
+				res *= this->_table[i * FIXED_BASE_WINDOW_SIZE + digit - 1];
+		}
+		return res;
 	}
 
 	Distribution<BigInt>& ECGroup::dist()
@@ -256,7 +499,8 @@ namespace senc::utils
 
 	const ECGroup::ECP& ECGroup::ec_curve()
 	{
-		static const ECP EC_CURVE = ec_params().GetCurve();
+		// curve arithmetic uses mutable workspace (even through const methods), so each thread has its own
+		thread_local const ECP EC_CURVE = ec_params().GetCurve();
 		return EC_CURVE;
 	}
 
@@ -266,7 +510,151 @@ namespace senc::utils
 		return EC_BASE_POINT;
 	}
 
+	const ECGroup::FixedBaseTable& ECGroup::generator_table()
+	{
+		// built once and only read afterwards, so all threads share it
+		// (additions go through each thread's own curve workspace)
+		static const FixedBaseTable GENERATOR_TABLE(generator());
+		return GENERATOR_TABLE;
+	}
+
+	ECGroup::Self ECGroup::multi_pow_straus(const std::vector<Self>& bases, const std::vector<BigInt>& exps,
+											unsigned int bits)
+	{
+		// tables of multiples 1..(2^w - 1) of each base, normalized together
+		constexpr std::size_t TABLE_SIZE = (std::size_t(1) << STRAUS_WINDOW) - 1;
+		std::vector<Self> tables(bases.size() * TABLE_SIZE);
+		for (std::size_t i = 0; i < bases.size(); ++i)
+		{
+			tables[i * TABLE_SIZE] = bases[i];
+			for (std::size_t j = 1; j < TABLE_SIZE; ++j)
+				tables[i * TABLE_SIZE + j] = tables[i * TABLE_SIZE + j - 1] * bases[i];
+		}
+		normalize_batch(tables);
+
+		// per window: shared doublings, then one table addition per base
+		Self res = identity();
+		for (unsigned int w = (bits + STRAUS_WINDOW - 1) / STRAUS_WINDOW; w-- > 0; )
+		{
+			if (!res.is_identity())
+				for (unsigned int k = 0; k < STRAUS_WINDOW; ++k)
+					res.double_in_place();
+			for (std::size_t i = 0; i < bases.size(); ++i)
+			{
+				const std::size_t digit = exp_window(exps[i], w * STRAUS_WINDOW, STRAUS_WINDOW);
+				if (digit)
+					res *= tables[i * TABLE_SIZE + digit - 1];
+			}
+		}
+		return res;
+	}
+
+	ECGroup::Self ECGroup::multi_pow_pippenger(const std::vector<Self>& bases, const std::vector<BigInt>& exps,
+											   unsigned int bits)
+	{
+		// window of about log2(n) - 2 bits balances bucket count against additions per window
+		const unsigned int width = std::clamp(static_cast<unsigned int>(std::bit_width(bases.size())) - 2, 4u, 12u);
+		std::vector<Self> buckets((std::size_t(1) << width) - 1);
+
+		Self res = identity();
+		for (unsigned int w = (bits + width - 1) / width; w-- > 0; )
+		{
+			if (!res.is_identity())
+				for (unsigned int k = 0; k < width; ++k)
+					res.double_in_place();
+
+			// put each base in the bucket of its digit
+			std::fill(buckets.begin(), buckets.end(), identity());
+			for (std::size_t i = 0; i < bases.size(); ++i)
+			{
+				const std::size_t digit = exp_window(exps[i], w * width, width);
+				if (digit)
+					buckets[digit - 1] *= bases[i];
+			}
+
+			// sum of digit * bucket[digit], using running sums from the top bucket down
+			Self running = identity();
+			Self windowSum = identity();
+			for (std::size_t d = buckets.size(); d-- > 0; )
+			{
+				running *= buckets[d];
+				windowSum *= running;
+			}
+			res *= windowSum;
+		}
+		return res;
+	}
+
+	const BigInt& ECGroup::field_modulus()
+	{
+		static const BigInt FIELD_MODULUS = ec_curve().GetField().GetModulus();
+		return FIELD_MODULUS;
+	}
+
+	const BigInt& ECGroup::curve_a()
+	{
+		static const BigInt CURVE_A = ec_curve().GetA();
+		return CURVE_A;
+	}
+
 	ECGroup::ECGroup(bool isIdentity) : _isIdentity(isIdentity) { }
 
-	ECGroup::ECGroup(const Point& point) : _point(point), _isIdentity(false) { }
+	ECGroup::ECGroup(const Point& point)
+		: _x(point.x), _y(point.y), _z(BigInt::One()), _isIdentity(point.identity) { }
+
+	ECGroup::Self ECGroup::normalized() const
+	{
+		Self res = *this;
+		res.normalize();
+		return res;
+	}
+
+	ECGroup::Point ECGroup::to_point() const
+	{
+		if (this->is_identity())
+			return Point();
+		if (this->is_normalized())
+			return Point(this->_x, this->_y);
+		const Self affine = normalized();
+		return Point(affine._x, affine._y);
+	}
+
+	void ECGroup::double_in_place()
+	{
+		const BigInt& p = field_modulus();
+		if (this->_y.IsZero()) // point of order 2
+		{
+			*this = identity();
+			return;
+		}
+
+		// S = 4*X*Y^2, M = 3*X^2 + a*Z^4
+		const BigInt yy = fmul(this->_y, this->_y, p);
+		const BigInt xyy = fmul(this->_x, yy, p);
+		const BigInt xyy2 = fadd(xyy, xyy, p);
+		const BigInt s = fadd(xyy2, xyy2, p);
+
+		const BigInt xx = fmul(this->_x, this->_x, p);
+		BigInt m = fadd(fadd(xx, xx, p), xx, p);
+		if (this->_z == BigInt::One())
+			m = fadd(m, curve_a(), p);
+		else
+		{
+			const BigInt zz = fmul(this->_z, this->_z, p);
+			m = fadd(m, fmul(curve_a(), fmul(zz, zz, p), p), p);
+		}
+
+		// X3 = M^2 - 2*S, Y3 = M*(S - X3) - 8*Y^4, Z3 = 2*Y*Z
+		BigInt x3 = fsub(fmul(m, m, p), fadd(s, s, p), p);
+		const BigInt yyyy = fmul(yy, yy, p);
+		const BigInt yyyy2 = fadd(yyyy, yyyy, p);
+		const BigInt yyyy4 = fadd(yyyy2, yyyy2, p);
+		BigInt y3 = fsub(fmul(m, fsub(s, x3, p), p), fadd(yyyy4, yyyy4, p), p);
+		const BigInt yz = fmul(this->_y, this->_z, p);
+		BigInt z3 = fadd(yz, yz, p);
+
+		this->_x = std::move(x3);
+		this->_y = std::move(y3);
+		this->_z = std::move(z3);
+	}
 }
@@ -15,7 +15,10 @@
 #include <cryptopp/osrng.h>
 #include <cryptopp/oids.h>
 #include <cryptopp/ecp.h>
+#include <utility>
 #include <ostream>
+#include <span>
+#include <vector>
 
 #include "Random.hpp"
 #include "Group.hpp"
@@ -28,6 +31,9 @@ namespace senc::utils
 	 * @class senc::utils::ECGroup
 	 * @brief Elliptic Curve based algebric group.
 	 * @note Satisfies `senc::utils::Group`.
+	 * @note Points are held in Jacobian coordinates (X, Y, Z), standing for affine (X/Z^2, Y/Z^3),
+	 *       so that group operations need no field inversion.
+	 *       Conversion to affine is lazy (only when coordinates are needed, e.g. `x()` or `encode()`).
 	 */
 	class ECGroup
 	{
@@ -103,6 +109,24 @@ namespace senc::utils
 		 */
 		static Self from_scalar(const BigInt& scalar);
 
+		/**
+		 * @brief Raises group generator to a given power, using a precomputed fixed-base table.
+		 * @note Equivalent to `generator().pow(exp)`, but considerably faster.
+		 * @param exp Exponent to raise generator to the power of.
+		 * @return Result of raising group generator to the power of `exp`.
+		 */
+		static Self generator_pow(const BigInt& exp);
+
+		/**
+		 * @brief Computes product of multiple exponentiations, sharing doublings between them.
+		 * @note Uses Straus interleaving for few bases, and Pippenger buckets for many.
+		 * @param bases Bases to raise.
+		 * @param exps Exponents to raise bases to the power of (matching `bases` by index).
+		 * @return Product of `bases[i].pow(exps[i])` over all `i`.
+		 * @throw std::invalid_argument If `bases` and `exps` differ in size.
+		 */
+		static Self multi_pow(std::span<const Self> bases, std::span<const BigInt> exps);
+
 		/**
 		 * @brief Samples a random group element.
 		 * @return Sampled element.
@@ -169,16 +193,44 @@ namespace senc::utils
 		bool operator==(const Self& other) const;
 
 		/**
-		 * @brief Gets point's X value.
+		 * @brief Gets point's (affine) X value.
+		 * @note Requires a field inversion if point is not normalized.
 		 * @return Point's X value.
 		 */
-		const BigInt& x() const;
+		BigInt x() const;
 
 		/**
-		 * @brief Gets point's Y value.
+		 * @brief Gets point's (affine) Y value.
+		 * @note Requires a field inversion if point is not normalized.
 		 * @return Point's Y value.
 		 */
-		const BigInt& y() const;
+		BigInt y() const;
+
+		/**
+		 * @brief Gets point's (affine) X and Y values together.
+		 * @note Requires a single field inversion if point is not normalized
+		 *       (rather than one per coordinate, as with `x()` and `y()`).
+		 * @return Pair of point's X and Y values.
+		 */
+		std::pair<BigInt, BigInt> xy() const;
+
+		/**
+		 * @brief Determines whether or not point is held in affine form (Z = 1).
+		 * @return `true` if point is normalized (or is the identity), otherwise `false`.
+		 */
+		bool is_normalized() const;
+
+		/**
+		 * @brief Converts point to affine form (Z = 1) in place, using a single field inversion.
+		 */
+		void normalize();
+
+		/**
+		 * @brief Converts multiple points to affine form in place, using a single field inversion.
+		 * @note Uses Montgomery's trick (inverts product of all Z values, then recovers each inverse).
+		 * @param elems Points to normalize.
+		 */
+		static void normalize_batch(std::span<Self> elems);
 
 		/**
 		 * @brief Gets inverse of group element (by group operation).
@@ -221,18 +273,57 @@ namespace senc::utils
 		 */
 		Self pow(const BigInt& exp) const;
 
+		/**
+		 * @class senc::utils::ECGroup::FixedBaseTable
+		 * @brief Windowed precomputation of multiples of a fixed point, for raising it to many powers.
+		 * @note Building a table costs about as much as a few `pow` calls; each exponentiation
+		 *       afterwards is one addition of a precomputed (affine) point per window, with no doublings.
+		 */
+		class FixedBaseTable
+		{
+		public:
+			/**
+			 * @brief Builds precomputation table of a given point.
+			 * @param base Point to precompute multiples of.
+			 */
+			explicit FixedBaseTable(const Self& base);
+
+			/**
+			 * @brief Raises base point to a given power, using precomputed table.
+			 * @note Equivalent to `base.pow(exp)`.
+			 * @param exp Exponent to raise base point to the power of.
+			 * @return Result of raising base point to the power of `exp`.
+			 */
+			Self pow(const BigInt& exp) const;
+
+		private:
+			// multiples 1..(2^w - 1) of `2^(i * w) * base` for each window i (empty if base is identity)
+			std::vector<Self> _table;
+		};
+
 	private:
 		using ECP = CryptoPP::ECP;
 		using Point = ECP::Point;
 
+		// multi-exponentiation parameters: max bases for Straus (Pippenger above it), and Straus window bits
+		static constexpr std::size_t STRAUS_MAX_SIZE = 32;
+		static constexpr unsigned int STRAUS_WINDOW = 4;
+
+		// fixed-base table parameters: window bits, and table entries per window
+		static constexpr unsigned int FIXED_BASE_WINDOW = 4;
+		static constexpr std::size_t FIXED_BASE_WINDOW_SIZE = (std::size_t(1) << FIXED_BASE_WINDOW) - 1;
+
 		// static constants
 		static Distribution<BigInt>& dist();                            // distribution for sampling
 		static const CryptoPP::DL_GroupParameters_EC<ECP>& ec_params(); // eliptic curve parameters
-		static const ECP& ec_curve();                                   // elliptic curve itself
+		static const ECP& ec_curve();                                   // elliptic curve itself (per thread)
 		static const Point& ec_base_point();                            // base point of curve
+		static const FixedBaseTable& generator_table();                 // fixed-base table of base point (shared)
 
-		// instance fields
-		Point _point;
+		// instance fields (Jacobian coordinates, meaningless if identity)
+		BigInt _x;
+		BigInt _y;
+		BigInt _z;
 		bool _isIdentity;
 
 		// private methods
@@ -244,10 +335,48 @@ namespace senc::utils
 		explicit ECGroup(bool isIdentity);
 
 		/**
-		 * @brief Constructs a non-identity element form a given point.
+		 * @brief Constructs an element form a given affine point.
 		 * @param point
 		 */
 		explicit ECGroup(const Point& point);
+
+		/**
+		 * @brief Gets normalized copy of this point.
+		 * @return Copy of `*this` in affine form.
+		 */
+		Self normalized() const;
+
+		/**
+		 * @brief Gets this point as an affine CryptoPP point.
+		 * @return Affine point.
+		 */
+		Point to_point() const;
+
+		/**
+		 * @brief Doubles this point (applies group operation with itself) in place.
+		 */
+		void double_in_place();
+
+		/**
+		 * @brief Computes multi-exponentiation using Straus interleaving (shared doublings, per-base tables).
+		 * @param bases Normalized non-identity bases.
+		 * @param exps Positive exponents below group order.
+		 * @param bits Bit count of largest exponent.
+		 * @return Product of `bases[i].pow(exps[i])` over all `i`.
+		 */
+		static Self multi_pow_straus(const std::vector<Self>& bases, const std::vector<BigInt>& exps, unsigned int bits);
+
+		/**
+		 * @brief Computes multi-exponentiation using Pippenger buckets (shared doublings and bucket sums).
+		 * @param bases Normalized non-identity bases.
+		 * @param exps Positive exponents below group order.
+		 * @param bits Bit count of largest exponent.
+		 * @return Product of `bases[i].pow(exps[i])` over all `i`.
+		 */
+		static Self multi_pow_pippenger(const std::vector<Self>& bases, const std::vector<BigInt>& exps, unsigned int bits);
+
+		static const BigInt& field_modulus(); // modulus of curve's field
+		static const BigInt& curve_a();       // "a" coefficient of curve equation
 	};
 
 	static_assert(Group<ECGroup>, "senc::utils::ECGroup should satisfy senc::utils::Group");
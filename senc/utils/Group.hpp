@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <stdexcept>
 #include <concepts>
+#include <span>
 
 #include "Random.hpp"
 #include "math.hpp"
@@ -59,4 +61,162 @@ namespace senc::utils
 	 */
 	template <typename Self>
 	concept SamplableGroup = Group<Self> && HasSampleMethod<Self>;
+
+	/**
+	 * @concept senc::utils::HasGeneratorPowMethod
+	 * @brief Looks for a typename with a dedicated generator-power-computing static method.
+	 * @tparam Self Examined typename.
+	 * @tparam Exponent Exponent type.
+	 */
+	template <typename Self, typename Exponent>
+	concept HasGeneratorPowMethod = requires
+	{
+		{ Self::generator_pow(std::declval<Exponent>()) } -> std::same_as<Self>;
+	};
+
+	/**
+	 * @brief Raises group generator to a given power.
+	 * @tparam G Group type.
+	 * @param exp Exponent to use for power raise.
+	 * @return Result of raising `G::generator()` to the power of `exp`.
+	 * If `G` satisfies `HasGeneratorPowMethod`, returns result of `G::generator_pow(exp)`.
+	 * Otherwise, returns result of `pow(G::generator(), exp)`.
+	 */
+	template <Group G, typename Exponent>
+	requires HasGeneratorPowMethod<G, Exponent> || PowerRaisable<G, Exponent>
+	inline G generator_pow(const Exponent& exp)
+	{
+		if constexpr (HasGeneratorPowMethod<G, Exponent>)
+			return G::generator_pow(exp);
+		else
+			return senc::utils::pow(G::generator(), exp);
+	}
+
+	/**
+	 * @concept senc::utils::HasFixedBaseTable
+	 * @brief Looks for a typename with a dedicated precomputation for repeated exponentiation of a fixed base.
+	 * @tparam Self Examined typename.
+	 * @tparam Exponent Exponent type.
+	 */
+	template <typename Self, typename Exponent>
+	concept HasFixedBaseTable = requires(const Self base, const Exponent exp)
+	{
+		typename Self::FixedBaseTable;
+		{ std::declval<const typename Self::FixedBaseTable&>().pow(exp) } -> std::same_as<Self>;
+		{ typename Self::FixedBaseTable(base) };
+	};
+
+	namespace sfinae
+	{
+		template <typename G, typename Exponent>
+		struct fixed_base_table { using type = G; }; // no precomputation, holds base itself
+
+		template <typename G, typename Exponent>
+		requires HasFixedBaseTable<G, Exponent>
+		struct fixed_base_table<G, Exponent> { using type = typename G::FixedBaseTable; };
+	}
+
+	/**
+	 * @class senc::utils::FixedBaseExp
+	 * @brief Exponentiation of a fixed group element, to be raised to many powers.
+	 * If `G` satisfies `HasFixedBaseTable`, uses `G::FixedBaseTable` (built once, on construction).
+	 * Otherwise, holds base and uses `pow`.
+	 * @tparam G Group type.
+	 * @tparam Exponent Exponent type.
+	 */
+	template <Group G, typename Exponent>
+	requires HasFixedBaseTable<G, Exponent> || PowerRaisable<G, Exponent>
+	class FixedBaseExp
+	{
+	public:
+		using Self = FixedBaseExp<G, Exponent>;
+
+		/**
+		 * @brief Constructs an exponentiation of a given base (building its precomputation, if any).
+		 * @param base Base to raise.
+		 */
+		explicit FixedBaseExp(const G& base) : _impl(base) { }
+
+		/**
+		 * @brief Raises base to a given power.
+		 * @param exp Exponent to raise base to the power of.
+		 * @return Result of raising base to the power of `exp`.
+		 */
+		G pow(const Exponent& exp) const
+		{
+			if constexpr (HasFixedBaseTable<G, Exponent>)
+				return _impl.pow(exp);
+			else
+				return senc::utils::pow(_impl, exp);
+		}
+
+	private:
+		typename sfinae::fixed_base_table<G, Exponent>::type _impl;
+	};
+
+	/**
+	 * @concept senc::utils::HasMultiPowMethod
+	 * @brief Looks for a typename with a static multi-exponentiation method.
+	 * @tparam Self Examined typename.
+	 * @tparam Exponent Exponent type.
+	 */
+	template <typename Self, typename Exponent>
+	concept HasMultiPowMethod = requires(std::span<const Self> bases, std::span<const Exponent> exps)
+	{
+		{ Self::multi_pow(bases, exps) } -> std::same_as<Self>;
+	};
+
+	/**
+	 * @brief Computes product of multiple exponentiations (`bases[i]` to the power of `exps[i]`).
+	 * @tparam G Group type.
+	 * @param bases Bases to raise.
+	 * @param exps Exponents to raise bases to the power of (matching `bases` by index).
+	 * @return Product of all exponentiations.
+	 * If `G` satisfies `HasMultiPowMethod`, returns result of `G::multi_pow(bases, exps)`.
+	 * Otherwise, multiplies results of separate `pow` calls.
+	 * @throw std::invalid_argument If `bases` and `exps` differ in size.
+	 */
+	template <Group G, typename Exponent>
+	requires HasMultiPowMethod<G, Exponent> || PowerRaisable<G, Exponent>
+	inline G multi_pow(std::span<const G> bases, std::span<const Exponent> exps)
+	{
+		if constexpr (HasMultiPowMethod<G, Exponent>)
+			return G::multi_pow(bases, exps);
+		else
+		{
+			if (bases.size() != exps.size())
+				throw std::invalid_argument("Failed to compute multi-exponentiation: Bases and exponents count mismatch");
+			G res = G::identity();
+			for (std::size_t i = 0; i < bases.size(); ++i)
+				res *= senc::utils::pow(bases[i], exps[i]);
+			return res;
+		}
+	}
+
+	/**
+	 * @concept senc::utils::HasNormalizeBatchMethod
+	 * @brief Looks for a typename with a static method normalizing the representation of multiple elements.
+	 * @tparam Self Examined typename.
+	 */
+	template <typename Self>
+	concept HasNormalizeBatchMethod = requires(std::span<Self> elems)
+	{
+		{ Self::normalize_batch(elems) };
+	};
+
+	/**
+	 * @brief Normalizes representation of multiple group elements at once (e.g. projective to affine).
+	 * @tparam G Group type.
+	 * @param elems Group elements to normalize.
+	 * If `G` satisfies `HasNormalizeBatchMethod`, calls `G::normalize_batch(elems)`.
+	 * Otherwise, does nothing.
+	 */
+	template <Group G>
+	inline void normalize_batch(std::span<G> elems)
+	{
+		if constexpr (HasNormalizeBatchMethod<G>)
+			G::normalize_batch(elems);
+		else
+			(void)elems;
+	}
 }
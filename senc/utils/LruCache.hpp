@@ -0,0 +1,121 @@
+/*********************************************************************
+ * \file   LruCache.hpp
+ * \brief  Header of LruCache class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <list>
+#include <map>
+
+#include "concepts.hpp"
+
+namespace senc::utils
+{
+	/**
+	 * @struct senc::utils::LruCacheStats
+	 * @brief Lookup statistics of an `LruCache`.
+	 */
+	struct LruCacheStats
+	{
+		std::uint64_t hits = 0;
+		std::uint64_t misses = 0;
+		std::uint64_t evictions = 0;
+	};
+
+	/**
+	 * @class senc::utils::LruCache
+	 * @brief Bounded thread-safe cache, evicting least recently used entries.
+	 * @note Values are held by shared pointers, so entries handed out stay valid after eviction.
+	 * @tparam K Key type (ordered).
+	 * @tparam V Value type.
+	 */
+	template <typename K, typename V>
+	class LruCache
+	{
+	public:
+		using Self = LruCache<K, V>;
+		using Value = std::shared_ptr<const V>;
+
+		/**
+		 * @brief Constructs an empty cache.
+		 * @param capacity Maximum amount of entries held (at least one).
+		 */
+		explicit LruCache(std::size_t capacity);
+
+		LruCache(const Self&) = delete;
+		Self& operator=(const Self&) = delete;
+
+		/**
+		 * @brief Gets cached value of a key, computing (and caching) it if missing.
+		 * @note `compute` is called without holding the cache lock, so concurrent misses on the
+		 *       same key may compute it more than once; the first stored value is kept.
+		 * @param key Key to look up.
+		 * @param compute Function computing value of `key`.
+		 * @return Value of `key`.
+		 */
+		template <Callable<V> F>
+		Value get_or_compute(const K& key, F&& compute);
+
+		/**
+		 * @brief Gets cached value of a key, if present.
+		 * @param key Key to look up.
+		 * @return Value of `key`, or `nullptr` if not cached.
+		 */
+		Value get(const K& key);
+
+		/**
+		 * @brief Removes all entries (statistics are kept).
+		 */
+		void clear();
+
+		/**
+		 * @brief Gets amount of cached entries.
+		 * @return Amount of cached entries.
+		 */
+		std::size_t size() const;
+
+		/**
+		 * @brief Gets maximum amount of cached entries.
+		 * @return Cache capacity.
+		 */
+		std::size_t capacity() const noexcept;
+
+		/**
+		 * @brief Gets lookup statistics.
+		 * @return Statistics since construction (or last `reset_stats`).
+		 */
+		LruCacheStats stats() const;
+
+		/**
+		 * @brief Resets lookup statistics.
+		 */
+		void reset_stats();
+
+	private:
+		// entries ordered by use (most recent first), and index of them by key
+		using Entry = std::pair<K, Value>;
+		using Entries = std::list<Entry>;
+
+		const std::size_t _capacity;
+		mutable std::mutex _mtx;
+		Entries _entries;
+		std::map<K, typename Entries::iterator> _index;
+		LruCacheStats _stats;
+
+		/**
+		 * @brief Looks up a key and marks it as most recently used (lock should be held).
+		 * @param key Key to look up.
+		 * @return Value of `key`, or `nullptr` if not cached.
+		 */
+		Value find_and_touch(const K& key);
+	};
+}
+
+#include "LruCache_impl.hpp"
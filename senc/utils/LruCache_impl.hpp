@@ -0,0 +1,106 @@
+/*********************************************************************
+ * \file   LruCache_impl.hpp
+ * \brief  Implementation of LruCache class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "LruCache.hpp"
+
+#include <algorithm>
+
+namespace senc::utils
+{
+	template <typename K, typename V>
+	inline LruCache<K, V>::LruCache(std::size_t capacity)
+		: _capacity(std::max<std::size_t>(capacity, 1)) { }
+
+	template <typename K, typename V>
+	template <Callable<V> F>
+	inline typename LruCache<K, V>::Value LruCache<K, V>::get_or_compute(const K& key, F&& compute)
+	{
+		{
+			const std::lock_guard<std::mutex> lock(_mtx);
+			if (Value res = find_and_touch(key))
+			{
+				_stats.hits++;
+				return res;
+			}
+			_stats.misses++;
+		}
+
+		Value computed = std::make_shared<const V>(compute());
+
+		const std::lock_guard<std::mutex> lock(_mtx);
+		if (Value res = find_and_touch(key))
+			return res; // computed concurrently
+
+		_entries.emplace_front(key, computed);
+		_index.emplace(key, _entries.begin());
+		if (_entries.size() > _capacity)
+		{
+			_index.erase(_entries.back().first);
+			_entries.pop_back();
+			_stats.evictions++;
+		}
+		return computed;
+	}
+
+	template <typename K, typename V>
+	inline typename LruCache<K, V>::Value LruCache<K, V>::get(const K& key)
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		Value res = find_and_touch(key);
+		if (res)
+			_stats.hits++;
+		else
+			_stats.misses++;
+		return res;
+	}
+
+	template <typename K, typename V>
+	inline void LruCache<K, V>::clear()
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		_index.clear();
+		_entries.clear();
+	}
+
+	template <typename K, typename V>
+	inline std::size_t LruCache<K, V>::size() const
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		return _entries.size();
+	}
+
+	template <typename K, typename V>
+	inline std::size_t LruCache<K, V>::capacity() const noexcept
+	{
+		return _capacity;
+	}
+
+	template <typename K, typename V>
+	inline LruCacheStats LruCache<K, V>::stats() const
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		return _stats;
+	}
+
+	template <typename K, typename V>
+	inline void LruCache<K, V>::reset_stats()
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		_stats = LruCacheStats{};
+	}
+
+	template <typename K, typename V>
+	inline typename LruCache<K, V>::Value LruCache<K, V>::find_and_touch(const K& key)
+	{
+		auto it = _index.find(key);
+		if (_index.end() == it)
+			return nullptr;
+		_entries.splice(_entries.begin(), _entries, it->second); // iterators stay valid
+		return it->second->second;
+	}
+}
@@ -148,9 +148,10 @@ namespace senc::utils
 	{
 	public:
 		using Self = ModInt<ModTraits>;
+		using Traits = ModTraits;
 		using Int = typename ModTraits::Underlying;
 		static constexpr bool IS_PRIME_MOD = ModTraits::is_known_prime();
-		static constexpr auto modulus() { return ModTraits::modulus(); }
+		static constexpr decltype(auto) modulus() { return ModTraits::modulus(); } // no copy if traits return a reference
 
 		/**
 		 * @brief Constructs a modular integer with zero value.
@@ -0,0 +1,307 @@
+/*********************************************************************
+ * \file   MontModInt.hpp
+ * \brief  Contains declaration of Montgomery-form modular int class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+// this include is needed because CryptoPP uses WinAPI
+#include "../utils/winapi_patch.hpp"
+#include <cryptopp/modarith.h>
+
+#include <type_traits>
+#include <cstdint>
+#include <ostream>
+#include "ModInt.hpp"
+#include "math.hpp"
+
+namespace senc::utils
+{
+	/**
+	 * @concept senc::utils::ConstexprModTraitsType
+	 * @brief Looks for a `ModTraitsType` of an integral type, with a compile-time constant modulus.
+	 * @tparam Self Examined typename.
+	 */
+	template <typename Self>
+	concept ConstexprModTraitsType = ModTraitsType<Self> && std::integral<typename Self::Underlying> &&
+		requires { typename std::integral_constant<typename Self::Underlying, Self::modulus()>; };
+
+	/**
+	 * @concept senc::utils::MontModTraitsType
+	 * @brief Looks for a `ModTraitsType` usable for `MontModInt`. Either:
+	 *        - Compile-time constant odd modulus, greater than one and below 2^31; or
+	 *        - `BigInt` modulus (required to be odd at runtime).
+	 * @tparam Self Examined typename.
+	 */
+	template <typename Self>
+	concept MontModTraitsType = ModTraitsType<Self> && (
+		(ConstexprModTraitsType<Self> &&
+			Self::modulus() > 1 && Self::modulus() % 2 == 1 &&
+			static_cast<std::uint64_t>(Self::modulus()) < (std::uint64_t(1) << 31)) ||
+		std::same_as<typename Self::Underlying, BigInt>
+	);
+
+	/**
+	 * @class senc::utils::MontgomeryContext
+	 * @brief Montgomery arithmetic for values under the modulus of given traits.
+	 *        All values passed and returned are in Montgomery form, except for `to_mont` input
+	 *        and `from_mont` output.
+	 * @tparam ModTraits Modulo traits (must satisfy `MontModTraitsType`).
+	 */
+	template <MontModTraitsType ModTraits>
+	class MontgomeryContext;
+
+	/**
+	 * @brief Montgomery context for compile-time constant moduli (`R = 2^32`, constants computed at compile time).
+	 */
+	template <MontModTraitsType ModTraits>
+	requires ConstexprModTraitsType<ModTraits>
+	class MontgomeryContext<ModTraits>
+	{
+	public:
+		using Int = typename ModTraits::Underlying;
+		using Rep = std::uint32_t;
+
+		static constexpr Rep zero() noexcept { return 0; }
+		static constexpr Rep one() noexcept { return R_MOD_N; }
+		static constexpr Rep to_mont(const Int& value) noexcept;
+		static constexpr Int from_mont(Rep value) noexcept;
+		static constexpr Rep add(Rep a, Rep b) noexcept;
+		static constexpr Rep sub(Rep a, Rep b) noexcept;
+		static constexpr Rep neg(Rep a) noexcept;
+		static constexpr Rep mul(Rep a, Rep b) noexcept;
+
+	private:
+		static constexpr std::uint64_t N = static_cast<std::uint64_t>(ModTraits::modulus());
+		static constexpr Rep R_MOD_N = static_cast<Rep>((std::uint64_t(1) << 32) % N);
+		static constexpr Rep R2_MOD_N = static_cast<Rep>((std::uint64_t(R_MOD_N) * R_MOD_N) % N);
+
+		// -N^(-1) mod 2^32, by Newton iteration (N is its own inverse mod 8, and each step doubles correct bits)
+		static constexpr Rep N_NEG_INV = []()
+		{
+			Rep inv = static_cast<Rep>(N);
+			for (int i = 0; i < 4; ++i)
+				inv *= 2 - static_cast<Rep>(N) * inv;
+			return static_cast<Rep>(0 - inv);
+		}();
+
+		/**
+		 * @brief Montgomery reduction: computes `t * R^(-1) mod N` (for `t < N * R`).
+		 */
+		static constexpr Rep redc(std::uint64_t t) noexcept;
+	};
+
+	/**
+	 * @brief Montgomery context for `BigInt` moduli (per-thread cached `CryptoPP::MontgomeryRepresentation`).
+	 */
+	template <MontModTraitsType ModTraits>
+	requires std::same_as<typename ModTraits::Underlying, BigInt>
+	class MontgomeryContext<ModTraits>
+	{
+	public:
+		using Int = BigInt;
+		using Rep = BigInt;
+
+		static Rep zero();
+		static Rep one();
+		static Rep to_mont(const Int& value);
+		static Int from_mont(const Rep& value);
+		static Rep add(const Rep& a, const Rep& b);
+		static Rep sub(const Rep& a, const Rep& b);
+		static Rep neg(const Rep& a);
+		static Rep mul(const Rep& a, const Rep& b);
+
+		/**
+		 * @brief Gets modular inverse of (non-zero) value under a prime modulus.
+		 */
+		static Rep prime_inverse(const Rep& a);
+
+	private:
+		/**
+		 * @brief Gets Montgomery representation of modulus (for the calling thread).
+		 * @note Representation methods return references to an internal buffer, so results are
+		 *       copied out immediately and each thread holds its own representation.
+		 * @throw ModException If modulus is even.
+		 */
+		static const CryptoPP::MontgomeryRepresentation& mont();
+	};
+
+	/**
+	 * @class senc::utils::MontModInt
+	 * @brief Modular integer type, holding value in Montgomery form.
+	 * @note Multiplications use Montgomery reduction instead of division; conversions to and
+	 *       from the plain value cost a multiplication each, so this is worthwhile for chains of
+	 *       arithmetic (polynomial evaluation, Lagrange coefficients) rather than single operations.
+	 * @tparam ModTraits Modulo traits (must satisfy `MontModTraitsType`).
+	 */
+	template <MontModTraitsType ModTraits>
+	class MontModInt
+	{
+	public:
+		using Self = MontModInt<ModTraits>;
+		using Traits = ModTraits;
+		using Int = typename ModTraits::Underlying;
+		using Context = MontgomeryContext<ModTraits>;
+		using Rep = typename Context::Rep;
+		static constexpr bool IS_PRIME_MOD = ModTraits::is_known_prime();
+		static constexpr decltype(auto) modulus() { return ModTraits::modulus(); }
+
+		/**
+		 * @brief Constructs a modular integer with zero value.
+		 */
+		MontModInt();
+
+		/**
+		 * @brief Constructs a modular integer with a given value.
+		 */
+		MontModInt(const Int& value);
+
+		/**
+		 * @brief Constructs a modular integer from a plain-form one with same traits.
+		 */
+		explicit MontModInt(const ModInt<ModTraits>& value);
+
+		/**
+		 * @brief Samples a random modular integer.
+		 * @return Sampled modular integer.
+		 */
+		static Self sample() requires DistVal<Int>;
+
+		/**
+		 * @brief Gets (plain) value of modular integer.
+		 * @return Value, in range [`0`, `modulus()`).
+		 */
+		Int value() const;
+
+		/**
+		 * @brief Casting of modular integer into its underlying type.
+		 */
+		explicit operator Int() const;
+
+		/**
+		 * @brief Casting of modular integer into a plain-form one with same traits.
+		 */
+		explicit operator ModInt<ModTraits>() const;
+
+		/**
+		 * @brief Hashes modint value (same hash as a plain-form `ModInt` of same value).
+		 * @return Result hash.
+		 */
+		std::size_t hash() const;
+
+		/**
+		 * @brief Checks if the modular integer is equal to another.
+		 * @param other Other modular integer to compare to.
+		 * @return `true` if `*this` has same value as `other`, otherwise `false`.
+		 */
+		bool operator==(const Self& other) const;
+
+		/**
+		 * @brief Negates modular integer (under modulus).
+		 * @return Negative of `*this` under modulus.
+		 */
+		Self operator-() const;
+
+		/**
+		 * @brief Gets inverse of modular integer.
+		 * @return Modular inverse.
+		 * @throw ModException If failed to find inverse (only if modulus is not known to be prime).
+		 */
+		Self inverse() const;
+
+		/**
+		 * @brief Adds another modular integer with this one.
+		 * @param other Other modular integer to add with this one.
+		 * @return Addition result.
+		 */
+		Self operator+(const Self& other) const;
+
+		/**
+		 * @brief Adds another modular integer to this one.
+		 * @param other Other modular integer to add to this one.
+		 * @return `*this`, after addition.
+		 */
+		Self& operator+=(const Self& other);
+
+		/**
+		 * @brief Subtract the modular integer by another.
+		 * @param other Other modular integer to subtract this one with.
+		 * @return Subtraction result.
+		 */
+		Self operator-(const Self& other) const;
+
+		/**
+		 * @brief Subtracts the modular integer by another.
+		 * @param other Other modular integer to subtract this one by.
+		 * @return `*this`, after subtraction.
+		 */
+		Self& operator-=(const Self& other);
+
+		/**
+		 * @brief Multiplies another modular integer with this one.
+		 * @param other Other modular integer to multiply with this one.
+		 * @return Multiplication result.
+		 */
+		Self operator*(const Self& other) const;
+
+		/**
+		 * @brief Multiplies the modular integer with another.
+		 * @param other Other modular integer to multiply this one by.
+		 * @return `*this`, after multiplication.
+		 */
+		Self& operator*=(const Self& other);
+
+		/**
+		 * @brief Divides the modular integer by another.
+		 * @param other Other modular integer to divide this one with.
+		 * @return Division result.
+		 * @throw ModException If failed to divide (only if modulus is not known to be prime).
+		 */
+		Self operator/(const Self& other) const;
+
+		/**
+		 * @brief Divides the modular integer by another.
+		 * @param other Other modular integer to divide this one by.
+		 * @return `*this`, after division.
+		 * @throw ModException If failed to divide (only if modulus is not known to be prime).
+		 */
+		Self& operator/=(const Self& other);
+
+		/**
+		 * @brief Raises modular integer to given power.
+		 * @param exp Non-negative exponent to raise `*this` to.
+		 * @return Raised modular inetger.
+		 */
+		template <typename Exp>
+		Self pow(Exp exp) const SENC_REQ(
+			(Copyable, Exp),
+			(LowerComparable, Exp),
+			(SelfDevisible, Exp)
+		);
+
+		/**
+		 * @brief Gets string representation of modint value (numeric representative as string).
+		 * @return String representation.
+		 */
+		std::string to_string() const;
+
+	private:
+		static inline Distribution<Int> _dist = Random<Int>::get_dist_below(modulus());
+
+		Rep _rep; // value in Montgomery form
+
+		/**
+		 * @brief Constructs a modular integer from a Montgomery form value.
+		 */
+		static Self from_rep(Rep rep);
+	};
+
+	template <MontModTraitsType ModTraits>
+	std::ostream& operator<<(std::ostream& os, const MontModInt<ModTraits>& modint)
+	requires Outputable<typename MontModInt<ModTraits>::Int>;
+}
+
+#include "MontModInt_impl.hpp"
@@ -0,0 +1,314 @@
+/*********************************************************************
+ * \file   MontModInt_impl.hpp
+ * \brief  Contains implementation of Montgomery-form modular int class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "MontModInt.hpp"
+
+#include <sstream>
+
+namespace senc::utils
+{
+	template <MontModTraitsType ModTraits>
+	requires ConstexprModTraitsType<ModTraits>
+	inline constexpr typename MontgomeryContext<ModTraits>::Rep
+		MontgomeryContext<ModTraits>::to_mont(const Int& value) noexcept
+	{
+		Int reduced = value % static_cast<Int>(N);
+		if constexpr (std::is_signed_v<Int>)
+			if (reduced < 0)
+				reduced += static_cast<Int>(N);
+		return mul(static_cast<Rep>(reduced), R2_MOD_N);
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires ConstexprModTraitsType<ModTraits>
+	inline constexpr typename MontgomeryContext<ModTraits>::Int
+		MontgomeryContext<ModTraits>::from_mont(Rep value) noexcept
+	{
+		return static_cast<Int>(redc(value));
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires ConstexprModTraitsType<ModTraits>
+	inline constexpr typename MontgomeryContext<ModTraits>::Rep
+		MontgomeryContext<ModTraits>::add(Rep a, Rep b) noexcept
+	{
+		const Rep res = a + b; // no overflow, as N < 2^31
+		return (res >= N) ? static_cast<Rep>(res - N) : res;
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires ConstexprModTraitsType<ModTraits>
+	inline constexpr typename MontgomeryContext<ModTraits>::Rep
+		MontgomeryContext<ModTraits>::sub(Rep a, Rep b) noexcept
+	{
+		return (a >= b) ? (a - b) : static_cast<Rep>(a + N - b);
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires ConstexprModTraitsType<ModTraits>
+	inline constexpr typename MontgomeryContext<ModTraits>::Rep
+		MontgomeryContext<ModTraits>::neg(Rep a) noexcept
+	{
+		return sub(0, a);
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires ConstexprModTraitsType<ModTraits>
+	inline constexpr typename MontgomeryContext<ModTraits>::Rep
+		MontgomeryContext<ModTraits>::mul(Rep a, Rep b) noexcept
+	{
+		return redc(static_cast<std::uint64_t>(a) * b);
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires ConstexprModTraitsType<ModTraits>
+	inline constexpr typename MontgomeryContext<ModTraits>::Rep
+		MontgomeryContext<ModTraits>::redc(std::uint64_t t) noexcept
+	{
+		// m = t * (-N^(-1)) mod R, so t + m * N is divisible by R (and below 2^64, as N < 2^31)
+		const Rep m = static_cast<Rep>(t) * N_NEG_INV;
+		const std::uint64_t res = (t + static_cast<std::uint64_t>(m) * N) >> 32;
+		return static_cast<Rep>((res >= N) ? (res - N) : res);
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires std::same_as<typename ModTraits::Underlying, BigInt>
+	inline BigInt MontgomeryContext<ModTraits>::zero()
+	{
+		return BigInt::Zero();
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires std::same_as<typename ModTraits::Underlying, BigInt>
+	inline BigInt MontgomeryContext<ModTraits>::one()
+	{
+		return mont().MultiplicativeIdentity();
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires std::same_as<typename ModTraits::Underlying, BigInt>
+	inline BigInt MontgomeryContext<ModTraits>::to_mont(const Int& value)
+	{
+		return mont().ConvertIn(value % ModTraits::modulus());
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires std::same_as<typename ModTraits::Underlying, BigInt>
+	inline BigInt MontgomeryContext<ModTraits>::from_mont(const Rep& value)
+	{
+		return mont().ConvertOut(value);
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires std::same_as<typename ModTraits::Underlying, BigInt>
+	inline BigInt MontgomeryContext<ModTraits>::add(const Rep& a, const Rep& b)
+	{
+		return mont().Add(a, b);
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires std::same_as<typename ModTraits::Underlying, BigInt>
+	inline BigInt MontgomeryContext<ModTraits>::sub(const Rep& a, const Rep& b)
+	{
+		return mont().Subtract(a, b);
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires std::same_as<typename ModTraits::Underlying, BigInt>
+	inline BigInt MontgomeryContext<ModTraits>::neg(const Rep& a)
+	{
+		return mont().Inverse(a); // additive inverse
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires std::same_as<typename ModTraits::Underlying, BigInt>
+	inline BigInt MontgomeryContext<ModTraits>::mul(const Rep& a, const Rep& b)
+	{
+		return mont().Multiply(a, b);
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires std::same_as<typename ModTraits::Underlying, BigInt>
+	inline BigInt MontgomeryContext<ModTraits>::prime_inverse(const Rep& a)
+	{
+		return mont().MultiplicativeInverse(a);
+	}
+
+	template <MontModTraitsType ModTraits>
+	requires std::same_as<typename ModTraits::Underlying, BigInt>
+	inline const CryptoPP::MontgomeryRepresentation& MontgomeryContext<ModTraits>::mont()
+	{
+		thread_local const CryptoPP::MontgomeryRepresentation res = []()
+		{
+			if (ModTraits::modulus().IsEven())
+				throw ModException("Montgomery form requires an odd modulus");
+			return CryptoPP::MontgomeryRepresentation(ModTraits::modulus());
+		}();
+		return res;
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::MontModInt() : _rep(Context::zero()) { }
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::MontModInt(const Int& value) : _rep(Context::to_mont(value)) { }
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::MontModInt(const ModInt<ModTraits>& value)
+		: Self(static_cast<const Int&>(value)) { }
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::Self MontModInt<ModTraits>::sample() requires DistVal<Int>
+	{
+		return Self(_dist());
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline typename MontModInt<ModTraits>::Int MontModInt<ModTraits>::value() const
+	{
+		return Context::from_mont(_rep);
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::operator Int() const
+	{
+		return value();
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::operator ModInt<ModTraits>() const
+	{
+		return ModInt<ModTraits>(value());
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline std::size_t MontModInt<ModTraits>::hash() const
+	{
+		return Hash<Int>()(value());
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline bool MontModInt<ModTraits>::operator==(const Self& other) const
+	{
+		return (this->_rep == other._rep); // Montgomery form is one-to-one
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::Self MontModInt<ModTraits>::operator-() const
+	{
+		return from_rep(Context::neg(this->_rep));
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::Self MontModInt<ModTraits>::inverse() const
+	{
+		if constexpr (!IS_PRIME_MOD)
+			return Self(modular_inverse(value(), static_cast<Int>(modulus())));
+		else if (this->_rep == Context::zero())
+			return *this; // same as `ModInt` (Fermat's formula gives zero)
+		else if constexpr (requires (const Rep& rep) { Context::prime_inverse(rep); })
+			return from_rep(Context::prime_inverse(this->_rep));
+		else
+			return pow(modulus() - 2); // Fermat's formula
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::Self MontModInt<ModTraits>::operator+(const Self& other) const
+	{
+		return from_rep(Context::add(this->_rep, other._rep));
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::Self& MontModInt<ModTraits>::operator+=(const Self& other)
+	{
+		this->_rep = Context::add(this->_rep, other._rep);
+		return *this;
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::Self MontModInt<ModTraits>::operator-(const Self& other) const
+	{
+		return from_rep(Context::sub(this->_rep, other._rep));
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::Self& MontModInt<ModTraits>::operator-=(const Self& other)
+	{
+		this->_rep = Context::sub(this->_rep, other._rep);
+		return *this;
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::Self MontModInt<ModTraits>::operator*(const Self& other) const
+	{
+		return from_rep(Context::mul(this->_rep, other._rep));
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::Self& MontModInt<ModTraits>::operator*=(const Self& other)
+	{
+		this->_rep = Context::mul(this->_rep, other._rep);
+		return *this;
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::Self MontModInt<ModTraits>::operator/(const Self& other) const
+	{
+		return *this * other.inverse();
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::Self& MontModInt<ModTraits>::operator/=(const Self& other)
+	{
+		return *this *= other.inverse();
+	}
+
+	template <MontModTraitsType ModTraits>
+	template <typename Exp>
+	inline MontModInt<ModTraits>::Self MontModInt<ModTraits>::pow(Exp exp) const SENC_REQ(
+		(Copyable, Exp),
+		(LowerComparable, Exp),
+		(SelfDevisible, Exp)
+	)
+	{
+		// fast exponent algorithm, same as `mod_pow` but multiplying in Montgomery form
+		Rep res = Context::one();
+		Rep base = this->_rep;
+		while (0 < exp)
+		{
+			if ((exp % 2) != 0)
+				res = Context::mul(res, base);
+			base = Context::mul(base, base);
+			exp /= 2;
+		}
+		return from_rep(std::move(res));
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline std::string MontModInt<ModTraits>::to_string() const
+	{
+		std::stringstream s;
+		s << *this;
+		return s.str();
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline MontModInt<ModTraits>::Self MontModInt<ModTraits>::from_rep(Rep rep)
+	{
+		Self res;
+		res._rep = std::move(rep);
+		return res;
+	}
+
+	template <MontModTraitsType ModTraits>
+	inline std::ostream& operator<<(std::ostream& os, const MontModInt<ModTraits>& modint)
+	requires Outputable<typename MontModInt<ModTraits>::Int>
+	{
+		return os << modint.value();
+	}
+}
@@ -0,0 +1,630 @@
+/*********************************************************************
+ * \file   P256Group.cpp
+ * \brief  Implementation of P256Group class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "P256Group.hpp"
+
+#include <stdexcept>
+#include <sstream>
+#include <memory>
+#include "StrParseException.hpp"
+
+#if defined(_MSC_VER) && !defined(__SIZEOF_INT128__)
+#include <intrin.h>
+#endif
+
+namespace senc::utils
+{
+	// fixed-width field arithmetic (values are 4 limbs, least significant first, kept reduced to [0, p))
+	namespace
+	{
+		using Limbs = std::array<std::uint64_t, 4>;
+
+		// field modulus: p = 2^256 - 2^224 + 2^192 + 2^96 - 1
+		constexpr Limbs P = { 0xFFFFFFFFFFFFFFFF, 0x00000000FFFFFFFF, 0x0000000000000000, 0xFFFFFFFF00000001 };
+
+		// group order
+		constexpr Limbs N = { 0xF3B9CAC2FC632551, 0xBCE6FAADA7179E84, 0xFFFFFFFFFFFFFFFF, 0xFFFFFFFF00000000 };
+
+		// Montgomery constants (R = 2^256): R^2 mod p, and R mod p (one in Montgomery form)
+		constexpr Limbs R2 = { 0x0000000000000003, 0xFFFFFFFBFFFFFFFF, 0xFFFFFFFFFFFFFFFE, 0x00000004FFFFFFFD };
+		constexpr Limbs ONE = { 0x0000000000000001, 0xFFFFFFFF00000000, 0xFFFFFFFFFFFFFFFF, 0x00000000FFFFFFFE };
+
+		// curve coefficient b and base point coordinates, in Montgomery form (a = -3 is built into formulas)
+		constexpr Limbs B = { 0xD89CDF6229C4BDDF, 0xACF005CD78843090, 0xE5A220ABF7212ED6, 0xDC30061D04874834 };
+		constexpr Limbs GX = { 0x79E730D418A9143C, 0x75BA95FC5FEDB601, 0x79FB732B77622510, 0x18905F76A53755C6 };
+		constexpr Limbs GY = { 0xDDF25357CE95560A, 0x8B4AB8E4BA19E45C, 0xD2E88688DD21F325, 0x8571FF1825885D85 };
+
+		// exponents for inversion (p - 2) and square root ((p + 1) / 4)
+		constexpr Limbs INV_EXP = { 0xFFFFFFFFFFFFFFFD, 0x00000000FFFFFFFF, 0x0000000000000000, 0xFFFFFFFF00000001 };
+		constexpr Limbs SQRT_EXP = { 0x0000000000000000, 0x0000000040000000, 0x4000000000000000, 0x3FFFFFFFC0000000 };
+
+		constexpr Limbs ZERO = { 0, 0, 0, 0 };
+
+#if defined(__SIZEOF_INT128__)
+		__extension__ using u128 = unsigned __int128;
+#endif
+
+		inline std::uint64_t add_carry(std::uint64_t a, std::uint64_t b, std::uint64_t& carry)
+		{
+#if defined(__SIZEOF_INT128__)
+			const u128 r = static_cast<u128>(a) + b + carry;
+			carry = static_cast<std::uint64_t>(r >> 64);
+			return static_cast<std::uint64_t>(r);
+#else
+			const std::uint64_t s = a + carry;
+			std::uint64_t c = (s < carry);
+			const std::uint64_t r = s + b;
+			c |= (r < b);
+			carry = c;
+			return r;
+#endif
+		}
+
+		inline std::uint64_t sub_borrow(std::uint64_t a, std::uint64_t b, std::uint64_t& borrow)
+		{
+#if defined(__SIZEOF_INT128__)
+			const u128 r = static_cast<u128>(a) - b - borrow;
+			borrow = static_cast<std::uint64_t>(r >> 64) & 1;
+			return static_cast<std::uint64_t>(r);
+#else
+			const std::uint64_t d = a - b;
+			std::uint64_t br = (a < b);
+			const std::uint64_t r = d - borrow;
+			br |= (d < borrow);
+			borrow = br;
+			return r;
+#endif
+		}
+
+		// computes a * b + c + d (never overflows 128 bits), returning low word and storing high word
+		inline std::uint64_t mul_add(std::uint64_t a, std::uint64_t b, std::uint64_t c, std::uint64_t d,
+									 std::uint64_t& hi)
+		{
+#if defined(__SIZEOF_INT128__)
+			const u128 r = static_cast<u128>(a) * b + c + d;
+			hi = static_cast<std::uint64_t>(r >> 64);
+			return static_cast<std::uint64_t>(r);
+#else
+			std::uint64_t h = 0;
+			std::uint64_t lo = _umul128(a, b, &h);
+			lo += c;
+			h += (lo < c);
+			lo += d;
+			h += (lo < d);
+			hi = h;
+			return lo;
+#endif
+		}
+
+		// mask of all ones if `a == b`, zero otherwise (without branching)
+		inline std::uint64_t eq_mask(std::uint64_t a, std::uint64_t b)
+		{
+			const std::uint64_t x = a ^ b;
+			return ((x | (0 - x)) >> 63) - 1;
+		}
+
+		// picks `a` where mask bits are set, `b` otherwise
+		inline Limbs fe_select(std::uint64_t mask, const Limbs& a, const Limbs& b)
+		{
+			Limbs res{};
+			for (std::size_t i = 0; i < 4; ++i)
+				res[i] = (a[i] & mask) | (b[i] & ~mask);
+			return res;
+		}
+
+		inline bool fe_is_zero(const Limbs& a)
+		{
+			return 0 == (a[0] | a[1] | a[2] | a[3]);
+		}
+
+		inline Limbs fe_add(const Limbs& a, const Limbs& b)
+		{
+			Limbs sum{}, reduced{};
+			std::uint64_t carry = 0, borrow = 0;
+			for (std::size_t i = 0; i < 4; ++i)
+				sum[i] = add_carry(a[i], b[i], carry);
+			for (std::size_t i = 0; i < 4; ++i)
+				reduced[i] = sub_borrow(sum[i], P[i], borrow);
+			sub_borrow(carry, 0, borrow); // borrow is now set iff sum < p
+			return fe_select(0 - borrow, sum, reduced);
+		}
+
+		inline Limbs fe_sub(const Limbs& a, const Limbs& b)
+		{
+			Limbs res{};
+			std::uint64_t borrow = 0, carry = 0;
+			for (std::size_t i = 0; i < 4; ++i)
+				res[i] = sub_borrow(a[i], b[i], borrow);
+			const std::uint64_t mask = 0 - borrow; // add p back if went negative
+			for (std::size_t i = 0; i < 4; ++i)
+				res[i] = add_carry(res[i], P[i] & mask, carry);
+			return res;
+		}
+
+		inline Limbs fe_neg(const Limbs& a)
+		{
+			return fe_sub(ZERO, a);
+		}
+
+		// Montgomery multiplication (CIOS): a * b / R mod p.
+		// Since p = -1 (mod 2^64), the per-word reduction factor is simply the low word.
+		inline Limbs fe_mul(const Limbs& a, const Limbs& b)
+		{
+			std::uint64_t t[6] = {};
+			for (std::size_t i = 0; i < 4; ++i)
+			{
+				std::uint64_t c = 0;
+				for (std::size_t j = 0; j < 4; ++j)
+					t[j] = mul_add(a[j], b[i], t[j], c, c);
+				std::uint64_t carry = 0;
+				t[4] = add_carry(t[4], c, carry);
+				t[5] = carry;
+
+				const std::uint64_t m = t[0];
+				mul_add(m, P[0], t[0], 0, c); // low word cancels out
+				for (std::size_t j = 1; j < 4; ++j)
+					t[j - 1] = mul_add(m, P[j], t[j], c, c);
+				carry = 0;
+				t[3] = add_carry(t[4], c, carry);
+				t[4] = t[5] + carry;
+			}
+
+			// result is below 2p, subtract p once if needed
+			Limbs res{ t[0], t[1], t[2], t[3] }, reduced{};
+			std::uint64_t borrow = 0;
+			for (std::size_t i = 0; i < 4; ++i)
+				reduced[i] = sub_borrow(res[i], P[i], borrow);
+			sub_borrow(t[4], 0, borrow); // borrow is now set iff result < p
+			return fe_select(0 - borrow, res, reduced);
+		}
+
+		inline Limbs fe_sqr(const Limbs& a)
+		{
+			return fe_mul(a, a);
+		}
+
+		// raises to a public exponent (branches only on exponent bits)
+		inline Limbs fe_pow(const Limbs& a, const Limbs& exp)
+		{
+			Limbs res = ONE;
+			for (std::size_t i = 256; i-- > 0; )
+			{
+				res = fe_sqr(res);
+				if ((exp[i / 64] >> (i % 64)) & 1)
+					res = fe_mul(res, a);
+			}
+			return res;
+		}
+
+		inline Limbs fe_inv(const Limbs& a)
+		{
+			return fe_pow(a, INV_EXP); // Fermat's little theorem (constant-time)
+		}
+
+		inline Limbs fe_to_mont(const Limbs& a)
+		{
+			return fe_mul(a, R2);
+		}
+
+		inline Limbs fe_from_mont(const Limbs& a)
+		{
+			return fe_mul(a, Limbs{ 1, 0, 0, 0 });
+		}
+
+		// lexicographic comparison of (non-secret) limbs
+		inline bool limbs_less(const Limbs& a, const Limbs& b)
+		{
+			for (std::size_t i = 4; i-- > 0; )
+				if (a[i] != b[i])
+					return a[i] < b[i];
+			return false;
+		}
+
+		inline Limbs limbs_from_bytes(const byte* bytes) // 32 big-endian bytes
+		{
+			Limbs res{};
+			for (std::size_t i = 0; i < 32; ++i)
+				res[3 - (i / 8)] = (res[3 - (i / 8)] << 8) | bytes[i];
+			return res;
+		}
+
+		inline void limbs_to_bytes(const Limbs& limbs, byte* bytes) // 32 big-endian bytes
+		{
+			for (std::size_t i = 0; i < 32; ++i)
+				bytes[i] = static_cast<byte>(limbs[3 - (i / 8)] >> (8 * (7 - (i % 8))));
+		}
+
+		inline Limbs limbs_from_big_int(const BigInt& value) // value in [0, 2^256)
+		{
+			byte bytes[32] = {};
+			value.Encode(bytes, sizeof(bytes));
+			return limbs_from_bytes(bytes);
+		}
+
+		inline BigInt big_int_from_limbs(const Limbs& limbs)
+		{
+			byte bytes[32] = {};
+			limbs_to_bytes(limbs, bytes);
+			return BigInt(bytes, sizeof(bytes));
+		}
+
+		const BigInt& field_modulus()
+		{
+			static const BigInt FIELD_MODULUS = big_int_from_limbs(P);
+			return FIELD_MODULUS;
+		}
+	}
+
+	GroupOrder P256Group::order()
+	{
+		static const GroupOrder ORDER = big_int_from_limbs(N);
+		return ORDER;
+	}
+
+	P256Group::Self P256Group::generator()
+	{
+		return Self(GX, GY, ONE);
+	}
+
+	P256Group::Self P256Group::identity()
+	{
+		return Self();
+	}
+
+	P256Group::P256Group() : Self(ZERO, ONE, ZERO) { } // (0 : 1 : 0)
+
+	P256Group::P256Group(const BigInt& x, const BigInt& y)
+		: Self(
+			fe_to_mont(limbs_from_big_int((x.IsNegative() || x >= field_modulus()) ? (x % field_modulus()) : x)),
+			fe_to_mont(limbs_from_big_int((y.IsNegative() || y >= field_modulus()) ? (y % field_modulus()) : y)),
+			ONE
+		) { }
+
+	P256Group::Self P256Group::from_scalar(const BigInt& scalar)
+	{
+		return generator_pow(scalar);
+	}
+
+	P256Group::Self P256Group::generator_pow(const BigInt& exp)
+	{
+		return generator_pow(to_scalar(exp));
+	}
+
+	P256Group::Self P256Group::generator_pow(const Scalar& exp)
+	{
+		// one (constant-time) table lookup and addition per 4-bit window, no doublings
+		const auto& table = generator_table();
+		Self res = identity();
+		for (std::size_t i = 0; i < 64; ++i)
+			res *= select(table[i], (exp[i / 16] >> (4 * (i % 16))) & 0xF);
+		return res;
+	}
+
+	P256Group::Self P256Group::sample()
+	{
+		return from_scalar(dist()());
+	}
+
+	P256Group::Self P256Group::decode(BytesView bytes)
+	{
+		if (bytes.size() != ENCODED_SIZE)
+			throw std::invalid_argument("Failed to decode group element: Invalid encoded point size");
+
+		if (0x00 == bytes[0])
+			return identity();
+
+		if (0x02 != bytes[0] && 0x03 != bytes[0])
+			throw std::invalid_argument("Failed to decode group element: Invalid point prefix byte");
+
+		const Limbs x = limbs_from_bytes(bytes.data() + 1);
+		if (!limbs_less(x, P))
+			throw std::invalid_argument("Failed to decode group element: Point is not on the curve");
+
+		// recover Y from X using the curve equation: y^2 = x^3 - 3x + b
+		const Limbs xm = fe_to_mont(x);
+		const Limbs threeX = fe_add(fe_add(xm, xm), xm);
+		const Limbs rhs = fe_add(fe_sub(fe_mul(fe_sqr(xm), xm), threeX), B);
+		Limbs ym = fe_pow(rhs, SQRT_EXP); // p = 3 (mod 4)
+		if (fe_sqr(ym) != rhs)
+			throw std::invalid_argument("Failed to decode group element: Point is not on the curve");
+
+		// pick root by parity in prefix (0x02 if Y even, 0x03 if Y odd)
+		const bool isOdd = fe_from_mont(ym)[0] & 1;
+		if (isOdd != (0x03 == bytes[0]))
+			ym = fe_neg(ym);
+
+		return Self(xm, ym, ONE);
+	}
+
+	Buffer P256Group::encode() const
+	{
+		Buffer res(ENCODED_SIZE, 0);
+
+		if (is_identity())
+		{
+			res[0] = 0x00;
+			return res;
+		}
+
+		const auto [x, y] = affine();
+
+		// prefix: 0x02 if Y even, 0x03 if Y odd
+		res[0] = (y[0] & 1) ? 0x03 : 0x02;
+		limbs_to_bytes(x, res.data() + 1);
+		return res;
+	}
+
+	P256Group::Self P256Group::from_string(std::string str)
+	{
+		static const std::string PREFIX = "P256Group(";
+		static const std::string SUFFIX = ")";
+
+		// check for prefix and suffix, then trim them off
+		if (!str.starts_with(PREFIX) || !str.ends_with(SUFFIX))
+			throw StrParseException("Invalid input", str);
+		str = str.substr(PREFIX.length());
+		str = str.substr(0, str.length() - SUFFIX.length());
+
+		// check for identity representative
+		if ("IDENTITY" == str)
+			return identity();
+
+		auto commaIdx = str.find(',');
+		if (commaIdx == std::string::npos)
+			throw StrParseException("Invalid input", str);
+
+		auto xStr = str.substr(0, commaIdx);
+		auto yStr = str.substr(commaIdx + 1);
+		return Self(BigInt(xStr.c_str()), BigInt(yStr.c_str()));
+	}
+
+	std::string P256Group::to_string() const
+	{
+		std::stringstream s;
+		s << *this;
+		return s.str();
+	}
+
+	std::ostream& operator<<(std::ostream& os, const P256Group& elem)
+	{
+		if (elem.is_identity())
+			return os << "P256Group(IDENTITY)";
+		return os << "P256Group(" << elem.x() << "," << elem.y() << ")";
+	}
+
+	bool P256Group::is_identity() const
+	{
+		return fe_is_zero(this->_z);
+	}
+
+	bool P256Group::operator==(const Self& other) const
+	{
+		if (this->is_identity() || other.is_identity())
+			return this->is_identity() && other.is_identity();
+
+		// compare without inversions: X1*Z2 == X2*Z1 and Y1*Z2 == Y2*Z1
+		return fe_mul(this->_x, other._z) == fe_mul(other._x, this->_z) &&
+			fe_mul(this->_y, other._z) == fe_mul(other._y, this->_z);
+	}
+
+	BigInt P256Group::x() const
+	{
+		if (is_identity())
+			return BigInt::Zero();
+		return big_int_from_limbs(affine().first);
+	}
+
+	BigInt P256Group::y() const
+	{
+		if (is_identity())
+			return BigInt::Zero();
+		return big_int_from_limbs(affine().second);
+	}
+
+	P256Group::Self P256Group::inverse() const
+	{
+		return Self(this->_x, fe_neg(this->_y), this->_z);
+	}
+
+	P256Group::Self P256Group::operator*(const Self& other) const
+	{
+		Self res = *this;
+		return res *= other;
+	}
+
+	P256Group::Self& P256Group::operator*=(const Self& other)
+	{
+		// complete addition for a = -3 (Renes-Costello-Batina 2015, algorithm 4):
+		// valid for all inputs (including identity and doubling), so never branches
+		const Limbs& x1 = this->_x;
+		const Limbs& y1 = this->_y;
+		const Limbs& z1 = this->_z;
+		const Limbs& x2 = other._x;
+		const Limbs& y2 = other._y;
+		const Limbs& z2 = other._z;
+
+		Limbs t0 = fe_mul(x1, x2);
+		Limbs t1 = fe_mul(y1, y2);
+		Limbs t2 = fe_mul(z1, z2);
+		Limbs t3 = fe_mul(fe_add(x1, y1), fe_add(x2, y2));
+		Limbs t4 = fe_add(t0, t1);
+		t3 = fe_sub(t3, t4);
+		t4 = fe_mul(fe_add(y1, z1), fe_add(y2, z2));
+		Limbs x3 = fe_add(t1, t2);
+		t4 = fe_sub(t4, x3);
+		x3 = fe_mul(fe_add(x1, z1), fe_add(x2, z2));
+		Limbs y3 = fe_add(t0, t2);
+		y3 = fe_sub(x3, y3);
+		Limbs z3 = fe_mul(B, t2);
+		x3 = fe_sub(y3, z3);
+		z3 = fe_add(x3, x3);
+		x3 = fe_add(x3, z3);
+		z3 = fe_sub(t1, x3);
+		x3 = fe_add(t1, x3);
+		y3 = fe_mul(B, y3);
+		t1 = fe_add(t2, t2);
+		t2 = fe_add(t1, t2);
+		y3 = fe_sub(y3, t2);
+		y3 = fe_sub(y3, t0);
+		t1 = fe_add(y3, y3);
+		y3 = fe_add(t1, y3);
+		t1 = fe_add(t0, t0);
+		t0 = fe_add(t1, t0);
+		t0 = fe_sub(t0, t2);
+		t1 = fe_mul(t4, y3);
+		t2 = fe_mul(t0, y3);
+		y3 = fe_mul(x3, z3);
+		y3 = fe_add(y3, t2);
+		x3 = fe_mul(x3, t3);
+		x3 = fe_sub(x3, t1);
+		z3 = fe_mul(z3, t4);
+		t1 = fe_mul(t3, t0);
+		z3 = fe_add(z3, t1);
+
+		this->_x = x3;
+		this->_y = y3;
+		this->_z = z3;
+		return *this;
+	}
+
+	P256Group::Self P256Group::operator/(const Self& other) const
+	{
+		return *this * other.inverse();
+	}
+
+	P256Group::Self& P256Group::operator/=(const Self& other)
+	{
+		return *this *= other.inverse();
+	}
+
+	P256Group::Self P256Group::pow(const BigInt& exp) const
+	{
+		return pow(to_scalar(exp));
+	}
+
+	P256Group::Self P256Group::pow(const Scalar& exp) const
+	{
+		// fixed 4-bit window: table of 0..15 multiples, then 4 doublings and one addition per window
+		std::array<Self, 16> table;
+		table[0] = identity();
+		table[1] = *this;
+		for (std::size_t j = 2; j < table.size(); ++j)
+			table[j] = table[j - 1] * *this;
+
+		Self res = identity();
+		for (std::size_t i = 64; i-- > 0; )
+		{
+			for (int k = 0; k < 4; ++k)
+				res.double_in_place();
+			res *= select(table, (exp[i / 16] >> (4 * (i % 16))) & 0xF);
+		}
+		return res;
+	}
+
+	P256Group::Scalar P256Group::to_scalar(const BigInt& exp)
+	{
+		if (exp.IsNegative() || exp >= order())
+			return limbs_from_big_int(exp % order()); // remainder is non-negative
+		return limbs_from_big_int(exp);
+	}
+
+	Distribution<BigInt>& P256Group::dist()
+	{
+		static auto DIST = Random<BigInt>::get_dist_below(order());
+		return DIST;
+	}
+
+	P256Group::P256Group(const FieldElem& x, const FieldElem& y, const FieldElem& z)
+		: _x(x), _y(y), _z(z) { }
+
+	std::pair<P256Group::FieldElem, P256Group::FieldElem> P256Group::affine() const
+	{
+		const Limbs zInv = fe_inv(this->_z);
+		return { fe_from_mont(fe_mul(this->_x, zInv)), fe_from_mont(fe_mul(this->_y, zInv)) };
+	}
+
+	void P256Group::double_in_place()
+	{
+		// complete doubling for a = -3 (Renes-Costello-Batina 2015, algorithm 6)
+		const Limbs& x = this->_x;
+		const Limbs& y = this->_y;
+		const Limbs& z = this->_z;
+
+		Limbs t0 = fe_sqr(x);
+		Limbs t1 = fe_sqr(y);
+		Limbs t2 = fe_sqr(z);
+		Limbs t3 = fe_mul(x, y);
+		t3 = fe_add(t3, t3);
+		Limbs z3 = fe_mul(x, z);
+		z3 = fe_add(z3, z3);
+		Limbs y3 = fe_mul(B, t2);
+		y3 = fe_sub(y3, z3);
+		Limbs x3 = fe_add(y3, y3);
+		y3 = fe_add(x3, y3);
+		x3 = fe_sub(t1, y3);
+		y3 = fe_add(t1, y3);
+		y3 = fe_mul(x3, y3);
+		x3 = fe_mul(x3, t3);
+		t3 = fe_add(t2, t2);
+		t2 = fe_add(t2, t3);
+		z3 = fe_mul(B, z3);
+		z3 = fe_sub(z3, t2);
+		z3 = fe_sub(z3, t0);
+		t3 = fe_add(z3, z3);
+		z3 = fe_add(z3, t3);
+		t3 = fe_add(t0, t0);
+		t0 = fe_add(t3, t0);
+		t0 = fe_sub(t0, t2);
+		t0 = fe_mul(t0, z3);
+		y3 = fe_add(y3, t0);
+		t0 = fe_mul(y, z);
+		t0 = fe_add(t0, t0);
+		z3 = fe_mul(t0, z3);
+		x3 = fe_sub(x3, z3);
+		z3 = fe_mul(t0, t1);
+		z3 = fe_add(z3, z3);
+		z3 = fe_add(z3, z3);
+
+		this->_x = x3;
+		this->_y = y3;
+		this->_z = z3;
+	}
+
+	P256Group::Self P256Group::select(const std::array<Self, 16>& table, std::uint64_t index)
+	{
+		// scans whole table, so memory access pattern does not depend on index
+		Self res(ZERO, ZERO, ZERO);
+		for (std::size_t j = 0; j < table.size(); ++j)
+		{
+			const std::uint64_t mask = eq_mask(j, index);
+			res._x = fe_select(mask, table[j]._x, res._x);
+			res._y = fe_select(mask, table[j]._y, res._y);
+			res._z = fe_select(mask, table[j]._z, res._z);
+		}
+		return res;
+	}
+
+	const std::array<std::array<P256Group::Self, 16>, 64>& P256Group::generator_table()
+	{
+		static const auto GENERATOR_TABLE = []()
+		{
+			auto table = std::make_unique<std::array<std::array<Self, 16>, 64>>();
+			Self base = generator(); // 16^i * g
+			for (auto& row : *table)
+			{
+				row[0] = identity();
+				row[1] = base;
+				for (std::size_t j = 2; j < row.size(); ++j)
+					row[j] = row[j - 1] * base;
+				base = row[15] * base;
+			}
+			return table;
+		}();
+		return *GENERATOR_TABLE;
+	}
+}
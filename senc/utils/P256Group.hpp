@@ -0,0 +1,268 @@
+/*********************************************************************
+ * \file   P256Group.hpp
+ * \brief  Header of P256Group class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <array>
+
+#include "Random.hpp"
+#include "Group.hpp"
+#include "bytes.hpp"
+#include "math.hpp"
+
+namespace senc::utils
+{
+	/**
+	 * @class senc::utils::P256Group
+	 * @brief Elliptic Curve (secp256r1) based algebric group, with a dedicated fixed-width backend.
+	 * @note Satisfies `senc::utils::Group`, and is interchangable with `senc::utils::ECGroup`
+	 *       (same curve, same encoding).
+	 * @note Field elements are held as 4 64-bit limbs in Montgomery form, and points in homogeneous
+	 *       projective coordinates using complete addition formulas, so group operations never allocate
+	 *       or branch on secret data. Scalar multiplication is constant-time (fixed window, with
+	 *       constant-time table lookups); conversion of `BigInt` exponents to scalars is not.
+	 */
+	class P256Group
+	{
+	public:
+		using Self = P256Group;
+
+		/**
+		 * @typedef senc::utils::P256Group::Scalar
+		 * @brief 256-bit exponent, as 64-bit limbs (least significant first).
+		 */
+		using Scalar = std::array<std::uint64_t, 4>;
+
+		static constexpr size_t ENCODED_FIELD_SIZE = 32; // 256 bits / 8
+		static constexpr size_t ENCODED_SIZE = 1 + ENCODED_FIELD_SIZE; // 33 bytes
+
+		static constexpr bool is_prime_ordered() noexcept { return true; } // EC is always prime ordered
+
+		/**
+		 * @brief Gets group order.
+		 * @return Group order.
+		 */
+		static GroupOrder order();
+
+		/**
+		 * @brief Gets group generator.
+		 * @return Group generator.
+		 */
+		static Self generator();
+
+		/**
+		 * @brief Gets group identity element.
+		 * @return Group identity element.
+		 */
+		static Self identity();
+
+		/**
+		 * @brief Constructs group identity element.
+		 */
+		P256Group();
+
+		/**
+		 * @brief Constructs a non-identity group element from given x and y values on the curve.
+		 * @param x
+		 * @param y
+		 */
+		P256Group(const BigInt& x, const BigInt& y);
+
+		/**
+		 * @brief Maps given scalar to an elliptic curve group element.
+		 * @param scalar Scalar to convert to P256Group elem (in range [`0`, `ORDER`]).
+		 * @return Elliptic curve group mapped from `scalar`.
+		 */
+		static Self from_scalar(const BigInt& scalar);
+
+		/**
+		 * @brief Raises group generator to a given power, using a precomputed fixed-base table.
+		 * @param exp Exponent to raise generator to the power of.
+		 * @return Result of raising group generator to the power of `exp`.
+		 */
+		static Self generator_pow(const BigInt& exp);
+
+		/**
+		 * @brief Raises group generator to a given power, using a precomputed fixed-base table.
+		 * @note Constant-time.
+		 * @param exp Exponent to raise generator to the power of.
+		 * @return Result of raising group generator to the power of `exp`.
+		 */
+		static Self generator_pow(const Scalar& exp);
+
+		/**
+		 * @brief Samples a random group element.
+		 * @return Sampled element.
+		 */
+		static Self sample();
+
+		/**
+		 * @brief Parses group element from bytes by SEC 1 standard.
+		 * @param bytes View of bytes.
+		 * @return Parsed group element.
+		 */
+		static Self decode(BytesView bytes);
+
+		/**
+		 * @brief Serializes group element to bytes by SEC 1 standard.
+		 * @return Serialized group element.
+		 */
+		Buffer encode() const;
+
+		/**
+		 * @brief Parses group element from string.
+		 * @param str String to parse.
+		 * @return Parsed group element.
+		 */
+		static Self from_string(std::string str);
+
+		/**
+		 * @brief Converts group element to string.
+		 * @return String representation of group element.
+		 */
+		std::string to_string() const;
+
+		/**
+		 * @brief Output operator for `P256Group`.
+		 */
+		friend std::ostream& operator<<(std::ostream& os, const P256Group& elem);
+
+		/**
+		 * @brief Determines whether or not this is the identity element.
+		 * @return `true` if `*this` is the identity element, otherwise `false`.
+		 */
+		bool is_identity() const;
+
+		/**
+		 * @brief Compares two elliptic curve group elements.
+		 * @param other Other element to compare with.
+		 * @return `true` if `*this` is the same element as `other`, otherwise `false`.
+		 */
+		bool operator==(const Self& other) const;
+
+		/**
+		 * @brief Gets point's (affine) X value.
+		 * @return Point's X value.
+		 */
+		BigInt x() const;
+
+		/**
+		 * @brief Gets point's (affine) Y value.
+		 * @return Point's Y value.
+		 */
+		BigInt y() const;
+
+		/**
+		 * @brief Gets inverse of group element (by group operation).
+		 * @return Inverse element of `*this`.
+		 */
+		Self inverse() const;
+
+		/**
+		 * @brief Applies group operation (point addition).
+		 * @param other Other group element to apply operation with.
+		 * @return Result of group operation on `*this` and `other`.
+		 */
+		Self operator*(const Self& other) const;
+
+		/**
+		 * @brief Applies group operation (point addition) into this group element.
+		 * @param other Other group element to apply operation with.
+		 * @return `*this`, after operator applying.
+		 */
+		Self& operator*=(const Self& other);
+
+		/**
+		 * @brief Applies inverse group operation.
+		 * @param other Other group element to apply operation with.
+		 * @return Result of inverse group operation on `*this` and `other`.
+		 */
+		Self operator/(const Self& other) const;
+
+		/**
+		 * @brief Applies inverse group operation into this group element.
+		 * @param other Other group element to apply inverse operation with.
+		 * @return `*this`, after operation applying.
+		 */
+		Self& operator/=(const Self& other);
+
+		/**
+		 * @brief Applies repeated group operation.
+		 * @param exp Amount of times to apply group operation (plus one).
+		 * @return Result of repeated group operation.
+		 */
+		Self pow(const BigInt& exp) const;
+
+		/**
+		 * @brief Applies repeated group operation.
+		 * @note Constant-time.
+		 * @param exp Amount of times to apply group operation (plus one).
+		 * @return Result of repeated group operation.
+		 */
+		Self pow(const Scalar& exp) const;
+
+		/**
+		 * @brief Converts a big integer exponent to a scalar (reduced modulo group order).
+		 * @param exp Exponent to convert.
+		 * @return Scalar congruent to `exp` modulo group order.
+		 */
+		static Scalar to_scalar(const BigInt& exp);
+
+	private:
+		// field element, as 64-bit limbs (least significant first) in Montgomery form
+		using FieldElem = std::array<std::uint64_t, 4>;
+
+		// static constants
+		static Distribution<BigInt>& dist(); // distribution for sampling
+
+		// instance fields (homogeneous projective coordinates, identity has Z = 0)
+		FieldElem _x;
+		FieldElem _y;
+		FieldElem _z;
+
+		// private methods
+
+		/**
+		 * @brief Constructs an element from given projective coordinates (in Montgomery form).
+		 * @param x
+		 * @param y
+		 * @param z
+		 */
+		P256Group(const FieldElem& x, const FieldElem& y, const FieldElem& z);
+
+		/**
+		 * @brief Gets affine coordinates of this (non-identity) point.
+		 * @return Pair of affine X and Y (not in Montgomery form).
+		 */
+		std::pair<FieldElem, FieldElem> affine() const;
+
+		/**
+		 * @brief Doubles this point (applies group operation with itself) in place.
+		 */
+		void double_in_place();
+
+		/**
+		 * @brief Selects a point from a table without data-dependant memory access.
+		 * @param table Table of 16 points.
+		 * @param index Index of point to select.
+		 * @return Selected point.
+		 */
+		static Self select(const std::array<Self, 16>& table, std::uint64_t index);
+
+		/**
+		 * @brief Gets fixed-base table of generator multiples (row `i` holds `j * 16^i * g` at `j`).
+		 * @return Table reference.
+		 */
+		static const std::array<std::array<Self, 16>, 64>& generator_table();
+	};
+
+	static_assert(Group<P256Group>, "senc::utils::P256Group should satisfy senc::utils::Group");
+	static_assert(PrimeOrderedGroup<P256Group>, "senc::utils::P256Group should satisfy senc::utils::PrimeOrderedGroup");
+}
@@ -8,11 +8,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <utility>
+#include <tuple>
+#include <array>
+#include <span>
 
 #include "enc/HybridElGamal2L.hpp"
 #include "Fraction.hpp"
 #include "concepts.hpp"
+#include "MontModInt.hpp"
+#include "LruCache.hpp"
 #include "ModInt.hpp"
 #include "Group.hpp"
 #include "poly.hpp"
@@ -148,7 +154,44 @@ namespace senc::utils
 		requires std::convertible_to<std::ranges::range_value_t<R>, SID>
 		static std::vector<Shard> make_shards(const Poly& poly, R&& shardsIDs);
 
+		/**
+		 * @brief Gets Shamir shards of several polynomials for the same IDs, evaluating all in one pass.
+		 * @note Uses `Poly::eval_many` (one Horner pass per ID for all polynomials).
+		 * @param polys Polynomials sampled for Shamir (e.g. one per layer).
+		 * @param shardsIDs Non-zero unique ID values for Shamir shards.
+		 * @return Shards, where `res[p][j]` is the shard of `*polys[p]` for `shardsIDs[j]`.
+		 * @throw ShamirException If `shardsIDs` aren't unique, or if any of them is zero-equivalent.
+		 */
+		static std::vector<std::vector<Shard>> make_shards_batch(std::span<const Poly* const> polys,
+																 const std::vector<SID>& shardsIDs);
+
+		/**
+		 * @brief Gets Lagrange coefficients for all shards in a sequence.
+		 * @note For field secrets, uses a single (batched) inversion for all coefficients.
+		 * @param shardsIDs Sequence of shards IDs.
+		 * @return Lagrange coefficients, where the `i`th is of the `i`th shard from `shardsIDs`.
+		 * @throw ShamirException If `shardsIDs` are not unique or contain a zero-equivalent.
+		 */
+		static std::vector<PackedSecret> lagrange_coeffs(const std::vector<SID>& shardsIDs);
+
+		/**
+		 * @brief Gets Lagrange coefficient of a single shard in a sequence.
+		 * @note For field secrets, uses a single inversion (rather than computing all coefficients).
+		 * @param i Index of shard in sequence.
+		 * @param shardsIDs Sequence of shards IDs.
+		 * @return Lagrange coefficient of the `i`th shard from `shardsIDs`.
+		 * @throw ShamirException If `shardsIDs` are not unique or contain a zero-equivalent.
+		 */
+		static PackedSecret lagrange_coeff(std::size_t i, const std::vector<SID>& shardsIDs);
+
 	protected:
+		/**
+		 * @brief Checks that shards IDs are non-zero and unique.
+		 * @param shardsIDs Sequence of shards IDs.
+		 * @throw ShamirException If `shardsIDs` are not unique or contain a zero-equivalent.
+		 */
+		static void validate_shards_ids(const std::vector<SID>& shardsIDs);
+
 		/**
 		 * @brief Gets Lagrange coefficient for a specific shard in a sequence.
 		 * @param i Index of shard in sequence.
@@ -157,6 +200,25 @@ namespace senc::utils
 		 * @throw ShamirException If `shardsIDs` are not unique or contain a zero-equivalent.
 		 */
 		static PackedSecret get_lagrange_coeff(std::size_t i, const std::vector<SID>& shardsIDs);
+
+		/**
+		 * @brief Gets Lagrange coefficients for all shards in a sequence, using a single inversion.
+		 * @tparam F Field element type to compute in.
+		 * @param shardsIDs Sequence of (validated) shards IDs.
+		 * @return Lagrange coefficients, where the `i`th is of the `i`th shard from `shardsIDs`.
+		 */
+		template <typename F>
+		static std::vector<F> field_lagrange_coeffs(const std::vector<SID>& shardsIDs);
+
+		/**
+		 * @brief Gets Lagrange coefficient of a single shard in a sequence, using a single inversion.
+		 * @tparam F Field element type to compute in.
+		 * @param i Index of shard in sequence.
+		 * @param shardsIDs Sequence of (validated) shards IDs.
+		 * @return Lagrange coefficient of the `i`th shard from `shardsIDs`.
+		 */
+		template <typename F>
+		static F field_lagrange_coeff(std::size_t i, const std::vector<SID>& shardsIDs);
 	};
 
 	/**
@@ -206,7 +268,11 @@ namespace senc::utils
 	struct ShamirHybridElGamalSecretModTraits
 	{
 		using Underlying = GroupOrder;
-		static GroupOrder modulus() noexcept { return G::order(); }
+		static const GroupOrder& modulus() noexcept
+		{
+			static const GroupOrder order = G::order(); // cached, as `ModInt` operations use it repeatedly
+			return order;
+		}
 		static constexpr bool is_known_prime() noexcept { return PrimeOrderedGroup<G>; }
 	};
 
@@ -242,6 +308,8 @@ namespace senc::utils
 		using Ciphertext = enc::Ciphertext<enc::HybridElGamal2L<G, SE, KDF>>;
 		using Part = G;
 
+		static constexpr std::size_t LAGRANGE_CACHE_CAPACITY = 256; // participant sets held
+
 		ShamirHybridElGamal() = delete;
 
 		/**
@@ -261,6 +329,7 @@ namespace senc::utils
 		 * @param privKeyShardsIDs ID values of private key Shamir shards (of layer `layer`).
 		 * @return Part of decryption matching `privKeyShard` (computed from c1,c2).
 		 * @throw ShamirException If `privKeyShardsIDs` are invalid or `privKeyShard` is invalid.
+		 * @note Lagrange coefficient is cached per (layer, participant set, shard), see `lagrange_cache_stats`.
 		 */
 		template <int layer>
 		requires (1 == layer || 2 == layer)
@@ -279,9 +348,29 @@ namespace senc::utils
 										 const std::vector<Part>& parts1,
 										 const std::vector<Part>& parts2);
 
+		/**
+		 * @brief Gets lookup statistics of Lagrange coefficients cache (used by `decrypt_get_2l`).
+		 * @return Cache statistics.
+		 */
+		static LruCacheStats lagrange_cache_stats();
+
+		/**
+		 * @brief Clears Lagrange coefficients cache (used by `decrypt_get_2l`) and its statistics.
+		 */
+		static void clear_lagrange_cache();
+
 	private:
 		static SE _symmetricSchema;
 		static KDF _kdf;
+
+		// layer, sorted shards IDs and own shard ID, mapped to own Lagrange coefficient
+		using LagrangeCache = LruCache<std::tuple<int, std::vector<SID>, SID>, PackedSecret>;
+
+		/**
+		 * @brief Gets Lagrange coefficients cache.
+		 * @return Cache reference.
+		 */
+		static LagrangeCache& lagrange_cache();
 	};
 }
 
@@ -41,6 +41,50 @@ namespace senc::utils
 		return res;
 	}
 
+	template <typename S, ShamirShardID SID>
+	requires ShamirSecret<S, SID>
+	inline std::vector<std::vector<typename ShamirUtils<S, SID>::Shard>> ShamirUtils<S, SID>::make_shards_batch(
+		std::span<const Poly* const> polys, const std::vector<SID>& shardsIDs)
+	{
+		validate_shards_ids(shardsIDs);
+
+		std::vector<std::vector<Shard>> res;
+		res.reserve(polys.size());
+		for (auto& values : Poly::eval_many(polys, shardsIDs))
+		{
+			auto& shards = res.emplace_back();
+			shards.reserve(shardsIDs.size());
+			for (std::size_t j = 0; j < shardsIDs.size(); ++j)
+				shards.emplace_back(shardsIDs[j], std::move(values[j]));
+		}
+		return res;
+	}
+
+	template <typename S, ShamirShardID SID>
+	requires ShamirSecret<S, SID>
+	inline void ShamirUtils<S, SID>::validate_shards_ids(const std::vector<SID>& shardsIDs)
+	{
+		if (std::ranges::any_of(shardsIDs, [](const SID& shardID) { return 0 == shardID; }))
+			throw ShamirException("Invalid ID provided: Should be non-zero");
+
+		// sorting a copy avoids hashing each ID (costly for big integers)
+		bool unique = true;
+		if constexpr (std::totally_ordered<SID>)
+		{
+			std::vector<SID> sortedIDs = shardsIDs;
+			std::ranges::sort(sortedIDs);
+			unique = (sortedIDs.end() == std::ranges::adjacent_find(sortedIDs));
+		}
+		else
+		{
+			HashSet<SID> usedIDs;
+			for (const SID& shardID : shardsIDs)
+				unique = unique && usedIDs.insert(shardID).second;
+		}
+		if (!unique)
+			throw ShamirException("Invalid IDs provided: Not unique");
+	}
+
 	template <typename S, ShamirShardID SID>
 	requires ShamirSecret<S, SID>
 	inline typename ShamirUtils<S, SID>::PackedSecret ShamirUtils<S, SID>::get_lagrange_coeff(
@@ -60,6 +104,133 @@ namespace senc::utils
 		);
 	}
 
+	template <typename S, ShamirShardID SID>
+	requires ShamirSecret<S, SID>
+	inline std::vector<typename ShamirUtils<S, SID>::PackedSecret> ShamirUtils<S, SID>::lagrange_coeffs(
+		const std::vector<SID>& shardsIDs)
+	{
+		validate_shards_ids(shardsIDs);
+
+		const std::size_t n = shardsIDs.size();
+		std::vector<PackedSecret> res;
+		res.reserve(n);
+
+		// fractions reduce as they go, so products of differences would only risk overflow
+		if constexpr (std::integral<S>)
+		{
+			for (std::size_t i = 0; i < n; ++i)
+				res.push_back(get_lagrange_coeff(i, shardsIDs));
+			return res;
+		}
+		else if constexpr (ModIntType<PackedSecret>)
+		{
+			if constexpr (MontModTraitsType<typename PackedSecret::Traits>)
+			{
+				// compute in Montgomery form (no division per multiplication), convert back once
+				using Mont = MontModInt<typename PackedSecret::Traits>;
+				for (const Mont& coeff : field_lagrange_coeffs<Mont>(shardsIDs))
+					res.emplace_back(coeff.value());
+				return res;
+			}
+			else return field_lagrange_coeffs<PackedSecret>(shardsIDs);
+		}
+		else return field_lagrange_coeffs<PackedSecret>(shardsIDs);
+	}
+
+	template <typename S, ShamirShardID SID>
+	requires ShamirSecret<S, SID>
+	inline typename ShamirUtils<S, SID>::PackedSecret ShamirUtils<S, SID>::lagrange_coeff(
+		std::size_t i, const std::vector<SID>& shardsIDs)
+	{
+		validate_shards_ids(shardsIDs);
+
+		// fractions reduce as they go, so products of differences would only risk overflow
+		if constexpr (std::integral<S>)
+			return get_lagrange_coeff(i, shardsIDs);
+		else if constexpr (ModIntType<PackedSecret>)
+		{
+			if constexpr (MontModTraitsType<typename PackedSecret::Traits>)
+			{
+				using Mont = MontModInt<typename PackedSecret::Traits>;
+				return PackedSecret(field_lagrange_coeff<Mont>(i, shardsIDs).value());
+			}
+			else return field_lagrange_coeff<PackedSecret>(i, shardsIDs);
+		}
+		else return field_lagrange_coeff<PackedSecret>(i, shardsIDs);
+	}
+
+	template <typename S, ShamirShardID SID>
+	requires ShamirSecret<S, SID>
+	template <typename F>
+	inline std::vector<F> ShamirUtils<S, SID>::field_lagrange_coeffs(const std::vector<SID>& shardsIDs)
+	{
+		const std::size_t n = shardsIDs.size();
+		const auto xs = utils::to_vector<F>(
+			shardsIDs |
+			std::views::transform([](const SID& x) { return static_cast<F>(x); })
+		);
+
+		// coeff_i = (prod_{j!=i} xj) / (prod_{j!=i} (xj - xi)):
+		// numerators via prefix/suffix products, denominators inverted all at once
+		std::vector<F> dens;
+		dens.reserve(n);
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			F den(1);
+			for (std::size_t j = 0; j < n; ++j)
+				if (j != i)
+					den *= xs[j] - xs[i];
+			dens.push_back(std::move(den));
+		}
+
+		// Montgomery batch inversion: prefix products, one inversion, then walk back
+		std::vector<F> prefix;
+		prefix.reserve(n + 1);
+		prefix.emplace_back(1);
+		for (const auto& den : dens)
+			prefix.push_back(prefix.back() * den);
+		F inv = F(1) / prefix.back();
+		for (std::size_t i = n; i-- > 0; )
+		{
+			F denInv = inv * prefix[i];
+			inv *= dens[i];
+			dens[i] = std::move(denInv);
+		}
+
+		// numerators: prefix[i] holds product of xs before i, suffix that of xs after i
+		prefix.clear();
+		prefix.emplace_back(1);
+		for (const auto& x : xs)
+			prefix.push_back(prefix.back() * x);
+		std::vector<F> res(n);
+		F suffix(1);
+		for (std::size_t i = n; i-- > 0; )
+		{
+			res[i] = prefix[i] * suffix * dens[i];
+			suffix *= xs[i];
+		}
+		return res;
+	}
+
+	template <typename S, ShamirShardID SID>
+	requires ShamirSecret<S, SID>
+	template <typename F>
+	inline F ShamirUtils<S, SID>::field_lagrange_coeff(std::size_t i, const std::vector<SID>& shardsIDs)
+	{
+		// coeff_i = (prod_{j!=i} xj) / (prod_{j!=i} (xj - xi))
+		const F xi = static_cast<F>(shardsIDs[i]);
+		F num(1), den(1);
+		for (std::size_t j = 0; j < shardsIDs.size(); ++j)
+		{
+			if (j == i)
+				continue;
+			const F xj = static_cast<F>(shardsIDs[j]);
+			num *= xj;
+			den *= xj - xi;
+		}
+		return num / den;
+	}
+
 	template <typename S, ShamirShardID SID>
 	requires ShamirSecret<S, SID>
 	inline typename Shamir<S, SID>::Poly Shamir<S, SID>::sample_poly(
@@ -82,14 +253,15 @@ namespace senc::utils
 		);
 		if (shards.size() <= static_cast<std::size_t>(threshold))
 			throw ShamirException("Not enough shards provided to restore secret");
+		const auto coeffs = Utils::lagrange_coeffs(shardsIDs);
 		PackedSecret res = utils::sum(
 			shards |
 			std::views::transform([](const Shard& shard) -> const PackedSecret& { return shard.second; }) |
 			views::enumerate |
-			std::views::transform([&shardsIDs](auto p) -> PackedSecret
+			std::views::transform([&coeffs](auto p) -> PackedSecret
 			{
 				const auto& [i, yi] = p; // shard index, shard value
-				return yi * Utils::get_lagrange_coeff(i, shardsIDs);
+				return yi * coeffs[i];
 			})
 		);
 
@@ -124,25 +296,29 @@ namespace senc::utils
 		const G& c = std::get<layer - 1>(ciphertext);
 		const auto& [xi, yi] = privKeyShard;
 
-		HashSet<SID> privKeyShardsIDsSet;
-		std::optional<std::size_t> i;
-		for (const auto& [idx, shardID] : privKeyShardsIDs | views::enumerate)
+		if constexpr (std::totally_ordered<SID>)
 		{
-			if (0 == shardID)
-				throw ShamirException("Invalid ID provided: Should be non-zero");
-			privKeyShardsIDsSet.insert(shardID);
-			if (shardID == xi)
-				i = idx;
+			// canonical (sorted) participant set, so that order of IDs does not matter
+			std::tuple<int, std::vector<SID>, SID> key{ layer, privKeyShardsIDs, xi };
+			auto& sortedIDs = std::get<1>(key);
+			std::ranges::sort(sortedIDs);
+			const auto coeff = lagrange_cache().get_or_compute(key, [&sortedIDs, &xi]()
+			{
+				const auto it = std::ranges::lower_bound(sortedIDs, xi);
+				if (sortedIDs.end() == it || *it != xi)
+					throw ShamirException("Shard with ID no present");
+				return Utils::lagrange_coeff(it - sortedIDs.begin(), sortedIDs); // also validates IDs
+			});
+			return utils::pow(c, yi * *coeff);
+		}
+		else
+		{
+			const auto it = std::ranges::find(privKeyShardsIDs, xi);
+			if (privKeyShardsIDs.end() == it)
+				throw ShamirException("Shard with ID no present");
+			const auto coeff = Utils::lagrange_coeff(it - privKeyShardsIDs.begin(), privKeyShardsIDs); // also validates IDs
+			return utils::pow(c, yi * coeff);
 		}
-		if (privKeyShardsIDs.size() != privKeyShardsIDsSet.size())
-			throw ShamirException("Invalid IDs provided: Not unique");
-		if (!i.has_value())
-			throw ShamirException("Shard with ID no present");
-
-		return utils::pow(
-			c,
-			yi * Utils::get_lagrange_coeff(i.value(), privKeyShardsIDs)
-		);
 	}
 
 	template <Group G, enc::Symmetric1L SE, ConstCallable<enc::Key<SE>, G, G> KDF, ShamirShardID SID>
@@ -153,10 +329,10 @@ namespace senc::utils
 			const std::vector<Part>& parts2)
 	{
 		const auto& c3 = std::get<2>(ciphertext);
-		auto z1 = utils::product(parts1);
-		auto z2 = utils::product(parts2);
+		std::array<G, 2> z{ utils::product(parts1), utils::product(parts2) };
+		utils::normalize_batch(std::span<G>(z)); // single inversion for both (if representation has any)
 
-		auto k = _kdf(z1, z2);
+		auto k = _kdf(z[0], z[1]);
 
 		return _symmetricSchema.decrypt(c3, k);
 	}
@@ -166,4 +342,25 @@ namespace senc::utils
 
 	template <Group G, enc::Symmetric1L SE, ConstCallable<enc::Key<SE>, G, G> KDF, ShamirShardID SID>
 	inline KDF ShamirHybridElGamal<G, SE, KDF, SID>::_kdf;
+
+	template <Group G, enc::Symmetric1L SE, ConstCallable<enc::Key<SE>, G, G> KDF, ShamirShardID SID>
+	inline LruCacheStats ShamirHybridElGamal<G, SE, KDF, SID>::lagrange_cache_stats()
+	{
+		return lagrange_cache().stats();
+	}
+
+	template <Group G, enc::Symmetric1L SE, ConstCallable<enc::Key<SE>, G, G> KDF, ShamirShardID SID>
+	inline void ShamirHybridElGamal<G, SE, KDF, SID>::clear_lagrange_cache()
+	{
+		lagrange_cache().clear();
+		lagrange_cache().reset_stats();
+	}
+
+	template <Group G, enc::Symmetric1L SE, ConstCallable<enc::Key<SE>, G, G> KDF, ShamirShardID SID>
+	inline typename ShamirHybridElGamal<G, SE, KDF, SID>::LagrangeCache&
+		ShamirHybridElGamal<G, SE, KDF, SID>::lagrange_cache()
+	{
+		static LagrangeCache cache(LAGRANGE_CACHE_CAPACITY);
+		return cache;
+	}
 }
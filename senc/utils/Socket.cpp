@@ -137,6 +137,14 @@ namespace senc::utils
 		if (!(leftoverBytes > 0 || is_connected()))
 			throw SocketException("Failed to recieve", "Socket is not connected");
 
+		// in a buffered-only scope, never wait on underlying socket
+		if (this->_bufferedOnly)
+		{
+			if (0 == leftoverBytes && maxsize > 0)
+				throw SocketWouldBlockException("Failed to recieve", "Message not fully received yet");
+			return leftoverBytes;
+		}
+
 		if (leftoverBytes > 0 && !underlying_has_data(this->_sock))
 			return leftoverBytes; // if read leftover, and has nothing more - stop here
 
@@ -151,13 +159,119 @@ namespace senc::utils
 		std::size_t bytesRead = 0;
 		while (bytesRead < size)
 		{
-			bytesRead += recv_connected_into(
+			const std::size_t count = recv_connected_into(
 				reinterpret_cast<byte*>(out) + bytesRead,
 				size - bytesRead
 			);
+
+			// zero bytes read means peer closed connection (would otherwise spin forever)
+			if (0 == count)
+				throw SocketException("Failed to recieve", "Connection closed by peer");
+
+			bytesRead += count;
+		}
+	}
+
+	Socket::NativeHandle Socket::native_handle() const
+	{
+		return this->_sock;
+	}
+
+	bool Socket::has_leftover_data() const
+	{
+		return this->_bufferPos < this->_buffer.size();
+	}
+
+	bool Socket::has_pending_data() const
+	{
+		return has_leftover_data() || underlying_has_data(this->_sock);
+	}
+
+	std::size_t Socket::recv_available()
+	{
+		if (!is_connected())
+			throw SocketException("Failed to recieve", "Socket is not connected");
+
+		// drop consumed leftover data before appending to it
+		this->_buffer.erase(this->_buffer.begin(), this->_buffer.begin() + this->_bufferPos);
+		this->_bufferPos = 0;
+
+		std::size_t total = 0;
+		while (underlying_has_data(this->_sock))
+		{
+			const std::size_t prevSize = this->_buffer.size();
+			this->_buffer.resize(prevSize + RECV_AVAILABLE_CHUNK);
+			const int count = ::recv(
+				this->_sock, (char*)this->_buffer.data() + prevSize, (int)RECV_AVAILABLE_CHUNK, 0
+			);
+			if (count < 0)
+			{
+				const std::string err = SocketUtils::get_last_sock_err();
+				this->_buffer.resize(prevSize);
+				throw SocketException("Failed to recieve", err);
+			}
+			this->_buffer.resize(prevSize + count);
+
+			// readable with nothing to read means peer closed connection
+			if (0 == count)
+				throw SocketException("Failed to recieve", "Connection closed by peer");
+
+			total += count;
+			if (static_cast<std::size_t>(count) < RECV_AVAILABLE_CHUNK)
+				break; // read everything that was available
+		}
+		return total;
+	}
+
+	Socket::BufferedRecv::BufferedRecv(Socket& sock)
+		: _sock(sock), _start(sock._bufferPos)
+	{
+		this->_sock._bufferedOnly = true;
+	}
+
+	Socket::BufferedRecv::~BufferedRecv()
+	{
+		if (!this->_committed)
+			this->_sock._bufferPos = this->_start;
+		this->_sock._bufferedOnly = false;
+
+		if (this->_sock._bufferPos == this->_sock._buffer.size())
+		{
+			this->_sock._buffer.clear();
+			this->_sock._bufferPos = 0;
 		}
 	}
 
+	void Socket::BufferedRecv::commit()
+	{
+		this->_committed = true;
+	}
+
+	void Socket::set_option(int level, int name, int value)
+	{
+#ifdef SENC_WINDOWS
+		const auto ret = ::setsockopt(this->_sock, level, name, reinterpret_cast<const char*>(&value), sizeof(value));
+#else
+		const auto ret = ::setsockopt(this->_sock, level, name, &value, sizeof(value));
+#endif
+		if (ret < 0)
+			throw SocketException("Failed to set socket option", SocketUtils::get_last_sock_err());
+	}
+
+	int Socket::get_option(int level, int name) const
+	{
+		int value = 0;
+		socklen_t len = sizeof(value);
+#ifdef SENC_WINDOWS
+		const auto ret = ::getsockopt(this->_sock, level, name, reinterpret_cast<char*>(&value), &len);
+#else
+		const auto ret = ::getsockopt(this->_sock, level, name, &value, &len);
+#endif
+		if (ret < 0)
+			throw SocketException("Failed to get socket option", SocketUtils::get_last_sock_err());
+		return value;
+	}
+
 	Socket::Socket(Underlying sock, bool isConnected)
 		: _sock(sock), _isConnected(isConnected)
 	{
@@ -202,15 +316,36 @@ namespace senc::utils
 
 	std::size_t Socket::out_leftover_data(void* out, std::size_t maxsize)
 	{
-		if (this->_buffer.empty())
+		const std::size_t outputSize = std::min(this->_buffer.size() - this->_bufferPos, maxsize);
+		if (0 == outputSize)
 			return 0; // no leftover output
 
-		const std::size_t outputSize = std::min(this->_buffer.size(), maxsize);
-		std::memcpy(out, this->_buffer.data(), outputSize);
-		this->_buffer = Buffer(this->_buffer.begin() + outputSize, this->_buffer.end());
+		std::memcpy(out, this->_buffer.data() + this->_bufferPos, outputSize);
+		this->_bufferPos += outputSize;
+
+		// consumed data is kept in a buffered-only scope, as it might be restored
+		if (!this->_bufferedOnly && this->_bufferPos == this->_buffer.size())
+		{
+			this->_buffer.clear();
+			this->_bufferPos = 0;
+		}
 		return outputSize;
 	}
 
+	void Socket::unread_leftover_data(const void* data, std::size_t size)
+	{
+		// if data was outputted from leftover data, it is still held right before current offset
+		if (this->_bufferPos >= size)
+		{
+			this->_bufferPos -= size;
+			return;
+		}
+
+		// otherwise, it was (partly) recieved from underlying socket after leftover data ran out
+		const byte* bytes = static_cast<const byte*>(data);
+		this->_buffer.insert(this->_buffer.begin() + this->_bufferPos, bytes, bytes + size);
+	}
+
 #ifdef SENC_WINDOWS
 	bool Socket::underlying_has_data(Underlying sock)
 	{
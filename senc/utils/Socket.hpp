@@ -12,6 +12,7 @@
 #ifdef SENC_WINDOWS
 #include "../utils/winapi_patch.hpp"
 #else
+#include <netinet/tcp.h>
 #include <sys/select.h>
 #include <sys/time.h>
 #include <unistd.h>
@@ -60,6 +61,34 @@ namespace senc::utils
 		Self& operator=(Self&&) = default;
 	};
 
+	/**
+	 * @class senc::utils::SocketWouldBlockException
+	 * @brief Type of exceptions thrown when a buffered-only recv needs more data than was received
+	 *		  so far (see `senc::utils::Socket::BufferedRecv`).
+	 */
+	class SocketWouldBlockException : public SocketException
+	{
+	public:
+		using Self = SocketWouldBlockException;
+		using Base = SocketException;
+
+		SocketWouldBlockException(const std::string& msg) : Base(msg) { }
+
+		SocketWouldBlockException(std::string&& msg) : Base(std::move(msg)) { }
+
+		SocketWouldBlockException(const std::string& msg, const std::string& info) : Base(msg, info) { }
+
+		SocketWouldBlockException(std::string&& msg, const std::string& info) : Base(std::move(msg), info) { }
+
+		SocketWouldBlockException(const Self&) = default;
+
+		Self& operator=(const Self&) = default;
+
+		SocketWouldBlockException(Self&&) = default;
+
+		Self& operator=(Self&&) = default;
+	};
+
 	/**
 	 * @class senc::utils::SocketUtils
 	 * @brief Contains utility functions for sockets.
@@ -323,12 +352,105 @@ namespace senc::utils
 				  std::size_t chunkSize = 32>
 		void recv_connected_values(Tpl& values);
 
+#ifdef SENC_WINDOWS
+		using NativeHandle = SOCKET;
+#else
+		using NativeHandle = int;
+#endif
+
+		/**
+		 * @brief Gets underlying library's socket handle (e.g. for registering in a poller).
+		 * @return Underlying socket handle.
+		 */
+		NativeHandle native_handle() const;
+
+		/**
+		 * @brief Checks if socket holds leftover data from previous recvs.
+		 * @return `true` if socket has leftover data, otherwise `false`.
+		 * @note Leftover data is not visible to pollers of the underlying socket.
+		 */
+		bool has_leftover_data() const;
+
+		/**
+		 * @brief Checks, without blocking, if there is data to recv (leftover data, or data pending
+		 *		  on the underlying socket).
+		 * @return `true` if a recv would not block, otherwise `false`.
+		 * @throw senc::utils::SocketException On failure.
+		 * @note Also `true` if connection was closed by peer (so that a recv would fail immediately).
+		 */
+		bool has_pending_data() const;
+
+		/**
+		 * @brief Reads all data currently available on (a connected) socket into leftover data,
+		 *		  without blocking.
+		 * @return Amount of bytes read (zero if no data was available).
+		 * @throw senc::utils::SocketException On failure, or if connection was closed by peer.
+		 * @note Not to be called within a `BufferedRecv` scope.
+		 */
+		std::size_t recv_available();
+
+		/**
+		 * @class senc::utils::Socket::BufferedRecv
+		 * @brief Scope in which recvs of a socket are served from its leftover data only (see
+		 *		  `recv_available`), so they never block: a recv needing more data throws
+		 *		  `senc::utils::SocketWouldBlockException` instead. Unless committed, data consumed
+		 *		  in scope is restored on scope exit, so that an incomplete message can be read again
+		 *		  once the rest of it arrives.
+		 */
+		class BufferedRecv
+		{
+		public:
+			using Self = BufferedRecv;
+
+			/**
+			 * @brief Begins serving recvs of a socket from its leftover data only.
+			 * @param sock Socket to recv through.
+			 */
+			explicit BufferedRecv(Socket& sock);
+
+			BufferedRecv(const Self&) = delete;
+
+			Self& operator=(const Self&) = delete;
+
+			/**
+			 * @brief Ends scope, restoring data consumed in it unless committed.
+			 */
+			~BufferedRecv();
+
+			/**
+			 * @brief Keeps data consumed in scope consumed (e.g. once a whole message was read).
+			 */
+			void commit();
+
+		private:
+			Socket& _sock;
+			std::size_t _start;
+			bool _committed = false;
+		};
+
+		/**
+		 * @brief Sets an integer socket option (see `setsockopt`).
+		 * @param level Protocol level of option (e.g. `SOL_SOCKET`).
+		 * @param name Option name (e.g. `SO_REUSEADDR`).
+		 * @param value Option value.
+		 * @throw senc::utils::SocketException On failure.
+		 */
+		void set_option(int level, int name, int value);
+
+		/**
+		 * @brief Gets an integer socket option (see `getsockopt`).
+		 * @param level Protocol level of option (e.g. `SOL_SOCKET`).
+		 * @param name Option name (e.g. `SO_REUSEADDR`).
+		 * @return Option value.
+		 * @throw senc::utils::SocketException On failure.
+		 */
+		int get_option(int level, int name) const;
+
 	protected:
+		using Underlying = NativeHandle;
 #ifdef SENC_WINDOWS
-		using Underlying = SOCKET;
 		static constexpr Underlying UNDERLYING_NO_SOCK = INVALID_SOCKET;
 #else
-		using Underlying = int;
 		static constexpr Underlying UNDERLYING_NO_SOCK = -1;
 #endif
 
@@ -364,10 +486,22 @@ namespace senc::utils
 		 */
 		std::size_t out_leftover_data(void* out, std::size_t maxsize);
 
+		/**
+		 * @brief Returns data outputted by the last recv to the front of leftover data.
+		 * @param data Data outputted by the last recv (its last `size` bytes).
+		 * @param size Amount of bytes to return.
+		 */
+		void unread_leftover_data(const void* data, std::size_t size);
+
 		static bool underlying_has_data(Underlying sock);
 
 	private:
+		// maximum amount of bytes read by a single recv of `recv_available`
+		static constexpr std::size_t RECV_AVAILABLE_CHUNK = 64 * 1024;
+
 		Buffer _buffer; // for leftover data
+		std::size_t _bufferPos = 0; // leftover data starts at this offset of `_buffer`
+		bool _bufferedOnly = false; // if set, recvs are served from leftover data only
 	};
 
 	/**
@@ -412,6 +546,13 @@ namespace senc::utils
 		 */
 		void bind(const IP& addr, Port port);
 
+		/**
+		 * @brief Gets local address socket is bound to.
+		 * @return IP address and port socket is bound to (the assigned port, if bound to port 0).
+		 * @throw senc::utils::SocketException On failure.
+		 */
+		std::tuple<IP, Port> local_address() const;
+
 	protected:
 		using Underlying = Base::Underlying;
 
@@ -470,6 +611,36 @@ namespace senc::utils
 		 */
 		Self& operator=(Self&&) = default;
 
+#ifdef SO_REUSEPORT
+		static constexpr bool REUSE_PORT_SUPPORTED = true;
+#else
+		static constexpr bool REUSE_PORT_SUPPORTED = false;
+#endif
+
+		/**
+		 * @brief Sets whether socket may bind to an address in `TIME_WAIT` (`SO_REUSEADDR`).
+		 * @param enable Whether to enable option.
+		 * @throw senc::utils::SocketException On failure.
+		 * @note Should be called before `bind`.
+		 */
+		void set_reuse_address(bool enable);
+
+		/**
+		 * @brief Sets whether several sockets may bind and listen to the same port (`SO_REUSEPORT`).
+		 *		  Incoming connections are then balanced between listening sockets by the kernel.
+		 * @param enable Whether to enable option.
+		 * @throw senc::utils::SocketException On failure, or if not supported (see `REUSE_PORT_SUPPORTED`).
+		 * @note Should be called before `bind`, on each of the sockets sharing the port.
+		 */
+		void set_reuse_port(bool enable);
+
+		/**
+		 * @brief Sets whether to disable Nagle's algorithm, sending small writes at once (`TCP_NODELAY`).
+		 * @param enable Whether to enable option.
+		 * @throw senc::utils::SocketException On failure.
+		 */
+		void set_no_delay(bool enable);
+
 		/**
 		 * @brief Begins listening for clients.
 		 * @throw senc::utils::SocketException On failure.
@@ -122,7 +122,6 @@ namespace senc::utils
 		constexpr C nullchr = static_cast<C>(0);
 		C chunk[chunkSize] = {0};
 		const C* pNullChrInChunk = nullptr;
-		const C* chunkEnd = chunk + chunkSize;
 		std::size_t bytesRead = 0;
 		bool lastChunk = false;
 		Str res{};
@@ -132,18 +131,29 @@ namespace senc::utils
 		{
 			// get current chunk
 			bytesRead = recv_connected_into(chunk, chunkSize * sizeof(C));
+			if (0 == bytesRead)
+				throw SocketException("Failed to recieve", "Connection closed by peer");
 
-			// look for null termination
-			pNullChrInChunk = std::find<const C*>(chunk, chunkEnd, nullchr);
+			// look for null termination (only in chars fully read)
+			const C* readEnd = chunk + bytesRead / sizeof(C);
+			pNullChrInChunk = std::find<const C*>(chunk, readEnd, nullchr);
+
+			// if not found, complete a partially read char and look in it too
+			if (const std::size_t partial = bytesRead % sizeof(C); readEnd == pNullChrInChunk && partial > 0)
+			{
+				recv_connected_exact_into(reinterpret_cast<byte*>(chunk) + bytesRead, sizeof(C) - partial);
+				bytesRead += sizeof(C) - partial;
+				pNullChrInChunk = std::find<const C*>(chunk, ++readEnd, nullchr);
+			}
 
 			// if has null termination, this is the last chunk
-			lastChunk = (chunkEnd != pNullChrInChunk);
+			lastChunk = (readEnd != pNullChrInChunk);
 
 			// if last chunk, append until null-terination; else, append all
 			if (lastChunk)
 				res.append(static_cast<const C*>(chunk), pNullChrInChunk);
 			else
-				res.append(chunk, chunkSize);
+				res.append(static_cast<const C*>(chunk), readEnd);
 		}
 
 		// end of read data in last chunk
@@ -151,11 +161,9 @@ namespace senc::utils
 			reinterpret_cast<const byte*>(static_cast<const C*>(chunk)) + bytesRead;
 
 		// res now has string, with `pNullChrInChunk` pointing to null termination
-		// extra bytes are after null termination
+		// extra bytes are after null termination, and belong to next recvs
 		const byte* extraBytesStart = reinterpret_cast<const byte*>(pNullChrInChunk + 1);
-
-		// append extra bytes to `_buffer`:
-		this->_buffer.insert(this->_buffer.end(), extraBytesStart, dataEnd);
+		unread_leftover_data(extraBytesStart, dataEnd - extraBytesStart);
 
 		// if required endianess is not same as native, reverse each elem
 		if constexpr (std::endian::native != endianess)
@@ -261,6 +269,16 @@ namespace senc::utils
 			throw SocketException("Failed to bind", SocketUtils::get_last_sock_err());
 	}
 
+	template <IPType IP>
+	inline std::tuple<IP, Port> ConnectableSocket<IP>::local_address() const
+	{
+		typename IP::UnderlyingSockAddr sa{};
+		socklen_t saLen = sizeof(sa);
+		if (::getsockname(this->_sock, (struct sockaddr*)&sa, &saLen) < 0)
+			throw SocketException("Failed to get local address", SocketUtils::get_last_sock_err());
+		return IP::from_underlying_sock_addr(sa);
+	}
+
 	template <IPType IP>
 	inline ConnectableSocket<IP>::ConnectableSocket(Underlying sock, bool isConnected)
 		: Base(sock, isConnected) { }
@@ -276,6 +294,29 @@ namespace senc::utils
 		this->connect(addr, port);
 	}
 
+	template <IPType IP>
+	inline void TcpSocket<IP>::set_reuse_address(bool enable)
+	{
+		this->set_option(SOL_SOCKET, SO_REUSEADDR, enable);
+	}
+
+	template <IPType IP>
+	inline void TcpSocket<IP>::set_reuse_port(bool enable)
+	{
+#ifdef SO_REUSEPORT
+		this->set_option(SOL_SOCKET, SO_REUSEPORT, enable);
+#else
+		(void)enable;
+		throw SocketException("Failed to set socket option", "SO_REUSEPORT is not supported on this platform");
+#endif
+	}
+
+	template <IPType IP>
+	inline void TcpSocket<IP>::set_no_delay(bool enable)
+	{
+		this->set_option(IPPROTO_TCP, TCP_NODELAY, enable);
+	}
+
 	template <IPType IP>
 	inline void TcpSocket<IP>::listen()
 	{
@@ -23,8 +23,16 @@ namespace senc::utils::enc
 
 	AES1L::Key ECHKDF1L::operator()(const ECGroup& elem) const
 	{
-		const auto& num = elem.x();
+		return derive(elem.x());
+	}
 
+	AES1L::Key ECHKDF1L::operator()(const P256Group& elem) const
+	{
+		return derive(elem.x());
+	}
+
+	AES1L::Key ECHKDF1L::derive(const BigInt& num) const
+	{
 		const std::size_t size = num.MinEncodedSize();
 
 		// make SIZE-byte input keying material for HKDF out of num:
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "../P256Group.hpp"
 #include "../ECGroup.hpp"
 #include "AES1L.hpp"
 
@@ -53,12 +54,27 @@ namespace senc::utils::enc
 		 */
 		AES1L::Key operator()(const ECGroup& elem) const;
 
+		/**
+		 * @brief Derives an AES1L key from a P256Group element.
+		 * @note Derives the same key as for the equivalent ECGroup element.
+		 * @param elem P256Group element.
+		 * @return Derives AES1L key.
+		 */
+		AES1L::Key operator()(const P256Group& elem) const;
+
 	private:
 		std::size_t _ikmSize;
 		Buffer _salt;
 
 		CryptoPP::HKDF<CryptoPP::SHA256> _hkdf;
 
+		/**
+		 * @brief Derives an AES1L key from X value of a group element.
+		 * @param num X value of group element.
+		 * @return Derives AES1L key.
+		 */
+		AES1L::Key derive(const BigInt& num) const;
+
 		static constexpr std::size_t DEFAULT_IKM_SIZE = 64; // default ikmSize is 64 (64-byte IKM)
 		static constexpr std::initializer_list<byte> DEFAULT_SALT = { 4, 3, 5 }; // default salt value
 	};
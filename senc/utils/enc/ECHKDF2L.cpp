@@ -23,9 +23,16 @@ namespace senc::utils::enc
 
 	AES1L::Key senc::utils::enc::ECHKDF2L::operator()(const ECGroup& a, const ECGroup& b) const
 	{
-		const auto& aNum = a.x();
-		const auto& bNum = b.x();
+		return derive(a.x(), b.x());
+	}
 
+	AES1L::Key ECHKDF2L::operator()(const P256Group& a, const P256Group& b) const
+	{
+		return derive(a.x(), b.x());
+	}
+
+	AES1L::Key ECHKDF2L::derive(const BigInt& aNum, const BigInt& bNum) const
+	{
 		const std::size_t aSize = aNum.MinEncodedSize();
 		const std::size_t bSize = bNum.MinEncodedSize();
 
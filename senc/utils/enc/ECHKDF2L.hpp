@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "../P256Group.hpp"
 #include "../ECGroup.hpp"
 #include "AES1L.hpp"
 
@@ -54,12 +55,29 @@ namespace senc::utils::enc
 		 */
 		AES1L::Key operator()(const ECGroup& a, const ECGroup& b) const;
 
+		/**
+		 * @brief Derives an AES1L key from two P256Group elements.
+		 * @note Derives the same key as for the equivalent ECGroup elements.
+		 * @param a First P256Group element.
+		 * @param b Second P256Group element.
+		 * @return Derives AES1L key.
+		 */
+		AES1L::Key operator()(const P256Group& a, const P256Group& b) const;
+
 	private:
 		std::size_t _ikmEachSize;
 		Buffer _salt;
 
 		CryptoPP::HKDF<CryptoPP::SHA256> _hkdf;
 
+		/**
+		 * @brief Derives an AES1L key from X values of two group elements.
+		 * @param aNum X value of first group element.
+		 * @param bNum X value of second group element.
+		 * @return Derives AES1L key.
+		 */
+		AES1L::Key derive(const BigInt& aNum, const BigInt& bNum) const;
+
 		static constexpr std::size_t DEFAULT_IKM_EACH_SIZE = 32; // default ikmEachSize is 32 (resulting 64-byte IKM)
 		static constexpr std::initializer_list<byte> DEFAULT_SALT = { 4, 3, 5 }; // default salt value
 	};
@@ -8,9 +8,13 @@
 
 #pragma once
 
+#include <vector>
 #include <tuple>
+#include <span>
 
+#include "../LruCache.hpp"
 #include "../concepts.hpp"
+#include "../bytes.hpp"
 #include "../Random.hpp"
 #include "../Group.hpp"
 #include "../math.hpp"
@@ -35,6 +39,12 @@ namespace senc::utils::enc
 		using PubKey = G;
 		using PrivKey = BigInt;
 
+		// public keys whose precomputation tables are held (for `encrypt_batch`)
+		static constexpr std::size_t TABLE_CACHE_CAPACITY = 64;
+
+		// minimal batch size for which `encrypt_batch` builds tables of public keys not held already
+		static constexpr std::size_t TABLE_MIN_BATCH = 8;
+
 		/**
 		 * @brief Constructs an instance with default-constructed `S` and `KDF` instances.
 		 * @param symmetricSchema `S` instance (symmetric schema)>
@@ -82,6 +92,21 @@ namespace senc::utils::enc
 		 */
 		Ciphertext encrypt(const Plaintext& plaintext, const PubKey& pubKey1, const PubKey& pubKey2);
 
+		/**
+		 * @brief Encrypts multiple plaintexts under the same public keys.
+		 * @note Equivalent to calling `encrypt` on each plaintext, but exponentiations of public keys
+		 *       use precomputation tables (built once per public key for batches of at least
+		 *       `TABLE_MIN_BATCH`, and cached if `G` is byte-convertible).
+		 * @note Runs on calling thread only; callers with several batches may run them in parallel
+		 *       (on separate instances, as instances are not thread-safe).
+		 * @param plaintexts Plaintexts to encrypt.
+		 * @param pubKey1 Public key for first encryption layer.
+		 * @param pubKey2 Public key for second encryption layer.
+		 * @return Encrypted plaintexts (ciphertexts), matching `plaintexts` by index.
+		 */
+		std::vector<Ciphertext> encrypt_batch(std::span<const Plaintext> plaintexts,
+											  const PubKey& pubKey1, const PubKey& pubKey2);
+
 		/**
 		 * @brief Decrypts a given ciphertext.
 		 * @param ciphertext Ciphertext to decrypt.
@@ -91,10 +116,38 @@ namespace senc::utils::enc
 		 */
 		Plaintext decrypt(const Ciphertext& ciphertext, const PrivKey& privKey1, const PrivKey& privKey2);
 
+		/**
+		 * @brief Gets lookup statistics of public key tables cache (used by `encrypt_batch`).
+		 * @return Cache statistics.
+		 */
+		static LruCacheStats table_cache_stats();
+
+		/**
+		 * @brief Clears public key tables cache (used by `encrypt_batch`) and its statistics.
+		 */
+		static void clear_table_cache();
+
 	private:
+		using PubKeyTable = FixedBaseExp<G, BigInt>;
+		using TableCache = LruCache<Buffer, PubKeyTable>;
+
+
 		Distribution<BigInt> _underOrderDist;
 		S _symmetricSchema;
 		KDF _kdf;
+
+		/**
+		 * @brief Gets precomputation table of a public key (from cache, if held).
+		 * @param pubKey Public key.
+		 * @param batchSize Amount of exponentiations table would be used for.
+		 * @return Table of `pubKey`, or `nullptr` if batch is too small to build one (and none is held).
+		 */
+		static std::shared_ptr<const PubKeyTable> pub_key_table(const PubKey& pubKey, std::size_t batchSize);
+
+		/**
+		 * @brief Gets cache of public key tables (shared by all instances).
+		 */
+		static TableCache& table_cache();
 	};
 }
 
@@ -8,6 +8,7 @@
 
 #include "HybridElGamal2L.hpp"
 
+#include <algorithm>
 #include <utility>
 #include "../math.hpp"
 
@@ -38,7 +39,7 @@ namespace senc::utils::enc
 		HybridElGamal2L<G, S, KDF>::keygen()
 	{
 		PrivKey privKey = _underOrderDist();
-		PubKey pubKey = senc::utils::pow(G::generator(), privKey);
+		PubKey pubKey = senc::utils::generator_pow<G>(privKey);
 		return { pubKey, privKey };
 	}
 
@@ -48,8 +49,8 @@ namespace senc::utils::enc
 		auto r1 = _underOrderDist();
 		auto r2 = _underOrderDist();
 
-		auto c1 = senc::utils::pow(G::generator(), r1);
-		auto c2 = senc::utils::pow(G::generator(), r2);
+		auto c1 = senc::utils::generator_pow<G>(r1);
+		auto c2 = senc::utils::generator_pow<G>(r2);
 
 		auto z1 = senc::utils::pow(pubKey1, r1);
 		auto z2 = senc::utils::pow(pubKey2, r2);
@@ -61,6 +62,34 @@ namespace senc::utils::enc
 		return { c1, c2, c3 };
 	}
 
+	template <Group G, Symmetric1L S, ConstCallable<Key<S>, G, G> KDF>
+	inline std::vector<typename HybridElGamal2L<G, S, KDF>::Ciphertext> HybridElGamal2L<G, S, KDF>::encrypt_batch(
+		std::span<const Plaintext> plaintexts, const PubKey& pubKey1, const PubKey& pubKey2)
+	{
+		const auto table1 = pub_key_table(pubKey1, plaintexts.size());
+		const auto table2 = pub_key_table(pubKey2, plaintexts.size());
+
+		// runs on calling thread only (callers with several batches may run them on threads of their own)
+		std::vector<Ciphertext> res;
+		res.reserve(plaintexts.size());
+		for (const auto& plaintext : plaintexts)
+		{
+			auto r1 = _underOrderDist();
+			auto r2 = _underOrderDist();
+
+			auto c1 = senc::utils::generator_pow<G>(r1);
+			auto c2 = senc::utils::generator_pow<G>(r2);
+
+			auto k = this->_kdf(
+				table1 ? table1->pow(r1) : senc::utils::pow(pubKey1, r1),
+				table2 ? table2->pow(r2) : senc::utils::pow(pubKey2, r2)
+			);
+
+			res.emplace_back(std::move(c1), std::move(c2), this->_symmetricSchema.encrypt(plaintext, k));
+		}
+		return res;
+	}
+
 	template <Group G, Symmetric1L S, ConstCallable<Key<S>, G, G> KDF>
 	inline HybridElGamal2L<G, S, KDF>::Plaintext HybridElGamal2L<G, S, KDF>::decrypt(const Ciphertext& ciphertext, const PrivKey& privKey1, const PrivKey& privKey2)
 	{
@@ -73,4 +102,42 @@ namespace senc::utils::enc
 
 		return this->_symmetricSchema.decrypt(c3, k);
 	}
+
+	template <Group G, Symmetric1L S, ConstCallable<Key<S>, G, G> KDF>
+	inline LruCacheStats HybridElGamal2L<G, S, KDF>::table_cache_stats()
+	{
+		return table_cache().stats();
+	}
+
+	template <Group G, Symmetric1L S, ConstCallable<Key<S>, G, G> KDF>
+	inline void HybridElGamal2L<G, S, KDF>::clear_table_cache()
+	{
+		table_cache().clear();
+		table_cache().reset_stats();
+	}
+
+	template <Group G, Symmetric1L S, ConstCallable<Key<S>, G, G> KDF>
+	inline std::shared_ptr<const typename HybridElGamal2L<G, S, KDF>::PubKeyTable>
+		HybridElGamal2L<G, S, KDF>::pub_key_table(const PubKey& pubKey, std::size_t batchSize)
+	{
+		if constexpr (HasToBytes<G>)
+		{
+			// small batches use a held table, but do not pay for building one
+			const Buffer key = pubKey.to_bytes();
+			if (batchSize < TABLE_MIN_BATCH)
+				return table_cache().get(key);
+			return table_cache().get_or_compute(key, [&pubKey]() { return PubKeyTable(pubKey); });
+		}
+		else if (batchSize < TABLE_MIN_BATCH)
+			return nullptr;
+		else
+			return std::make_shared<const PubKeyTable>(pubKey);
+	}
+
+	template <Group G, Symmetric1L S, ConstCallable<Key<S>, G, G> KDF>
+	inline typename HybridElGamal2L<G, S, KDF>::TableCache& HybridElGamal2L<G, S, KDF>::table_cache()
+	{
+		static TableCache cache(TABLE_CACHE_CAPACITY);
+		return cache;
+	}
 }
@@ -0,0 +1,125 @@
+/*********************************************************************
+ * \file   KeyPool.hpp
+ * \brief  Header of `enc::KeyPool` class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <concepts>
+#include <optional>
+#include <cstdint>
+#include <utility>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace senc::utils::enc
+{
+	/**
+	 * @concept senc::utils::enc::KeyGenerator
+	 * @brief Looks for a typename generating key-pairs via `keygen()` (e.g. any asymmetric schema).
+	 * @tparam Self Examined typename.
+	 */
+	template <typename Self>
+	concept KeyGenerator = std::default_initializable<Self> && requires(Self self)
+	{
+		{ self.keygen() } -> std::movable;
+	};
+
+	/**
+	 * @class senc::utils::enc::KeyPool
+	 * @brief Pool of ready key-pairs, refilled by a low-priority background thread.
+	 * @note Lets callers needing fresh key-pairs (e.g. handshakes, userset creation) skip the
+	 *       exponentiation of `keygen`, as long as the pool keeps up with them.
+	 * @tparam G Key-pair generator (refill thread holds its own default-constructed instance).
+	 */
+	template <KeyGenerator G>
+	class KeyPool
+	{
+	public:
+		using Self = KeyPool<G>;
+		using KeyPair = decltype(std::declval<G&>().keygen());
+
+		static constexpr std::size_t DEFAULT_DEPTH = 32;
+
+		/**
+		 * @struct senc::utils::enc::KeyPool::Stats
+		 * @brief Snapshot of pool counters.
+		 */
+		struct Stats
+		{
+			std::uint64_t hits;	   // pairs taken ready from pool
+			std::uint64_t misses;  // pairs generated on taking thread, as pool was empty
+			std::size_t available; // pairs currently ready
+			std::size_t depth;	   // maximum amount of ready pairs
+		};
+
+		/**
+		 * @brief Constructs a key pool and starts its refill thread.
+		 * @param depth Maximum amount of ready pairs (zero to generate all pairs on taking threads).
+		 */
+		explicit KeyPool(std::size_t depth = DEFAULT_DEPTH);
+
+		/**
+		 * @brief Destructor of key pool, stops refill thread.
+		 */
+		~KeyPool();
+
+		KeyPool(const Self&) = delete;
+
+		Self& operator=(const Self&) = delete;
+
+		/**
+		 * @brief Takes a key-pair, generating it on calling thread if none are ready.
+		 * @param gen Generator to generate key-pair with, if pool is empty.
+		 * @return Key-pair (never handed out twice).
+		 */
+		KeyPair take(G& gen);
+
+		/**
+		 * @brief Gets a snapshot of pool counters.
+		 */
+		Stats stats() const;
+
+		/**
+		 * @brief Waits until pool holds a given amount of ready pairs (or until timeout).
+		 * @param count Amount of ready pairs to wait for.
+		 * @param timeout Maximum time to wait.
+		 * @return `true` if pool holds at least `count` ready pairs, otherwise `false`.
+		 */
+		bool wait_available(std::size_t count, std::chrono::milliseconds timeout) const;
+
+	private:
+		const std::size_t _depth;
+
+		// ready pairs (uses mtx)
+		std::deque<KeyPair> _pairs;
+		bool _isRunning = true;
+		mutable std::mutex _mtx;
+		std::condition_variable _cvRefill;		   // notified when a pair is taken, or on stop
+		mutable std::condition_variable _cvFilled; // notified when a pair is made ready
+
+		std::atomic<std::uint64_t> _hits = 0;
+		std::atomic<std::uint64_t> _misses = 0;
+
+		std::optional<std::jthread> _refillThread;
+
+		/**
+		 * @brief Keeps pool filled up to its depth, until stopped.
+		 */
+		void refill_loop();
+
+		/**
+		 * @brief Lowers scheduling priority of calling thread (best effort).
+		 */
+		static void lower_thread_priority();
+	};
+}
+
+#include "KeyPool_impl.hpp"
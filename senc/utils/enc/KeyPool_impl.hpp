@@ -0,0 +1,113 @@
+/*********************************************************************
+ * \file   KeyPool_impl.hpp
+ * \brief  Implementation of `enc::KeyPool` class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "KeyPool.hpp"
+
+#include "../winapi_patch.hpp"
+#ifndef SENC_WINDOWS
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace senc::utils::enc
+{
+	template <KeyGenerator G>
+	inline KeyPool<G>::KeyPool(std::size_t depth)
+		: _depth(depth)
+	{
+		if (_depth > 0)
+			_refillThread.emplace(&Self::refill_loop, this);
+	}
+
+	template <KeyGenerator G>
+	inline KeyPool<G>::~KeyPool()
+	{
+		{
+			const std::lock_guard<std::mutex> lock(_mtx);
+			_isRunning = false;
+		}
+		_cvRefill.notify_all();
+		_refillThread.reset(); // joins refill thread
+	}
+
+	template <KeyGenerator G>
+	inline typename KeyPool<G>::KeyPair KeyPool<G>::take(G& gen)
+	{
+		{
+			const std::lock_guard<std::mutex> lock(_mtx);
+			if (!_pairs.empty())
+			{
+				KeyPair res = std::move(_pairs.front());
+				_pairs.pop_front();
+				++_hits;
+				_cvRefill.notify_one();
+				return res;
+			}
+		}
+
+		// pool drained (e.g. burst of handshakes or usersets) - generate here, refill thread catches up
+		++_misses;
+		return gen.keygen();
+	}
+
+	template <KeyGenerator G>
+	inline typename KeyPool<G>::Stats KeyPool<G>::stats() const
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		return Stats{
+			.hits = _hits,
+			.misses = _misses,
+			.available = _pairs.size(),
+			.depth = _depth
+		};
+	}
+
+	template <KeyGenerator G>
+	inline bool KeyPool<G>::wait_available(std::size_t count, std::chrono::milliseconds timeout) const
+	{
+		std::unique_lock<std::mutex> lock(_mtx);
+		return _cvFilled.wait_for(lock, timeout, [this, count]() { return _pairs.size() >= count; });
+	}
+
+	template <KeyGenerator G>
+	inline void KeyPool<G>::refill_loop()
+	{
+		lower_thread_priority(); // only uses idle time, never competing with request handling
+		G gen; // generators need not be thread-safe, so refill thread has its own
+
+		std::unique_lock<std::mutex> lock(_mtx);
+		while (true)
+		{
+			_cvRefill.wait(lock, [this]() { return !_isRunning || _pairs.size() < _depth; });
+			if (!_isRunning)
+				return;
+
+			// generate without holding lock, so takers are never blocked by it
+			lock.unlock();
+			KeyPair pair = gen.keygen();
+			lock.lock();
+
+			if (_pairs.size() < _depth)
+			{
+				_pairs.push_back(std::move(pair));
+				_cvFilled.notify_all();
+			}
+		}
+	}
+
+	template <KeyGenerator G>
+	inline void KeyPool<G>::lower_thread_priority()
+	{
+#ifdef SENC_WINDOWS
+		SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(SCHED_IDLE)
+		const sched_param param{};
+		pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+	}
+}
@@ -38,7 +38,7 @@ namespace senc::utils
 	std::tuple<IPv4::Self, Port> IPv4::from_underlying_sock_addr(
 		const UnderlyingSockAddr& underlyingSockAddr)
 	{
-		return { Self(underlyingSockAddr.sin_addr), underlyingSockAddr.sin_port };
+		return { Self(underlyingSockAddr.sin_addr), ntohs(underlyingSockAddr.sin_port) };
 	}
 
 	IPv4::IPv4(const char* addr) : Self(std::string(addr)) { }
@@ -91,7 +91,7 @@ namespace senc::utils
 	std::tuple<IPv6::Self, Port> IPv6::from_underlying_sock_addr(
 		const UnderlyingSockAddr& underlyingSockAddr)
 	{
-		return { Self(underlyingSockAddr.sin6_addr), underlyingSockAddr.sin6_port };
+		return { Self(underlyingSockAddr.sin6_addr), ntohs(underlyingSockAddr.sin6_port) };
 	}
 
 	IPv6::IPv6(const char* addr) : Self(std::string(addr)) { }
@@ -19,6 +19,7 @@
 
 #include <concepts>
 #include <optional>
+#include <tuple>
 #include <variant>
 
 #include "Exception.hpp"
@@ -11,6 +11,7 @@
 #include <functional>
 #include <ostream>
 #include <vector>
+#include <span>
 #include "concepts.hpp"
 #include "math.hpp"
 
@@ -160,6 +161,29 @@ namespace senc::utils
 		 */
 		O operator()(const I& x) const;
 
+		/**
+		 * @brief Calls polynomial function on multiple inputs (see `eval_many`).
+		 * @param xs Inputs to call polynomial function on.
+		 * @return Polynomial results, where the `j`th is of `xs[j]`.
+		 */
+		std::vector<O> eval(std::span<const I> xs) const
+		requires std::constructible_from<C, const I&> && Multiplicable<C> && Addable<C> &&
+			std::convertible_to<C, O>;
+
+		/**
+		 * @brief Calls several polynomial functions on the same inputs, in one pass over inputs.
+		 * @note Evaluates by Horner's rule in coefficient type, so no input powers are computed;
+		 *       each input is converted once and shared by all polynomials. Runs on calling thread
+		 *       (callers may already be on a worker pool). A polynomial with no coefficients
+		 *       yields default-constructed outputs.
+		 * @param polys Polynomials to call.
+		 * @param xs Inputs to call polynomial functions on.
+		 * @return Polynomial results, where `res[p][j]` is `(*polys[p])(xs[j])`.
+		 */
+		static std::vector<std::vector<O>> eval_many(std::span<const Self* const> polys, std::span<const I> xs)
+		requires std::constructible_from<C, const I&> && Multiplicable<C> && Addable<C> &&
+			std::convertible_to<C, O>;
+
 	private:
 		std::vector<C> _coeffs;
 
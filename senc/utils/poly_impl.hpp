@@ -102,6 +102,42 @@ namespace senc::utils
 		return res;
 	}
 
+	template <PolyInput I, PolyOutput O, PolyCoeff<I, O> C>
+	inline std::vector<O> Poly<I, O, C>::eval(std::span<const I> xs) const
+	requires std::constructible_from<C, const I&> && Multiplicable<C> && Addable<C> &&
+		std::convertible_to<C, O>
+	{
+		const Self* self = this;
+		return std::move(eval_many(std::span<const Self* const>(&self, 1), xs).front());
+	}
+
+	template <PolyInput I, PolyOutput O, PolyCoeff<I, O> C>
+	inline std::vector<std::vector<O>> Poly<I, O, C>::eval_many(
+		std::span<const Self* const> polys, std::span<const I> xs)
+	requires std::constructible_from<C, const I&> && Multiplicable<C> && Addable<C> &&
+		std::convertible_to<C, O>
+	{
+		std::vector<std::vector<O>> res(polys.size());
+		for (auto& outputs : res)
+			outputs.resize(xs.size());
+
+		for (std::size_t j = 0; j < xs.size(); ++j)
+		{
+			const C x(xs[j]);
+			for (std::size_t p = 0; p < polys.size(); ++p)
+			{
+				const auto& coeffs = polys[p]->_coeffs;
+				if (coeffs.empty())
+					continue; // no coefficients, output stays default-constructed
+				C acc = coeffs.back();
+				for (std::size_t i = coeffs.size() - 1; i-- > 0; )
+					acc = acc * x + coeffs[i];
+				res[p][j] = std::move(acc);
+			}
+		}
+		return res;
+	}
+
 	template <PolyInput I, PolyOutput O, PolyCoeff<I, O> C>
 	inline void Poly<I, O, C>::sample_missing_coeffs(PolyDegree degree, std::function<C()> coeffSampler)
 	{
@@ -0,0 +1,133 @@
+/*********************************************************************
+ * \file   ConnectionPool.hpp
+ * \brief  Header of sqlite ConnectionPool class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include "Database.hpp"
+#include <condition_variable>
+#include <type_traits>
+#include <functional>
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <mutex>
+
+namespace senc::utils::sqlite
+{
+	/**
+	 * @struct senc::utils::sqlite::ConnectionPoolStats
+	 * @brief Snapshot of connection pool counters.
+	 */
+	struct ConnectionPoolStats
+	{
+		std::size_t readers;		 // amount of read-only connections
+		std::size_t readers_in_use;	 // read-only connections currently lent
+		std::uint64_t reads;		 // finished and running reads
+		std::uint64_t read_waits;	 // reads that had to wait for a free read-only connection
+		std::uint64_t writes;		 // finished and running writes
+	};
+
+	/**
+	 * @class senc::utils::sqlite::ConnectionPool
+	 * @brief Connections to an sqlite database in WAL mode: a single writer connection, and a pool
+	 *        of read-only connections, so that reads run in parallel (with each other and with
+	 *        the writer).
+	 * @note Connections use `synchronous = NORMAL`, so a power loss may lose the last committed
+	 *       writes (but never corrupts the database).
+	 * @tparam Schema Database schema.
+	 */
+	template <schemas::SomeDB Schema>
+	class ConnectionPool
+	{
+	public:
+		using Self = ConnectionPool<Schema>;
+		using Connection = Database<Schema>;
+
+		// page cache size of each connection, in KiB
+		static constexpr std::size_t CACHE_SIZE_KIB = 8192;
+
+		// time a connection waits on a locked database before failing
+		static constexpr int BUSY_TIMEOUT_MS = 5000;
+
+		/**
+		 * @brief Opens database connections.
+		 * @param path Database file path.
+		 * @param readers Amount of read-only connections (zero to read through writer connection).
+		 * @note An in-memory database is private to its connection, so it gets no read-only
+		 *       connections (regardless of `readers`).
+		 * @throw SQLiteException If failed to open database.
+		 */
+		ConnectionPool(const std::string& path, std::size_t readers);
+
+		ConnectionPool(const Self&) = delete;
+		Self& operator=(const Self&) = delete;
+
+		/**
+		 * @brief Runs a function on a read-only connection, waiting for one to be free.
+		 * @param func Function to run (given the connection, must not write through it).
+		 * @return Result of `func`.
+		 */
+		template <std::invocable<Connection&> F>
+		std::invoke_result_t<F, Connection&> read(F&& func);
+
+		/**
+		 * @brief Runs a function on the writer connection, waiting for other writes to finish.
+		 * @param func Function to run (given the connection).
+		 * @return Result of `func`.
+		 */
+		template <std::invocable<Connection&> F>
+		std::invoke_result_t<F, Connection&> write(F&& func);
+
+		/**
+		 * @brief Gets amount of read-only connections.
+		 * @return Amount of read-only connections.
+		 */
+		std::size_t readers() const noexcept;
+
+		/**
+		 * @brief Gets pool counters.
+		 * @return Counters since construction.
+		 */
+		ConnectionPoolStats stats() const;
+
+	private:
+		Connection _writer; // constructed first, so that tables exist when readers open
+		std::mutex _mtxWriter;
+
+		std::vector<std::unique_ptr<Connection>> _readers;
+
+		// idle read-only connections and counters, guarded by `_mtx`
+		mutable std::mutex _mtx;
+		std::condition_variable _cvIdleReaders;
+		std::vector<Connection*> _idleReaders;
+		std::uint64_t _reads = 0;
+		std::uint64_t _readWaits = 0;
+		std::uint64_t _writes = 0;
+
+		/**
+		 * @brief Applies connection pragmas shared by all connections.
+		 * @param conn Connection to apply pragmas on.
+		 */
+		static void tune(Connection& conn);
+
+		/**
+		 * @brief Lends an idle read-only connection, waiting for one if all are lent.
+		 * @return Lent connection (to be returned by `return_reader`).
+		 */
+		Connection& lend_reader();
+
+		/**
+		 * @brief Returns a lent read-only connection.
+		 * @param conn Lent connection.
+		 */
+		void return_reader(Connection& conn);
+	};
+}
+
+#include "ConnectionPool_impl.hpp"
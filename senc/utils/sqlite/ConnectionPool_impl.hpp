@@ -0,0 +1,124 @@
+/*********************************************************************
+ * \file   ConnectionPool_impl.hpp
+ * \brief  Implementation of sqlite ConnectionPool class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "ConnectionPool.hpp"
+
+#include "../AtScopeExit.hpp"
+
+namespace senc::utils::sqlite
+{
+	template <schemas::SomeDB Schema>
+	inline ConnectionPool<Schema>::ConnectionPool(const std::string& path, std::size_t readers)
+		: _writer(path)
+	{
+		// journal mode is kept in database file, so read-only connections open in WAL mode too
+		_writer.set_pragma("journal_mode", "WAL");
+		tune(_writer);
+
+		if (path.empty() || ":memory:" == path)
+			readers = 0;
+
+		_readers.reserve(readers);
+		_idleReaders.reserve(readers);
+		for (std::size_t i = 0; i < readers; ++i)
+		{
+			auto& reader = *_readers.emplace_back(
+				std::make_unique<Connection>(path, Connection::Access::ReadOnly)
+			);
+			tune(reader);
+			_idleReaders.push_back(&reader);
+		}
+	}
+
+	template <schemas::SomeDB Schema>
+	template <std::invocable<typename ConnectionPool<Schema>::Connection&> F>
+	inline std::invoke_result_t<F, typename ConnectionPool<Schema>::Connection&>
+		ConnectionPool<Schema>::read(F&& func)
+	{
+		if (_readers.empty())
+		{
+			{
+				const std::lock_guard<std::mutex> lock(_mtx);
+				_reads++;
+			}
+			const std::lock_guard<std::mutex> lock(_mtxWriter);
+			return std::invoke(std::forward<F>(func), _writer);
+		}
+
+		Connection& conn = lend_reader();
+		const AtScopeExit returnReader([this, &conn]() { return_reader(conn); });
+		return std::invoke(std::forward<F>(func), conn);
+	}
+
+	template <schemas::SomeDB Schema>
+	template <std::invocable<typename ConnectionPool<Schema>::Connection&> F>
+	inline std::invoke_result_t<F, typename ConnectionPool<Schema>::Connection&>
+		ConnectionPool<Schema>::write(F&& func)
+	{
+		{
+			const std::lock_guard<std::mutex> lock(_mtx);
+			_writes++;
+		}
+		const std::lock_guard<std::mutex> lock(_mtxWriter);
+		return std::invoke(std::forward<F>(func), _writer);
+	}
+
+	template <schemas::SomeDB Schema>
+	inline std::size_t ConnectionPool<Schema>::readers() const noexcept
+	{
+		return _readers.size();
+	}
+
+	template <schemas::SomeDB Schema>
+	inline ConnectionPoolStats ConnectionPool<Schema>::stats() const
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		return ConnectionPoolStats{
+			.readers = _readers.size(),
+			.readers_in_use = _readers.size() - _idleReaders.size(),
+			.reads = _reads,
+			.read_waits = _readWaits,
+			.writes = _writes
+		};
+	}
+
+	template <schemas::SomeDB Schema>
+	inline void ConnectionPool<Schema>::tune(Connection& conn)
+	{
+		conn.set_pragma("synchronous", "NORMAL");
+
+		// negative cache size is in KiB (rather than pages)
+		conn.set_pragma("cache_size", "-" + std::to_string(CACHE_SIZE_KIB));
+		conn.set_pragma("busy_timeout", std::to_string(BUSY_TIMEOUT_MS));
+	}
+
+	template <schemas::SomeDB Schema>
+	inline typename ConnectionPool<Schema>::Connection& ConnectionPool<Schema>::lend_reader()
+	{
+		std::unique_lock<std::mutex> lock(_mtx);
+		_reads++;
+		if (_idleReaders.empty())
+		{
+			_readWaits++;
+			_cvIdleReaders.wait(lock, [this]() { return !_idleReaders.empty(); });
+		}
+		Connection* conn = _idleReaders.back();
+		_idleReaders.pop_back();
+		return *conn;
+	}
+
+	template <schemas::SomeDB Schema>
+	inline void ConnectionPool<Schema>::return_reader(Connection& conn)
+	{
+		{
+			const std::lock_guard<std::mutex> lock(_mtx);
+			_idleReaders.push_back(&conn);
+		}
+		_cvIdleReaders.notify_one();
+	}
+}
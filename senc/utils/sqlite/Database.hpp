@@ -9,6 +9,11 @@
 #pragma once
 
 #include "TableView.hpp"
+#include "StatementCache.hpp"
+#include <type_traits>
+#include <functional>
+#include <concepts>
+#include <ranges>
 
 namespace senc::utils::sqlite
 {
@@ -24,18 +29,69 @@ namespace senc::utils::sqlite
 	public:
 		using Self = Database<Schema>;
 
+		/**
+		 * @enum senc::utils::sqlite::Database::Access
+		 * @brief Access of a database connection.
+		 */
+		enum class Access
+		{
+			ReadWrite, // creates database file and tables if missing
+			ReadOnly   // database (with its tables) must already exist
+		};
+
+		/**
+		 * @class senc::utils::sqlite::Database::Transaction
+		 * @brief Scoped database transaction (`BEGIN IMMEDIATE`), rolled back unless committed.
+		 * @note If database is already within a transaction, joins it (begins, commits and rolls
+		 *       back nothing), so that the outer transaction stays atomic.
+		 */
+		class Transaction
+		{
+		public:
+			using Self = Transaction;
+
+			/**
+			 * @brief Begins a transaction.
+			 * @param db Database to begin transaction on.
+			 * @throw SQLiteException If failed to begin transaction.
+			 */
+			explicit Transaction(Database& db);
+
+			/**
+			 * @brief Destructor of transaction, rolls back if not committed.
+			 */
+			~Transaction();
+
+			Transaction(const Self&) = delete;
+			Self& operator=(const Self&) = delete;
+
+			/**
+			 * @brief Commits the transaction.
+			 * @throw SQLiteException If failed to commit.
+			 */
+			void commit();
+
+		private:
+			Database& _db;
+			bool _active; // `true` if owns an uncommitted transaction
+		};
+
 		/**
 		 * @brief Loads database from file.
 		 * @param path Database file path.
+		 * @param access Access of database connection.
 		 * @throw SQLiteException If failed to open database.
 		 */
-		Database(const std::string& path);
+		Database(const std::string& path, Access access = Access::ReadWrite);
 
 		/**
 		 * @brief Database destructor, closes database.
 		 */
 		virtual ~Database();
 
+		Database(const Self&) = delete;
+		Self& operator=(const Self&) = delete;
+
 		/**
 		 * @brief Inserts a record into a table of the database.
 		 * @tparam tableName Name of table to insert into.
@@ -56,6 +112,32 @@ namespace senc::utils::sqlite
 		requires schemas::DBWithTable<Schema, tableName>
 		void remove(const std::string& where);
 
+		/**
+		 * @brief Inserts multiple records into a table of the database, within one transaction.
+		 * @note Records are inserted several at a time, by multi-row insert statements.
+		 * @tparam tableName Name of table to insert into.
+		 * @param rows Records to insert, as tuples of values (as given to `insert`).
+		 * @throw SQLiteException If insertion failed (no record is inserted).
+		 */
+		template <FixedString tableName, std::ranges::input_range R>
+		requires std::ranges::sized_range<R> &&
+			schemas::PARAMS_TUPLE_FOR_TABLE<
+				schemas::DBTable<Schema, tableName>,
+				std::remove_cvref_t<std::ranges::range_reference_t<R>>
+			>
+		void insert_many(R&& rows);
+
+		/**
+		 * @brief Runs a function within a transaction, committed if function returns normally.
+		 * @note If function throws, transaction is rolled back and exception is rethrown.
+		 * @note Nested calls join the outer transaction.
+		 * @param func Function to run (using this database).
+		 * @return Result of `func`.
+		 * @throw SQLiteException If failed to begin or commit transaction.
+		 */
+		template <std::invocable F>
+		std::invoke_result_t<F> transaction(F&& func);
+
 		/**
 		 * @brief Applies "select" on database (and gets fitting table view).
 		 * @tparam Args Select arguments.
@@ -70,7 +152,7 @@ namespace senc::utils::sqlite
 		TableView<schemas::Select<
 			schemas::DBTable<Schema, tableName>,
 			Args...
-		>> select();
+		>, schemas::DBTable<Schema, tableName>> select();
 
 		/**
 		 * @brief Applies (inner) join on database (and gets fitting table view).
@@ -95,9 +177,67 @@ namespace senc::utils::sqlite
 			axisCol2
 		>> join();
 
+		/**
+		 * @brief Gets value of a pragma of database connection.
+		 * @param name Pragma name (e.g. `"journal_mode"`).
+		 * @return Pragma value (empty if pragma has no value).
+		 * @throw SQLiteException If failed to query pragma.
+		 */
+		std::string get_pragma(const std::string& name);
+
+		/**
+		 * @brief Sets value of a pragma of database connection.
+		 * @param name Pragma name (e.g. `"journal_mode"`).
+		 * @param value Pragma value (e.g. `"WAL"`).
+		 * @throw SQLiteException If failed to set pragma.
+		 */
+		void set_pragma(const std::string& name, const std::string& value);
+
+		/**
+		 * @brief Gets prepared statement cache statistics of database connection.
+		 * @return Statement cache statistics (a hit is a reused prepared statement).
+		 */
+		LruCacheStats statement_cache_stats() const;
+
 	protected:
+		// maximum statement params count, as allowed by any sqlite version
+		static constexpr std::size_t MAX_STATEMENT_PARAMS = 999;
+
+		// maximum rows inserted by a single statement of `insert_many`
+		static constexpr std::size_t INSERT_MANY_MAX_ROWS = 64;
+
 		std::string _path;
 		sqlite3* _db;
+		StatementCache _statements; // used by `insert` and table views
+
+		/**
+		 * @brief Runs a (cached) statement which returns no rows.
+		 * @param sql SQL statement to run.
+		 * @throw SQLiteException If statement failed.
+		 */
+		void exec(const std::string& sql);
+
+		/**
+		 * @brief Opens database connection.
+		 * @param path Database file path.
+		 * @param access Access of database connection.
+		 * @return Native sqlite3 pointer.
+		 * @throw SQLiteException If failed to open database.
+		 */
+		static sqlite3* open(const std::string& path, Access access);
+
+		/**
+		 * @brief Runs a pragma statement, getting its (first) result value.
+		 * @param sql Pragma statement to run.
+		 * @return First column of first result row (empty if no rows).
+		 * @throw SQLiteException If statement failed.
+		 */
+		std::string exec_pragma(const std::string& sql);
+
+		/**
+		 * @brief Closes database connection (finalizing cached statements).
+		 */
+		void close();
 	};
 
 	/**
@@ -9,11 +9,14 @@
 #include "Database.hpp"
 
 #include "sqlite_utils.hpp"
+#include <algorithm>
+#include <optional>
 #include <cstdio>
+#include <tuple>
 
 namespace senc::utils::sqlite
 {
-	template <schemas::SomeTable... Ts>
+	template <schemas::SomeDBElem... Ts>
 	class DatabaseUtils;
 
 	template <FixedString name, schemas::SomeCol... Cs>
@@ -23,24 +26,43 @@ namespace senc::utils::sqlite
 	class ColUtils;
 
 	template <schemas::SomeDB Schema>
-	inline Database<Schema>::Database(const std::string& path)
-		: _path(path), _db(nullptr)
+	inline Database<Schema>::Transaction::Transaction(Database& db)
+		: _db(db), _active(0 != sqlite3_get_autocommit(db._db)) // not within a transaction
 	{
-		int code = sqlite3_open(_path.c_str(), &_db);
-		if (SQLITE_OK != code)
-			throw SQLiteException("Failed to open database " + _path, code);
+		if (_active)
+			_db.exec("BEGIN IMMEDIATE;");
+	}
 
-		DatabaseUtils(Schema{}).create_tables_if_not_exist(_db);
+	template <schemas::SomeDB Schema>
+	inline Database<Schema>::Transaction::~Transaction()
+	{
+		if (!_active)
+			return;
+		try { _db.exec("ROLLBACK;"); }
+		catch (const SQLiteException&) { } // rolled back by sqlite if failed
+	}
+
+	template <schemas::SomeDB Schema>
+	inline void Database<Schema>::Transaction::commit()
+	{
+		if (!_active)
+			return;
+		_db.exec("COMMIT;");
+		_active = false;
+	}
+
+	template <schemas::SomeDB Schema>
+	inline Database<Schema>::Database(const std::string& path, Access access)
+		: _path(path), _db(open(path, access)), _statements(_db)
+	{
+		if (Access::ReadWrite == access)
+			DatabaseUtils(Schema{}).create_tables_if_not_exist(_db);
 	}
 
 	template <schemas::SomeDB Schema>
 	inline Database<Schema>::~Database()
 	{
-		if (_db)
-		{
-			sqlite3_close(_db);
-			_db = nullptr;
-		}
+		close();
 	}
 
 	template <schemas::SomeDB Schema>
@@ -54,23 +76,18 @@ namespace senc::utils::sqlite
 			"(" + TableUtils(T{}).get_columns() + ") VALUES(" +
 			FIXED_STRING_DUP<"?", COLS_COUNT, ", "> + ");";
 
-		sqlite3_stmt* stmt = nullptr;
-		int code = sqlite3_prepare_v2(_db, sql.c_str(), -1, &stmt, nullptr);
-		if (SQLITE_OK != code)
-			throw SQLiteException(std::string("Failed to run statement: " + sql), code);
+		// statement is reset and returned to cache at scope exit
+		auto stmt = _statements.acquire(std::string(sql));
 
 		// bind parameters
 		ParamUtils::bind_all(
 			std::make_index_sequence<sizeof...(Values)>{},
-			stmt, values...
+			stmt.get(), values...
 		);
 
-		code = sqlite3_step(stmt);
+		int code = sqlite3_step(stmt.get());
 		if (SQLITE_DONE != code)
 			throw SQLiteException("Failed to insert into table " + std::string(tableName), code);
-
-		// cleanup
-		sqlite3_finalize(stmt);
 	}
 
 	template <schemas::SomeDB Schema>
@@ -85,6 +102,76 @@ namespace senc::utils::sqlite
 			throw SQLiteException("Failed to remove", code);
 	}
 
+	template <schemas::SomeDB Schema>
+	template <FixedString tableName, std::ranges::input_range R>
+	requires std::ranges::sized_range<R> &&
+		schemas::PARAMS_TUPLE_FOR_TABLE<
+			schemas::DBTable<Schema, tableName>,
+			std::remove_cvref_t<std::ranges::range_reference_t<R>>
+		>
+	inline void Database<Schema>::insert_many(R&& rows)
+	{
+		using T = schemas::DBTable<Schema, tableName>;
+		constexpr std::size_t COLS_COUNT = std::tuple_size_v<schemas::TableTuple<T>>;
+		constexpr std::size_t CHUNK_ROWS = std::clamp<std::size_t>(
+			MAX_STATEMENT_PARAMS / COLS_COUNT, 1, INSERT_MANY_MAX_ROWS
+		);
+		constexpr FixedString row = "(" + FIXED_STRING_DUP<"?", COLS_COUNT, ", "> + ")";
+		constexpr FixedString sql = "INSERT INTO " + schemas::TABLE_NAME<T> +
+			"(" + TableUtils(T{}).get_columns() + ") VALUES" +
+			FIXED_STRING_DUP<row, CHUNK_ROWS, ", "> + ";";
+
+		const std::size_t count = std::ranges::size(rows);
+		transaction([&]()
+		{
+			auto it = std::ranges::begin(rows);
+
+			// full chunks, by multi-row statement
+			if (count >= CHUNK_ROWS)
+			{
+				auto stmt = _statements.acquire(std::string(sql));
+				for (std::size_t chunk = 0; chunk < count / CHUNK_ROWS; ++chunk)
+				{
+					for (std::size_t i = 0; i < CHUNK_ROWS; ++i, ++it)
+						std::apply([&stmt, i](const auto&... values)
+						{
+							ParamUtils::bind_all_at(
+								std::make_index_sequence<sizeof...(values)>{},
+								stmt.get(), i * COLS_COUNT, values...
+							);
+						}, *it);
+
+					int code = sqlite3_step(stmt.get());
+					if (SQLITE_DONE != code)
+						throw SQLiteException("Failed to insert into table " + std::string(tableName), code);
+					sqlite3_reset(stmt.get()); // all params are re-bound by next chunk
+				}
+			}
+
+			// remaining rows, one at a time
+			for (std::size_t i = 0; i < count % CHUNK_ROWS; ++i, ++it)
+				std::apply([this](const auto&... values) { insert<tableName>(values...); }, *it);
+		});
+	}
+
+	template <schemas::SomeDB Schema>
+	template <std::invocable F>
+	inline std::invoke_result_t<F> Database<Schema>::transaction(F&& func)
+	{
+		Transaction trans(*this);
+		if constexpr (std::is_void_v<std::invoke_result_t<F>>)
+		{
+			std::invoke(std::forward<F>(func));
+			trans.commit();
+		}
+		else
+		{
+			auto res = std::invoke(std::forward<F>(func));
+			trans.commit();
+			return res;
+		}
+	}
+
 	template <schemas::SomeDB Schema>
 	template <FixedString tableName, SomeSelectArg... Args>
 	requires schemas::Selectable<
@@ -94,14 +181,14 @@ namespace senc::utils::sqlite
 	inline TableView<schemas::Select<
 		schemas::DBTable<Schema, tableName>,
 		Args...
-	>> Database<Schema>::select()
+	>, schemas::DBTable<Schema, tableName>> Database<Schema>::select()
 	{
 		using RetSchema = schemas::Select<
 			schemas::DBTable<Schema, tableName>,
 			Args...
 		>;
-		return TableView<RetSchema>(
-			_db,
+		return TableView<RetSchema, schemas::DBTable<Schema, tableName>>(
+			_statements,
 			std::string(schemas::TABLE_TO_SELECT<
 				RetSchema,
 				SelectArgsCollection<Args...>
@@ -132,7 +219,7 @@ namespace senc::utils::sqlite
 			axisCol2
 		>;
 		return TableView<RetSchema>(
-			_db,
+			_statements,
 			std::nullopt,
 			std::nullopt,
 			std::nullopt,
@@ -142,6 +229,77 @@ namespace senc::utils::sqlite
 		);
 	}
 
+	template <schemas::SomeDB Schema>
+	inline std::string Database<Schema>::get_pragma(const std::string& name)
+	{
+		return exec_pragma("PRAGMA " + name + ";");
+	}
+
+	template <schemas::SomeDB Schema>
+	inline void Database<Schema>::set_pragma(const std::string& name, const std::string& value)
+	{
+		exec_pragma("PRAGMA " + name + " = " + value + ";");
+	}
+
+	template <schemas::SomeDB Schema>
+	inline LruCacheStats Database<Schema>::statement_cache_stats() const
+	{
+		return _statements.stats();
+	}
+
+	template <schemas::SomeDB Schema>
+	inline sqlite3* Database<Schema>::open(const std::string& path, Access access)
+	{
+		const int flags = (Access::ReadOnly == access)
+			? SQLITE_OPEN_READONLY
+			: SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+		sqlite3* db = nullptr;
+		int code = sqlite3_open_v2(path.c_str(), &db, flags, nullptr);
+		if (SQLITE_OK != code)
+		{
+			sqlite3_close(db); // handle is allocated even on failure
+			throw SQLiteException("Failed to open database " + path, code);
+		}
+		return db;
+	}
+
+	template <schemas::SomeDB Schema>
+	inline void Database<Schema>::exec(const std::string& sql)
+	{
+		auto stmt = _statements.acquire(sql);
+		int code = sqlite3_step(stmt.get());
+		if (SQLITE_DONE != code)
+			throw SQLiteException("Failed to run statement: " + sql, code);
+	}
+
+	template <schemas::SomeDB Schema>
+	inline std::string Database<Schema>::exec_pragma(const std::string& sql)
+	{
+		// pragmas are rarely run, so they aren't cached
+		std::optional<std::string> res;
+		int code = sqlite3_exec(_db, sql.c_str(), [](void* out, int cols, char** values, char**) -> int
+		{
+			auto& res = *static_cast<std::optional<std::string>*>(out);
+			if (!res && cols > 0)
+				res.emplace(values[0] ? values[0] : "");
+			return 0;
+		}, &res, nullptr);
+		if (SQLITE_OK != code)
+			throw SQLiteException("Failed to run statement: " + sql, code);
+		return res.value_or("");
+	}
+
+	template <schemas::SomeDB Schema>
+	inline void Database<Schema>::close()
+	{
+		if (_db)
+		{
+			_statements.clear(); // connection can't close with unfinalized statements
+			sqlite3_close(_db);
+			_db = nullptr;
+		}
+	}
+
 	template <schemas::SomeDB Schema>
 	inline TempDatabase<Schema>::TempDatabase(const std::string& path)
 		: Base(path) { }
@@ -151,8 +309,7 @@ namespace senc::utils::sqlite
 	{
 		if (this->_db)
 		{
-			sqlite3_close(this->_db);
-			this->_db = nullptr;
+			this->close();
 			this->_path.clear();
 		}
 		if (!this->_path.empty())
@@ -0,0 +1,142 @@
+/*********************************************************************
+ * \file   StatementCache.cpp
+ * \brief  Implementation of sqlite StatementCache class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#include "StatementCache.hpp"
+
+#include "SQLiteException.hpp"
+#include <algorithm>
+
+namespace senc::utils::sqlite
+{
+	StatementCache::Statement::Statement(StatementCache& cache, std::string&& sql, sqlite3_stmt* stmt)
+		: _cache(&cache), _sql(std::move(sql)), _stmt(stmt) { }
+
+	StatementCache::Statement::Statement(Self&& other) noexcept
+		: _cache(other._cache), _sql(std::move(other._sql)), _stmt(other._stmt)
+	{
+		other._stmt = nullptr;
+	}
+
+	StatementCache::Statement::Self& StatementCache::Statement::operator=(Self&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release();
+			_cache = other._cache;
+			_sql = std::move(other._sql);
+			_stmt = other._stmt;
+			other._stmt = nullptr;
+		}
+		return *this;
+	}
+
+	StatementCache::Statement::~Statement()
+	{
+		release();
+	}
+
+	sqlite3_stmt* StatementCache::Statement::get() const noexcept
+	{
+		return _stmt;
+	}
+
+	void StatementCache::Statement::release() noexcept
+	{
+		if (!_stmt)
+			return;
+		sqlite3_reset(_stmt);
+		sqlite3_clear_bindings(_stmt);
+		_cache->put_back(std::move(_sql), _stmt);
+		_stmt = nullptr;
+	}
+
+	StatementCache::StatementCache(sqlite3* db, std::size_t capacity)
+		: _db(db), _capacity(std::max<std::size_t>(capacity, 1)) { }
+
+	StatementCache::~StatementCache()
+	{
+		clear();
+	}
+
+	sqlite3* StatementCache::db() const noexcept
+	{
+		return _db;
+	}
+
+	StatementCache::Statement StatementCache::acquire(const std::string& sql)
+	{
+		{
+			const std::lock_guard<std::mutex> lock(_mtx);
+			auto it = _index.find(sql);
+			if (_index.end() != it)
+			{
+				sqlite3_stmt* stmt = it->second->second;
+				_entries.erase(it->second);
+				_index.erase(it);
+				_stats.hits++;
+				return Statement(*this, std::string(sql), stmt);
+			}
+			_stats.misses++;
+		}
+
+		sqlite3_stmt* stmt = nullptr;
+		int code = sqlite3_prepare_v3(_db, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr);
+		if (SQLITE_OK != code)
+			throw SQLiteException("Failed to run statement: " + sql, code);
+		return Statement(*this, std::string(sql), stmt);
+	}
+
+	void StatementCache::clear()
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		for (const auto& [sql, stmt] : _entries)
+			sqlite3_finalize(stmt);
+		_index.clear();
+		_entries.clear();
+	}
+
+	std::size_t StatementCache::size() const
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		return _entries.size();
+	}
+
+	LruCacheStats StatementCache::stats() const
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		return _stats;
+	}
+
+	void StatementCache::reset_stats()
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+		_stats = LruCacheStats{};
+	}
+
+	void StatementCache::put_back(std::string&& sql, sqlite3_stmt* stmt) noexcept
+	{
+		const std::lock_guard<std::mutex> lock(_mtx);
+
+		// another statement of same SQL was returned while this one was lent (nested use)
+		if (_index.contains(sql))
+		{
+			sqlite3_finalize(stmt);
+			return;
+		}
+
+		_entries.emplace_front(std::move(sql), stmt);
+		_index.emplace(_entries.front().first, _entries.begin());
+		if (_entries.size() > _capacity)
+		{
+			sqlite3_finalize(_entries.back().second);
+			_index.erase(_entries.back().first);
+			_entries.pop_back();
+			_stats.evictions++;
+		}
+	}
+}
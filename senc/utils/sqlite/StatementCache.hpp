@@ -0,0 +1,154 @@
+/*********************************************************************
+ * \file   StatementCache.hpp
+ * \brief  Header of sqlite StatementCache class.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include <sqlite3.h>
+#include <cstdint>
+#include <string>
+#include <mutex>
+#include <list>
+#include <map>
+
+#include "../LruCache.hpp"
+
+namespace senc::utils::sqlite
+{
+	/**
+	 * @class senc::utils::sqlite::StatementCache
+	 * @brief Per-connection cache of prepared statements, keyed by their SQL.
+	 * @note Statements are lent out by `acquire` and returned (reset, with cleared bindings) when
+	 *       the lease is destroyed; a statement is never lent twice at the same time, so nested
+	 *       queries with the same SQL simply prepare another statement.
+	 */
+	class StatementCache
+	{
+	public:
+		using Self = StatementCache;
+		static constexpr std::size_t DEFAULT_CAPACITY = 64;
+
+		/**
+		 * @class senc::utils::sqlite::StatementCache::Statement
+		 * @brief Lease of a prepared statement, returning it to the cache on destruction.
+		 */
+		class Statement
+		{
+		public:
+			using Self = Statement;
+
+			Statement(const Self&) = delete;
+			Self& operator=(const Self&) = delete;
+
+			/**
+			 * @brief Move constructor of statement lease.
+			 */
+			Statement(Self&& other) noexcept;
+
+			/**
+			 * @brief Move assignment operator of statement lease.
+			 */
+			Self& operator=(Self&& other) noexcept;
+
+			/**
+			 * @brief Destructor of statement lease, returns statement to cache.
+			 */
+			~Statement();
+
+			/**
+			 * @brief Gets native statement handle.
+			 * @return Native statement handle.
+			 */
+			sqlite3_stmt* get() const noexcept;
+
+		private:
+			friend class StatementCache;
+
+			StatementCache* _cache;
+			std::string _sql;
+			sqlite3_stmt* _stmt;
+
+			Statement(StatementCache& cache, std::string&& sql, sqlite3_stmt* stmt);
+
+			/**
+			 * @brief Returns held statement to cache (if any).
+			 */
+			void release() noexcept;
+		};
+
+		/**
+		 * @brief Constructs an empty statement cache for a connection.
+		 * @param db Native sqlite3 pointer of connection.
+		 * @param capacity Maximum amount of idle statements held (at least one).
+		 */
+		explicit StatementCache(sqlite3* db, std::size_t capacity = DEFAULT_CAPACITY);
+
+		/**
+		 * @brief Destructor of statement cache, finalizes idle statements.
+		 * @note Must be cleared before connection is closed.
+		 */
+		~StatementCache();
+
+		StatementCache(const Self&) = delete;
+		Self& operator=(const Self&) = delete;
+
+		/**
+		 * @brief Gets native sqlite3 pointer of connection.
+		 * @return Native sqlite3 pointer.
+		 */
+		sqlite3* db() const noexcept;
+
+		/**
+		 * @brief Gets a prepared statement of given SQL, preparing it if none is idle.
+		 * @param sql SQL of statement.
+		 * @return Lease of prepared statement.
+		 * @throw SQLiteException If failed to prepare statement.
+		 */
+		Statement acquire(const std::string& sql);
+
+		/**
+		 * @brief Finalizes all idle statements (statistics are kept).
+		 */
+		void clear();
+
+		/**
+		 * @brief Gets amount of idle statements.
+		 * @return Amount of idle statements.
+		 */
+		std::size_t size() const;
+
+		/**
+		 * @brief Gets lookup statistics (a hit is an `acquire` reusing an idle statement).
+		 * @return Statistics since construction (or last `reset_stats`).
+		 */
+		LruCacheStats stats() const;
+
+		/**
+		 * @brief Resets lookup statistics.
+		 */
+		void reset_stats();
+
+	private:
+		// idle statements ordered by use (most recent first), and index of them by SQL
+		using Entry = std::pair<std::string, sqlite3_stmt*>;
+		using Entries = std::list<Entry>;
+
+		sqlite3* _db;
+		const std::size_t _capacity;
+		mutable std::mutex _mtx;
+		Entries _entries;
+		std::map<std::string, typename Entries::iterator> _index;
+		LruCacheStats _stats;
+
+		/**
+		 * @brief Returns a statement to the idle set (evicting least recently used if full).
+		 * @param sql SQL of statement.
+		 * @param stmt Statement to return (reset, with cleared bindings).
+		 */
+		void put_back(std::string&& sql, sqlite3_stmt* stmt) noexcept;
+	};
+}
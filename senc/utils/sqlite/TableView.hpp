@@ -9,23 +9,31 @@
 #pragma once
 
 #include "schemas/all.hpp"
+#include "StatementCache.hpp"
+#include <functional>
 #include <optional>
 #include <string>
 #include <vector>
 
 namespace senc::utils::sqlite
 {
+	/**
+	 * @brief Binds a (captured) parameter to a statement parameter of given index.
+	 */
+	using ParamBinder = std::function<void(sqlite3_stmt* stmt, int index)>;
+
 	/**
 	 * @class senc::utils::sqlite::TableView
 	 * @brief Used to view a database's table (or joined tables).
 	 * @tparam Schema Schema of viewed table.
+	 * @tparam Underlying Schema of table filtered by "where" clauses (viewed table before last select).
 	 * @note Has forward declaration in `sqlite_utils.hpp`
 	 */
-	template <schemas::SomeTable Schema>
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying = Schema>
 	class TableView
 	{
 	public:
-		using Self = TableView<Schema>;
+		using Self = TableView<Schema, Underlying>;
 		using Tuple = schemas::TableTuple<Schema>;
 		static constexpr auto ROW_LEN = std::tuple_size_v<Tuple>;
 		
@@ -40,15 +48,15 @@ namespace senc::utils::sqlite
 		Self& operator=(const Self&) = default;
 
 		/**
-		 * @brief Constructs a table view form native sqlite3 pointer.
-		 * @param db Native sqlite3 pointer.
+		 * @brief Constructs a table view from a connection's statement cache.
+		 * @param statements Statement cache of viewed database connection.
 		 * @param select Select string constructed from original schema (moved).
 		 */
-		explicit TableView(sqlite3* db, std::string&& select);
+		explicit TableView(StatementCache& statements, std::string&& select);
 
 		/**
-		 * @brief Constructs a table view from native sqlite3 pointer and an inner query.
-		 * @param db Native sqlite3 pointer.
+		 * @brief Constructs a table view from a connection's statement cache and an inner query.
+		 * @param statements Statement cache of viewed database connection.
 		 * @param select An optional "select" query part (`std::nullopt` means select all).
 		 * @param where An optional vector of "where" clauses for filtering.
 		 * @param orderBy An optional vector of "order by" clauses for ordering.
@@ -56,7 +64,7 @@ namespace senc::utils::sqlite
 		 * @param offset An optional row offset.
 		 * @param inner An optional (lambda) function returning an inner query (using a copied inner view).
 		 */
-		explicit TableView(sqlite3* db,
+		explicit TableView(StatementCache& statements,
 						   const std::optional<std::string>& select,
 						   const std::optional<std::vector<std::string>>& where,
 						   const std::optional<std::vector<std::string>>& orderBy,
@@ -75,7 +83,7 @@ namespace senc::utils::sqlite
 			Schema,
 			Args...
 		>
-		TableView<schemas::Select<Schema, Args...>> select() const;
+		TableView<schemas::Select<Schema, Args...>, Schema> select() const;
 
 		/**
 		 * @brief Applies a where clause on the table view.
@@ -84,6 +92,22 @@ namespace senc::utils::sqlite
 		 */
 		Self where(const std::string& condition) const;
 
+		/**
+		 * @brief Applies a where clause comparing a column to a value, bound as a statement parameter.
+		 * @note Unlike string clauses, resulting SQL doesn't depend on `value`, so the prepared
+		 *       statement can be reused for any value.
+		 * @note Column may be any column of the underlying table (not only selected ones), and `value`
+		 *       must fit its type.
+		 * @note `value` is copied into the view; if it is a value view, viewed data must outlive
+		 *       the table view.
+		 * @tparam colName Name of column to compare.
+		 * @param value Value to compare column to.
+		 * @return Table view with "where" applied.
+		 */
+		template <FixedString colName, Param P>
+		requires schemas::TableWithParamCol<Underlying, colName, P>
+		Self where(const P& value) const;
+
 		/**
 		 * @brief Applied "order by" to the table view.
 		 * @tparam Arg Order argument.
@@ -147,9 +171,13 @@ namespace senc::utils::sqlite
 		const Self& operator>>(schemas::TableCallable<Schema> auto&& callback) const;
 
 	private:
-		sqlite3* _db;
+		template <schemas::SomeTable S, schemas::SomeTable U>
+		friend class TableView;
+
+		StatementCache* _statements;
 		std::optional<std::string> _select;
 		std::vector<std::string> _where;
+		std::vector<ParamBinder> _params; // by order of appearance in SQL
 		std::vector<std::string> _orderBy;
 		std::optional<std::int64_t> _limit;
 		std::optional<std::int64_t> _offset;
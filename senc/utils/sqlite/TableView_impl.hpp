@@ -13,7 +13,7 @@
 
 namespace senc::utils::sqlite
 {
-	template <schemas::SomeTable... Ts>
+	template <schemas::SomeDBElem... Ts>
 	class DatabaseUtils;
 
 	template <FixedString name, schemas::SomeCol... Cs>
@@ -22,20 +22,20 @@ namespace senc::utils::sqlite
 	template <schemas::SomeCol C>
 	class ColUtils;
 
-	template <schemas::SomeTable Schema>
-	inline TableView<Schema>::TableView(sqlite3* db, std::string&& select)
-		: _db(db), _select(std::move(select)) { }
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+	inline TableView<Schema, Underlying>::TableView(StatementCache& statements, std::string&& select)
+		: _statements(&statements), _select(std::move(select)) { }
 
-	template <schemas::SomeTable Schema>
-	inline TableView<Schema>::TableView(
-		sqlite3* db,
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+	inline TableView<Schema, Underlying>::TableView(
+		StatementCache& statements,
 		const std::optional<std::string>& select,
 		const std::optional<std::vector<std::string>>& where,
 		const std::optional<std::vector<std::string>>& orderBy,
 		const std::optional<std::int64_t> limit,
 		const std::optional<std::int64_t> offset,
 		const std::optional<std::function<std::string()>>& inner)
-		: _db(db),
+		: _statements(&statements),
 		  _select(select),
 		  _where(where.value_or(std::vector<std::string>{})),
 		  _orderBy(orderBy.value_or(std::vector<std::string>{})),
@@ -43,21 +43,23 @@ namespace senc::utils::sqlite
 		  _offset(offset),
 		  _inner(inner) { }
 
-	template <schemas::SomeTable Schema>
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
 	template <SomeSelectArg... Args>
 	requires schemas::Selectable<
 		Schema,
 		Args...
 	>
-	inline TableView<schemas::Select<Schema, Args...>> TableView<Schema>::select() const
+	inline TableView<schemas::Select<Schema, Args...>, Schema> TableView<Schema, Underlying>::select() const
 	{
 		using RetSchema = schemas::Select<Schema, Args...>;
-		using Ret = TableView<RetSchema>;
+		using Ret = TableView<RetSchema, Schema>;
 
 		// if has select already, return a new view with `this` being used as an inner view
+		// (inner query comes before any clause of new view, so its params are bound first)
 		if (_select.has_value())
-			return Ret(
-				_db,
+		{
+			Ret res(
+				*_statements,
 				std::string(schemas::TABLE_TO_SELECT<
 					RetSchema,
 					SelectArgsCollection<Args...>,
@@ -69,10 +71,13 @@ namespace senc::utils::sqlite
 				std::nullopt,
 				[*this]() -> std::string { return this->as_sql(); }
 			);
+			res._params = _params;
+			return res;
+		}
 		
 		// otherwise, simply add select
-		return Ret(
-			_db,
+		Ret res(
+			*_statements,
 			std::string(schemas::TABLE_TO_SELECT<
 				RetSchema,
 				SelectArgsCollection<Args...>
@@ -83,10 +88,12 @@ namespace senc::utils::sqlite
 			_offset,
 			_inner
 		);
+		res._params = _params;
+		return res;
 	}
 
-	template <schemas::SomeTable Schema>
-	inline TableView<Schema>::Self TableView<Schema>::where(const std::string& condition) const
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+	inline TableView<Schema, Underlying>::Self TableView<Schema, Underlying>::where(const std::string& condition) const
 	{
 		using Ret = Self;
 
@@ -95,9 +102,25 @@ namespace senc::utils::sqlite
 		return res;
 	}
 
-	template <schemas::SomeTable Schema>
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+	template <FixedString colName, Param P>
+	requires schemas::TableWithParamCol<Underlying, colName, P>
+	inline TableView<Schema, Underlying>::Self TableView<Schema, Underlying>::where(const P& value) const
+	{
+		using Ret = Self;
+
+		Ret res = *this;
+		res._where.push_back(std::string(colName) + " = ?");
+		res._params.push_back([value](sqlite3_stmt* stmt, int index)
+		{
+			ParamUtils::bind_one(stmt, index, value);
+		});
+		return res;
+	}
+
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
 	template <SomeOrderArg Arg>
-	inline TableView<Schema>::Self TableView<Schema>::order_by() const
+	inline TableView<Schema, Underlying>::Self TableView<Schema, Underlying>::order_by() const
 	{
 		using Ret = Self;
 
@@ -107,8 +130,8 @@ namespace senc::utils::sqlite
 		return res;
 	}
 
-	template <schemas::SomeTable Schema>
-	inline TableView<Schema>::Self TableView<Schema>::limit(std::int64_t n) const
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+	inline TableView<Schema, Underlying>::Self TableView<Schema, Underlying>::limit(std::int64_t n) const
 	{
 		using Ret = Self;
 
@@ -122,8 +145,8 @@ namespace senc::utils::sqlite
 		return res;
 	}
 
-	template <schemas::SomeTable Schema>
-	inline TableView<Schema>::Self TableView<Schema>::offset(std::int64_t n) const
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+	inline TableView<Schema, Underlying>::Self TableView<Schema, Underlying>::offset(std::int64_t n) const
 	{
 		using Ret = Self;
 
@@ -132,66 +155,66 @@ namespace senc::utils::sqlite
 		return res;
 	}
 
-	template <schemas::SomeTable Schema>
-	inline const TableView<Schema>::Self&
-		TableView<Schema>::operator>>(Tuple& tpl) const
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+	inline const TableView<Schema, Underlying>::Self&
+		TableView<Schema, Underlying>::operator>>(Tuple& tpl) const
 	{
 		TableUtils(Schema{}).execute(
-			_db, as_sql(),
+			*_statements, as_sql(), _params,
 			[&tpl](auto&&... values) { tpl = std::make_tuple(values...); },
 			1
 		);
 		return *this;
 	}
 
-	template <schemas::SomeTable Schema>
-	inline const TableView<Schema>::Self&
-		TableView<Schema>::operator>>(std::vector<Tuple>& tpls) const
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+	inline const TableView<Schema, Underlying>::Self&
+		TableView<Schema, Underlying>::operator>>(std::vector<Tuple>& tpls) const
 	{
 		TableUtils(Schema{}).execute(
-			_db, as_sql(),
+			*_statements, as_sql(), _params,
 			[&tpls](auto&&... values) { tpls.emplace_back(values...); },
 			std::nullopt
 		);
 		return *this;
 	}
 
-	template <schemas::SomeTable Schema>
-	inline const TableView<Schema>::Self&
-		TableView<Schema>::operator>>(std::tuple_element_t<0, Tuple>& var) const
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+	inline const TableView<Schema, Underlying>::Self&
+		TableView<Schema, Underlying>::operator>>(std::tuple_element_t<0, Tuple>& var) const
 	requires (1 == ROW_LEN)
 	{
 		TableUtils(Schema{}).execute(
-			_db, as_sql(),
+			*_statements, as_sql(), _params,
 			[&var](auto&& value) { var = value; },
 			1
 		);
 		return *this;
 	}
 
-	template <schemas::SomeTable Schema>
-	inline const TableView<Schema>::Self&
-		TableView<Schema>::operator>>(std::vector<std::tuple_element_t<0, Tuple>>& vec) const
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+	inline const TableView<Schema, Underlying>::Self&
+		TableView<Schema, Underlying>::operator>>(std::vector<std::tuple_element_t<0, Tuple>>& vec) const
 	requires (1 == ROW_LEN)
 	{
 		TableUtils(Schema{}).execute(
-			_db, as_sql(),
+			*_statements, as_sql(), _params,
 			[&vec](auto&& value) { vec.emplace_back(value); },
 			std::nullopt
 		);
 		return *this;
 	}
 
-	template <schemas::SomeTable Schema>
-	inline const TableView<Schema>::Self&
-		TableView<Schema>::operator>>(schemas::TableCallable<Schema> auto&& callback) const
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+	inline const TableView<Schema, Underlying>::Self&
+		TableView<Schema, Underlying>::operator>>(schemas::TableCallable<Schema> auto&& callback) const
 	{
-		TableUtils(Schema{}).execute(_db, as_sql(), callback, std::nullopt);
+		TableUtils(Schema{}).execute(*_statements, as_sql(), _params, callback, std::nullopt);
 		return *this;
 	}
 
-	template <schemas::SomeTable Schema>
-	inline std::string TableView<Schema>::as_sql() const
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+	inline std::string TableView<Schema, Underlying>::as_sql() const
 	{
 		std::string res = _select.has_value() ? *_select : "SELECT * FROM";
 
@@ -10,16 +10,61 @@
 
 #include "../../FixedString.hpp"
 #include "tables.hpp"
+#include "indexes.hpp"
 
 namespace senc::utils::sqlite::schemas
 {
+	/**
+	 * @concept senc::utils::sqlite::schemas::SomeDBElem
+	 * @brief Looks for a database schema element (table or index schema).
+	 * @tparam Self Examined typename.
+	 */
+	template <typename Self>
+	concept SomeDBElem = SomeTable<Self> || SomeIndex<Self>;
+
+	namespace sfinae
+	{
+		// used for checking if a DB schema element is a table of a specific name
+		template <SomeDBElem E, FixedString tableName>
+		struct is_table_named : std::false_type { };
+
+		template <SomeTable T, FixedString tableName>
+		struct is_table_named<T, tableName> : std::bool_constant<(TABLE_NAME<T> == tableName)> { };
+
+		// used for checking if there are duplicated tables in a pack of DB schema elements
+		template <SomeDBElem... Es>
+		struct has_dup_db_tables : std::false_type { };
+
+		// table: compare to every table that comes after
+		template <SomeTable First, SomeDBElem... Rest>
+		struct has_dup_db_tables<First, Rest...> : std::disjunction<
+			std::bool_constant<(is_table_named<Rest, TABLE_NAME<First>>::value || ...)>,
+			has_dup_db_tables<Rest...>
+		> { };
+
+		// index: skip
+		template <SomeIndex First, SomeDBElem... Rest>
+		struct has_dup_db_tables<First, Rest...> : has_dup_db_tables<Rest...> { };
+
+		// used for checking if a DB schema element is valid among all elements
+		// (an index must be on one of the tables)
+		template <typename E, typename... Es>
+		struct is_valid_db_elem : std::true_type { };
+
+		template <SomeIndex I, SomeDBElem... Es>
+		struct is_valid_db_elem<I, Es...> : std::bool_constant<(IndexOnTable<I, Es> || ...)> { };
+	}
+
 	/**
 	 * @struct senc::utils::sqlite::schemas::DB
 	 * @brief Schema of database.
-	 * @tparam Ts Database tables (schemas).
+	 * @tparam Ts Database tables and indexes (schemas).
+	 * @note Requires `Ts` to contain no duplicated tables, and indexes to be on tables (and
+	 *       columns) within `Ts`.
 	 */
-	template <SomeTable... Ts>
-	requires (!HAS_DUP_TABLES<Ts...>)
+	template <SomeDBElem... Ts>
+	requires (!sfinae::has_dup_db_tables<Ts...>::value) &&
+		(sfinae::is_valid_db_elem<Ts, Ts...>::value && ...)
 	struct DB { };
 
 	namespace sfinae
@@ -28,7 +73,7 @@ namespace senc::utils::sqlite::schemas
 		template <typename T>
 		struct some_db : std::false_type { };
 
-		template <SomeTable... Ts>
+		template <SomeDBElem... Ts>
 		struct some_db<DB<Ts...>> : std::true_type { };
 	}
 
@@ -46,10 +91,10 @@ namespace senc::utils::sqlite::schemas
 		template <SomeDB D, FixedString tableName>
 		struct db_has_table : std::false_type { };
 
-		template <FixedString tableName, SomeTable... Ts>
+		template <FixedString tableName, SomeDBElem... Ts>
 		struct db_has_table<DB<Ts...>, tableName>
-			: std::bool_constant<((tableName == TABLE_NAME<Ts>) || ...)> { };
-		// any of `Ts` has name `tableName`
+			: std::bool_constant<(is_table_named<Ts, tableName>::value || ...)> { };
+		// any of `Ts` is a table with name `tableName`
 	}
 
 	/**
@@ -65,13 +110,13 @@ namespace senc::utils::sqlite::schemas
 	namespace sfinae
 	{
 		// used for retrieving table by name
-		template <FixedString tableName, SomeTable... Ts>
+		template <FixedString tableName, SomeDBElem... Ts>
 		struct find_table { using type = void; };
 
-		// if first has name, return. otherwise, continue
-		template <FixedString tableName, SomeTable First, SomeTable... Rest>
+		// if first is a table with name, return. otherwise, continue
+		template <FixedString tableName, SomeDBElem First, SomeDBElem... Rest>
 		struct find_table<tableName, First, Rest...> : std::conditional<
-			(TABLE_NAME<First> == tableName),
+			is_table_named<First, tableName>::value,
 			First,
 			typename find_table<tableName, Rest...>::type
 		> { };
@@ -80,7 +125,7 @@ namespace senc::utils::sqlite::schemas
 		requires DBWithTable<D, tableName>
 		struct db_table { };
 
-		template <FixedString tableName, SomeTable... Ts>
+		template <FixedString tableName, SomeDBElem... Ts>
 		struct db_table<DB<Ts...>, tableName> : find_table<tableName, Ts...> { };
 	}
 
@@ -123,18 +168,10 @@ namespace senc::utils::sqlite::schemas
 		// used for retreiving DB table column by names of table and column
 		template <SomeDB D, FixedString tableName, FixedString colName>
 		requires DBWithTableWithCol<D, tableName, colName>
-		struct db_table_col { };
-
-		// if first has table name, invoke table column getter. otherwise, continue
-		template <
-			FixedString tableName, FixedString colName,
-			SomeTable First, SomeTable... Rest
-		>
-		struct db_table_col<DB<First, Rest...>, tableName, colName> : std::conditional<
-			(TABLE_NAME<First> == tableName),
-			TableCol<First, colName>,
-			typename db_table_col<DB<Rest...>, tableName, colName>::type
-		> { };
+		struct db_table_col
+		{
+			using type = TableCol<DBTable<D, tableName>, colName>;
+		};
 	}
 
 	/**
@@ -10,6 +10,7 @@
 
 #include "columns.hpp"
 #include "tables.hpp"
+#include "indexes.hpp"
 #include "DBs.hpp"
 #include "select.hpp"
 #include "join.hpp"
@@ -0,0 +1,126 @@
+/*********************************************************************
+ * \file   indexes.hpp
+ * \brief  Contains sqlite index schema utilities.
+ *
+ * \author aviad1b
+ * \date   October 2026, Heshvan 5787
+ *********************************************************************/
+
+#pragma once
+
+#include "../../FixedString.hpp"
+#include "tables.hpp"
+
+namespace senc::utils::sqlite::schemas
+{
+	/**
+	 * @struct senc::utils::sqlite::schemas::BasicIndex
+	 * @brief Schema of (secondary) index on table columns.
+	 * @tparam unique Whether index is unique (no two records share indexed values).
+	 * @tparam tableName Name of indexed table.
+	 * @tparam colNames Names of indexed columns (by order).
+	 * @note Use through `Index` and `UniqueIndex`.
+	 */
+	template <bool unique, FixedString tableName, FixedString... colNames>
+	requires (sizeof...(colNames) > 0)
+	struct BasicIndex
+	{
+		static constexpr bool UNIQUE = unique;
+		static constexpr FixedString TABLE_NAME = tableName;
+		static constexpr FixedString NAME = "idx_" + tableName + "_" + FIXED_STRING_JOIN<"_", colNames...>;
+		static constexpr FixedString COLS = FIXED_STRING_JOIN<", ", colNames...>;
+	};
+
+	/**
+	 * @typedef senc::utils::sqlite::schemas::Index
+	 * @brief Schema of (secondary) index on table columns.
+	 * @tparam tableName Name of indexed table.
+	 * @tparam colNames Names of indexed columns (by order).
+	 */
+	template <FixedString tableName, FixedString... colNames>
+	using Index = BasicIndex<false, tableName, colNames...>;
+
+	/**
+	 * @typedef senc::utils::sqlite::schemas::UniqueIndex
+	 * @brief Schema of unique (secondary) index on table columns.
+	 * @tparam tableName Name of indexed table.
+	 * @tparam colNames Names of indexed columns (by order).
+	 */
+	template <FixedString tableName, FixedString... colNames>
+	using UniqueIndex = BasicIndex<true, tableName, colNames...>;
+
+	namespace sfinae
+	{
+		// used for detecting an index schema
+		template <typename T>
+		struct some_index : std::false_type { };
+
+		template <bool unique, FixedString tableName, FixedString... colNames>
+		struct some_index<BasicIndex<unique, tableName, colNames...>> : std::true_type { };
+	}
+
+	/**
+	 * @concept senc::utils::sqlite::schemas::SomeIndex
+	 * @brief Looks for any instantation of an index schema.
+	 * @tparam Self Examined typename.
+	 */
+	template <typename Self>
+	concept SomeIndex = sfinae::some_index<Self>::value;
+
+	/**
+	 * @var senc::utils::sqlite::schemas::INDEX_NAME
+	 * @brief Gets (generated) index name from index schema.
+	 * @tparam I Index schema.
+	 */
+	template <SomeIndex I>
+	constexpr FixedString INDEX_NAME = I::NAME;
+
+	/**
+	 * @var senc::utils::sqlite::schemas::INDEX_TABLE_NAME
+	 * @brief Gets name of indexed table from index schema.
+	 * @tparam I Index schema.
+	 */
+	template <SomeIndex I>
+	constexpr FixedString INDEX_TABLE_NAME = I::TABLE_NAME;
+
+	/**
+	 * @var senc::utils::sqlite::schemas::INDEX_COLS
+	 * @brief Gets indexed columns from index schema, in one string (comma separated).
+	 * @tparam I Index schema.
+	 */
+	template <SomeIndex I>
+	constexpr FixedString INDEX_COLS = I::COLS;
+
+	/**
+	 * @var senc::utils::sqlite::schemas::IS_UNIQUE_INDEX
+	 * @brief Checks if index schema is of a unique index.
+	 * @tparam I Index schema.
+	 */
+	template <SomeIndex I>
+	constexpr bool IS_UNIQUE_INDEX = I::UNIQUE;
+
+	namespace sfinae
+	{
+		// used for checking if an index schema is on a given table schema (with all its columns)
+		template <SomeIndex I, SomeTable T>
+		struct index_on_table : std::false_type { };
+
+		template <bool unique, FixedString indexTableName, FixedString... colNames,
+			FixedString tableName, SomeCol... Cs>
+		struct index_on_table<BasicIndex<unique, indexTableName, colNames...>, Table<tableName, Cs...>>
+			: std::bool_constant<
+				(indexTableName == tableName) &&
+				(TableWithCol<Table<tableName, Cs...>, colNames> && ...)
+			> { };
+	}
+
+	/**
+	 * @concept senc::utils::sqlite::schemas::IndexOnTable
+	 * @brief Looks for an index schema on a given table schema (with all indexed columns in table).
+	 * @tparam Self Examined typename.
+	 * @tparam T Table schema.
+	 */
+	template <typename Self, typename T>
+	concept IndexOnTable = SomeIndex<Self> && SomeTable<T> &&
+		sfinae::index_on_table<Self, T>::value;
+}
@@ -157,6 +157,17 @@ namespace senc::utils::sqlite::schemas
 	requires TableWithCol<T, colName>
 	using TableCol = typename sfinae::table_col<T, colName>::type;
 
+	/**
+	 * @concept senc::utils::sqlite::schemas::TableWithParamCol
+	 * @brief Looks for a table schema which has a column with a specific name, fitting for a given param.
+	 * @tparam Self Examined typename.
+	 * @tparam colName Column name to look for.
+	 * @tparam P Param typename (compared to column).
+	 */
+	template <typename Self, FixedString colName, typename P>
+	concept TableWithParamCol = SomeTable<Self> && TableWithCol<Self, colName> &&
+		ParamOfValue<P, ColType<TableCol<Self, colName>>>;
+
 	/**
 	 * @var senc::utils::sqlite::schemas::IS_DUP_TABLE
 	 * @brief Checks if one table schema is duplicate of another (cannot be differentiated).
@@ -217,6 +228,27 @@ namespace senc::utils::sqlite::schemas
 	template <SomeTable T, typename... Ps>
 	constexpr bool PARAMS_FOR_TABLE = sfinae::params_for_table<T, Ps...>::value;
 
+	namespace sfinae
+	{
+		// used to check if a given tuple typename is of params fitting for insertion into a table
+		template <SomeTable T, typename Tpl>
+		struct params_tuple_for_table : std::false_type { };
+
+		template <SomeTable T, typename... Ps>
+		struct params_tuple_for_table<T, std::tuple<Ps...>> : std::bool_constant<
+			PARAMS_FOR_TABLE<T, Ps...>
+		> { };
+	}
+
+	/**
+	 * @var senc::utils::sqlite::schemas::PARAMS_TUPLE_FOR_TABLE
+	 * @brief Checks if given tuple typename is of params fitting for insertion into a table.
+	 * @tparam T Table schema.
+	 * @tparam Tpl Tuple typename (of params).
+	 */
+	template <SomeTable T, typename Tpl>
+	constexpr bool PARAMS_TUPLE_FOR_TABLE = sfinae::params_tuple_for_table<T, Tpl>::value;
+
 	namespace sfinae
 	{
 		// utility sfinae used for concating a column at a table's head
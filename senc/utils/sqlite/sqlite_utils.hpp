@@ -17,7 +17,7 @@ namespace senc::utils::sqlite
 	template <schemas::SomeDB Schema>
 	class Database;
 
-	template <schemas::SomeTable Schema>
+	template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
 	class TableView;
 
 	/**
@@ -29,6 +29,20 @@ namespace senc::utils::sqlite
 		template <schemas::SomeDB Schema>
 		friend class Database;
 
+		template <schemas::SomeTable Schema, schemas::SomeTable Underlying>
+		friend class TableView;
+
+		/**
+		 * @brief Binds a parameter to a statement parameter.
+		 * @tparam P Parameter type.
+		 * @param stmt Statement handle pointer.
+		 * @param index Statement param index (counting from one).
+		 * @param param Parameter to bind.
+		 * @throw SQLiteException If failed to bind.
+		 */
+		template <Param P>
+		static void bind_one(sqlite3_stmt* stmt, int index, const P& param);
+
 		/**
 		 * @brief Binds a parameter to a statement parameter.
 		 * @tparam i Statement param index.
@@ -50,6 +64,19 @@ namespace senc::utils::sqlite
 		 */
 		template <std::size_t... is, Param... Ps>
 		static void bind_all(std::index_sequence<is...> dummy, sqlite3_stmt* stmt, const Ps&... params);
+
+		/**
+		 * @brief Binds parameters to consecutive statement parameters, starting at a given offset.
+		 * @tparam is Statement param indexes (relative to `offset`).
+		 * @tparam Ps Parameter types.
+		 * @param stmt Statement handle pointer.
+		 * @param offset Amount of statement params before first one to bind.
+		 * @param params Parameters to bind.
+		 * @throw SQLiteException If failed to bind.
+		 */
+		template <std::size_t... is, Param... Ps>
+		static void bind_all_at(std::index_sequence<is...> dummy, sqlite3_stmt* stmt,
+								std::size_t offset, const Ps&... params);
 	};
 
 	/**
@@ -123,9 +150,10 @@ namespace senc::utils::sqlite
 	class TableUtils
 	{
 		using Schema = schemas::Table<name, Cs...>;
-		friend class TableView<Schema>;
+		template <schemas::SomeTable S, schemas::SomeTable U>
+		friend class TableView;
 
-		template <schemas::SomeTable... Ts>
+		template <schemas::SomeDBElem... Ts>
 		friend class DatabaseUtils;
 
 		template <schemas::SomeDB Schema>
@@ -136,14 +164,16 @@ namespace senc::utils::sqlite
 
 		/**
 		 * @brief Executes a statement with a given callback function on a table.
-		 * @param db Database handle pointer.
+		 * @param statements Statement cache of database connection.
 		 * @param sql SQL statement to run.
+		 * @param params Binders of statement parameters (by order).
 		 * @param callback A callback function (of fitting schema).
 		 * @param expected Optional expected record count.
 		 * @throw SQLiteException If `expected` was provided and exceeded or not met.
 		 */
-		void execute(sqlite3* db,
+		void execute(StatementCache& statements,
 					 const std::string& sql,
+					 const std::vector<ParamBinder>& params,
 					 schemas::TableCallable<Schema> auto&& callback,
 					 std::optional<int> expected);
 
@@ -190,12 +220,42 @@ namespace senc::utils::sqlite
 		}
 	};
 
+	/**
+	 * @class senc::utils::sqlite::IndexUtils
+	 * @brief Contains private utility index functions.
+	 * @tparam I Index schema.
+	 */
+	template <schemas::SomeIndex I>
+	class IndexUtils
+	{
+		template <schemas::SomeDBElem... Ts>
+		friend class DatabaseUtils;
+
+		// dummy arg is used for template inference
+		constexpr IndexUtils(I) { }
+
+		/**
+		 * @brief Gets SQL create statement for index.
+		 * @return SQL create statement.
+		 */
+		static constexpr auto get_create_statement()
+		{
+			constexpr auto rest = "INDEX IF NOT EXISTS " +
+				schemas::INDEX_NAME<I> + " ON " + schemas::INDEX_TABLE_NAME<I> +
+				"(" + schemas::INDEX_COLS<I> + ");";
+			if constexpr (schemas::IS_UNIQUE_INDEX<I>)
+				return "CREATE UNIQUE " + rest;
+			else
+				return "CREATE " + rest;
+		}
+	};
+
 	/**
 	 * @class senc::utils::sqlite::DatabaseUtils
 	 * @brief Contains private utility database functions.
-	 * @tparam Ts Database table schemas.
+	 * @tparam Ts Database table and index schemas.
 	 */
-	template <schemas::SomeTable... Ts>
+	template <schemas::SomeDBElem... Ts>
 	class DatabaseUtils
 	{
 		using Schema = schemas::DB<Ts...>;
@@ -205,11 +265,39 @@ namespace senc::utils::sqlite
 		DatabaseUtils(Schema) { }
 
 		/**
-		 * @brief Creates each table in schema if doesn't exist.
+		 * @brief Creates each table in schema if doesn't exist, then each index.
 		 * @param db Database handle pointer.
 		 * @throw SQLiteException On error.
 		 */
 		void create_tables_if_not_exist(sqlite3* db);
+
+		/**
+		 * @brief Gets SQL create statement for schema element, if it is a table.
+		 * @tparam E Database schema element.
+		 * @return SQL create statement of table (followed by a space), or empty if not a table.
+		 */
+		template <schemas::SomeDBElem E>
+		static constexpr auto get_table_create_statement()
+		{
+			if constexpr (schemas::SomeTable<E>)
+				return TableUtils(E{}).get_create_statement() + " ";
+			else
+				return FixedString("");
+		}
+
+		/**
+		 * @brief Gets SQL create statement for schema element, if it is an index.
+		 * @tparam E Database schema element.
+		 * @return SQL create statement of index (followed by a space), or empty if not an index.
+		 */
+		template <schemas::SomeDBElem E>
+		static constexpr auto get_index_create_statement()
+		{
+			if constexpr (schemas::SomeIndex<E>)
+				return IndexUtils(E{}).get_create_statement() + " ";
+			else
+				return FixedString("");
+		}
 	};
 }
 
@@ -14,6 +14,12 @@ namespace senc::utils::sqlite
 	inline void ParamUtils::bind_one(sqlite3_stmt* stmt, const P& param)
 	{
 		constexpr int index = static_cast<int>(i) + 1; // sql starts counting params from one
+		bind_one(stmt, index, param);
+	}
+
+	template <Param P>
+	inline void ParamUtils::bind_one(sqlite3_stmt* stmt, int index, const P& param)
+	{
 		param.bind(stmt, index);
 	}
 
@@ -24,21 +30,29 @@ namespace senc::utils::sqlite
 		(bind_one<is, Ps>(stmt, params), ...);
 	}
 
+	template <std::size_t... is, Param... Ps>
+	inline void ParamUtils::bind_all_at(std::index_sequence<is...> dummy, sqlite3_stmt* stmt,
+										std::size_t offset, const Ps&... params)
+	{
+		(void)dummy; // for template inference
+		(bind_one(stmt, static_cast<int>(offset + is) + 1, params), ...);
+	}
+
 	template <FixedString name, schemas::SomeCol... Cs>
 	inline void TableUtils<name, Cs...>::execute(
-		sqlite3* db,
+		StatementCache& statements,
 		const std::string& sql,
+		const std::vector<ParamBinder>& params,
 		schemas::TableCallable<Schema> auto&& callback,
 		std::optional<int> expected)
 	{
-		sqlite3_stmt* stmt = nullptr;
-
-		int code = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, nullptr);
-		if (SQLITE_OK != code)
-			throw SQLiteException("Failed to run statement: " + sql, code);
+		// statement is reset and returned to cache at scope exit
+		const auto lease = statements.acquire(sql);
+		sqlite3_stmt* stmt = lease.get();
 
-		// cleanup of `stmt` at scope exit
-		AtScopeExit cleanup([stmt]() { sqlite3_finalize(stmt); });
+		// bind parameters (sql starts counting params from one)
+		for (std::size_t i = 0; i < params.size(); ++i)
+			params[i](stmt, static_cast<int>(i) + 1);
 
 		// if has limit, set limit function to compare; otherwise, limit function always false
 		std::function<bool(int)> pastLimit = expected.has_value()
@@ -61,11 +75,13 @@ namespace senc::utils::sqlite
 			throw SQLiteException("Too few rows to unpack: Expected " + std::to_string(*expected));
 	}
 
-	template <schemas::SomeTable... Ts>
+	template <schemas::SomeDBElem... Ts>
 	inline void DatabaseUtils<Ts...>::create_tables_if_not_exist(sqlite3* db)
 	{
+		// indexes are created after all tables, since they refer to them
 		const auto sql = "BEGIN; " +
-			((TableUtils(Ts{}).get_create_statement() + " ") + ...) +
+			(get_table_create_statement<Ts>() + ...) +
+			(get_index_create_statement<Ts>() + ...) +
 			"COMMIT;";
 		int code = sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr);
 		if (SQLITE_OK != code)